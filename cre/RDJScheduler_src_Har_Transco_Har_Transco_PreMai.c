@@ -10,6 +10,8 @@
  *
  *         Har_Transco_PreMai <Parameter 1> <Parameter 2>
  *       - Parameter 1 : Input File                         [Mandatory]
+ *                       "-" : Records read from stdin and written to stdout, Logs written to stderr
+ *                       gzip or zstd compressed Input is detected, RDJ_OUTPUT_COMPRESSION compresses the Output
  *       - Parameter 2 : Accounting Date in YYYYMMDD Format [Mandatory]
  *		 - Parameter 3 : Site [if "NULL" : Default Site is CACIB+SST+LCL (PPCO dodge CACIB) / If "CASA" : Site is CASA (PPCO dodge CASA)]
  *
@@ -25,17 +27,42 @@
 /* Includes */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
 #include <errno.h>
 #include <time.h>
 #include <math.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/timeb.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#define IO_URING_SUPPORTED
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define INPUT_SCAN_DISPATCHED					// AVX2 and AVX-512 Scanners of the Input File chosen at run time
+#endif
+#ifdef RDJ_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef RDJ_WITH_ZSTD
+#include <zstd.h>
+#endif
 
 /* Additional Functions */
 #define SIGN(x)  ((x) < 0 ? ('-') : ('+'))
 #define ROUND(x) ((x - floor(x)) < 0.5 ? (floor(x)) : (ceil(x)))
+#define DIGIT(x) (((x) >= '0') && ((x) <= '9') ? ((x) - '0') : 0)
 
 /* Common Constants */
 #define DATE_LENGTH						8
@@ -52,17 +79,42 @@
 #define FIELD_NAME_LENGTH				50
 #define FIELD_FORMAT_LENGTH				20
 #define MAX_FIELD_LENGTH				500				
+#define NUMERIC_SCAN_WIDTH				16	// Characters of a Numeric Field classified at once
+#define NUMERIC_SCAN_LENGTH				64	// Longest Numeric Field converted by ConvertNumericField
 #define MAX_FIELD_NUMBER				400
 #define SEPARATOR 						";"
 
 /* Hash Key Handling */
-#define HASH_DODGE_ARRAY_SIZE  			2000
-#define HASH_CURRENCY_ARRAY_SIZE		50
-#define HASH_LOT_ARRAY_SIZE				2000
+#define HASH_MIN_ARRAY_SIZE				1024	// Hash Tables are sized at run time : power of 2, at least HASH_LOAD_FACTOR times the Number of Records
+#define HASH_LOAD_FACTOR				2
+#define HASH_MAX_LOT_ARRAY_SIZE			1048576	// Maximal initial Size of LOTHashArray : the Table grows beyond if needed
+#define LOT_RESIZE_STEP					16		// Number of Slots moved into the resized LOTHashArray Table at each access
+#define LOT_KEY_IRREGULAR				0x8000000000000000ULL	// Set in ullAPPLI_EMET when the LOT Key cannot be packed : the Key String is kept
+#define HASH_GROUP_SIZE					16		// Number of Slots whose Control Bytes are compared at once
+#define HASH_CTRL_EMPTY					0x00	// Control Byte of a free Slot
+#define HASH_CTRL_USED					0x80	// Control Byte of a used Slot : HASH_CTRL_USED | 7 bits Fingerprint of the Hash Key
 #define HASH_KEY_FOUND			   		1
 #define HASH_KEY_NOT_FOUND				0
-#define MAX_HASH_KEY_LENGTH				18	// Hash Key is a 'long long' variable. Its Maximal Value is : 9 223 372 036 854 775 807
+#define MAX_HASH_KEY_LENGTH				18	// Former Hash Key was a 'long long' variable. Its Maximal Value is : 9 223 372 036 854 775 807
 											// The string "zzzzzzzzzzzzzzzzzz" gives the highest value of Hash Key : 9 999 999 999 999 999 990
+#define HASH_FORMER_ARRAY_SIZE			2000	// Size of the former static Hash Key Tables, used by the Hash Key Report
+#define HASH_KEY_SEED					0x9E3779B97F4A7C15ULL
+#define HASH_KEY_MULTIPLIER				0xBF58476D1CE4E5B9ULL
+#define HASH_REPORT_VARIABLE			"RDJ_HASH_REPORT"	// If this environment variable is set, the Distribution of the Hash Keys is printed
+#define PERFECT_HASH_VARIABLE			"RDJ_DODGE_PERFECT_HASH"	// If this environment variable is set, COMPTE_DODGE Accounts are found by a Minimal Perfect Hash
+#define PERFECT_HASH_BUCKET_SIZE		4		// Average Number of Keys per Bucket of the Perfect Hash
+#define PERFECT_HASH_MAX_PILOT			16777216	// Number of Pilots tried for a Bucket before giving up the Perfect Hash
+
+/* Snapshot of the Reference Tables */
+#define SNAPSHOT_VARIABLE				"RDJ_REF_SNAPSHOT"	// If this environment variable is set, the Tables built from a .dat File are kept in a Snapshot File
+#define SNAPSHOT_FILE_EXTENSION			".premai.snp"	// The Snapshot File is written next to its .dat File
+#define SNAPSHOT_MAGIC					"RDJSNAP"
+#define SNAPSHOT_VERSION				1		// To be increased when BuildHashKey or the Layout of a Table changes
+#define SNAPSHOT_ALIGNMENT				64		// Each Table of the Snapshot starts on a Cache Line
+#define SNAPSHOT_MAX_SECTIONS			8		// Maximal Number of Tables in a Snapshot
+#define SNAPSHOT_MAX_COUNTERS			4
+#define COMPTE_DODGE_SNAPSHOT_SECTIONS	2		// COMPTE_DODGEHashArray and its Control Bytes
+#define CURRENCY_SNAPSHOT_SECTIONS		2		// CURRENCYDecimalArray and CURRENCYOverflowArray
 
 /* File Handling */
 #define MAX_INPUT_REC_LENGTH			1000
@@ -76,6 +128,60 @@
 #define MAX_ID_ECRITU					999999
 #define HEADER_CH_FILLER1_LENGTH		94
 #define OUTPUT_FILE_EXTENSION			".out"
+
+/* Input File mapped by Windows */
+#define INPUT_MAP_WINDOW_SIZE			(256L * 1024 * 1024)	// Size of the mapped Windows of the Input File
+#define INPUT_STDIO_VARIABLE			"RDJ_INPUT_STDIO"	// If this environment variable is set, the Input File is read with fgets instead of being mapped
+#define INPUT_SCAN_BLOCK_SIZE			64					// Bytes scanned at once for their '\n' and '\0' : one Bit each in a Mask
+#define INPUT_SCAN_BLOCKS				4096				// Blocks scanned in one pass (256 KB)
+#define INPUT_SCAN_RECORDS				4096				// Maximal Number of Records found in one pass
+#define INPUT_SCAN_VARIABLE				"RDJ_INPUT_SCAN"	// "scalar", "sse2" or "avx2" : the Scanner used if it is narrower than the widest one supported
+#define INPUT_SCAN_ZERO_BYTES(w)		((((~((((w) & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | (w))) & 0x8080808080808080ULL) >> 7) * 0x0102040810204080ULL >> 56)	// Bit n set if the Byte n of the Word w is '\0'
+
+/* Output File written by large Blocks */
+#define OUTPUT_BUFFER_ALIGNMENT			4096				// Alignment of the Output Buffers
+#define OUTPUT_MAPPED_OFF_VARIABLE		"RDJ_OUTPUT_MAPPED_OFF"	// If this environment variable is set, the Enrichment Threads hand their Records to main instead of writing them in the mapped Output File
+
+/* Asynchronous I/O : Input File read ahead and Output File written behind the Records handled */
+#define IO_RING_DEPTH_VARIABLE			"RDJ_IO_RING_DEPTH"	// Number of Buffers read or written in flight (0 : Input File mapped, Output File written synchronously)
+#define IO_RING_DEFAULT_DEPTH			4
+#define IO_RING_MIN_DEPTH				2
+#define IO_RING_MAX_DEPTH				64
+#define IO_BUFFER_SIZE_VARIABLE			"RDJ_IO_BUFFER_MB"	// Size of each Buffer, in MB
+#define IO_BUFFER_DEFAULT_MB			8
+#define IO_URING_OFF_VARIABLE			"RDJ_IO_URING_OFF"	// If this environment variable is set, the Requests are handled by a Worker Thread instead of io_uring
+#define IO_REQUEST_READ					0
+#define IO_REQUEST_WRITE				1
+#define IO_REQUEST_FREE					0					// States of a Request
+#define IO_REQUEST_QUEUED				1
+#define IO_REQUEST_DONE					2
+
+/* Streaming inside a Pipe */
+#define STREAM_FILE_NAME				"-"					// Input File read from stdin and Output File written to stdout, the Logs going to stderr
+#define STREAM_OUTPUT_FILE_NAME			"(stdout)"
+
+/* Output Records created in parallel : LOT_NUM and ID_ECRITU given by main, in the Order of the Input File */
+#define ENRICH_THREADS_VARIABLE			"RDJ_ENRICH_THREADS"	// Number of Threads creating the Output Records (0 : one by CPU). Default : 1, the Records are created by main
+#define ENRICH_MAX_THREADS				64
+#define ENRICH_BATCHES_BY_THREAD		2					// Batches created while the former ones are written
+#define ENRICH_BATCH_RECORDS			2048				// Maximal Number of Records of a Batch
+#define ENRICH_BATCH_SIZE				(1024L * 1024)		// Size of the Input Records of a Batch, beyond which it is submitted
+#define ENRICH_BATCH_LOT_SLOTS			(2 * ENRICH_BATCH_RECORDS)	// Slots of the LOT Table of a Batch : power of 2
+#define ENRICH_BATCH_FREE				0					// States of a Batch
+#define ENRICH_BATCH_QUEUED				1
+#define ENRICH_BATCH_DONE				2
+
+/* Compressed Input and Output Files : gzip built with -DRDJ_WITH_ZLIB -lz, zstd with -DRDJ_WITH_ZSTD -lzstd (libzstd 1.4 or later, for ZSTD_compressStream2) */
+#define COMPRESSION_NONE				0
+#define COMPRESSION_GZIP				1
+#define COMPRESSION_ZSTD				2
+#define COMPRESSION_OUTPUT_VARIABLE		"RDJ_OUTPUT_COMPRESSION"	// "gzip" or "zstd", followed by ":Level" if needed : the Output File is compressed
+#define COMPRESSION_GZIP_LEVEL			6
+#define COMPRESSION_GZIP_LEVEL_MAX		9
+#define COMPRESSION_ZSTD_LEVEL			3
+#define COMPRESSION_ZSTD_LEVEL_MAX		22
+#define COMPRESSION_CHUNK_SIZE			(1024L * 1024)		// Size of the Blocks read and written when decompressing the Input File
+
 #define CONFIGURATION_DIRECTORY			"RDJ_DAT"
 #define INPUT_FILE_FORMAT_NAME			"struct_premai.conf"
 #define REF_RCA_CPT_CAS_FILE_NAME		"REF_RCA_CPT_CAS.dat"
@@ -91,6 +197,7 @@
 #define REF_RCA_CPT_RECORD_LENGTH		3000
 #define REF_RCA_CPT_SEPARATOR			";"
 #define MAX_SEPARATOR_IN_REF_RCA_CPT	54	// Number of separators in REF_RCA_CPT.dat File
+#define REF_RCA_CPT_SCAN_WIDTH			16	// Characters of a REF_RCA_CPT.dat Record searched at once for the Separators
 #define MAX_FIELD_NUMBER_REF_RCA_CPT	55	// Number of records in REF_RCA_CPT.conf File
 #define ADD_CD_TYPIMP_TYPEI_TVA			10
 #define UPDATE_MAI_MNT_IMP				110
@@ -111,6 +218,13 @@
 #define MAX_FIELD_NUMBER_CURRENCY		2	// Number of records in REF_CURRENCY.conf File
 #define CURRENCY_CD_LENGTH				3
 #define EMPTY_CURRENCY					"   "
+#define CURRENCY_LETTER_NUMBER			26	// Codes made of 3 upper case Letters are indexed directly in CURRENCYDecimalArray
+#define CURRENCY_EMPTY_INDEX			(CURRENCY_LETTER_NUMBER * CURRENCY_LETTER_NUMBER * CURRENCY_LETTER_NUMBER)
+#define CURRENCY_DIRECT_ARRAY_SIZE		(CURRENCY_EMPTY_INDEX + 1)
+#define CURRENCY_NOT_INDEXED			-1
+#define CURRENCY_DECIMAL_NOT_FOUND		'\0'
+#define CURRENCY_DEFAULT_DECIMAL_POS	'3'
+#define MAX_CURRENCY_OVERFLOW			50	// Codes of REF_CURRENCY.dat File which are not 3 upper case Letters
 
 char RefRcaCpt_Record[REF_RCA_CPT_RECORD_LENGTH];
 char ENTITY[10];
@@ -135,6 +249,21 @@ typedef enum
 	unknown=-1		// Unknown Format
 }	enumFieldFormat;
 
+/* Role of a Field of the Input Record in the building of the Output Record */
+typedef enum 
+{
+	roleMapped=0,		// Field only converted and mapped in the Output Record
+	roleMAI_DEV_IMP=1,	// Currency : MAI_DEV_IMP
+	roleMAI_MNT_IMP=2,	// Amount : MAI_MNT_IMP
+	roleMAI_DEV_GES=3,	// Currency of Management : MAI_DEV_GES
+	roleMAI_MNT_GES=4,	// Amount of Management : MAI_MNT_GES
+	roleMAI_DEV_CTP=5,	// Original Currency of Operation : MAI_DEV_CTP
+	roleMAI_MNT_NOM=6,	// Nominal Amount : MAI_MNT_NOM
+	roleMAI_DAT_OPE=7,	// Date of Operation : MAI_DAT_OPE
+	roleMAI_CPT_IMP=8,	// DODGE Account : MAI_CPT_IMP
+	roleMAI_REF_OPE=9	// Reference of Operation : MAI_REF_OPE
+}	enumFieldRole;
+
 /* Useful Data extracted from REF_RCA_CPT.dat File */ 
 struct
 {
@@ -162,39 +291,89 @@ typedef struct stCOMPTE_DODGEHashElt
 	char		strTVA[CD_TVA_APP_FIELD_LENGTH + 1];
 }	COMPTE_DODGEHashElt;
 
-struct
+COMPTE_DODGEHashElt		*COMPTE_DODGEHashArray		= NULL;
+unsigned char			*COMPTE_DODGEHashCtrl		= NULL;		// One Control Byte per Slot of COMPTE_DODGEHashArray
+long					lCOMPTE_DODGEHashArraySize	= 0;
+
+/* COMPTE_DODGEPerfectArray Table : one Slot per Account, given by the Pilot of the Bucket of the Account */
+typedef struct stCOMPTE_DODGEPerfectElt
 {
-	COMPTE_DODGEHashElt		stElt[HASH_DODGE_ARRAY_SIZE];
-}	COMPTE_DODGEHashArray[HASH_DODGE_ARRAY_SIZE];
+	char 		strCOMPTE_DODGE[15 + 1];	// Only used to check the Key
+	char		strHB_IMPUTATION[CD_TYPIMP_FIELD_LENGTH + 1];
+	char 		strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH + 1];
+	char		strTVA[CD_TVA_APP_FIELD_LENGTH + 1];
+}	COMPTE_DODGEPerfectElt;
 
-/* CURRENCYHashArray Table */
-typedef struct stCURRENCYHashElt
+COMPTE_DODGEPerfectElt	*COMPTE_DODGEPerfectArray	= NULL;		// NULL if the Perfect Hash is not used
+unsigned int			*COMPTE_DODGEPerfectPilot	= NULL;		// One Pilot per Bucket
+long					lCOMPTE_DODGEPerfectSize	= 0;		// Number of Accounts
+long					lCOMPTE_DODGEPerfectBuckets	= 0;
+
+/* CURRENCY Table : Number of Decimals of each Currency Code, CURRENCY_DECIMAL_NOT_FOUND if the Code is unknown */
+char	CURRENCYDecimalArray[CURRENCY_DIRECT_ARRAY_SIZE];
+
+/* Codes of REF_CURRENCY.dat File which cannot be indexed in CURRENCYDecimalArray Table */
+typedef struct stCURRENCYOverflowElt
 {
-	long long	CURRENCYHashKey;
 	char 		strCURRENCY_CD[CURRENCY_CD_LENGTH + 1];
 	char		strDECIMAL_POS[1 + 1];
-}	CURRENCYHashElt;
+}	CURRENCYOverflowElt;
 
-struct
+CURRENCYOverflowElt		CURRENCYOverflowArray[MAX_CURRENCY_OVERFLOW];
+long					lCURRENCYOverflowNumber		= 0;
+
+/* Snapshot File : Header followed by the Tables (Sections) built from a .dat File */
+typedef struct stSnapshotHeader
+{
+	char				strMagic[8];
+	unsigned int		uiVersion;
+	unsigned int		uiNbSections;
+	long long			llSourceSize;			// Key of the .dat File : Size, Modification Time and Content Hash
+	long long			llSourceMtime;
+	unsigned long long	ullSourceHash;
+	unsigned long long	ullFormatKey;			// Key of the Layout of the Tables and of the .conf File used
+	unsigned long long	ullPayloadHash;			// Checksum of the Sections
+	long long			llSectionSize[SNAPSHOT_MAX_SECTIONS];
+	long long			llCounter[SNAPSHOT_MAX_COUNTERS];
+}	SnapshotHeader;
+
+typedef struct stSnapshot
+{
+	char			strFileName[MAX_FULL_FILE_NAME_LENGTH + 16];
+	SnapshotHeader	stKey;					// Key expected, then Header of the mapped Snapshot
+	char			*pMapping;				// NULL if the Snapshot is not mapped
+	long			lMappingSize;
+	char			*pSection[SNAPSHOT_MAX_SECTIONS];
+}	Snapshot;
+
+Snapshot				COMPTE_DODGESnapshot;		// COMPTE_DODGE Hash Key Table is in COMPTE_DODGESnapshot when it is mapped
+
+/* Packed LOT Key : built from APPLI_EMET and ID_LOT without any string operation */
+typedef struct stLOTKey
 {
-	CURRENCYHashElt		stElt[HASH_CURRENCY_ARRAY_SIZE];
-}	CURRENCYHashArray[HASH_CURRENCY_ARRAY_SIZE];
+	unsigned long long	ullID_LOT;		// DAT_OPE (27 bits) | NUM_CRE (20 bits) << 27 | HB_IMPUTATION (1 bit) << 47 | TOP_INT_EXT (8 bits) << 48
+	unsigned long long	ullAPPLI_EMET;	// 3 characters of APPLI_EMET, with LOT_KEY_IRREGULAR for an irregular Key
+}	LOTKey;
 
 /* LOTHashArray Table */
 typedef struct stLOTHashElt
 {
-	long long	LOTHashKey;
-	char		strAPPLI_EMET_ID_LOT[20 + 1];
-	char		strAPPLI_EMET[3 + 1];
-	char		strID_LOT[17 + 1];
+	LOTKey		stKey;
 	long		iLOT_NUM;
 	long		iID_ECRITU;
+	char		strAPPLI_EMET_ID_LOT[20 + 1];	// Only filled for an irregular Key
 }	LOTHashElt;
 
-struct
-{
-	LOTHashElt	stElt[HASH_LOT_ARRAY_SIZE];
-}	LOTHashArray[HASH_LOT_ARRAY_SIZE];
+LOTHashElt	*LOTHashArray			= NULL;		// Empty Slot : iLOT_NUM == 0
+long		lLOTHashArraySize		= 0;
+long		lLOTHashArrayElements	= 0;
+
+/* While LOTHashArray is resized, the Elements of the former Table are moved by LOT_RESIZE_STEP Slots */
+LOTHashElt	*LOTFormerHashArray			= NULL;		// NULL if no Resize in progress
+long		lLOTFormerHashArraySize		= 0;
+long		lLOTFormerHashArrayPosit	= 0;		// Slots below this Position are already moved
+long		lLOTHashArrayPeakSize		= 0;		// Highest Number of Slots allocated at once
+long		lLOTHashArrayResizes		= 0;
 
 /* Table of the different Fields of the Output File Record */
 struct
@@ -209,6 +388,24 @@ struct
 	int				iFieldStartPosOutput;
 }	tabFieldOfRecord[MAX_FIELD_NUMBER];
 
+/* Plan of the Output File Record : tabFieldOfRecord without the Names and Formats of its Fields, resolved once by BuildOutputRecordFormat */
+typedef struct stFieldPlan
+{
+	enumFieldRole	iFieldRole;
+	enumFieldFormat	iFieldFormat;			// Conversion done by Convert_InputField
+	int				iFieldType;
+	int				iFieldLengthInput;
+	int				iFieldLengthOutput;
+	int				iFieldStartPosInput;
+	int				iFieldStartPosOutput;
+}	FieldPlan;
+
+FieldPlan	tabFieldPlan[MAX_FIELD_NUMBER];
+int			iFieldPlanNumber		= 0;		// Number of Fields in tabFieldPlan
+
+/* Powers of 10 used to rescale the Amounts */
+unsigned long long	ullPowerOf10[AMOUNT_FIELD_LENGTH + 1] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL};
+
 /* Table of the different Fields of the REF_RCA_CPT.dat or REF_RCA_CPT_CAS.dat File */
 struct
 {
@@ -247,12 +444,206 @@ struct
 	char Input_Record[MAX_INPUT_REC_LENGTH];
 }	Input_Record_Struct;
 
+/* Compression of the Output File */
+const char *tabCompressionName[]		= { "none", "gzip", "zstd" };
+const char *tabCompressionExtension[]	= { "", ".gz", ".zst" };
+
+typedef struct stCompressor
+{
+	int			iFormat;				// COMPRESSION_GZIP or COMPRESSION_ZSTD
+	void		*pStream;				// z_stream or ZSTD_CCtx
+	char		*pBuffer;				// Compressed Data to write
+	long		lBufferSize;
+	long long	llBytesOut;				// Bytes written in the Output File
+}	Compressor;
+
+/* Input File decompressed by a Thread into a Pipe */
+typedef struct stDecompressor
+{
+	FILE		*pSource;				// Compressed Input File
+	int			iFormat;				// Given by the Magic Bytes of the Input File
+	int			iPipe[2];
+	char		*pReadBuffer;			// stdio Buffer of the Pipe
+	long long	llBytesIn;
+	long long	llBytesOut;
+	int			iError;					// errno, or -1 if the compressed Data are corrupted
+	pthread_t	stThread;
+	int			iStarted;
+}	Decompressor;
+
+Decompressor	InputFile_Decompressor;
+
+/* Request of an asynchronous I/O Ring */
+typedef struct stIORequest
+{
+	int			iFile;
+	int			iOpcode;				// IO_REQUEST_READ or IO_REQUEST_WRITE
+	char		*pBuffer;
+	long		lLength;
+	long long	llOffset;
+	long		lDone;					// Bytes read or written
+	int			iError;					// errno of a failed Request
+	int			iState;					// IO_REQUEST_FREE, IO_REQUEST_QUEUED or IO_REQUEST_DONE
+}	IORequest;
+
+/* Asynchronous I/O Ring : its Requests are handled by io_uring, or by a Worker Thread */
+typedef struct stIORing
+{
+	int				iDepth;					// 0 if the Ring is not started
+	IORequest		stRequest[IO_RING_MAX_DEPTH];
+	int				iUring;					// io_uring File Descriptor, -1 without io_uring
+	char			*pSQRing;
+	long			lSQRingSize;
+	char			*pCQRing;
+	long			lCQRingSize;
+	void			*pSQEntries;
+	long			lSQEntriesSize;
+	unsigned int	*puiSQTail;
+	unsigned int	*puiSQArray;
+	unsigned int	uiSQMask;
+	unsigned int	*puiCQHead;
+	unsigned int	*puiCQTail;
+	unsigned int	uiCQMask;
+	void			*pCQEntries;
+	pthread_t		stWorker;
+	int				iWorkerStarted;
+	pthread_mutex_t	stMutex;
+	pthread_cond_t	stQueued;
+	pthread_cond_t	stDone;
+	int				iQueue[IO_RING_MAX_DEPTH];	// Slots submitted to the Worker Thread, in Order
+	int				iQueueHead;
+	int				iQueueCount;
+	int				iStop;
+	Compressor		*pCompressor;			// Written Blocks compressed first by the Worker Thread
+}	IORing;
+
+/* Input File mapped by Windows : its Records are read in place, as fgets would read them */
+typedef struct stInputMap
+{
+	int			iFile;
+	long long	llFileSize;
+	long long	llWindowOffset;			// Offset in the Input File of the mapped Window
+	long		lWindowSize;
+	char		*pWindow;				// NULL if the Input File is read with fgets
+	long long	llRecordOffset;			// Offset in the Input File of the next Record
+	const char	*pPendingRecord;		// Last Record read in place, not copied in Input_Record_Struct
+	long		lPendingLength;
+	IORing		stRing;					// Started if the Input File is read ahead instead of mapped
+	char		*pBuffers;				// Buffers read ahead, each one after MAX_INPUT_REC_LENGTH free Bytes
+	long		lBufferSize;
+	int			iBuffer;				// Buffer of the current Window
+	long long	llReadOffset;			// Offset in the Input File of the next Read
+	void		(*pScanBlocks)(const char *, long, unsigned long long *, unsigned long long *);
+	unsigned long long	*pullNewLineMasks;	// Masks of the '\n' and '\0' of the scanned Part of the Window
+	unsigned long long	*pullNulMasks;
+	long		*plScanOffset;			// Records found by the last Scan : Offset in the Window,
+	long		*plScanChunk;			// Bytes read up to the '\n' included,
+	long		*plScanLength;			// and Length given by strlen
+	long		lScanRecords;
+	long		lScanNext;				// Next Record of the last Scan to be read
+}	InputMap;
+
+#define INPUT_BUFFER(map, slot)			((map)->pBuffers + (slot) * (MAX_INPUT_REC_LENGTH + (map)->lBufferSize))
+
+InputMap	InputFile_Map;
+long		lInputRecordExtent		= 0;	// Create_Output_Record reads the Input Record up to this Position
+
+/* Output File written by large Blocks from an aligned Buffer */
+typedef struct stOutputWriter
+{
+	int				iFile;
+	char			*pBuffers;				// One Buffer by Slot of the I/O Ring
+	char			*pBuffer;				// Buffer being filled
+	long			lBufferSize;
+	int				iBuffer;
+	IORing			stRing;					// Started if the Buffers are written behind
+	int				iStream;				// TRUE if the Output File is a Pipe or compressed, written at its current Position
+	Compressor		stCompressor;
+	long			lBufferUsed;
+	long long		llBytesWritten;
+	long			lWrites;				// Number of write calls
+	char			*pMapping;				// Output File mapped while the Enrichment Threads write each Record in its Slot
+	long long		llMappingSize;
+	long			lSlotSize;				// Maximal Length of an Output Record and its '\n'
+	struct timespec	stStartTime;
+}	OutputWriter;
+
+OutputWriter	OutputFile_Writer;
+
 /* Output File */
-struct
+typedef struct stOutputRecord
 {
 	char Output_Header[HEADER_LENGTH + 1];
 	char Output_Record[MAX_INPUT_REC_LENGTH + 3 * (SIGN_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH) + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH + CD_TVA_APP_FIELD_LENGTH + 1];
-}	Output_Record_Struct;
+}	OutputRecord;
+
+OutputRecord	Output_Record_Struct;		// Output Record created by main, each Enrichment Thread having its own one
+OutputRecord	Output_Record_Template;		// Constant Bytes of every Output Record, built by BuildOutputRecordTemplate
+long			lOutputRecordTemplateLength	= 0;	// Bytes of Output_Record_Template copied for each Output Record
+
+/* Messages printed while an Output Record is created : in the Log of its Batch for an Enrichment Thread, stdout if NULL */
+__thread FILE	*RecordLog_Ptr			= NULL;
+
+/* LOT of the Records of a Batch : an Enrichment Thread finds its Key, main gives its LOT_NUM and ID_ECRITU */
+typedef struct stBatchLOT
+{
+	LOTKey				stKey;
+	unsigned long long	ullHashKey;
+	char				strAPPLI_EMET_ID_LOT[20 + 1];	// Only filled for an irregular Key
+	long				lFirstRecord;			// Index of the first Record of the Batch in this LOT
+	long				lRecords;				// Number of Records of the Batch in this LOT
+	long				iLOT_NUM;
+	long				iID_ECRITU;				// ID_ECRITU of the LOT before the Batch : 0 for a new LOT
+}	BatchLOT;
+
+/* Batch of Records handed to an Enrichment Thread */
+typedef struct stRecordBatch
+{
+	char		*pInput;				// Input Records, each one as Create_Output_Record would read it
+	long		lInputUsed;
+	long		*plInputOffset;
+	long		*plInputLength;			// Length given by ReadInputRecord
+	char		*pOutput;				// Output Records, without their '\n' : LOT_NUM and ID_ECRITU are set by main
+	long		*plOutputLength;
+	long		lRecords;
+	long		lFirstRecord;			// Number of the first Record of the Batch
+	BatchLOT	*pLOTs;					// LOTs of the Batch, in the Order of their first Record
+	long		lLOTs;
+	long		*plLOTSlots;			// Index + 1 of a LOT in pLOTs, 0 for a free Slot
+	long		*plRecordLOT;			// Index of the LOT of each Record in pLOTs
+	long		*plRecordRank;			// Rank of each Record in its LOT, from 1
+	char		*pLog;					// Messages printed while the Output Records were created
+	size_t		lLogSize;
+	int			iState;					// ENRICH_BATCH_FREE, ENRICH_BATCH_QUEUED or ENRICH_BATCH_DONE
+}	RecordBatch;
+
+/* Enrichment Thread : its Context replaces Output_Record_Struct */
+typedef struct stEnrichThread
+{
+	struct stEnrichPool	*pPool;
+	pthread_t			stThread;
+	OutputRecord		stOutputRecord;
+}	EnrichThread;
+
+/* Enrichment Threads : the Batches are taken in the Order they were submitted, and written in the same Order */
+typedef struct stEnrichPool
+{
+	int				iThreads;				// 0 if the Pool is not started : the Output Records are created by main
+	EnrichThread	*pThreads;
+	RecordBatch		*pBatches;
+	int				iBatches;
+	long			lOutputRecordLength;	// Maximal Length of an Output Record
+	OutputWriter	*pWriter;				// If its Output File is mapped, the Records are written in it by the Threads
+	long			lSubmitted;				// Numbers of Batches submitted, taken by a Thread and written
+	long			lTaken;
+	long			lWritten;
+	pthread_mutex_t	stMutex;
+	pthread_cond_t	stQueued;
+	pthread_cond_t	stDone;
+	int				iStop;
+}	EnrichPool;
+
+EnrichPool		Enrich_Pool;
 
 /* 
  * =============================================================================
@@ -304,6 +695,52 @@ int whichOutputFormat (const char *i_strFieldFormat)
 	return unknown;
 }
 
+/* 
+ * =============================================================================
+ *            Which Role for the Field in the Output Record ?
+ * =============================================================================
+ */
+int whichFieldRole (const char *i_strFieldName)
+{
+	if (strcmp(i_strFieldName, "MAI_DEV_IMP") == 0)
+	{
+		return roleMAI_DEV_IMP;
+	}
+	if (strcmp(i_strFieldName, "MAI_MNT_IMP") == 0)
+	{
+		return roleMAI_MNT_IMP;
+	}
+	if (strcmp(i_strFieldName, "MAI_DEV_GES") == 0)
+	{
+		return roleMAI_DEV_GES;
+	}
+	if (strcmp(i_strFieldName, "MAI_MNT_GES") == 0)
+	{
+		return roleMAI_MNT_GES;
+	}
+	if (strcmp(i_strFieldName, "MAI_DEV_CTP") == 0)
+	{
+		return roleMAI_DEV_CTP;
+	}
+	if (strcmp(i_strFieldName, "MAI_MNT_NOM") == 0)
+	{
+		return roleMAI_MNT_NOM;
+	}
+	if (strcmp(i_strFieldName, "MAI_DAT_OPE") == 0)
+	{
+		return roleMAI_DAT_OPE;
+	}
+	if (strcmp(i_strFieldName, "MAI_CPT_IMP") == 0)
+	{
+		return roleMAI_CPT_IMP;
+	}
+	if (strcmp(i_strFieldName, "MAI_REF_OPE") == 0)
+	{
+		return roleMAI_REF_OPE;
+	}
+	return roleMapped;
+}
+
 /* 
  * =============================================================================
  *              Is the Year of the Accounting Date a Leap Year ?
@@ -497,6 +934,48 @@ void Trim(char *i_strField)
 	RTrim(i_strField);
 }
 
+/* 
+ * =============================================================================
+ *   Length of a Field read in place : as a string, it ends at its first '\0'
+ * =============================================================================
+ */
+int FieldLength(const char *i_pField, int i_iMaxLength)
+{
+	const char	*l_pEnd		= NULL;
+
+	l_pEnd = (const char *) memchr(i_pField, '\0', i_iMaxLength);
+	return (l_pEnd != NULL) ? l_pEnd - i_pField : i_iMaxLength;
+}
+
+/* 
+ * =============================================================================
+ *   Suppress spaces at the Left and the Right sides of a Field read in place.
+ *   Only its Bounds are moved : the Field itself is not modified.
+ * =============================================================================
+ */
+void TrimField(const char **io_pField, int *io_iLength)
+{
+	while ((*io_iLength > 0) && (**io_pField == ' '))
+	{
+		(*io_pField)++;
+		(*io_iLength)--;
+	}
+	while ((*io_iLength > 0) && ((*io_pField)[*io_iLength - 1] == ' '))
+	{
+		(*io_iLength)--;
+	}
+}
+
+/* 
+ * =============================================================================
+ *   Is a string equal to the i_iLength characters of a Field read in place ?
+ * =============================================================================
+ */
+int isEqualToField(const char *i_strString, const char *i_pField, int i_iLength)
+{
+	return (strncmp(i_strString, i_pField, i_iLength) == 0) && (i_strString[i_iLength] == '\0');
+}
+
 /* 
  * =============================================================================
  *          Is the Field Numeric ? Which is its Sign ?
@@ -720,79 +1199,280 @@ void CorrectFormatAmount(const char *i_strAmount, const char *i_strCurDecimalNr,
 
 /*
  * =============================================================================
- *              Initialize COMPTE_DODGE Hash Key Table
+ *   Write an Amount with 3 Decimals from its Value i_ullAmount, given with
+ *   i_iAmtDecimalNr decimals, as CorrectFormatAmount writes it : Sign, Amount
+ *   (AMOUNT_FIELD_LENGTH digits) and Number of decimals. The rescaling is done
+ *   with integers : no Digit is lost above 2^53 and the Ratio is rounded half
+ *   up. Returns FALSE for the Numbers of decimals of the Currency over 3 which
+ *   CorrectFormatAmount cannot handle.
  * =============================================================================
 */
-void InitializeCOMPTE_DODGEHashKeyTable	()
+int FormatAmount3DEC (char i_cSign, unsigned long long i_ullAmount, int i_iAmtDecimalNr, int i_iCurDecimalNr, char *o_strAmount)
 {
-	long	l_lIdX;
-	long	l_lIdY;
-	
-	for (l_lIdX = 0; l_lIdX < HASH_DODGE_ARRAY_SIZE; l_lIdX++)
+	unsigned long long	l_ullAmount		= i_ullAmount;
+	unsigned long long	l_ullDivisor	= 0;
+	int					l_iShift		= 0;
+	int					l_iIdx			= 0;
+
+	if (i_iCurDecimalNr == i_iAmtDecimalNr)
+	{
+		if (i_iCurDecimalNr > 3)
+		{
+			return FALSE;
+		}
+		l_iShift = 3 - i_iCurDecimalNr;
+	}
+	else
+	{
+		if (i_iCurDecimalNr > i_iAmtDecimalNr)
+		{
+			l_iShift = i_iCurDecimalNr - i_iAmtDecimalNr;
+		}
+		else
+		{
+			if (i_iCurDecimalNr > 3)
+			{
+				return FALSE;
+			}
+			l_ullDivisor = ullPowerOf10[i_iAmtDecimalNr - i_iCurDecimalNr];
+			l_ullAmount  = (l_ullAmount + l_ullDivisor / 2) / l_ullDivisor;
+			l_iShift     = 3 - i_iCurDecimalNr;
+		}
+	}
+	// The Digits moved beyond AMOUNT_FIELD_LENGTH are lost, as in CorrectFormatAmount
+	l_ullAmount = (l_ullAmount % ullPowerOf10[AMOUNT_FIELD_LENGTH - l_iShift]) * ullPowerOf10[l_iShift];
+
+	o_strAmount[0] = i_cSign;
+	for (l_iIdx = AMOUNT_FIELD_LENGTH; l_iIdx > 0; l_iIdx--)
+	{
+		o_strAmount[l_iIdx] = '0' + (char) (l_ullAmount % 10);
+		l_ullAmount /= 10;
+	}
+	o_strAmount[SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH] = AMOUNT_DECIMAL_NR[0];
+	return TRUE;
+}
+
+/*
+ * =============================================================================
+ *   Convert an Input Amount straight to its Output Field with 3 Decimals, in
+ *   one pass instead of isValidInputAmount, Convert_InputField and
+ *   CorrectFormatAmount. Only the plain Amounts are handled : spaces, an
+ *   optional Sign, the Digits with an optional Decimal Symbol, then spaces.
+ *   The i_iInputLength characters of the Amount are read in place. Returns
+ *   FALSE for any other Amount, which keeps the former conversion.
+ * =============================================================================
+*/
+int ConvertInputAmount3DEC (const char *i_pInputField, int i_iInputLength, const FieldPlan *i_pField, char i_cCurDecimalNr, char *o_strAmount)
+{
+	const char			*l_pChar			= i_pInputField;
+	const char			*l_pEnd				= i_pInputField + i_iInputLength;
+	const char			*l_pDecimalSymbol	= NULL;
+	unsigned long long	l_ullAmount			= 0;
+	int					l_iSign				= 1;
+	int					l_iDigitNumber		= 0;
+	int					l_iDecimalNumber	= 0;
+
+	if ((i_pField->iFieldFormat != amount3DEC) || (i_pField->iFieldLengthOutput != SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH)
+	||  (i_iInputLength <= 0))
+	{
+		return FALSE;
+	}
+	while ((l_pChar < l_pEnd) && (*l_pChar == ' '))
+	{
+		l_pChar++;
+	}
+	if ((l_pChar < l_pEnd) && ((*l_pChar == '+') || (*l_pChar == '-')))
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_DODGE_ARRAY_SIZE; l_lIdY++)
+		l_iSign = (*l_pChar == '-') ? -1 : 1;
+		l_pChar++;
+	}
+	for (; l_pChar < l_pEnd; l_pChar++)
+	{
+		if ((*l_pChar >= '0') && (*l_pChar <= '9'))
+		{
+			// The Zeroes at the Left side are not significant
+			if ((l_iDigitNumber > 0) || (*l_pChar != '0'))
+			{
+				if (++l_iDigitNumber > AMOUNT_FIELD_LENGTH)
+				{
+					return FALSE;
+				}
+				l_ullAmount = l_ullAmount * 10 + (*l_pChar - '0');
+			}
+			if (l_pDecimalSymbol != NULL)
+			{
+				l_iDecimalNumber++;
+			}
+		}
+		else if ((*l_pChar == DECIMAL_SYMBOL) && (l_pDecimalSymbol == NULL))
+		{
+			l_pDecimalSymbol = l_pChar;
+		}
+		else
 		{
-			COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].COMPTE_DODGEHashKey = -1;
-			memset(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strCOMPTE_DODGE, '\0', sizeof(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strCOMPTE_DODGE));
-			memset(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTOP_BILAN,    '\0', sizeof(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTOP_BILAN));
-			memset(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strHB_IMPUTATION,'\0', sizeof(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strHB_IMPUTATION));
-			memset(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTOP_INT_EXT,  '\0', sizeof(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTOP_INT_EXT));
-			memset(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTVA,          '\0', sizeof(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTVA));
+			break;
 		}
 	}
+	while ((l_pChar < l_pEnd) && (*l_pChar == ' '))
+	{
+		l_pChar++;
+	}
+	// isValidInputAmount rejects a Decimal Symbol alone at the Left side
+	if ((l_pChar != l_pEnd) || (l_iDecimalNumber > 9) || ((l_pDecimalSymbol == i_pInputField) && (l_iDecimalNumber == 0)))
+	{
+		return FALSE;
+	}
+	return FormatAmount3DEC (SIGN(l_iSign), l_ullAmount, l_iDecimalNumber, DIGIT(i_cCurDecimalNr), o_strAmount);
 }
 
 /*
  * =============================================================================
- *              Initialize CURRENCY Hash Key Table
+ *          Count the Records of a File to size its Hash Key Table
  * =============================================================================
 */
-void InitializeCURRENCYHashKeyTable	()
+long CountRecordsInFile (const char *i_strFullFileName)
 {
-	long	l_lIdX;
-	long	l_lIdY;
-	
-	for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+	FILE	*l_File_Ptr			= NULL;
+	char	l_strBuffer[65536];
+	char	*l_pCurrent			= NULL;
+	size_t	l_lNbRead			= 0;
+	long	l_lNbRecords		= 0;
+
+	l_File_Ptr = fopen(i_strFullFileName, "r");
+	if (l_File_Ptr == NULL)
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_CURRENCY_ARRAY_SIZE; l_lIdY++)
+		return 0;
+	}
+	while ((l_lNbRead = fread(l_strBuffer, 1, sizeof(l_strBuffer), l_File_Ptr)) > 0)
+	{
+		l_pCurrent = l_strBuffer;
+		while ((l_pCurrent = memchr(l_pCurrent, '\n', l_strBuffer + l_lNbRead - l_pCurrent)) != NULL)
 		{
-			CURRENCYHashArray[l_lIdX].stElt[l_lIdY].CURRENCYHashKey = -1;
-			memset(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strCURRENCY_CD, '\0', sizeof(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strCURRENCY_CD));
-			memset(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strDECIMAL_POS, '\0', sizeof(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strDECIMAL_POS));
+			l_lNbRecords++;
+			l_pCurrent++;
 		}
 	}
+	fclose(l_File_Ptr);
+	// The last Record may not be ended by '\n'
+	return l_lNbRecords + 1;
+}
+
+/*
+ * =============================================================================
+ *          Evaluate the Size of a Hash Key Table for a Number of Records
+ * =============================================================================
+*/
+long EvaluateHashArraySize (long i_lNbRecords)
+{
+	long	l_lHashArraySize	= HASH_MIN_ARRAY_SIZE;
+
+	while (l_lHashArraySize < i_lNbRecords * HASH_LOAD_FACTOR)
+	{
+		l_lHashArraySize *= 2;
+	}
+	return l_lHashArraySize;
+}
+
+/*
+ * =============================================================================
+ *              Initialize COMPTE_DODGE Hash Key Table
+ *  The Tables are allocated with calloc : a zero Control Byte is a free Slot.
+ * =============================================================================
+*/
+int InitializeCOMPTE_DODGEHashKeyTable (long i_lNbRecords)
+{
+	lCOMPTE_DODGEHashArraySize = EvaluateHashArraySize (i_lNbRecords);
+	COMPTE_DODGEHashArray = (COMPTE_DODGEHashElt *) calloc(lCOMPTE_DODGEHashArraySize, sizeof(COMPTE_DODGEHashElt));
+	COMPTE_DODGEHashCtrl  = (unsigned char *) calloc(lCOMPTE_DODGEHashArraySize, sizeof(unsigned char));
+	if ((COMPTE_DODGEHashArray == NULL) || (COMPTE_DODGEHashCtrl == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating COMPTE_DODGEHashArray Table (%ld Elements)\n", errno, strerror(errno), lCOMPTE_DODGEHashArraySize);
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *              Initialize CURRENCY Table
+ * =============================================================================
+*/
+void InitializeCURRENCYTable	()
+{
+	memset(CURRENCYDecimalArray, CURRENCY_DECIMAL_NOT_FOUND, sizeof(CURRENCYDecimalArray));
+	lCURRENCYOverflowNumber = 0;
+
+	// An empty Currency Field gives the Default Decimal Number
+	CURRENCYDecimalArray[CURRENCY_EMPTY_INDEX] = CURRENCY_DEFAULT_DECIMAL_POS;
 }	
 
 /*
  * =============================================================================
  *              Initialize LOT Hash Key Table
+ *  The Table is allocated with calloc : a zero filled Slot is a free Slot.
  * =============================================================================
 */
-void InitializeLOTHashKeyTable ()
+int InitializeLOTHashKeyTable (long i_lNbRecords)
 {
-	long	l_lIdX;
-	long	l_lIdY;
-	
-	for (l_lIdX = 0; l_lIdX < HASH_LOT_ARRAY_SIZE; l_lIdX++)
+	lLOTHashArraySize = EvaluateHashArraySize (i_lNbRecords);
+	if (lLOTHashArraySize > HASH_MAX_LOT_ARRAY_SIZE)
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_LOT_ARRAY_SIZE; l_lIdY++)
-		{
-			LOTHashArray[l_lIdX].stElt[l_lIdY].LOTHashKey = -1;
-			memset(LOTHashArray[l_lIdX].stElt[l_lIdY].strAPPLI_EMET_ID_LOT, '\0', sizeof(LOTHashArray[l_lIdX].stElt[l_lIdY].strAPPLI_EMET_ID_LOT));
-			memset(LOTHashArray[l_lIdX].stElt[l_lIdY].strAPPLI_EMET,        '\0', sizeof(LOTHashArray[l_lIdX].stElt[l_lIdY].strAPPLI_EMET));
-			memset(LOTHashArray[l_lIdX].stElt[l_lIdY].strID_LOT,            '\0', sizeof(LOTHashArray[l_lIdX].stElt[l_lIdY].strID_LOT));
-			LOTHashArray[l_lIdX].stElt[l_lIdY].iLOT_NUM   = -1;
-			LOTHashArray[l_lIdX].stElt[l_lIdY].iID_ECRITU = -1;
-		}
+		lLOTHashArraySize = HASH_MAX_LOT_ARRAY_SIZE;
+	}
+	LOTHashArray = (LOTHashElt *) calloc(lLOTHashArraySize, sizeof(LOTHashElt));
+	if (LOTHashArray == NULL)
+	{
+		printf("Error %d : '%s' occurs when allocating LOTHashArray Table (%ld Elements)\n", errno, strerror(errno), lLOTHashArraySize);
+		return EXIT_ERR;
 	}
+	lLOTHashArrayPeakSize = lLOTHashArraySize;
+	return EXIT_OK;
 }	
 
 /*
  * =============================================================================
- *   Build Hash Key used to access COMPTE_DODGE, CURRENCY and LOT Tables
+ *   Build Hash Key used to access COMPTE_DODGE and LOT Tables
+ *   The Key is read 8 characters at a time : each Word is mixed into the Hash
+ *   Key by a multiplication, the last Word being completed with zeroes. The
+ *   whole Key is used, whatever its Length.
+ * =============================================================================
+*/
+unsigned long long BuildHashKey (const char i_strKey[], long i_lLength)
+{
+	unsigned long long	l_ullHashKey	= HASH_KEY_SEED ^ (unsigned long long) i_lLength;
+	unsigned long long	l_ullWord		= 0;
+	long				l_lIdx			= 0;
+
+	for (l_lIdx = 0; l_lIdx + 8 <= i_lLength; l_lIdx += 8)
+	{
+		memcpy(&l_ullWord, i_strKey + l_lIdx, 8);
+		l_ullHashKey  = (l_ullHashKey ^ l_ullWord) * HASH_KEY_MULTIPLIER;
+		l_ullHashKey ^= l_ullHashKey >> 29;
+	}
+	if (l_lIdx < i_lLength)
+	{
+		l_ullWord = 0;
+		memcpy(&l_ullWord, i_strKey + l_lIdx, i_lLength - l_lIdx);
+		l_ullHashKey  = (l_ullHashKey ^ l_ullWord) * HASH_KEY_MULTIPLIER;
+		l_ullHashKey ^= l_ullHashKey >> 29;
+	}
+	// Final Mixing : every Bit of the Key has an effect on the low Bits (Group) and the high Bits (Fingerprint)
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	l_ullHashKey *= 0xFF51AFD7ED558CCDULL;
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	l_ullHashKey *= 0xC4CEB9FE1A85EC53ULL;
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	// printf(" - [BuildHashKey] - i_strKey = %s, l_ullHashKey = %016llx\n", i_strKey, l_ullHashKey);
+	return l_ullHashKey;
+}
+
+/*
+ * =============================================================================
+ *   Former Hash Key : base 10 Number built from the last MAX_HASH_KEY_LENGTH
+ *   characters of the Key. Only used by ReportHashKeyTable for comparison.
  * =============================================================================
 */
-long BuildHashKey (const char i_strKey[], const long i_HashArraySize, long long *o_llHashKey)
+long BuildFormerHashKey (const char i_strKey[], const long i_HashArraySize, long long *o_llHashKey)
 {
 	long		l_lIdY				= 0;
 	long		l_lLength			= strlen (i_strKey);
@@ -800,7 +1480,7 @@ long BuildHashKey (const char i_strKey[], const long i_HashArraySize, long long
 	long long	l_llCoef			= 1;
 	long long	l_llHashKey			= 0;
 
-	// printf(" - [BuildHashKey] - i_strKey = %s, l_lLength = %ld\n", i_strKey, l_lLength);
+	// printf(" - [BuildFormerHashKey] - i_strKey = %s, l_lLength = %ld\n", i_strKey, l_lLength);
 	for (l_lIdY = l_lLength - 1; l_lIdY >= 0; l_lIdY--)
 	{
 		if ((l_lLength - l_lIdY) <= MAX_HASH_KEY_LENGTH)
@@ -817,1344 +1497,4762 @@ long BuildHashKey (const char i_strKey[], const long i_HashArraySize, long long
 		}
 		else
 		{
-			// Unexpected Key Length
-			printf(" - [BuildHashKey] - Unexpected Key Length : %ld > %ld. Truncated Hash Key %lld built for Key %s\n", l_lLength, MAX_HASH_KEY_LENGTH, l_llHashKey, i_strKey);
+			// Key truncated
 			l_lIdY = -1;
 		}
 	}
 
 	l_lPositYHashKey = l_llHashKey	% i_HashArraySize;
 	*o_llHashKey     = l_llHashKey;
-	// printf(" - [BuildHashKey] - l_llHashKey = %lld, l_lPositYHashKey = %ld\n", l_llHashKey, l_lPositYHashKey);
+	// printf(" - [BuildFormerHashKey] - l_llHashKey = %lld, l_lPositYHashKey = %ld\n", l_llHashKey, l_lPositYHashKey);
 	return l_lPositYHashKey;
 }
 
 /*
  * =============================================================================
- *                   Add COMPTE_DODGE HaskKey in COMPTE_DODGEHashArray Table
+ *   Locate a Hash Key in a grouped Hash Key Table
+ *   The Slots of a Table are split into Groups of HASH_GROUP_SIZE consecutive
+ *   Slots. The low Bits of the Hash Key give the first Group to probe and its
+ *   7 high Bits the Fingerprint stored in the Control Byte of the Slot, apart
+ *   from the Key strings.
  * =============================================================================
 */
-void AddElementInCOMPTE_DODGEHashKeyTable ()
+long LocateHashKey (unsigned long long i_ullHashKey, long i_lHashArraySize, unsigned char *o_ucCtrl)
 {
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	long long   l_llHashKey			= 0;
-
-	l_lPositYHashKey = BuildHashKey (RefRcaCptFile_Struct.strCOMPTE_DODGE, HASH_DODGE_ARRAY_SIZE, &l_llHashKey);
-
-	for (l_lIdX = 0; l_lIdX < HASH_DODGE_ARRAY_SIZE; l_lIdX++)
-	{
-		if (COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].COMPTE_DODGEHashKey != -1)
-		{
-			// Free Position not found. Check Duplicate Key
-			if (strcmp(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strCOMPTE_DODGE, RefRcaCptFile_Struct.strCOMPTE_DODGE) == 0)
-			{
-				// printf(" - [AddElementInCOMPTE_DODGEHashKeyTable] - Duplicate Key : Key %s already added in Hash Table\n", RefRcaCptFile_Struct.strCOMPTE_DODGE);
-				l_lIdX = HASH_DODGE_ARRAY_SIZE;
-			}
-		}
-		else
-		{
-			// Free Position found. Add COMPTE_DODGE HaskKey in COMPTE_DODGEHashArray Table
-			COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].COMPTE_DODGEHashKey = l_llHashKey;
-			strcpy(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strCOMPTE_DODGE, RefRcaCptFile_Struct.strCOMPTE_DODGE);
-			strcpy(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strTOP_BILAN, RefRcaCptFile_Struct.strTOP_BILAN);
-			switch (RefRcaCptFile_Struct.strTOP_BILAN[0])
-			{
-				case 'H'	:	memcpy(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strHB_IMPUTATION, "HB", CD_TYPIMP_FIELD_LENGTH);
-								break;
-				default		:	memcpy(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strHB_IMPUTATION, "BR", CD_TYPIMP_FIELD_LENGTH);
-								break;
-			}
-			strcpy(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strTOP_INT_EXT, RefRcaCptFile_Struct.strTOP_INT_EXT);
-			strcpy(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strTVA, RefRcaCptFile_Struct.strTVA);
-			l_lIdX = HASH_DODGE_ARRAY_SIZE;
-		}
-	}
+	*o_ucCtrl = HASH_CTRL_USED | (unsigned char) (i_ullHashKey >> 57);
+	return (long) (i_ullHashKey & (unsigned long long) (i_lHashArraySize / HASH_GROUP_SIZE - 1));
 }
 
 /*
  * =============================================================================
- *                   Add CURRENCY HaskKey in CURRENCYHashArray Table
+ *   Bit Mask of the Slots of a Group whose Control Byte is equal to i_ucCtrl
  * =============================================================================
 */
-void AddElementInCURRENCYHashKeyTable ()
+unsigned int MatchHashGroup (const unsigned char *i_pGroupCtrl, unsigned char i_ucCtrl)
 {
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	long long   l_llHashKey			= 0;
+#ifdef __SSE2__
+	__m128i			l_GroupCtrl		= _mm_loadu_si128((const __m128i *) i_pGroupCtrl);
 
-	l_lPositYHashKey = BuildHashKey (RefCurrencyFile_Struct.strCURRENCY_CD, HASH_CURRENCY_ARRAY_SIZE, &l_llHashKey);
+	return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_GroupCtrl, _mm_set1_epi8((char) i_ucCtrl)));
+#else
+	unsigned int	l_uiMask		= 0;
+	int				l_iIdx			= 0;
 
-	for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+	for (l_iIdx = 0; l_iIdx < HASH_GROUP_SIZE; l_iIdx++)
 	{
-		if (CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].CURRENCYHashKey != -1)
-		{
-			// Free Position not found. Check Duplicate Key
-			if (strcmp(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD) == 0)
-			{
-				// printf(" - [AddElementInCURRENCYHashKeyTable] - Duplicate Key : Key %s already added in Hash Table\n", RefCurrencyFile_Struct.strCURRENCY_CD);
-				l_lIdX = HASH_CURRENCY_ARRAY_SIZE;
-			}
-		}
-		else
+		if (i_pGroupCtrl[l_iIdx] == i_ucCtrl)
 		{
-			// Free Position found. Add CURRENCY HaskKey in CURRENCYHashArray Table
-			CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].CURRENCYHashKey = l_llHashKey;
-			strcpy(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD);
-			strcpy(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strDECIMAL_POS, RefCurrencyFile_Struct.strDECIMAL_POS);
-			l_lIdX = HASH_CURRENCY_ARRAY_SIZE;
+			l_uiMask |= 1U << l_iIdx;
 		}
 	}
+	return l_uiMask;
+#endif
 }
 
 /*
  * =============================================================================
- *                   Add LOT HaskKey in LOTHashArray Table
+ *   Report the Distribution of the Keys of a grouped Hash Key Table
+ *   The former Hash Key (former static Table of HASH_FORMER_ARRAY_SIZE Chains)
+ *   is compared with the current one : used Buckets and longest Chain against
+ *   used Groups and longest Probe. Probes are counted in Key comparisons for
+ *   the former Table and in Groups for the current one.
  * =============================================================================
 */
-void AddElementInLOTHashKeyTable (const char *i_strAPPLI_EMET, const char *i_strID_LOT, long *o_lPositXHashKey, long *o_lPositYHashKey)
+void ReportHashKeyTable (const char *i_strTableName, const unsigned char *i_pCtrl, const char *i_pFirstKey, size_t i_lEltSize, long i_lHashArraySize)
 {
-	char		l_strAPPLI_EMET_ID_LOT[20 + 1];
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	long long   l_llHashKey			= 0;
+	long			*l_plFormerChain		= NULL;
+	const char		*l_pKey					= NULL;
+	long			l_lNbGroups				= i_lHashArraySize / HASH_GROUP_SIZE;
+	long			l_lIdx					= 0;
+	long			l_lPositYHashKey		= 0;
+	long			l_lProbe				= 0;
+	long			l_lNbKeys				= 0;
+	long			l_lNbTruncatedKeys		= 0;
+	long			l_lFormerUsedBuckets	= 0;
+	long			l_lFormerLongestChain	= 0;
+	long			l_lFormerProbes			= 0;
+	long			l_lUsedGroups			= 0;
+	long			l_lLongestProbe			= 0;
+	long			l_lProbes				= 0;
+	long long		l_llFormerHashKey		= 0;
+	unsigned char	l_ucCtrl				= 0;
 
-	// Build Hash Key using APPLI_EMET and ID_LOT
-	memcpy(l_strAPPLI_EMET_ID_LOT, i_strAPPLI_EMET, strlen(i_strAPPLI_EMET));
-	memcpy(l_strAPPLI_EMET_ID_LOT + (int)strlen(i_strAPPLI_EMET), i_strID_LOT, strlen(i_strID_LOT));
-	l_strAPPLI_EMET_ID_LOT[strlen(i_strAPPLI_EMET) + strlen(i_strID_LOT)] = '\0';
-	
-	l_lPositYHashKey = BuildHashKey (i_strID_LOT, HASH_LOT_ARRAY_SIZE, &l_llHashKey);
-
-	for (l_lIdX = 0; l_lIdX < HASH_LOT_ARRAY_SIZE; l_lIdX++)
+	l_plFormerChain = (long *) calloc(HASH_FORMER_ARRAY_SIZE, sizeof(long));
+	if (l_plFormerChain == NULL)
+	{
+		return;
+	}
+	for (l_lIdx = 0; l_lIdx < i_lHashArraySize; l_lIdx++)
 	{
-		if (LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].LOTHashKey != -1)
+		if (i_pCtrl[l_lIdx] != HASH_CTRL_EMPTY)
 		{
-			// Free Position not found. Key already added in Hash Table : Increment iID_ECRITU.
-			if (strcmp(LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].strAPPLI_EMET_ID_LOT, l_strAPPLI_EMET_ID_LOT) == 0)
+			l_pKey = i_pFirstKey + l_lIdx * i_lEltSize;
+			l_lNbKeys++;
+			if (strlen(l_pKey) > MAX_HASH_KEY_LENGTH)
 			{
-				// printf(" - [AddElementInLOTHashKeyTable] - Key %s already added in Hash Table\n", l_strAPPLI_EMET_ID_LOT);
-				if (LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].iID_ECRITU < MAX_ID_ECRITU)
-				{
-					LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].iID_ECRITU++;
-				}
-				else
-				{
-					LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].iID_ECRITU = 1;
-				}
-				*o_lPositXHashKey = l_lIdX;
-				*o_lPositYHashKey = l_lPositYHashKey;
-				l_lIdX = HASH_LOT_ARRAY_SIZE;
+				l_lNbTruncatedKeys++;
+			}
+			// Former Hash Key : the Key is at the end of the Chain of its Bucket
+			l_lPositYHashKey = BuildFormerHashKey (l_pKey, HASH_FORMER_ARRAY_SIZE, &l_llFormerHashKey);
+			l_plFormerChain[l_lPositYHashKey]++;
+			l_lFormerProbes += l_plFormerChain[l_lPositYHashKey];
+			// Current Hash Key : Number of Groups probed from the Home Group
+			l_lProbe = (l_lIdx / HASH_GROUP_SIZE - LocateHashKey (BuildHashKey (l_pKey, strlen(l_pKey)), i_lHashArraySize, &l_ucCtrl) + l_lNbGroups) % l_lNbGroups + 1;
+			l_lProbes += l_lProbe;
+			if (l_lProbe > l_lLongestProbe)
+			{
+				l_lLongestProbe = l_lProbe;
 			}
 		}
-		else
+	}
+	for (l_lIdx = 0; l_lIdx < HASH_FORMER_ARRAY_SIZE; l_lIdx++)
+	{
+		if (l_plFormerChain[l_lIdx] > 0)
+		{
+			l_lFormerUsedBuckets++;
+		}
+		if (l_plFormerChain[l_lIdx] > l_lFormerLongestChain)
+		{
+			l_lFormerLongestChain = l_plFormerChain[l_lIdx];
+		}
+	}
+	for (l_lIdx = 0; l_lIdx < l_lNbGroups; l_lIdx++)
+	{
+		if (MatchHashGroup (i_pCtrl + l_lIdx * HASH_GROUP_SIZE, HASH_CTRL_EMPTY) != (1U << HASH_GROUP_SIZE) - 1)
 		{
-			// Free Position found. Add LOTHaskKey in LOTHashArray Table
-			LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].LOTHashKey = l_llHashKey;
-			strcpy(LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].strAPPLI_EMET_ID_LOT, l_strAPPLI_EMET_ID_LOT);
-			strcpy(LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].strAPPLI_EMET, i_strAPPLI_EMET);
-			strcpy(LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].strID_LOT, i_strID_LOT);
-			LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].iLOT_NUM = iLastLOT_NUM_USED + 1;
-			iLastLOT_NUM_USED++;
-			LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].iID_ECRITU = 1;
-			*o_lPositXHashKey = l_lIdX;
-			*o_lPositYHashKey = l_lPositYHashKey;
-			l_lIdX = HASH_LOT_ARRAY_SIZE;
+			l_lUsedGroups++;
 		}
 	}
+	free(l_plFormerChain);
+
+	printf("Hash Key Report - %s Table : %ld Keys (%ld longer than %d characters)\n", i_strTableName, l_lNbKeys, l_lNbTruncatedKeys, MAX_HASH_KEY_LENGTH);
+	if (l_lNbKeys > 0)
+	{
+		printf("   - Former  Hash Key : %6ld / %6ld Buckets used - Longest Chain %6ld Keys   - Average Probe %.2f Keys\n",
+					l_lFormerUsedBuckets, (long) HASH_FORMER_ARRAY_SIZE, l_lFormerLongestChain, (double) l_lFormerProbes / l_lNbKeys);
+		printf("   - Current Hash Key : %6ld / %6ld Groups  used - Longest Probe %6ld Groups - Average Probe %.2f Groups\n",
+					l_lUsedGroups, l_lNbGroups, l_lLongestProbe, (double) l_lProbes / l_lNbKeys);
+	}
 }
 
 /*
  * =============================================================================
- *                 Find an Element in COMPTE_DODGEHashArray Table
+ *                   Add COMPTE_DODGE HaskKey in COMPTE_DODGEHashArray Table
  * =============================================================================
 */
-long FindElementInCOMPTE_DODGEHashArrayTable (const char i_strKey[], long *o_lPositXHashKey, long *o_lPositYHashKey)
+void AddElementInCOMPTE_DODGEHashKeyTable ()
 {
-	char 		l_strKey[MAX_FIELD_LENGTH];
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	int  		l_iSign  			= 0;
-	long long   l_llHashKey			= 0;
-
-	// Initialize l_strKey
-	strcpy(l_strKey, i_strKey);
-	// Suppress spaces at the Left and the Right sides of l_strKey 
-	Trim(l_strKey);
+	long			l_lGroup			= 0;
+	long			l_lPositHashKey		= 0;
+	long			l_lIdx				= 0;
+	unsigned long long	l_ullHashKey		= 0;
+	unsigned int	l_uiMask			= 0;
+	unsigned char	l_ucCtrl			= 0;
 
-	// printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - i_strKey = %s, l_strKey = %s.\n", i_strKey, l_strKey);
+	l_ullHashKey = BuildHashKey (RefRcaCptFile_Struct.strCOMPTE_DODGE, strlen(RefRcaCptFile_Struct.strCOMPTE_DODGE));
+	l_lGroup = LocateHashKey (l_ullHashKey, lCOMPTE_DODGEHashArraySize, &l_ucCtrl);
 
-	if (strlen(l_strKey) > 0)
+	for (l_lIdx = 0; l_lIdx < lCOMPTE_DODGEHashArraySize / HASH_GROUP_SIZE; l_lIdx++)
 	{
-		l_lPositYHashKey = BuildHashKey (l_strKey, HASH_DODGE_ARRAY_SIZE, &l_llHashKey);
-
-		// Find l_lIdX Position in COMPTE_DODGEHashArray Table
-		for (l_lIdX = 0; l_lIdX < HASH_DODGE_ARRAY_SIZE; l_lIdX++)
+		// Check Duplicate Key among the Slots of the Group having the same Fingerprint
+		l_uiMask = MatchHashGroup (COMPTE_DODGEHashCtrl + l_lGroup * HASH_GROUP_SIZE, l_ucCtrl);
+		while (l_uiMask != 0)
 		{
-			if (strlen(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strCOMPTE_DODGE) > 0)
-			{		
-				// printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGEHashArray[%03ld].stElt[%03ld].strCOMPTE_DODGE = %s.\n", l_lIdX, l_lPositYHashKey, COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strCOMPTE_DODGE);
-				if (memcmp(COMPTE_DODGEHashArray[l_lIdX].stElt[l_lPositYHashKey].strCOMPTE_DODGE, l_strKey, strlen(l_strKey)) == 0)
-				{
-					// Key found in COMPTE_DODGEHashArray Table
-					*o_lPositXHashKey = l_lIdX;
-					*o_lPositYHashKey = l_lPositYHashKey;
-					return HASH_KEY_FOUND;
-				}
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			if (strcmp(COMPTE_DODGEHashArray[l_lPositHashKey].strCOMPTE_DODGE, RefRcaCptFile_Struct.strCOMPTE_DODGE) == 0)
+			{
+				// printf(" - [AddElementInCOMPTE_DODGEHashKeyTable] - Duplicate Key : Key %s already added in Hash Table\n", RefRcaCptFile_Struct.strCOMPTE_DODGE);
+				return;
 			}
-			else
+			l_uiMask &= l_uiMask - 1;
+		}
+		l_uiMask = MatchHashGroup (COMPTE_DODGEHashCtrl + l_lGroup * HASH_GROUP_SIZE, HASH_CTRL_EMPTY);
+		if (l_uiMask != 0)
+		{
+			// Free Position found. Add COMPTE_DODGE HaskKey in COMPTE_DODGEHashArray Table
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			COMPTE_DODGEHashCtrl[l_lPositHashKey] = l_ucCtrl;
+			COMPTE_DODGEHashArray[l_lPositHashKey].COMPTE_DODGEHashKey = l_ullHashKey;
+			strcpy(COMPTE_DODGEHashArray[l_lPositHashKey].strCOMPTE_DODGE, RefRcaCptFile_Struct.strCOMPTE_DODGE);
+			strcpy(COMPTE_DODGEHashArray[l_lPositHashKey].strTOP_BILAN, RefRcaCptFile_Struct.strTOP_BILAN);
+			switch (RefRcaCptFile_Struct.strTOP_BILAN[0])
 			{
-				l_lIdX = HASH_DODGE_ARRAY_SIZE;
-			}				
+				case 'H'	:	memcpy(COMPTE_DODGEHashArray[l_lPositHashKey].strHB_IMPUTATION, "HB", CD_TYPIMP_FIELD_LENGTH);
+								break;
+				default		:	memcpy(COMPTE_DODGEHashArray[l_lPositHashKey].strHB_IMPUTATION, "BR", CD_TYPIMP_FIELD_LENGTH);
+								break;
+			}
+			strcpy(COMPTE_DODGEHashArray[l_lPositHashKey].strTOP_INT_EXT, RefRcaCptFile_Struct.strTOP_INT_EXT);
+			strcpy(COMPTE_DODGEHashArray[l_lPositHashKey].strTVA, RefRcaCptFile_Struct.strTVA);
+			return;
 		}
-		// Key NOT found in COMPTE_DODGEHashArray Table
-		printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGE Key %s NOT FOUND in COMPTE_DODGEHashArray Table\n", l_strKey);
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		// Group full : probe the next Group
+		l_lGroup = (l_lGroup + 1) % (lCOMPTE_DODGEHashArraySize / HASH_GROUP_SIZE);
 	}
-	else
+}
+
+/*
+ * =============================================================================
+ *         Build the Index of a Currency Code in CURRENCYDecimalArray Table
+ *   "AAA" .. "ZZZ" give 0 .. 17575, EMPTY_CURRENCY gives CURRENCY_EMPTY_INDEX
+ *   Any other Code gives CURRENCY_NOT_INDEXED. The Code is given by its
+ *   i_iLength characters at i_pCurrency.
+ * =============================================================================
+*/
+long BuildCurrencyIndex (const char *i_pCurrency, int i_iLength)
+{
+	if (i_iLength == 3
+	 && (unsigned char) (i_pCurrency[0] - 'A') < CURRENCY_LETTER_NUMBER
+	 && (unsigned char) (i_pCurrency[1] - 'A') < CURRENCY_LETTER_NUMBER
+	 && (unsigned char) (i_pCurrency[2] - 'A') < CURRENCY_LETTER_NUMBER)
 	{
-		// Key is only filled by spaces
-		// printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGE Key is Empty\n");
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		return ((i_pCurrency[0] - 'A') * CURRENCY_LETTER_NUMBER + (i_pCurrency[1] - 'A')) * CURRENCY_LETTER_NUMBER + (i_pCurrency[2] - 'A');
+	}
+	if (isEqualToField(EMPTY_CURRENCY, i_pCurrency, i_iLength))
+	{
+		return CURRENCY_EMPTY_INDEX;
 	}
+	return CURRENCY_NOT_INDEXED;
 }
 
 /*
  * =============================================================================
- *                 Find an Element in CURRENCYHashArray Table
+ *                   Add CURRENCY Code in CURRENCYDecimalArray Table
  * =============================================================================
 */
-long FindElementInCURRENCYHashArrayTable (const char i_strKey[], long *o_lPositXHashKey, long *o_lPositYHashKey)
+void AddElementInCURRENCYTable ()
 {
-	char 		l_strKey[MAX_FIELD_LENGTH];
-	long		l_lPositYHashKey	= 0;
+	long		l_lIndex			= 0;
 	long		l_lIdX				= 0;
-	int  		l_iSign  			= 0;
-	long long   l_llHashKey			= 0;
-
-	// Initialize l_strKey
-	strcpy(l_strKey, i_strKey);
 
-	// Suppress spaces at the Left and the Right sides of l_strKey
-	Trim(l_strKey);
-	
-	if (strlen(l_strKey) > 0)
+	l_lIndex = BuildCurrencyIndex (RefCurrencyFile_Struct.strCURRENCY_CD, strlen(RefCurrencyFile_Struct.strCURRENCY_CD));
+	if ((l_lIndex != CURRENCY_NOT_INDEXED) && (l_lIndex != CURRENCY_EMPTY_INDEX))
 	{
-		l_lPositYHashKey = BuildHashKey (l_strKey, HASH_CURRENCY_ARRAY_SIZE, &l_llHashKey);
-
-		// Find l_lIdX Position in CURRENCYHashArray Table
-		for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+		if (CURRENCYDecimalArray[l_lIndex] == CURRENCY_DECIMAL_NOT_FOUND)
 		{
-			if (strcmp(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strCURRENCY_CD, l_strKey) == 0)
-			{
-				// Key found in CURRENCYHashArray Table
-				*o_lPositXHashKey = l_lIdX;
-				*o_lPositYHashKey = l_lPositYHashKey;
-				return HASH_KEY_FOUND;
-			}
+			CURRENCYDecimalArray[l_lIndex] = RefCurrencyFile_Struct.strDECIMAL_POS[0];
 		}
-		// Key not found in CURRENCYHashArray Table
-		// printf(" - [FindElementInCURRENCYHashArrayTable] - CURRENCY Key %s NOT FOUND in CURRENCYHashArray Table\n", l_strKey);
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		// else
+		// {
+		// 	printf(" - [AddElementInCURRENCYTable] - Duplicate Key : Key %s already added in CURRENCY Table\n", RefCurrencyFile_Struct.strCURRENCY_CD);
+		// }
 	}
 	else
 	{
-		// Key is only filled by spaces
-		// printf(" - [FindElementInCURRENCYHashArrayTable] - CURRENCY Key is Empty\n");
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		// Code with spaces, digits or lower case Letters : kept in CURRENCYOverflowArray Table
+		for (l_lIdX = 0; l_lIdX < lCURRENCYOverflowNumber; l_lIdX++)
+		{
+			if (strcmp(CURRENCYOverflowArray[l_lIdX].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD) == 0)
+			{
+				// printf(" - [AddElementInCURRENCYTable] - Duplicate Key : Key %s already added in CURRENCY Table\n", RefCurrencyFile_Struct.strCURRENCY_CD);
+				return;
+			}
+		}
+		if (lCURRENCYOverflowNumber < MAX_CURRENCY_OVERFLOW)
+		{
+			strcpy(CURRENCYOverflowArray[lCURRENCYOverflowNumber].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD);
+			strcpy(CURRENCYOverflowArray[lCURRENCYOverflowNumber].strDECIMAL_POS, RefCurrencyFile_Struct.strDECIMAL_POS);
+			lCURRENCYOverflowNumber++;
+		}
+		else
+		{
+			printf("Too many Currency Codes which are not 3 upper case Letters : Currency \"%s\" ignored\n", RefCurrencyFile_Struct.strCURRENCY_CD);
+		}
 	}
 }
 
 /*
  * =============================================================================
- *                 Find an Element in LOTHashArray Table
+ *                  Convert a Field of Digits into a Number
  * =============================================================================
 */
-long FindElementInLOTHashArrayTable (const char i_strKey[], long *o_lPositXHashKey, long *o_lPositYHashKey)
+int PackDigits (const char *i_strField, int i_iLength, unsigned long long *o_ullValue)
 {
-	char 		l_strKey[MAX_FIELD_LENGTH];
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	int  		l_iSign  			= 0;
-	long long   l_llHashKey			= 0;
+	unsigned int	l_uiDigit	= 0;
+	int				l_iIdx		= 0;
 
-	// Initialize l_strKey
-	strcpy(l_strKey, i_strKey);
-
-	// Suppress spaces at the Left and the Right sides of l_strKey
-	Trim(l_strKey);
-	
-	if (strlen(l_strKey) > 0)
+	*o_ullValue = 0;
+	for (l_iIdx = 0; l_iIdx < i_iLength; l_iIdx++)
 	{
-		l_lPositYHashKey = BuildHashKey (l_strKey, HASH_LOT_ARRAY_SIZE, &l_llHashKey);
-
-		// Find l_lIdX Position in LOTHashArray Table
-		for (l_lIdX = 0; l_lIdX < HASH_LOT_ARRAY_SIZE; l_lIdX++)
+		l_uiDigit = (unsigned int) ((unsigned char) i_strField[l_iIdx]) - '0';
+		if (l_uiDigit > 9)
 		{
-			if (strcmp(LOTHashArray[l_lIdX].stElt[l_lPositYHashKey].strAPPLI_EMET_ID_LOT, l_strKey) == 0)
-			{
-				// Key found in LOTHashArray Table
-				*o_lPositXHashKey = l_lIdX;
-				*o_lPositYHashKey = l_lPositYHashKey;
-				return HASH_KEY_FOUND;
-			}
+			return EXIT_ERR;
 		}
-		// Key not found in LOTHashArray Table
-		// printf(" - [FindElementInLOTHashArrayTable] - LOT Key %s NOT FOUND in LOTHashArray Table\n", l_strKey);
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
-	}
-	else
-	{
-		// Key is only filled by spaces
-		// printf(" - [FindElementInLOTHashArrayTable] - LOT Key is Empty\n");
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		*o_ullValue = *o_ullValue * 10 + l_uiDigit;
 	}
+	return EXIT_OK;
 }
 
 /*
  * =============================================================================
- *          Find Id Ecriture using Id Lot in IdLotIdEcriture Table
+ *                          Build the LOT Key
+ *  ID_LOT is DAT_OPE (8 digits), HB_IMPUTATION ("BR" or "HB"), TOP_INT_EXT and
+ *  NUM_CRE (6 digits) : with APPLI_EMET, it is packed in 2 Words. As with the
+ *  former Key String, NUM_CRE is not part of the Key when TOP_INT_EXT is empty.
+ *  A Key which cannot be packed is irregular : the Hash Key of its String is
+ *  used instead and the String is returned in o_strAPPLI_EMET_ID_LOT.
  * =============================================================================
 */
-void FindIdLotIdEcriture (const char *i_strAPPLI_EMET, const char *i_strID_LOT, char *o_strLOT_NUM, char *o_strID_ECRITU)
+void BuildLOTKey (const char *i_strAPPLI_EMET, const char *i_strID_LOT, LOTKey *o_stKey, char *o_strAPPLI_EMET_ID_LOT)
 {
-	char	l_strAPPLI_EMET_ID_LOT[20 + 1];
-	long	l_lIdXPos			= -1;
-	long	l_lIdYPos			= -1;
+	unsigned long long	l_ullDAT_OPE	= 0;
+	unsigned long long	l_ullNUM_CRE	= 0;
+	unsigned long long	l_ullHB			= 0;
+	unsigned char		l_ucTOP_INT_EXT	= (unsigned char) i_strID_LOT[DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH];
+	int					l_iRegular		= 1;
 
-	// printf(" - [FindIdLotIdEcriture] - i_strAPPLI_EMET = %s, i_strID_LOT = %s\n", i_strAPPLI_EMET, i_strID_LOT);
-	
-	// Find ID_LOT and ID_ECRI in LOTHashArray Table using APPLI_EMET and ID_LOT
-	memcpy(l_strAPPLI_EMET_ID_LOT, i_strAPPLI_EMET, strlen(i_strAPPLI_EMET));
-	memcpy(l_strAPPLI_EMET_ID_LOT + (int)strlen(i_strAPPLI_EMET), i_strID_LOT, strlen(i_strID_LOT));
-	l_strAPPLI_EMET_ID_LOT[strlen(i_strAPPLI_EMET) + strlen(i_strID_LOT)] = '\0';
+	if (i_strAPPLI_EMET[0] == '\0' || i_strAPPLI_EMET[1] == '\0' || i_strAPPLI_EMET[2] == '\0')
+	{
+		l_iRegular = 0;
+	}
+	if (PackDigits (i_strID_LOT, DATE_LENGTH, &l_ullDAT_OPE) == EXIT_ERR)
+	{
+		l_iRegular = 0;
+	}
+	if (memcmp(i_strID_LOT + DATE_LENGTH, "HB", CD_TYPIMP_FIELD_LENGTH) == 0)
+	{
+		l_ullHB = 1;
+	}
+	else if (memcmp(i_strID_LOT + DATE_LENGTH, "BR", CD_TYPIMP_FIELD_LENGTH) != 0)
+	{
+		l_iRegular = 0;
+	}
+	if (l_ucTOP_INT_EXT != '\0')
+	{
+		if (PackDigits (i_strID_LOT + DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH, NUM_CRE_IN_CD_REFOPER_LENGTH, &l_ullNUM_CRE) == EXIT_ERR)
+		{
+			l_iRegular = 0;
+		}
+	}
 
-	if (FindElementInLOTHashArrayTable (i_strID_LOT, &l_lIdXPos, &l_lIdYPos))
+	if (l_iRegular)
 	{
-		sprintf(o_strLOT_NUM,  "%017d", LOTHashArray[l_lIdXPos].stElt[l_lIdYPos].iLOT_NUM);
-		sprintf(o_strID_ECRITU, "%06d", LOTHashArray[l_lIdXPos].stElt[l_lIdYPos].iID_ECRITU);
+		o_stKey->ullID_LOT     = l_ullDAT_OPE | (l_ullNUM_CRE << 27) | (l_ullHB << 47) | ((unsigned long long) l_ucTOP_INT_EXT << 48);
+		o_stKey->ullAPPLI_EMET = (unsigned long long) (unsigned char) i_strAPPLI_EMET[0]
+							   | (unsigned long long) (unsigned char) i_strAPPLI_EMET[1] << 8
+							   | (unsigned long long) (unsigned char) i_strAPPLI_EMET[2] << 16;
+		o_strAPPLI_EMET_ID_LOT[0] = '\0';
 	}
 	else
 	{
-		AddElementInLOTHashKeyTable (i_strAPPLI_EMET, i_strID_LOT, &l_lIdXPos, &l_lIdYPos);
-		sprintf(o_strLOT_NUM,  "%017d", LOTHashArray[l_lIdXPos].stElt[l_lIdYPos].iLOT_NUM);
-		sprintf(o_strID_ECRITU, "%06d", LOTHashArray[l_lIdXPos].stElt[l_lIdYPos].iID_ECRITU);
+		// Irregular Key : former Key String
+		strcpy(o_strAPPLI_EMET_ID_LOT, i_strAPPLI_EMET);
+		strcat(o_strAPPLI_EMET_ID_LOT, i_strID_LOT);
+		o_stKey->ullID_LOT     = BuildHashKey (o_strAPPLI_EMET_ID_LOT, strlen(o_strAPPLI_EMET_ID_LOT));
+		o_stKey->ullAPPLI_EMET = LOT_KEY_IRREGULAR;
+		// printf(" - [BuildLOTKey] - Irregular LOT Key %s\n", o_strAPPLI_EMET_ID_LOT);
 	}
-	// printf(" - [FindIdLotIdEcriture] - i_strAPPLI_EMET = %s, i_strID_LOT = %s, o_strLOT_NUM = %s, o_strID_ECRITU = %s\n", i_strAPPLI_EMET, i_strID_LOT, o_strLOT_NUM, o_strID_ECRITU);
 }
 
-/* 
+/*
  * =============================================================================
- *  Building Format of REF_RCA_CPT.dat File using REF_RCA_CPT.conf File
+ *        Move Slots of LOTFormerHashArray Table into LOTHashArray Table
+ *  The Slots are moved in the order of their Position : the Elements of the
+ *  Slots below lLOTFormerHashArrayPosit are in LOTHashArray.
  * =============================================================================
- */
-int BuildRefRcaCptRecordFormat()
+*/
+void MoveLOTHashKeyTable (long i_lNbSlots)
 {
-	FILE *l_RefRcaCptFile_RecordFormat_Ptr	= NULL;
-	char  l_strRefRcaCptFileFormat[REF_RCA_CPT_RECORD_LENGTH];
-	char  l_strFullRefRcaCptFormatFileName[MAX_FULL_FILE_NAME_LENGTH];
-	char  l_strRefRcaCptField[REF_RCA_CPT_FIELD_NAME_LENGTH];
-	int   l_iRefRcaCptFieldNumber			= -1;
-	int   l_iRefRcaCptFieldLength			= 0;
-	int   l_iFieldNumber					= 0;
-	int   l_idx								= 0;
-
-	/* Initializing the table of Fields used to create COMPTE_DODGE Hash Key Table */
-	for (l_iFieldNumber = 0; l_iFieldNumber < MAX_FIELD_NUMBER_REF_RCA_CPT; l_iFieldNumber++)
-	{
-		memset(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldName,   '\0', sizeof(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldName));
-		memset(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldFormat, '\0', sizeof(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldFormat));
-		tabFieldOfRefRcaCptRecord[l_iFieldNumber].iFieldFormat           = unknown;
-		tabFieldOfRefRcaCptRecord[l_iFieldNumber].iFieldLength           = -1;
-		tabFieldOfRefRcaCptRecord[l_iFieldNumber].iFieldStartSepPosition = -1;
-	}
-	
-	/* Opening REF_RCA_CPT.conf File : structure of REF_RCA_CPT.dat File */
-	strcpy(l_strFullRefRcaCptFormatFileName, strConfigurationDirectory);
-	strcat(l_strFullRefRcaCptFormatFileName, "/");
-	strcat(l_strFullRefRcaCptFormatFileName, REF_RCA_CPT_FORMAT_FILE_NAME);
-	
-	printf("Opening %s File ...\n", l_strFullRefRcaCptFormatFileName);
-	l_RefRcaCptFile_RecordFormat_Ptr = fopen(l_strFullRefRcaCptFormatFileName, "r");
-	if (l_RefRcaCptFile_RecordFormat_Ptr == NULL)
-	{
-		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefRcaCptFormatFileName);
-		return EXIT_ERR;
-	}
+	LOTHashElt	*l_pElt				= NULL;
+	long		l_lPositHashKey		= 0;
+	long		l_lIdx				= 0;
 
-	/* Reading Records of REF_RCA_CPT.conf File : Each Record gives the Name of a Field of REF_RCA_CPT.dat File Record */
-	while (fgets(l_strRefRcaCptField, REF_RCA_CPT_FIELD_NAME_LENGTH, l_RefRcaCptFile_RecordFormat_Ptr) != NULL)
+	for (l_lIdx = 0; l_lIdx < i_lNbSlots && LOTFormerHashArray != NULL; l_lIdx++)
 	{
-		if (strlen(l_strRefRcaCptField) > 1)
+		l_pElt = &LOTFormerHashArray[lLOTFormerHashArrayPosit];
+		if (l_pElt->iLOT_NUM != 0)
 		{
-			// Handle only not empty records
-			l_iRefRcaCptFieldNumber++;
-			if (l_iRefRcaCptFieldNumber < MAX_FIELD_NUMBER_REF_RCA_CPT)
-			{
-				// memcpy(l_strRefRcaCptFileFormat + l_iRefRcaCptFieldLength, l_strRefRcaCptField, strlen(l_strRefRcaCptField) - 1);
-				// l_iRefRcaCptFieldLength = l_iRefRcaCptFieldLength + strlen(l_strRefRcaCptField) - 1;
-				// memcpy(l_strRefRcaCptFileFormat + l_iRefRcaCptFieldLength, REF_RCA_CPT_SEPARATOR, 1);
-				// l_iRefRcaCptFieldLength = l_iRefRcaCptFieldLength + 1;	
-				
-				if (memcmp(l_strRefRcaCptField, "COMPTE_DODGE", 12) == 0)
-				{
-					memcpy(tabFieldOfRefRcaCptRecord[0].strFieldName, l_strRefRcaCptField, 12);
-					tabFieldOfRefRcaCptRecord[0].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
-					tabFieldOfRefRcaCptRecord[0].iFieldStartSepPosition = l_iRefRcaCptFieldNumber; 
-				}
-				else
-				{
-					if (memcmp(l_strRefRcaCptField, "TOP_BILAN", 9) == 0)
-					{
-						memcpy(tabFieldOfRefRcaCptRecord[1].strFieldName, l_strRefRcaCptField, 9);
-						tabFieldOfRefRcaCptRecord[1].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
-						tabFieldOfRefRcaCptRecord[1].iFieldStartSepPosition = l_iRefRcaCptFieldNumber; 
-					}
-					else
-					{
-						if (memcmp(l_strRefRcaCptField, "TOP_INT_EXT", 11) == 0)
-						{
-							memcpy(tabFieldOfRefRcaCptRecord[2].strFieldName, l_strRefRcaCptField, 11);
-							tabFieldOfRefRcaCptRecord[2].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
-							tabFieldOfRefRcaCptRecord[2].iFieldStartSepPosition = l_iRefRcaCptFieldNumber; 
-						}
-						else
-						{
-							if (memcmp(l_strRefRcaCptField, "CHAMPS_TVA", 10) == 0)
-							{
-								memcpy(tabFieldOfRefRcaCptRecord[3].strFieldName, l_strRefRcaCptField, 10);
-								tabFieldOfRefRcaCptRecord[3].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
-								tabFieldOfRefRcaCptRecord[3].iFieldStartSepPosition = l_iRefRcaCptFieldNumber;
-							}
-						}					
-					}
-				}
-			}
-			else
+			// The Key is not in LOTHashArray yet : first free Slot from its Home Slot
+			l_lPositHashKey = (long) (BuildHashKey ((const char *) &l_pElt->stKey, sizeof(l_pElt->stKey)) & (unsigned long long) (lLOTHashArraySize - 1));
+			while (LOTHashArray[l_lPositHashKey].iLOT_NUM != 0)
 			{
-				// Unexpected Number of Fields in REF_RCA_CPT.conf File
-				printf("Number of Fields %d instead of %d in %s File \n", l_iRefRcaCptFieldNumber + 1, MAX_FIELD_NUMBER_REF_RCA_CPT, l_strFullRefRcaCptFormatFileName);
-				return EXIT_ERR;
+				l_lPositHashKey = (l_lPositHashKey + 1) & (lLOTHashArraySize - 1);
 			}
+			LOTHashArray[l_lPositHashKey] = *l_pElt;
+		}
+		lLOTFormerHashArrayPosit++;
+		if (lLOTFormerHashArrayPosit == lLOTFormerHashArraySize)
+		{
+			// All the Slots are moved
+			free(LOTFormerHashArray);
+			LOTFormerHashArray       = NULL;
+			lLOTFormerHashArraySize  = 0;
+			lLOTFormerHashArrayPosit = 0;
 		}
 	}
-	/*for (l_idx=0; l_idx<4; l_idx++)
-	{
-		printf(" - [BuildRefRcaCptRecordFormat] - tabFieldOfRefRcaCptRecord[%d].strFieldName           = %s\n", l_idx, tabFieldOfRefRcaCptRecord[l_idx].strFieldName);
-		printf(" - [BuildRefRcaCptRecordFormat] - tabFieldOfRefRcaCptRecord[%d].iFieldStartSepPosition = %d\n", l_idx, tabFieldOfRefRcaCptRecord[l_idx].iFieldStartSepPosition); 
-	}*/
-
-	// l_strRefRcaCptFileFormat could be represented by the following string : "CODE_COMPTABILITE;NUMERO_COMPTE;CLE_COMPTE;COMPTE_DODGE;LIBELLE_COMPTE;
-	// TYPE_COMPTE;TOP_BILAN;TOP_ACTIF_PASSIF;TOP_REGLEMENT;TOP_SENS;TOP_MULTI_DEVISE;TOP_DENOTAGE;TYPE_LETTRAGE;DEVISE;PCEC_DEBIT;PCEC_CREDIT;
-	// DATE_CREATION;DATE_MAJ_DCAF;DATE_MAJ_DCMC;TENUE_CID;FAMILLE_CID;CPT_MAITRE;CODE_TENUE;TOP_FRAIS;NUMERO_COMPTE_FIC;NUM_COMPTE_CIDR1;
-	// NUM_COMPTE_CIDR2;NUM_COMPTE_CEG;CODE_ANA36;AGENCE_CDR;CLE_AGENCE_COMPTE;TOP_DODGE;TOP_IME;TOP_OSC;TOP_OAX;CODE_SOCIETE;TOP_ACTIF;CHAMPS_TVA;
-	// GENE_TVA;TVA;AFF_PRORATA;METHOD_PRORATA;PCCT;TOP_IAS;TOP_INT_EXT;PCIB_IAS_DEBIT;PCIB_IAS_CREDIT;GROUPE_COMPTE;TOSEGVAL;COMPTE_CTP;
-	// STATUT_RESULTAT;ID_SUIVI;ASSUJ;TAXATION;ADMISSION"
-	// l_strRefRcaCptFileFormat[l_iRefRcaCptFieldLength] = '\0';
-	// printf(" - [BuildRefRcaCptRecordFormat] - Structure of %s File given from %s File : \"%s\"\n", REF_RCA_CPT_FILE_NAME, REF_RCA_CPT_FORMAT_FILE_NAME, l_strRefRcaCptFileFormat);
-
-	/* Closing REF_RCA_CPT.conf File */
-	printf("Closing %s File ...\n", l_strFullRefRcaCptFormatFileName);
-	fclose(l_RefRcaCptFile_RecordFormat_Ptr);
-	return EXIT_OK;
 }
 
-/* 
+/*
  * =============================================================================
- *       Building COMPTE_DODGE Table using data of REF_RCA_CPT.dat File
+ *                       Resize LOT Hash Key Table
+ *  LOTHashArray is replaced by a Table twice as big. Its Elements are moved
+ *  afterwards by MoveLOTHashKeyTable, a few Slots at each access, so that the
+ *  Resize never stops the Handling of the Input File for long.
  * =============================================================================
- */
-int BuildCompteDodgeTable()
+*/
+int ResizeLOTHashKeyTable ()
 {
-	FILE *l_RefRcaCptFile_Ptr			= NULL;
-	char l_strFullRefRcaCptFileName[MAX_FULL_FILE_NAME_LENGTH];
-	int  l_iIdx							= 0;
-	int  l_iSepPositInRecord			= 0;
-	int  l_iNbSepInRecord				= 0;
-	int  l_iRecNumber					= 0;
-	long COMPTE_DODGEHashKey			= 0;
-	long long l_llHashKeyCOMPTE_DODGE	= 0;
+	LOTHashElt	*l_pNewHashArray	= NULL;
 
+	// A former Resize is completed first
+	MoveLOTHashKeyTable (lLOTFormerHashArraySize);
 
-	/* Initializing COMPTE_DODGE Hash Key Table */
-	InitializeCOMPTE_DODGEHashKeyTable ();
-	
-	/* Opening REF_RCA_CPT.dat File */
-	strcpy(l_strFullRefRcaCptFileName, strConfigurationDirectory);
-	strcat(l_strFullRefRcaCptFileName, "/");
-	strcat(l_strFullRefRcaCptFileName, strRCA_CPT_FILE_NAME);
-	
-	printf("Opening %s File ...\n", l_strFullRefRcaCptFileName);
-	l_RefRcaCptFile_Ptr = fopen(l_strFullRefRcaCptFileName, "r");
-	if (l_RefRcaCptFile_Ptr == NULL)
+	l_pNewHashArray = (LOTHashElt *) calloc(2 * lLOTHashArraySize, sizeof(LOTHashElt));
+	if (l_pNewHashArray == NULL)
 	{
-		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefRcaCptFileName);
+		printf("Error %d : '%s' occurs when resizing LOTHashArray Table (%ld Elements)\n", errno, strerror(errno), 2 * lLOTHashArraySize);
 		return EXIT_ERR;
 	}
+	LOTFormerHashArray       = LOTHashArray;
+	lLOTFormerHashArraySize  = lLOTHashArraySize;
+	lLOTFormerHashArrayPosit = 0;
+	LOTHashArray             = l_pNewHashArray;
+	lLOTHashArraySize        = 2 * lLOTHashArraySize;
+	lLOTHashArrayResizes++;
+	if (lLOTHashArraySize + lLOTFormerHashArraySize > lLOTHashArrayPeakSize)
+	{
+		lLOTHashArrayPeakSize = lLOTHashArraySize + lLOTFormerHashArraySize;
+	}
+	// printf(" - [ResizeLOTHashKeyTable] - %ld Elements : LOTHashArray resized to %ld Slots\n", lLOTHashArrayElements, lLOTHashArraySize);
+	return EXIT_OK;
+}
 
-	/* Reading Records of REF_RCA_CPT.dat File */
-	l_iRecNumber = -1;
-	while (fgets(RefRcaCpt_Record, REF_RCA_CPT_RECORD_LENGTH, l_RefRcaCptFile_Ptr) != NULL)
+/*
+ * =============================================================================
+ *                 Find an Element in a LOT Hash Key Table
+ *  The Slots below i_lFirstPosit are ignored : their Elements are already
+ *  moved into LOTHashArray.
+ * =============================================================================
+*/
+LOTHashElt *FindElementInLOTTable (LOTHashElt *i_pHashArray, long i_lHashArraySize, long i_lFirstPosit, unsigned long long i_ullHashKey, const LOTKey *i_pKey, const char *i_strAPPLI_EMET_ID_LOT)
+{
+	long		l_lPositHashKey		= 0;
+	long		l_lIdx				= 0;
+
+	l_lPositHashKey = (long) (i_ullHashKey & (unsigned long long) (i_lHashArraySize - 1));
+
+	// Probe from the Home Slot of the Key up to the first free Slot
+	for (l_lIdx = 0; l_lIdx < i_lHashArraySize; l_lIdx++)
 	{
-		if (strlen(RefRcaCpt_Record) > 1)
+		if (i_pHashArray[l_lPositHashKey].iLOT_NUM == 0)
 		{
-			// Handle only not empty records
-			memset(RefRcaCptFile_Struct.strCOMPTE_DODGE, '\0', sizeof(RefRcaCptFile_Struct.strCOMPTE_DODGE));
-			memset(RefRcaCptFile_Struct.strTOP_BILAN,    '\0', sizeof(RefRcaCptFile_Struct.strTOP_BILAN));
-			memset(RefRcaCptFile_Struct.strTOP_INT_EXT,  '\0', sizeof(RefRcaCptFile_Struct.strTOP_INT_EXT));
-			memset(RefRcaCptFile_Struct.strTVA,          '\0', sizeof(RefRcaCptFile_Struct.strTVA));
-			
-			l_iNbSepInRecord=-1;
-			l_iSepPositInRecord=0;
-			l_iRecNumber++;
-			for(l_iIdx=0; l_iIdx < strlen(RefRcaCpt_Record); l_iIdx++)
-			{
-				if (memcmp(RefRcaCpt_Record + l_iIdx, REF_RCA_CPT_SEPARATOR, 1) == 0)
-				{
-					l_iNbSepInRecord++;
-					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[0].iFieldStartSepPosition)
-					{
-						memcpy(RefRcaCptFile_Struct.strCOMPTE_DODGE, RefRcaCpt_Record + l_iSepPositInRecord + 1, l_iIdx - l_iSepPositInRecord - 1);
-						RefRcaCptFile_Struct.strCOMPTE_DODGE[l_iIdx - l_iSepPositInRecord - 1] = '\0';
-					}
-					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[1].iFieldStartSepPosition)
-					{
-						memcpy(RefRcaCptFile_Struct.strTOP_BILAN, RefRcaCpt_Record + l_iSepPositInRecord + 1, l_iIdx - l_iSepPositInRecord - 1);
-						RefRcaCptFile_Struct.strTOP_BILAN[l_iIdx - l_iSepPositInRecord - 1] = '\0';
-					}
-					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[2].iFieldStartSepPosition)
-					{
-						if (memcmp(RefRcaCpt_Record + l_iSepPositInRecord + 1, "M", CD_TYPEI_FIELD_LENGTH) == 0)
-						{
-							memcpy(RefRcaCptFile_Struct.strTOP_INT_EXT, "I", CD_TYPEI_FIELD_LENGTH);
-							RefRcaCptFile_Struct.strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH] = '\0';
-						}
-						else
-						{
-							memcpy(RefRcaCptFile_Struct.strTOP_INT_EXT, RefRcaCpt_Record + l_iSepPositInRecord + 1 , l_iIdx - l_iSepPositInRecord - 1);
-							RefRcaCptFile_Struct.strTOP_INT_EXT[l_iIdx - l_iSepPositInRecord - 1] = '\0';
-						}
-					}
-					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[3].iFieldStartSepPosition)
-					{
-						memcpy(RefRcaCptFile_Struct.strTVA, RefRcaCpt_Record + l_iSepPositInRecord + 1 , l_iIdx - l_iSepPositInRecord - 1);
-						RefRcaCptFile_Struct.strTVA[l_iIdx - l_iSepPositInRecord - 1] = '\0';
-					}					
-					l_iSepPositInRecord = l_iIdx;
-					// printf(" - [BuildCompteDodgeTable] - Record %04d : Separator No %02d at position %04d\n", l_iRecNumber, l_iNbSepInRecord + 1, l_iSepPositInRecord);
-				}
-			}
-			if (l_iNbSepInRecord + 1 != MAX_SEPARATOR_IN_REF_RCA_CPT)
-			{
-				RefRcaCpt_Record[strlen(RefRcaCpt_Record) - 1] = '\0';
-				printf("Number of separator %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", l_iNbSepInRecord + 1, MAX_SEPARATOR_IN_REF_RCA_CPT, l_strFullRefRcaCptFileName, l_iRecNumber + 1, RefRcaCpt_Record);
-			}
-			else
+			l_lIdx = i_lHashArraySize;
+		}
+		else
+		{
+			if (i_pHashArray[l_lPositHashKey].stKey.ullID_LOT     == i_pKey->ullID_LOT
+			 && i_pHashArray[l_lPositHashKey].stKey.ullAPPLI_EMET == i_pKey->ullAPPLI_EMET
+			 && (i_pKey->ullAPPLI_EMET != LOT_KEY_IRREGULAR || strcmp(i_pHashArray[l_lPositHashKey].strAPPLI_EMET_ID_LOT, i_strAPPLI_EMET_ID_LOT) == 0)
+			 && l_lPositHashKey >= i_lFirstPosit)
 			{
-				if (strlen(RefRcaCptFile_Struct.strCOMPTE_DODGE) == 0)
-				{
-					// Record rejected
-					RefRcaCpt_Record[strlen(RefRcaCpt_Record) - 1] = '\0';
-					printf("COMPTE_DODGE Field NOT FOUND in %s File - Record %06d rejected : \"%s\"\n", l_strFullRefRcaCptFileName, l_iRecNumber + 1, RefRcaCpt_Record);
-				}
-				else
-				{
-					// Record taken into account
-					// printf(" - [BuildCompteDodgeTable] - %s Record %03d : %s \t\t| %s \t\t| %s \t\t| %s\n", l_strFullRefRcaCptFileName, l_iRecNumber, RefRcaCptFile_Struct.strCOMPTE_DODGE, RefRcaCptFile_Struct.strTOP_BILAN, RefRcaCptFile_Struct.strTOP_INT_EXT, RefRcaCptFile_Struct.strTVA);
-					if (strlen(RefRcaCptFile_Struct.strCOMPTE_DODGE) > 0)
-					{
-						AddElementInCOMPTE_DODGEHashKeyTable ();
-					}
-				}
+				// Key found in LOT Table
+				return &i_pHashArray[l_lPositHashKey];
 			}
+			l_lPositHashKey = (l_lPositHashKey + 1) & (i_lHashArraySize - 1);
 		}
 	}
-	/* Closing REF_RCA_CPT.dat File */
-	printf("Closing %s File ...\n", l_strFullRefRcaCptFileName);
-	fclose(l_RefRcaCptFile_Ptr);
+	// Key not found in LOT Table
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *   Keep the Load of LOTHashArray under 1 / HASH_LOAD_FACTOR before a Key is
+ *   added, and go on with a Resize in progress. Done at each access.
+ * =============================================================================
+*/
+int ReserveLOTHashKeyTable ()
+{
+	if ((lLOTHashArrayElements + 1) * HASH_LOAD_FACTOR > lLOTHashArraySize)
+	{
+		if (ResizeLOTHashKeyTable () == EXIT_ERR)
+		{
+			return EXIT_ERR;
+		}
+	}
+	MoveLOTHashKeyTable (LOT_RESIZE_STEP);
 	return EXIT_OK;
 }
 
-/* 
+/*
  * =============================================================================
- *  Building Format of REF_CURRENCY.dat File using REF_CURRENCY.conf File
+ *              Find a LOT Key in LOTHashArray Table, or add it
+ *  A new Key gets the next LOT_NUM and an iID_ECRITU of 0. During a Resize,
+ *  a Key not found in LOTHashArray may be in a Slot of LOTFormerHashArray
+ *  which is not moved yet.
  * =============================================================================
- */
-int BuildRefCurrencyRecordFormat()
+*/
+int FindOrAddElementInLOTHashKeyTable (const LOTKey *i_pKey, unsigned long long i_ullHashKey, const char *i_strAPPLI_EMET_ID_LOT, LOTHashElt **o_pLOTHashElt)
 {
-	FILE *l_CurrencyFile_RecordFormat_Ptr	= NULL;
-	char l_strFullRefCurrencyFormatFileName[MAX_FULL_FILE_NAME_LENGTH];
-	char l_strFieldName[FIELD_NAME_LENGTH];
-	int  l_iRefCurrencyFieldNumber			= -1;
-	int  l_iFieldNumber						= 0;
+	LOTHashElt	*l_pElt				= NULL;
+	long		l_lPositHashKey		= 0;
 
-	/* Initializing the table of Fields of Currency Format File */
-	for (l_iFieldNumber = 0; l_iFieldNumber < MAX_FIELD_NUMBER_CURRENCY; l_iFieldNumber++)
+	if (ReserveLOTHashKeyTable () == EXIT_ERR)
 	{
-		memset(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldName,   '\0', sizeof(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldName));
-		memset(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldFormat, '\0', sizeof(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldFormat));
-		tabFieldOfRefCurrencyRecord[l_iFieldNumber].iFieldFormat           = unknown;
-		tabFieldOfRefCurrencyRecord[l_iFieldNumber].iFieldLength           = -1;
-		tabFieldOfRefCurrencyRecord[l_iFieldNumber].iFieldStartSepPosition = -1;
+		*o_pLOTHashElt = NULL;
+		return EXIT_ERR;
 	}
-	
-	/* Opening REF_CURRENCY.conf File : structure of REF_CURRENCY.dat File */
-	strcpy(l_strFullRefCurrencyFormatFileName, strConfigurationDirectory);
-	strcat(l_strFullRefCurrencyFormatFileName, "/");
-	strcat(l_strFullRefCurrencyFormatFileName, REF_CURRENCY_FORMAT_FILE_NAME);
-	
-	printf("Opening %s File ...\n", l_strFullRefCurrencyFormatFileName);
-	l_CurrencyFile_RecordFormat_Ptr = fopen(l_strFullRefCurrencyFormatFileName, "r");
-	if (l_CurrencyFile_RecordFormat_Ptr == NULL)
+
+	// Linear Probing from the Home Slot of the Key in LOTHashArray, then in LOTFormerHashArray
+	l_pElt = FindElementInLOTTable (LOTHashArray, lLOTHashArraySize, 0, i_ullHashKey, i_pKey, i_strAPPLI_EMET_ID_LOT);
+	if (l_pElt == NULL && LOTFormerHashArray != NULL)
 	{
-		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefCurrencyFormatFileName);
+		l_pElt = FindElementInLOTTable (LOTFormerHashArray, lLOTFormerHashArraySize, lLOTFormerHashArrayPosit, i_ullHashKey, i_pKey, i_strAPPLI_EMET_ID_LOT);
+	}
+
+	if (l_pElt == NULL)
+	{
+		// Free Position found. Add LOTHaskKey in LOTHashArray Table
+		l_lPositHashKey = (long) (i_ullHashKey & (unsigned long long) (lLOTHashArraySize - 1));
+		while (LOTHashArray[l_lPositHashKey].iLOT_NUM != 0)
+		{
+			l_lPositHashKey = (l_lPositHashKey + 1) & (lLOTHashArraySize - 1);
+		}
+		l_pElt = &LOTHashArray[l_lPositHashKey];
+		l_pElt->stKey = *i_pKey;
+		strcpy(l_pElt->strAPPLI_EMET_ID_LOT, i_strAPPLI_EMET_ID_LOT);
+		l_pElt->iLOT_NUM = iLastLOT_NUM_USED + 1;
+		iLastLOT_NUM_USED++;
+		l_pElt->iID_ECRITU = 0;
+		lLOTHashArrayElements++;
+	}
+	*o_pLOTHashElt = l_pElt;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                   Add LOT HaskKey in LOTHashArray Table
+ *  If the Key is already in the Table, its iID_ECRITU is incremented.
+ * =============================================================================
+*/
+int AddElementInLOTHashKeyTable (const char *i_strAPPLI_EMET, const char *i_strID_LOT, LOTHashElt **o_pLOTHashElt)
+{
+	LOTKey		l_stKey;
+	LOTHashElt	*l_pElt				= NULL;
+	char		l_strAPPLI_EMET_ID_LOT[20 + 1];
+
+	// Build Hash Key using APPLI_EMET and ID_LOT
+	BuildLOTKey (i_strAPPLI_EMET, i_strID_LOT, &l_stKey, l_strAPPLI_EMET_ID_LOT);
+	if (FindOrAddElementInLOTHashKeyTable (&l_stKey, BuildHashKey ((const char *) &l_stKey, sizeof(l_stKey)), l_strAPPLI_EMET_ID_LOT, &l_pElt) == EXIT_ERR)
+	{
+		*o_pLOTHashElt = NULL;
 		return EXIT_ERR;
 	}
 
-	/* Reading Records of REF_CURRENCY.conf File : Each Record gives the Characteristics of a Field of the Currency File Record */
-	while (fgets((char*) &Currency_File_Record_Format_Struct, MAX_CURRENCY_FORMAT_REC_LENGTH, l_CurrencyFile_RecordFormat_Ptr) != NULL)
+	// Increment iID_ECRITU : 1 for a new Key
+	if (l_pElt->iID_ECRITU < MAX_ID_ECRITU)
 	{
-		if (strlen(Currency_File_Record_Format_Struct.CurrencyFormat_Record) > 1)
+		l_pElt->iID_ECRITU++;
+	}
+	else
+	{
+		l_pElt->iID_ECRITU = 1;
+	}
+	*o_pLOTHashElt = l_pElt;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Print a Message about the Record being created, in RecordLog_Ptr
+ * =============================================================================
+*/
+void PrintRecordLog (const char *i_strFormat, ...)
+{
+	va_list		l_Arguments;
+
+	va_start(l_Arguments, i_strFormat);
+	vfprintf((RecordLog_Ptr != NULL) ? RecordLog_Ptr : stdout, i_strFormat, l_Arguments);
+	va_end(l_Arguments);
+}
+
+/*
+ * =============================================================================
+ *                 Find an Element in COMPTE_DODGEHashArray Table
+ * =============================================================================
+*/
+long FindElementInCOMPTE_DODGEHashArrayTable (const char *i_pKey, int i_iKeyLength, long *o_lPositHashKey)
+{
+	long			l_lGroup			= 0;
+	long			l_lPositHashKey		= 0;
+	long			l_lIdx				= 0;
+	unsigned long long	l_ullHashKey		= 0;
+	unsigned int	l_uiMask			= 0;
+	unsigned char	l_ucCtrl			= 0;
+
+	// Suppress spaces at the Left and the Right sides of the Key, read in place
+	TrimField(&i_pKey, &i_iKeyLength);
+
+	// printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - Key = %.*s.\n", i_iKeyLength, i_pKey);
+
+	if (i_iKeyLength > 0)
+	{
+		l_ullHashKey = BuildHashKey (i_pKey, i_iKeyLength);
+		l_lGroup = LocateHashKey (l_ullHashKey, lCOMPTE_DODGEHashArraySize, &l_ucCtrl);
+
+		// Probe the Groups up to the first one having a free Slot
+		for (l_lIdx = 0; l_lIdx < lCOMPTE_DODGEHashArraySize / HASH_GROUP_SIZE; l_lIdx++)
 		{
-			// Handle only not empty records
-			l_iRefCurrencyFieldNumber++;
-			if (l_iRefCurrencyFieldNumber < MAX_FIELD_NUMBER_CURRENCY)
+			l_uiMask = MatchHashGroup (COMPTE_DODGEHashCtrl + l_lGroup * HASH_GROUP_SIZE, l_ucCtrl);
+			while (l_uiMask != 0)
 			{
-				strcpy(l_strFieldName, strtok(Currency_File_Record_Format_Struct.CurrencyFormat_Record, REF_CURRENCY_SEPARATOR));
-				if (memcmp(l_strFieldName, "CURRENCY_CD", 11) == 0)
-				{
-					if (l_iRefCurrencyFieldNumber == 0)
-					{
-						strcpy(tabFieldOfRefCurrencyRecord[0].strFieldName, l_strFieldName);
-						strcpy(tabFieldOfRefCurrencyRecord[0].strFieldFormat, strtok(NULL, REF_CURRENCY_SEPARATOR));
-						tabFieldOfRefCurrencyRecord[0].iFieldFormat = whichOutputFormat(tabFieldOfRefCurrencyRecord[0].strFieldFormat);
-						tabFieldOfRefCurrencyRecord[0].iFieldLength = atoi(strtok(NULL, REF_CURRENCY_SEPARATOR));
-						tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition = tabFieldOfRefCurrencyRecord[0].iFieldLength;
-					}
-					else
-					{
-						// Unexpected Position of CURRENCY_CD in REF_CURRENCY.conf File
-						printf("Unexpected Position of CURRENCY_CD in %s File \n", l_strFullRefCurrencyFormatFileName);
-						return EXIT_ERR;
-					}
-				}
-				else
+				l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+				// printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGEHashArray[%06ld].strCOMPTE_DODGE = %s.\n", l_lPositHashKey, COMPTE_DODGEHashArray[l_lPositHashKey].strCOMPTE_DODGE);
+				if (isEqualToField(COMPTE_DODGEHashArray[l_lPositHashKey].strCOMPTE_DODGE, i_pKey, i_iKeyLength))
 				{
-					if (memcmp(l_strFieldName, "DECIMAL_POS", 11) == 0)
-					{
-						if (l_iRefCurrencyFieldNumber == 1)
-						{
-							strcpy(tabFieldOfRefCurrencyRecord[1].strFieldName, l_strFieldName);
-							strcpy(tabFieldOfRefCurrencyRecord[1].strFieldFormat, strtok(NULL, REF_CURRENCY_SEPARATOR));
-							tabFieldOfRefCurrencyRecord[1].iFieldFormat = whichOutputFormat(tabFieldOfRefCurrencyRecord[1].strFieldFormat);
-							tabFieldOfRefCurrencyRecord[1].iFieldLength = atoi(strtok(NULL, REF_CURRENCY_SEPARATOR));
-							tabFieldOfRefCurrencyRecord[1].iFieldStartSepPosition = tabFieldOfRefCurrencyRecord[0].iFieldLength + 1 + tabFieldOfRefCurrencyRecord[1].iFieldLength;
-						}
-						else
-						{
-							// Unexpected Position of DECIMAL_POS in REF_CURRENCY.conf File
-							printf("Unexpected Position of DECIMAL_POS in %s File \n", l_strFullRefCurrencyFormatFileName);
-							return EXIT_ERR;
-						}
-					}
+					// Key found in COMPTE_DODGEHashArray Table
+					*o_lPositHashKey = l_lPositHashKey;
+					return HASH_KEY_FOUND;
 				}
+				l_uiMask &= l_uiMask - 1;
+			}
+			if (MatchHashGroup (COMPTE_DODGEHashCtrl + l_lGroup * HASH_GROUP_SIZE, HASH_CTRL_EMPTY) != 0)
+			{
+				l_lIdx = lCOMPTE_DODGEHashArraySize;
 			}
 			else
 			{
-				// Unexpected Number of Fields in REF_CURRENCY.conf File
-				printf("Number of Fields %d instead of %d in %s File \n", l_iRefCurrencyFieldNumber + 1, MAX_FIELD_NUMBER_CURRENCY, l_strFullRefCurrencyFormatFileName);
-				return EXIT_ERR;
+				l_lGroup = (l_lGroup + 1) % (lCOMPTE_DODGEHashArraySize / HASH_GROUP_SIZE);
 			}
 		}
+		// Key NOT found in COMPTE_DODGEHashArray Table
+		PrintRecordLog(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGE Key %.*s NOT FOUND in COMPTE_DODGEHashArray Table\n", i_iKeyLength, i_pKey);
+		*o_lPositHashKey = -1;
+		return HASH_KEY_NOT_FOUND;
+	}
+	else
+	{
+		// Key is only filled by spaces
+		// printf(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGE Key is Empty\n");
+		*o_lPositHashKey = -1;
+		return HASH_KEY_NOT_FOUND;
 	}
-	/* Closing REF_CURRENCY.conf File */
-	printf("Closing %s File ...\n", l_strFullRefCurrencyFormatFileName);
-	fclose(l_CurrencyFile_RecordFormat_Ptr);
-	return EXIT_OK;
 }
 
 /*
  * =============================================================================
- *   Building CURRENCY Table using data of REF_CURRENCY.dat File
+ *          Bucket and Slot of a Key in COMPTE_DODGEPerfectArray Table
+ *  The Bucket is given by the high Bits of the Hash Key, the Slot by the Hash
+ *  Key mixed with the Pilot of the Bucket.
  * =============================================================================
- */
-int BuildCurrencyTable()
+*/
+long LocatePerfectHashBucket (unsigned long long i_ullHashKey)
 {
-	FILE *l_CurrencyFile_Ptr		= NULL;
-	char l_strFullRefCurrencyFileName[MAX_FULL_FILE_NAME_LENGTH];
-	int  l_iIdx						= 0;
-	int  l_iNbSepInRecord			= 0;
-	int  l_iRecNumber				= -1;
-	int  l_iRecRejected             = -1;
-	long CURRENCYHashKey			= 0;
-	long long l_llHashKeyCURRENCY	= 0;
+	return (long) (((i_ullHashKey >> 32) * (unsigned long long) lCOMPTE_DODGEPerfectBuckets) >> 32);
+}
 
-	/* Initializing CURRENCY Hash Key Table */
-	InitializeCURRENCYHashKeyTable ();
-	
-	/* Opening REF_CURRENCY.dat File */
-	strcpy(l_strFullRefCurrencyFileName, strConfigurationDirectory);
-	strcat(l_strFullRefCurrencyFileName, "/");
-	strcat(l_strFullRefCurrencyFileName, REF_CURRENCY_FILE_NAME);
-	
-	printf("Opening %s File ...\n", l_strFullRefCurrencyFileName);
-	l_CurrencyFile_Ptr = fopen(l_strFullRefCurrencyFileName, "r");
-	if (l_CurrencyFile_Ptr == NULL)
+long LocatePerfectHashSlot (unsigned long long i_ullHashKey, unsigned int i_uiPilot)
+{
+	unsigned long long	l_ullSlotKey	= i_ullHashKey ^ ((unsigned long long) i_uiPilot * HASH_KEY_SEED);
+
+	l_ullSlotKey ^= l_ullSlotKey >> 33;
+	l_ullSlotKey *= 0xFF51AFD7ED558CCDULL;
+	l_ullSlotKey ^= l_ullSlotKey >> 33;
+	return (long) (((l_ullSlotKey >> 32) * (unsigned long long) lCOMPTE_DODGEPerfectSize) >> 32);
+}
+
+/*
+ * =============================================================================
+ *     Build a Minimal Perfect Hash of the Accounts of COMPTE_DODGEHashArray
+ *  The Accounts are spread into Buckets. Starting with the biggest Buckets, a
+ *  Pilot is searched for each Bucket so that all its Accounts fall in free
+ *  Slots of COMPTE_DODGEPerfectArray, which has exactly one Slot per Account.
+ *  If a Bucket has no Pilot, the Perfect Hash is not used.
+ * =============================================================================
+*/
+int BuildCOMPTE_DODGEPerfectHashTable ()
+{
+	long		*l_plKeyPosit		= NULL;		// Positions in COMPTE_DODGEHashArray of the Keys, sorted by Bucket
+	long		*l_plBucketStart	= NULL;		// First Key of each Bucket in l_plKeyPosit
+	long		*l_plBucketFill		= NULL;		// Number of Keys already put in each Bucket
+	long		*l_plBucketOrder	= NULL;		// Buckets sorted by decreasing Size
+	long		*l_plSlot			= NULL;		// Slots of the Keys of the current Bucket
+	char		*l_pcSlotUsed		= NULL;
+	long		l_lMaxBucketSize	= 0;
+	long		l_lNbBuckets		= 0;		// Number of Buckets which are not empty
+	long		l_lBucket			= 0;
+	long		l_lBucketSize		= 0;
+	long		l_lPositHashKey		= 0;
+	long		l_lIdx				= 0;
+	long		l_lIdy				= 0;
+	long		l_lIdz				= 0;
+	unsigned int	l_uiPilot		= 0;
+	int			l_iSlotFree			= 1;
+	int			l_iResult			= EXIT_OK;
+
+	// Number of Accounts
+	lCOMPTE_DODGEPerfectSize = 0;
+	for (l_lPositHashKey = 0; l_lPositHashKey < lCOMPTE_DODGEHashArraySize; l_lPositHashKey++)
+	{
+		if (COMPTE_DODGEHashCtrl[l_lPositHashKey] != HASH_CTRL_EMPTY)
+		{
+			lCOMPTE_DODGEPerfectSize++;
+		}
+	}
+	if (lCOMPTE_DODGEPerfectSize == 0)
 	{
-		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefCurrencyFileName);
 		return EXIT_ERR;
 	}
+	lCOMPTE_DODGEPerfectBuckets = (lCOMPTE_DODGEPerfectSize + PERFECT_HASH_BUCKET_SIZE - 1) / PERFECT_HASH_BUCKET_SIZE;
 
-	// Reading Records of REF_CURRENCY.dat File : Each Record gives the "CURRENCY_CD" and "DECIMAL_POS" Data
-	while (fgets(RefCurrency_Record, REF_CURRENCY_RECORD_LENGTH, l_CurrencyFile_Ptr) != NULL)
+	COMPTE_DODGEPerfectArray = (COMPTE_DODGEPerfectElt *) calloc(lCOMPTE_DODGEPerfectSize, sizeof(COMPTE_DODGEPerfectElt));
+	COMPTE_DODGEPerfectPilot = (unsigned int *) calloc(lCOMPTE_DODGEPerfectBuckets, sizeof(unsigned int));
+	l_plKeyPosit    = (long *) malloc(lCOMPTE_DODGEPerfectSize * sizeof(long));
+	l_plBucketStart = (long *) calloc(lCOMPTE_DODGEPerfectBuckets + 1, sizeof(long));
+	l_plBucketFill  = (long *) calloc(lCOMPTE_DODGEPerfectBuckets, sizeof(long));
+	l_plBucketOrder = (long *) malloc(lCOMPTE_DODGEPerfectBuckets * sizeof(long));
+	l_plSlot        = (long *) malloc(lCOMPTE_DODGEPerfectSize * sizeof(long));
+	l_pcSlotUsed    = (char *) calloc(lCOMPTE_DODGEPerfectSize, sizeof(char));
+	if ((COMPTE_DODGEPerfectArray == NULL) || (COMPTE_DODGEPerfectPilot == NULL) || (l_plKeyPosit == NULL) || (l_plBucketStart == NULL)
+	 || (l_plBucketFill == NULL) || (l_plBucketOrder == NULL) || (l_plSlot == NULL) || (l_pcSlotUsed == NULL))
 	{
-		l_iRecNumber++;
-		if (strlen(RefCurrency_Record) > 1)
+		printf("Error %d : '%s' occurs when allocating COMPTE_DODGEPerfectArray Table (%ld Elements)\n", errno, strerror(errno), lCOMPTE_DODGEPerfectSize);
+		l_iResult = EXIT_ERR;
+	}
+	else
+	{
+		// Sort the Keys by Bucket
+		for (l_lPositHashKey = 0; l_lPositHashKey < lCOMPTE_DODGEHashArraySize; l_lPositHashKey++)
 		{
-			// Handle only not empty records
-			l_iRecRejected = 0;
-			if (strlen(RefCurrency_Record) == tabFieldOfRefCurrencyRecord[0].iFieldLength + 1 + tabFieldOfRefCurrencyRecord[1].iFieldLength + 1) // 1 + 1 : separator + carriage return
+			if (COMPTE_DODGEHashCtrl[l_lPositHashKey] != HASH_CTRL_EMPTY)
 			{
-				// Correct Record Length
-				memset(RefCurrencyFile_Struct.strCURRENCY_CD, '\0', sizeof(RefCurrencyFile_Struct.strCURRENCY_CD));
-				memset(RefCurrencyFile_Struct.strDECIMAL_POS, '\0', sizeof(RefCurrencyFile_Struct.strDECIMAL_POS));
-
-				l_iNbSepInRecord=-1;
+				l_plBucketStart[LocatePerfectHashBucket (COMPTE_DODGEHashArray[l_lPositHashKey].COMPTE_DODGEHashKey) + 1]++;
+			}
+		}
+		for (l_lBucket = 0; l_lBucket < lCOMPTE_DODGEPerfectBuckets; l_lBucket++)
+		{
+			if (l_plBucketStart[l_lBucket + 1] > l_lMaxBucketSize)
+			{
+				l_lMaxBucketSize = l_plBucketStart[l_lBucket + 1];
+			}
+			l_plBucketStart[l_lBucket + 1] += l_plBucketStart[l_lBucket];
+		}
+		for (l_lPositHashKey = 0; l_lPositHashKey < lCOMPTE_DODGEHashArraySize; l_lPositHashKey++)
+		{
+			if (COMPTE_DODGEHashCtrl[l_lPositHashKey] != HASH_CTRL_EMPTY)
+			{
+				l_lBucket = LocatePerfectHashBucket (COMPTE_DODGEHashArray[l_lPositHashKey].COMPTE_DODGEHashKey);
+				l_plKeyPosit[l_plBucketStart[l_lBucket] + l_plBucketFill[l_lBucket]] = l_lPositHashKey;
+				l_plBucketFill[l_lBucket]++;
+			}
+		}
 
-				for(l_iIdx=0; l_iIdx < strlen(RefCurrency_Record); l_iIdx++)
+		// Sort the Buckets by decreasing Size : the biggest Buckets are placed while most Slots are free
+		for (l_lBucketSize = l_lMaxBucketSize; l_lBucketSize > 0; l_lBucketSize--)
+		{
+			for (l_lBucket = 0; l_lBucket < lCOMPTE_DODGEPerfectBuckets; l_lBucket++)
+			{
+				if (l_plBucketFill[l_lBucket] == l_lBucketSize)
 				{
-					if (memcmp(RefCurrency_Record + l_iIdx, REF_CURRENCY_SEPARATOR, 1) == 0)
-					{
-						l_iNbSepInRecord++;
-						if ((l_iNbSepInRecord == 0) && (l_iIdx == tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition))
-						{
-							// Correct Position of REF_CURRENCY_SEPARATOR
-							memcpy(RefCurrencyFile_Struct.strCURRENCY_CD, RefCurrency_Record, tabFieldOfRefCurrencyRecord[0].iFieldLength);
-							RefCurrencyFile_Struct.strCURRENCY_CD[tabFieldOfRefCurrencyRecord[0].iFieldLength] = '\0';
-							memcpy(RefCurrencyFile_Struct.strDECIMAL_POS, RefCurrency_Record + l_iIdx + 1, tabFieldOfRefCurrencyRecord[1].iFieldLength);
-							RefCurrencyFile_Struct.strDECIMAL_POS[tabFieldOfRefCurrencyRecord[1].iFieldLength] = '\0';
-						}
-						else
-						{
-							// Unexpected Position of separator
-							RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
-							printf("Unexpected Position of separator %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", l_iIdx + 1, tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition + 1, l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
-							l_iRecRejected = 1;
-						}
-						l_iIdx = strlen(RefCurrency_Record);
-					}
+					l_plBucketOrder[l_lNbBuckets] = l_lBucket;
+					l_lNbBuckets++;
 				}
-				if (l_iRecRejected == 0)
+			}
+		}
+
+		// Search the Pilot of each Bucket
+		for (l_lIdx = 0; l_lIdx < l_lNbBuckets && l_iSlotFree; l_lIdx++)
+		{
+			l_lBucket     = l_plBucketOrder[l_lIdx];
+			l_lBucketSize = l_plBucketFill[l_lBucket];
+			for (l_uiPilot = 0; l_uiPilot < PERFECT_HASH_MAX_PILOT; l_uiPilot++)
+			{
+				l_iSlotFree = 1;
+				for (l_lIdy = 0; l_lIdy < l_lBucketSize && l_iSlotFree; l_lIdy++)
 				{
-					if (l_iNbSepInRecord + 1 != MAX_SEPARATOR_IN_REF_CURRENCY)
+					l_plSlot[l_lIdy] = LocatePerfectHashSlot (COMPTE_DODGEHashArray[l_plKeyPosit[l_plBucketStart[l_lBucket] + l_lIdy]].COMPTE_DODGEHashKey, l_uiPilot);
+					if (l_pcSlotUsed[l_plSlot[l_lIdy]])
 					{
-						// Unexpected Number of separators
-						RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
-						printf("Unexpected Number of separators %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", l_iNbSepInRecord + 1, MAX_SEPARATOR_IN_REF_CURRENCY, l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
+						l_iSlotFree = 0;
 					}
-					else
+					for (l_lIdz = 0; l_lIdz < l_lIdy; l_lIdz++)
 					{
-						if (! isdigit(RefCurrencyFile_Struct.strDECIMAL_POS[0]))
-						{
-							// Unexpected Value of DECIMAL_POS
-							RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
-							printf("Unexpected Value of DECIMAL_POS %c in %s File - Record %06d rejected : \"%s\"\n", RefCurrencyFile_Struct.strDECIMAL_POS[0], l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
-						}
-						else
+						if (l_plSlot[l_lIdz] == l_plSlot[l_lIdy])
 						{
-							// Record taken into account
-							// printf(" - [BuildCurrencyTable] - %s Record %03d : %s \t\t| %s \n", l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrencyFile_Struct.strCURRENCY_CD, RefCurrencyFile_Struct.strDECIMAL_POS);
-							if (strlen(RefCurrencyFile_Struct.strCURRENCY_CD) > 0)
-							{
-								AddElementInCURRENCYHashKeyTable ();
-							}
+							l_iSlotFree = 0;
 						}
 					}
 				}
+				if (l_iSlotFree)
+				{
+					// Pilot found
+					for (l_lIdy = 0; l_lIdy < l_lBucketSize; l_lIdy++)
+					{
+						l_pcSlotUsed[l_plSlot[l_lIdy]] = 1;
+					}
+					COMPTE_DODGEPerfectPilot[l_lBucket] = l_uiPilot;
+					l_uiPilot = PERFECT_HASH_MAX_PILOT;
+				}
 			}
-			else
+		}
+		if (! l_iSlotFree)
+		{
+			printf("No Pilot found for a Bucket of %ld Accounts : COMPTE_DODGE Perfect Hash is not used\n", l_lBucketSize);
+			l_iResult = EXIT_ERR;
+		}
+		else
+		{
+			// Copy the Accounts in their Slot
+			for (l_lBucket = 0; l_lBucket < lCOMPTE_DODGEPerfectBuckets; l_lBucket++)
 			{
-				// Unexpected Record Length
-				RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
-				printf("Unexpected Record Length %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", strlen(RefCurrency_Record), tabFieldOfRefCurrencyRecord[0].iFieldLength + 1 + tabFieldOfRefCurrencyRecord[1].iFieldLength, l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
+				for (l_lIdx = l_plBucketStart[l_lBucket]; l_lIdx < l_plBucketStart[l_lBucket + 1]; l_lIdx++)
+				{
+					l_lPositHashKey = l_plKeyPosit[l_lIdx];
+					l_lIdy = LocatePerfectHashSlot (COMPTE_DODGEHashArray[l_lPositHashKey].COMPTE_DODGEHashKey, COMPTE_DODGEPerfectPilot[l_lBucket]);
+					strcpy(COMPTE_DODGEPerfectArray[l_lIdy].strCOMPTE_DODGE,  COMPTE_DODGEHashArray[l_lPositHashKey].strCOMPTE_DODGE);
+					strcpy(COMPTE_DODGEPerfectArray[l_lIdy].strHB_IMPUTATION, COMPTE_DODGEHashArray[l_lPositHashKey].strHB_IMPUTATION);
+					strcpy(COMPTE_DODGEPerfectArray[l_lIdy].strTOP_INT_EXT,   COMPTE_DODGEHashArray[l_lPositHashKey].strTOP_INT_EXT);
+					strcpy(COMPTE_DODGEPerfectArray[l_lIdy].strTVA,           COMPTE_DODGEHashArray[l_lPositHashKey].strTVA);
+				}
 			}
+			printf("COMPTE_DODGE Perfect Hash Table : %ld Accounts, %ld Buckets\n", lCOMPTE_DODGEPerfectSize, lCOMPTE_DODGEPerfectBuckets);
 		}
 	}
-	/* Closing REF_CURRENCY.dat File */
-	printf("Closing %s File ...\n", l_strFullRefCurrencyFileName);
-	fclose(l_CurrencyFile_Ptr);
-	return EXIT_OK;
+
+	if (l_iResult == EXIT_ERR)
+	{
+		free(COMPTE_DODGEPerfectArray);
+		free(COMPTE_DODGEPerfectPilot);
+		COMPTE_DODGEPerfectArray = NULL;
+		COMPTE_DODGEPerfectPilot = NULL;
+	}
+	free(l_plKeyPosit);
+	free(l_plBucketStart);
+	free(l_plBucketFill);
+	free(l_plBucketOrder);
+	free(l_plSlot);
+	free(l_pcSlotUsed);
+	return l_iResult;
 }
 
-/* 
+/*
  * =============================================================================
- *                       Convert Input Field
+ *               Find an Element in COMPTE_DODGEPerfectArray Table
+ *  Only one Slot may hold the Key : a single Comparison checks it.
  * =============================================================================
- */
-void Convert_InputField (const char *i_strInputField, const int *i_iIdx, char *o_strOutputField)
+*/
+long FindElementInCOMPTE_DODGEPerfectTable (const char *i_pKey, int i_iKeyLength, long *o_lPositHashKey)
 {
-	char l_strInputField[MAX_FIELD_LENGTH];
-	char l_strOutputField[MAX_FIELD_LENGTH];
-	char l_strDecimalNumber[2];
-	int  l_iIdx   			= 0;
-	int  l_iSign  			= 0;
-	int  l_iDecimalNumber   = 0;
-	
-	// Initialize l_iIdx and l_strInputField
-	l_iIdx = *i_iIdx;
-	strcpy(l_strInputField, i_strInputField);
-	// printf(" - [Convert_InputField] - l_strInputField = %s\n", l_strInputField);
-	// printf(" - [Convert_InputField] - tabFieldOfRecord[%d].iFieldFormat = %d\n", l_iIdx, tabFieldOfRecord[l_iIdx].iFieldFormat);
-	// Check if the Input Field must be converted
-	switch (tabFieldOfRecord[l_iIdx].iFieldFormat)
-	{
-		case skip		:	// Original Value without Formating
-							memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-							break;
-
-		case charED		:	// Right space filled
-							Trim(l_strInputField);
-							memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_strOutputField, l_strInputField, strlen(l_strInputField));
-							break;
-
-		case charEG		:	// Left  space filled
-							Trim(l_strInputField);
-							memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
-							break;
-							
-		case entierEG	:	// Unsigned Numeric with Left spaces
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
-							{
-								memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
-							}
-							else
-							{
-								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
-							}
-							break;
-		
-		case entierZG	:	// Unsigned Numeric with Left zeroes
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
-							{
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
-							}
-							else
-							{
-								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
-							}
-							break;
-							
-		case entierSG	:	// Signed Numeric with Left spaces - The sign is at the Left side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
-							{
-								memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								o_strOutputField[0] = SIGN(l_iSign);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
-							}
-							else
-							{
-								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
-							}
-							break;
-							
-		case entierSZG	:	// Signed Numeric with Left zeroes - The sign is at the Left side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
-							{
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								o_strOutputField[0] = SIGN(l_iSign);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
-							}
-							else
-							{
-								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
-							}
-							break;
-							
-		case entierSD	:	// Signed Numeric with Left spaces - The sign is at the Right side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
-							{
-								memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
-								o_strOutputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
-							}
-							else
-							{
-								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
-							}
-							break;
-							
-		case entierSZD	:	// Signed Numeric with Left zeroes - The sign is at the Right side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
-							{
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
-								o_strOutputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
-							}
-							else
-							{
-								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
-							}
-							break;
+	long			l_lPositHashKey		= 0;
+	unsigned long long	l_ullHashKey		= 0;
 
-		case amount3DEC	:	// Amount with the following Format : Sign, Amount and Number of decimals
-							// This amount will be updated (with 3 Decimals) in CorrectFormatAmount Function
-							if (isValidInputAmount(l_strInputField, l_strOutputField, &l_iSign, &l_iDecimalNumber))
-							{
-								// printf(" - [Convert_InputField] - l_strInputField = %s, l_strOutputField = %s, l_iSign = %d, l_iDecimalNumber = %d.\n", l_strInputField,l_strOutputField, l_iSign, l_iDecimalNumber);
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								o_strOutputField[0]  = SIGN(l_iSign);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strOutputField) - 1, l_strOutputField, strlen(l_strOutputField));
-								sprintf(l_strDecimalNumber, "%d", l_iDecimalNumber);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - 1, l_strDecimalNumber, 1);
-							}
-							else
-							{
-								// The Input Amount is Invalid
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Invalid Amount %s found in Input File\n", l_strInputField);
-							}
-							break;
+	// Suppress spaces at the Left and the Right sides of the Key, read in place
+	TrimField(&i_pKey, &i_iKeyLength);
 
-		default			:	// If unknown Format, we suppose that the Original Value is returned without Formating
-							memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-							printf(" - [Convert_InputField] - Unknown Format %s for Field %s in Input File\n", tabFieldOfRecord[l_iIdx].iFieldFormat, tabFieldOfRecord[l_iIdx].strFieldName);
-							break;
+	if (i_iKeyLength > 0)
+	{
+		l_ullHashKey    = BuildHashKey (i_pKey, i_iKeyLength);
+		l_lPositHashKey = LocatePerfectHashSlot (l_ullHashKey, COMPTE_DODGEPerfectPilot[LocatePerfectHashBucket (l_ullHashKey)]);
+		if (isEqualToField(COMPTE_DODGEPerfectArray[l_lPositHashKey].strCOMPTE_DODGE, i_pKey, i_iKeyLength))
+		{
+			// Key found in COMPTE_DODGEPerfectArray Table
+			*o_lPositHashKey = l_lPositHashKey;
+			return HASH_KEY_FOUND;
+		}
+		// Key NOT found : same message as with COMPTE_DODGEHashArray Table
+		PrintRecordLog(" - [FindElementInCOMPTE_DODGEHashArrayTable] - COMPTE_DODGE Key %.*s NOT FOUND in COMPTE_DODGEHashArray Table\n", i_iKeyLength, i_pKey);
+		*o_lPositHashKey = -1;
+		return HASH_KEY_NOT_FOUND;
+	}
+	else
+	{
+		// Key is only filled by spaces
+		*o_lPositHashKey = -1;
+		return HASH_KEY_NOT_FOUND;
 	}
 }
 
-/* 
+/*
  * =============================================================================
- *                       Create Output Record
+ *                 Find the Decimal Number of a Currency Code
+ *   Returns CURRENCY_DECIMAL_NOT_FOUND if the Code is unknown. The Code is
+ *   read in place : i_iLength characters at i_pCurrency.
  * =============================================================================
- */
-int Create_Output_Record(const char *i_InputRecord, char *o_OutputRecord)
+*/
+char FindDecimalPosInCURRENCYTable (const char *i_pCurrency, int i_iLength)
 {
-	char l_strIdLot[17 + 1];
-	char l_strDAT_OPE[4 + 1];
-	char l_strAppliEmet[3 + 1];
-	char l_strLotNum[17 + 1];
-	char l_strIdEcriture[6 + 1];
-	char l_strInputField[MAX_FIELD_LENGTH];
-	char l_strOutputField[MAX_FIELD_LENGTH];
-	char l_strHB_IMPUTATION[CD_TYPIMP_FIELD_LENGTH + 1];
-	char l_strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH + 1];
-	char l_strTVA[CD_TVA_APP_FIELD_LENGTH + 1];
-	char l_strDEV_IMP[3 + 1];
-	char l_strDEV_GES[3 + 1];
-	char l_strDEV_CTP[3 + 1];
-	char l_strDEV_IMP_DECIMAL_POS[1 + 1];
-	char l_strDEV_GES_DECIMAL_POS[1 + 1];
-	char l_strDEV_CTP_DECIMAL_POS[1 + 1];
-	char l_strMAI_MNT_IMP[20 + 1];
-	char l_strMAI_MNT_GES[20 + 1];
-	char l_strMAI_MNT_NOM[20 + 1];
-	char l_strOutputAmount[20 + 1];
-	int  l_iIdx   			= 0;
-	int  l_iSign  			= 0;
-	long l_lPositXHashKey	= -1;
-	long l_lPositYHashKey	= -1;
+	long		l_lIndex			= 0;
+	long		l_lIdX				= 0;
 
-	// Initialize l_strInputField and l_strOutputField
-	memset(l_strInputField,  ' ', MAX_FIELD_LENGTH);
-	memset(l_strOutputField, ' ', MAX_FIELD_LENGTH);
-	
-	// Set Default Values for HB_IMPUTATION, TOP_INT_EXT and TVA
-	memcpy(l_strHB_IMPUTATION, "BR", CD_TYPIMP_FIELD_LENGTH);
-	l_strHB_IMPUTATION[CD_TYPIMP_FIELD_LENGTH] = '\0';
-	memcpy(l_strTOP_INT_EXT, "E", CD_TYPEI_FIELD_LENGTH);
-	l_strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH] = '\0';
-	memcpy(l_strTVA, "  ", CD_TVA_APP_FIELD_LENGTH);
-	l_strTVA[CD_TVA_APP_FIELD_LENGTH] = '\0';
+	// Usual Case : 3 upper case Letters or EMPTY_CURRENCY, only one access to CURRENCYDecimalArray Table
+	l_lIndex = BuildCurrencyIndex (i_pCurrency, i_iLength);
+	if (l_lIndex != CURRENCY_NOT_INDEXED)
+	{
+		return CURRENCYDecimalArray[l_lIndex];
+	}
+
+	// Suppress spaces at the Left and the Right sides of the Code
+	TrimField(&i_pCurrency, &i_iLength);
 	
-	while (strlen(tabFieldOfRecord[l_iIdx].strFieldName) > 0)
+	if (i_iLength > 0)
 	{
-		memcpy(l_strInputField, i_InputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosInput, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-		l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthInput] = '\0';
-		Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-		memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-		// Currency : MAI_DEV_IMP
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_DEV_IMP") == 0)
+		l_lIndex = BuildCurrencyIndex (i_pCurrency, i_iLength);
+		if (l_lIndex != CURRENCY_NOT_INDEXED)
 		{
-			strcpy(l_strDEV_IMP, l_strInputField);
-			if (strcmp(l_strDEV_IMP, EMPTY_CURRENCY) == 0)
-			{
-				// Currency Field Empty
-				l_strDEV_IMP_DECIMAL_POS[0] = '3';
-				l_strDEV_IMP_DECIMAL_POS[1] = '\0';
-			}
-			else
-			{
-				if (FindElementInCURRENCYHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
-				{
-					strcpy(l_strDEV_IMP_DECIMAL_POS, CURRENCYHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strDECIMAL_POS);
-				}
-				else
-				{
-					// Currency not found in CURRENCYHashArray Table
-					l_strDEV_IMP_DECIMAL_POS[0] = '3';
-					l_strDEV_IMP_DECIMAL_POS[1] = '\0';
-					printf("Currency NOT FOUND ............ : %s. Default Decimal Number = %s\n", l_strDEV_IMP, l_strDEV_IMP_DECIMAL_POS);
-				}
-			}
+			return CURRENCYDecimalArray[l_lIndex];
 		}
-		// Amount : MAI_MNT_IMP
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_MNT_IMP") == 0)
-		{
-			memcpy(l_strMAI_MNT_IMP, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-			l_strMAI_MNT_IMP[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-			CorrectFormatAmount(l_strMAI_MNT_IMP, l_strDEV_IMP_DECIMAL_POS, l_strOutputAmount);
-			// printf(" - [Create_Output_Record] - l_strMAI_MNT_IMP = %s, l_strDEV_IMP_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strMAI_MNT_IMP, l_strDEV_IMP_DECIMAL_POS, l_strOutputAmount);
-			memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputAmount, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-		}		
-		// Currency of Management : MAI_DEV_GES
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_DEV_GES") == 0)
+		for (l_lIdX = 0; l_lIdX < lCURRENCYOverflowNumber; l_lIdX++)
 		{
-			strcpy(l_strDEV_GES, l_strInputField);
-			if (strcmp(l_strDEV_GES, EMPTY_CURRENCY) == 0)
+			if (isEqualToField(CURRENCYOverflowArray[l_lIdX].strCURRENCY_CD, i_pCurrency, i_iLength))
 			{
-				// Currency Field Empty
-				l_strDEV_GES_DECIMAL_POS[0] = '3';
-				l_strDEV_GES_DECIMAL_POS[1] = '\0';
-			}
-			else
-			{
-				if (FindElementInCURRENCYHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
-				{
-					strcpy(l_strDEV_GES_DECIMAL_POS, CURRENCYHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strDECIMAL_POS);
-				}
-				else
-				{
-					// Currency not found in CURRENCYHashArray Table
-					l_strDEV_GES_DECIMAL_POS[0] = '3';
-					l_strDEV_GES_DECIMAL_POS[1] = '\0';
-					printf("Currency NOT FOUND ............ : %s. Default Decimal Number = %s\n", l_strDEV_GES, l_strDEV_GES_DECIMAL_POS);
-				}
+				return CURRENCYOverflowArray[l_lIdX].strDECIMAL_POS[0];
 			}
 		}
-		// Amount : MAI_MNT_GES
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_MNT_GES") == 0)
-		{
-			memcpy(l_strMAI_MNT_GES, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-			l_strMAI_MNT_GES[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-			CorrectFormatAmount(l_strMAI_MNT_GES, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
-			// printf(" - [Create_Output_Record] - l_strMAI_MNT_GES = %s, l_strDEV_GES_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strMAI_MNT_GES, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
-			memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputAmount, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-		}		
-		// Original Currency of Operation : MAI_DEV_CTP
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_DEV_CTP") == 0)
-		{
-			strcpy(l_strDEV_CTP, l_strInputField);
-			if (strcmp(l_strDEV_CTP, EMPTY_CURRENCY) == 0)
-			{
-				// Currency Field Empty
-				l_strDEV_CTP_DECIMAL_POS[0] = '3';
-				l_strDEV_CTP_DECIMAL_POS[1] = '\0';
-			}
-			else
+		// printf(" - [FindDecimalPosInCURRENCYTable] - CURRENCY Key %.*s NOT FOUND in CURRENCY Table\n", i_iLength, i_pCurrency);
+	}
+	// else
+	// {
+	// 	Key is only filled by spaces
+	// 	printf(" - [FindDecimalPosInCURRENCYTable] - CURRENCY Key is Empty\n");
+	// }
+	return CURRENCY_DECIMAL_NOT_FOUND;
+}
+
+/*
+ * =============================================================================
+ *          Find Id Ecriture using Id Lot in IdLotIdEcriture Table
+ * =============================================================================
+*/
+int FindIdLotIdEcriture (const char *i_strAPPLI_EMET, const char *i_strID_LOT, char *o_strLOT_NUM, char *o_strID_ECRITU)
+{
+	LOTHashElt	*l_pLOTHashElt		= NULL;
+
+	// printf(" - [FindIdLotIdEcriture] - i_strAPPLI_EMET = %s, i_strID_LOT = %s\n", i_strAPPLI_EMET, i_strID_LOT);
+	
+	// Find ID_LOT and ID_ECRI in LOTHashArray Table using APPLI_EMET and ID_LOT : a new Key is added
+	if (AddElementInLOTHashKeyTable (i_strAPPLI_EMET, i_strID_LOT, &l_pLOTHashElt) == EXIT_ERR)
+	{
+		return EXIT_ERR;
+	}
+	sprintf(o_strLOT_NUM,  "%017d", l_pLOTHashElt->iLOT_NUM);
+	sprintf(o_strID_ECRITU, "%06d", l_pLOTHashElt->iID_ECRITU);
+	// printf(" - [FindIdLotIdEcriture] - i_strAPPLI_EMET = %s, i_strID_LOT = %s, o_strLOT_NUM = %s, o_strID_ECRITU = %s\n", i_strAPPLI_EMET, i_strID_LOT, o_strLOT_NUM, o_strID_ECRITU);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Unmap the Snapshot of a Reference File
+ * =============================================================================
+*/
+void CloseSnapshot (Snapshot *io_pSnapshot)
+{
+	if (io_pSnapshot->pMapping != NULL)
+	{
+		munmap(io_pSnapshot->pMapping, io_pSnapshot->lMappingSize);
+		io_pSnapshot->pMapping     = NULL;
+		io_pSnapshot->lMappingSize = 0;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Open the Snapshot of a Reference File : Key of the Source File
+ *   The Key is the Size, the Modification Time and the Content Hash of the
+ *   .dat File, with the Layout of the Tables built from it (i_ullFormatKey).
+ * =============================================================================
+*/
+int OpenSnapshot (Snapshot *o_pSnapshot, const char *i_strSourceFileName, unsigned long long i_ullFormatKey)
+{
+	struct stat	l_SourceFile_Stat;
+	int			l_iSourceFile		= -1;
+	char		*l_pSource			= NULL;
+
+	memset(o_pSnapshot, '\0', sizeof(Snapshot));
+	strcpy(o_pSnapshot->strFileName, i_strSourceFileName);
+	strcat(o_pSnapshot->strFileName, SNAPSHOT_FILE_EXTENSION);
+
+	l_iSourceFile = open(i_strSourceFileName, O_RDONLY);
+	if ((l_iSourceFile < 0) || (fstat(l_iSourceFile, &l_SourceFile_Stat) != 0))
+	{
+		if (l_iSourceFile >= 0)
+		{
+			close(l_iSourceFile);
+		}
+		return EXIT_ERR;
+	}
+	if (l_SourceFile_Stat.st_size > 0)
+	{
+		l_pSource = (char *) mmap(NULL, l_SourceFile_Stat.st_size, PROT_READ, MAP_PRIVATE, l_iSourceFile, 0);
+		if (l_pSource == MAP_FAILED)
+		{
+			close(l_iSourceFile);
+			return EXIT_ERR;
+		}
+		o_pSnapshot->stKey.ullSourceHash = BuildHashKey (l_pSource, l_SourceFile_Stat.st_size);
+		munmap(l_pSource, l_SourceFile_Stat.st_size);
+	}
+	close(l_iSourceFile);
+
+	memcpy(o_pSnapshot->stKey.strMagic, SNAPSHOT_MAGIC, sizeof(o_pSnapshot->stKey.strMagic));
+	o_pSnapshot->stKey.uiVersion     = SNAPSHOT_VERSION;
+	o_pSnapshot->stKey.llSourceSize  = l_SourceFile_Stat.st_size;
+	o_pSnapshot->stKey.llSourceMtime = l_SourceFile_Stat.st_mtime;
+	o_pSnapshot->stKey.ullFormatKey  = i_ullFormatKey;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Map the Snapshot of a Reference File read-only
+ *   Returns EXIT_ERR if the Snapshot is missing, stale or corrupted : the
+ *   .dat File must then be parsed. Otherwise pSection gives each Table.
+ * =============================================================================
+*/
+int LoadSnapshot (Snapshot *io_pSnapshot, int i_iNbSections)
+{
+	struct stat		l_SnapshotFile_Stat;
+	SnapshotHeader	*l_pHeader				= NULL;
+	int				l_iSnapshotFile			= -1;
+	int				l_iIdx					= 0;
+	long long		l_llPayloadSize			= 0;
+
+	l_iSnapshotFile = open(io_pSnapshot->strFileName, O_RDONLY);
+	if (l_iSnapshotFile < 0)
+	{
+		return EXIT_ERR;
+	}
+	if ((fstat(l_iSnapshotFile, &l_SnapshotFile_Stat) != 0) || (l_SnapshotFile_Stat.st_size < (off_t) sizeof(SnapshotHeader)))
+	{
+		close(l_iSnapshotFile);
+		return EXIT_ERR;
+	}
+	io_pSnapshot->pMapping = (char *) mmap(NULL, l_SnapshotFile_Stat.st_size, PROT_READ, MAP_PRIVATE, l_iSnapshotFile, 0);
+	close(l_iSnapshotFile);
+	if (io_pSnapshot->pMapping == MAP_FAILED)
+	{
+		io_pSnapshot->pMapping = NULL;
+		return EXIT_ERR;
+	}
+	io_pSnapshot->lMappingSize = l_SnapshotFile_Stat.st_size;
+	l_pHeader = (SnapshotHeader *) io_pSnapshot->pMapping;
+
+	// Same Version, same Source File and same Layout
+	if ((memcmp(l_pHeader->strMagic, io_pSnapshot->stKey.strMagic, sizeof(l_pHeader->strMagic)) != 0)
+	||  (l_pHeader->uiVersion     != io_pSnapshot->stKey.uiVersion)
+	||  (l_pHeader->uiNbSections  != (unsigned int) i_iNbSections)
+	||  (l_pHeader->llSourceSize  != io_pSnapshot->stKey.llSourceSize)
+	||  (l_pHeader->llSourceMtime != io_pSnapshot->stKey.llSourceMtime)
+	||  (l_pHeader->ullSourceHash != io_pSnapshot->stKey.ullSourceHash)
+	||  (l_pHeader->ullFormatKey  != io_pSnapshot->stKey.ullFormatKey))
+	{
+		printf("Snapshot %s is stale ...\n", io_pSnapshot->strFileName);
+		CloseSnapshot (io_pSnapshot);
+		return EXIT_ERR;
+	}
+
+	// Sections are stored after the Header, each one aligned on SNAPSHOT_ALIGNMENT Bytes
+	l_llPayloadSize = 0;
+	for (l_iIdx = 0; l_iIdx < i_iNbSections; l_iIdx++)
+	{
+		if ((l_pHeader->llSectionSize[l_iIdx] < 0) || (l_pHeader->llSectionSize[l_iIdx] > io_pSnapshot->lMappingSize))
+		{
+			l_llPayloadSize = io_pSnapshot->lMappingSize;
+			l_iIdx = i_iNbSections;
+		}
+		else
+		{
+			io_pSnapshot->pSection[l_iIdx] = io_pSnapshot->pMapping + sizeof(SnapshotHeader) + l_llPayloadSize;
+			l_llPayloadSize += (l_pHeader->llSectionSize[l_iIdx] + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+		}
+	}
+	if (((long long) sizeof(SnapshotHeader) + l_llPayloadSize != io_pSnapshot->lMappingSize)
+	||  (BuildHashKey (io_pSnapshot->pMapping + sizeof(SnapshotHeader), l_llPayloadSize) != l_pHeader->ullPayloadHash))
+	{
+		printf("Snapshot %s is corrupted ...\n", io_pSnapshot->strFileName);
+		CloseSnapshot (io_pSnapshot);
+		return EXIT_ERR;
+	}
+	io_pSnapshot->stKey = *l_pHeader;
+	printf("Loading %s Snapshot ...\n", io_pSnapshot->strFileName);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Write the Snapshot of a Reference File once its Tables are built
+ *   The Snapshot is written in a temporary File renamed at the end, so that a
+ *   concurrent Run never maps a partial Snapshot. A failure is only reported.
+ * =============================================================================
+*/
+void WriteSnapshot (Snapshot *io_pSnapshot, int i_iNbSections, const void *i_pSection[], const long i_lSectionSize[])
+{
+	FILE		*l_SnapshotFile_Ptr		= NULL;
+	char		l_strTmpFileName[MAX_FULL_FILE_NAME_LENGTH + 32];
+	char		*l_pPayload				= NULL;
+	long long	l_llPayloadSize			= 0;
+	long long	l_llSectionPosit		= 0;
+	int			l_iIdx					= 0;
+	int			l_iWritten				= 0;
+
+	io_pSnapshot->stKey.uiNbSections = i_iNbSections;
+	for (l_iIdx = 0; l_iIdx < i_iNbSections; l_iIdx++)
+	{
+		io_pSnapshot->stKey.llSectionSize[l_iIdx] = i_lSectionSize[l_iIdx];
+		l_llPayloadSize += (i_lSectionSize[l_iIdx] + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	}
+
+	// The Checksum is computed on the Payload as written, Padding included
+	l_pPayload = (char *) calloc(l_llPayloadSize + 1, sizeof(char));
+	if (l_pPayload == NULL)
+	{
+		printf("Error %d : '%s' occurs when writing %s Snapshot\n", errno, strerror(errno), io_pSnapshot->strFileName);
+		return;
+	}
+	for (l_iIdx = 0; l_iIdx < i_iNbSections; l_iIdx++)
+	{
+		memcpy(l_pPayload + l_llSectionPosit, i_pSection[l_iIdx], i_lSectionSize[l_iIdx]);
+		l_llSectionPosit += (i_lSectionSize[l_iIdx] + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	}
+	io_pSnapshot->stKey.ullPayloadHash = BuildHashKey (l_pPayload, l_llPayloadSize);
+
+	sprintf(l_strTmpFileName, "%s.%ld", io_pSnapshot->strFileName, (long) getpid());
+	l_SnapshotFile_Ptr = fopen(l_strTmpFileName, "w");
+	if (l_SnapshotFile_Ptr != NULL)
+	{
+		l_iWritten = (fwrite(&io_pSnapshot->stKey, sizeof(SnapshotHeader), 1, l_SnapshotFile_Ptr) == 1)
+				  && ((l_llPayloadSize == 0) || (fwrite(l_pPayload, l_llPayloadSize, 1, l_SnapshotFile_Ptr) == 1));
+		l_iWritten = (fclose(l_SnapshotFile_Ptr) == 0) && l_iWritten;
+		l_iWritten = l_iWritten && (rename(l_strTmpFileName, io_pSnapshot->strFileName) == 0);
+	}
+	if (l_iWritten)
+	{
+		printf("Writing %s Snapshot ...\n", io_pSnapshot->strFileName);
+	}
+	else
+	{
+		printf("Error %d : '%s' occurs when writing %s Snapshot\n", errno, strerror(errno), io_pSnapshot->strFileName);
+		remove(l_strTmpFileName);
+	}
+	free(l_pPayload);
+}
+
+/* 
+ * =============================================================================
+ *  Building Format of REF_RCA_CPT.dat File using REF_RCA_CPT.conf File
+ * =============================================================================
+ */
+int BuildRefRcaCptRecordFormat()
+{
+	FILE *l_RefRcaCptFile_RecordFormat_Ptr	= NULL;
+	char  l_strRefRcaCptFileFormat[REF_RCA_CPT_RECORD_LENGTH];
+	char  l_strFullRefRcaCptFormatFileName[MAX_FULL_FILE_NAME_LENGTH];
+	char  l_strRefRcaCptField[REF_RCA_CPT_FIELD_NAME_LENGTH];
+	int   l_iRefRcaCptFieldNumber			= -1;
+	int   l_iRefRcaCptFieldLength			= 0;
+	int   l_iFieldNumber					= 0;
+	int   l_idx								= 0;
+
+	/* Initializing the table of Fields used to create COMPTE_DODGE Hash Key Table */
+	for (l_iFieldNumber = 0; l_iFieldNumber < MAX_FIELD_NUMBER_REF_RCA_CPT; l_iFieldNumber++)
+	{
+		memset(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldName,   '\0', sizeof(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldName));
+		memset(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldFormat, '\0', sizeof(tabFieldOfRefRcaCptRecord[l_iFieldNumber].strFieldFormat));
+		tabFieldOfRefRcaCptRecord[l_iFieldNumber].iFieldFormat           = unknown;
+		tabFieldOfRefRcaCptRecord[l_iFieldNumber].iFieldLength           = -1;
+		tabFieldOfRefRcaCptRecord[l_iFieldNumber].iFieldStartSepPosition = -1;
+	}
+	
+	/* Opening REF_RCA_CPT.conf File : structure of REF_RCA_CPT.dat File */
+	strcpy(l_strFullRefRcaCptFormatFileName, strConfigurationDirectory);
+	strcat(l_strFullRefRcaCptFormatFileName, "/");
+	strcat(l_strFullRefRcaCptFormatFileName, REF_RCA_CPT_FORMAT_FILE_NAME);
+	
+	printf("Opening %s File ...\n", l_strFullRefRcaCptFormatFileName);
+	l_RefRcaCptFile_RecordFormat_Ptr = fopen(l_strFullRefRcaCptFormatFileName, "r");
+	if (l_RefRcaCptFile_RecordFormat_Ptr == NULL)
+	{
+		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefRcaCptFormatFileName);
+		return EXIT_ERR;
+	}
+
+	/* Reading Records of REF_RCA_CPT.conf File : Each Record gives the Name of a Field of REF_RCA_CPT.dat File Record */
+	while (fgets(l_strRefRcaCptField, REF_RCA_CPT_FIELD_NAME_LENGTH, l_RefRcaCptFile_RecordFormat_Ptr) != NULL)
+	{
+		if (strlen(l_strRefRcaCptField) > 1)
+		{
+			// Handle only not empty records
+			l_iRefRcaCptFieldNumber++;
+			if (l_iRefRcaCptFieldNumber < MAX_FIELD_NUMBER_REF_RCA_CPT)
 			{
-				if (FindElementInCURRENCYHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
+				// memcpy(l_strRefRcaCptFileFormat + l_iRefRcaCptFieldLength, l_strRefRcaCptField, strlen(l_strRefRcaCptField) - 1);
+				// l_iRefRcaCptFieldLength = l_iRefRcaCptFieldLength + strlen(l_strRefRcaCptField) - 1;
+				// memcpy(l_strRefRcaCptFileFormat + l_iRefRcaCptFieldLength, REF_RCA_CPT_SEPARATOR, 1);
+				// l_iRefRcaCptFieldLength = l_iRefRcaCptFieldLength + 1;	
+				
+				if (memcmp(l_strRefRcaCptField, "COMPTE_DODGE", 12) == 0)
 				{
-					strcpy(l_strDEV_CTP_DECIMAL_POS, CURRENCYHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strDECIMAL_POS);
+					memcpy(tabFieldOfRefRcaCptRecord[0].strFieldName, l_strRefRcaCptField, 12);
+					tabFieldOfRefRcaCptRecord[0].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
+					tabFieldOfRefRcaCptRecord[0].iFieldStartSepPosition = l_iRefRcaCptFieldNumber; 
 				}
 				else
 				{
-					// Currency not found in CURRENCYHashArray Table
-					l_strDEV_CTP_DECIMAL_POS[0] = '3';
-					l_strDEV_CTP_DECIMAL_POS[1] = '\0';
-					printf("Currency NOT FOUND ............ : %s. Default Decimal Number = %s\n", l_strDEV_CTP, l_strDEV_CTP_DECIMAL_POS);
+					if (memcmp(l_strRefRcaCptField, "TOP_BILAN", 9) == 0)
+					{
+						memcpy(tabFieldOfRefRcaCptRecord[1].strFieldName, l_strRefRcaCptField, 9);
+						tabFieldOfRefRcaCptRecord[1].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
+						tabFieldOfRefRcaCptRecord[1].iFieldStartSepPosition = l_iRefRcaCptFieldNumber; 
+					}
+					else
+					{
+						if (memcmp(l_strRefRcaCptField, "TOP_INT_EXT", 11) == 0)
+						{
+							memcpy(tabFieldOfRefRcaCptRecord[2].strFieldName, l_strRefRcaCptField, 11);
+							tabFieldOfRefRcaCptRecord[2].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
+							tabFieldOfRefRcaCptRecord[2].iFieldStartSepPosition = l_iRefRcaCptFieldNumber; 
+						}
+						else
+						{
+							if (memcmp(l_strRefRcaCptField, "CHAMPS_TVA", 10) == 0)
+							{
+								memcpy(tabFieldOfRefRcaCptRecord[3].strFieldName, l_strRefRcaCptField, 10);
+								tabFieldOfRefRcaCptRecord[3].strFieldName[strlen(l_strRefRcaCptField)] = '\0';
+								tabFieldOfRefRcaCptRecord[3].iFieldStartSepPosition = l_iRefRcaCptFieldNumber;
+							}
+						}					
+					}
 				}
 			}
+			else
+			{
+				// Unexpected Number of Fields in REF_RCA_CPT.conf File
+				printf("Number of Fields %d instead of %d in %s File \n", l_iRefRcaCptFieldNumber + 1, MAX_FIELD_NUMBER_REF_RCA_CPT, l_strFullRefRcaCptFormatFileName);
+				return EXIT_ERR;
+			}
 		}
-		// Amount : MAI_MNT_NOM
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_MNT_NOM") == 0)
-		{
-			memcpy(l_strMAI_MNT_NOM, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-			l_strMAI_MNT_NOM[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-			CorrectFormatAmount(l_strMAI_MNT_NOM, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
-			// printf(" - [Create_Output_Record] - l_strMAI_MNT_NOM = %s, l_strDEV_GES_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strMAI_MNT_NOM, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
-			memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputAmount, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-		}		
-		// Build LOT Identifier using DODGE Account : MAI_CPT_IMP
-		// For an efficient use of the LOT Hash Key, we have chosen to write l_strIdLot
-		// in the following order : DAT_OPE, l_strHB_IMPUTATION, l_strTOP_INT_EXT, NUM_CRE
-		// instead of the order   : l_strHB_IMPUTATION, l_strTOP_INT_EXT, NUM_CRE, DAT_OPE
-		// DATE_OPE
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_DAT_OPE") == 0)
-		{
-			memcpy(l_strDAT_OPE, l_strInputField, 4);
-			memcpy(l_strIdLot, l_strInputField, DATE_LENGTH);
-		}		
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_CPT_IMP") == 0)
+	}
+	/*for (l_idx=0; l_idx<4; l_idx++)
+	{
+		printf(" - [BuildRefRcaCptRecordFormat] - tabFieldOfRefRcaCptRecord[%d].strFieldName           = %s\n", l_idx, tabFieldOfRefRcaCptRecord[l_idx].strFieldName);
+		printf(" - [BuildRefRcaCptRecordFormat] - tabFieldOfRefRcaCptRecord[%d].iFieldStartSepPosition = %d\n", l_idx, tabFieldOfRefRcaCptRecord[l_idx].iFieldStartSepPosition); 
+	}*/
+
+	// l_strRefRcaCptFileFormat could be represented by the following string : "CODE_COMPTABILITE;NUMERO_COMPTE;CLE_COMPTE;COMPTE_DODGE;LIBELLE_COMPTE;
+	// TYPE_COMPTE;TOP_BILAN;TOP_ACTIF_PASSIF;TOP_REGLEMENT;TOP_SENS;TOP_MULTI_DEVISE;TOP_DENOTAGE;TYPE_LETTRAGE;DEVISE;PCEC_DEBIT;PCEC_CREDIT;
+	// DATE_CREATION;DATE_MAJ_DCAF;DATE_MAJ_DCMC;TENUE_CID;FAMILLE_CID;CPT_MAITRE;CODE_TENUE;TOP_FRAIS;NUMERO_COMPTE_FIC;NUM_COMPTE_CIDR1;
+	// NUM_COMPTE_CIDR2;NUM_COMPTE_CEG;CODE_ANA36;AGENCE_CDR;CLE_AGENCE_COMPTE;TOP_DODGE;TOP_IME;TOP_OSC;TOP_OAX;CODE_SOCIETE;TOP_ACTIF;CHAMPS_TVA;
+	// GENE_TVA;TVA;AFF_PRORATA;METHOD_PRORATA;PCCT;TOP_IAS;TOP_INT_EXT;PCIB_IAS_DEBIT;PCIB_IAS_CREDIT;GROUPE_COMPTE;TOSEGVAL;COMPTE_CTP;
+	// STATUT_RESULTAT;ID_SUIVI;ASSUJ;TAXATION;ADMISSION"
+	// l_strRefRcaCptFileFormat[l_iRefRcaCptFieldLength] = '\0';
+	// printf(" - [BuildRefRcaCptRecordFormat] - Structure of %s File given from %s File : \"%s\"\n", REF_RCA_CPT_FILE_NAME, REF_RCA_CPT_FORMAT_FILE_NAME, l_strRefRcaCptFileFormat);
+
+	/* Closing REF_RCA_CPT.conf File */
+	printf("Closing %s File ...\n", l_strFullRefRcaCptFormatFileName);
+	fclose(l_RefRcaCptFile_RecordFormat_Ptr);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *     Map COMPTE_DODGE Hash Key Table from the Snapshot of REF_RCA_CPT.dat
+ * =============================================================================
+*/
+int LoadCompteDodgeSnapshot ()
+{
+	if (LoadSnapshot (&COMPTE_DODGESnapshot, COMPTE_DODGE_SNAPSHOT_SECTIONS) == EXIT_ERR)
+	{
+		return EXIT_ERR;
+	}
+	COMPTE_DODGEHashArray		= (COMPTE_DODGEHashElt *) COMPTE_DODGESnapshot.pSection[0];
+	COMPTE_DODGEHashCtrl		= (unsigned char *) COMPTE_DODGESnapshot.pSection[1];
+	lCOMPTE_DODGEHashArraySize	= COMPTE_DODGESnapshot.stKey.llSectionSize[0] / sizeof(COMPTE_DODGEHashElt);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *     Write COMPTE_DODGE Hash Key Table in the Snapshot of REF_RCA_CPT.dat
+ * =============================================================================
+*/
+void WriteCompteDodgeSnapshot ()
+{
+	const void	*l_pSection[COMPTE_DODGE_SNAPSHOT_SECTIONS];
+	long		l_lSectionSize[COMPTE_DODGE_SNAPSHOT_SECTIONS];
+
+	l_pSection[0] = COMPTE_DODGEHashArray;	l_lSectionSize[0] = lCOMPTE_DODGEHashArraySize * sizeof(COMPTE_DODGEHashElt);
+	l_pSection[1] = COMPTE_DODGEHashCtrl;	l_lSectionSize[1] = lCOMPTE_DODGEHashArraySize * sizeof(unsigned char);
+	WriteSnapshot (&COMPTE_DODGESnapshot, COMPTE_DODGE_SNAPSHOT_SECTIONS, l_pSection, l_lSectionSize);
+}
+
+/*
+ * =============================================================================
+ *   Report on COMPTE_DODGE Hash Key Table once it is built, and replace it by
+ *   the Minimal Perfect Hash if requested
+ * =============================================================================
+*/
+void FinalizeCompteDodgeTable ()
+{
+	/* Distribution of the Keys in COMPTE_DODGE Hash Key Table */
+	if (getenv(HASH_REPORT_VARIABLE) != NULL)
+	{
+		ReportHashKeyTable ("COMPTE_DODGE", COMPTE_DODGEHashCtrl, COMPTE_DODGEHashArray[0].strCOMPTE_DODGE, sizeof(COMPTE_DODGEHashElt), lCOMPTE_DODGEHashArraySize);
+	}
+
+	/* Minimal Perfect Hash of the COMPTE_DODGE Accounts : it replaces the Hash Key Table */
+	if (getenv(PERFECT_HASH_VARIABLE) != NULL)
+	{
+		if (BuildCOMPTE_DODGEPerfectHashTable () == EXIT_OK)
 		{
-			// HB_IMPUTATION, TOP_INT_EXT and TVA
-			 // printf(" - [Create_Output_Record] - Dodge Account = %s.\n", l_strInputField);
-			if (FindElementInCOMPTE_DODGEHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
+			if (COMPTE_DODGESnapshot.pMapping != NULL)
 			{
-				strcpy(l_strHB_IMPUTATION, COMPTE_DODGEHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strHB_IMPUTATION);
-				strcpy(l_strTOP_INT_EXT, COMPTE_DODGEHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strTOP_INT_EXT);
-				strcpy(l_strTVA, COMPTE_DODGEHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strTVA);
+				CloseSnapshot (&COMPTE_DODGESnapshot);
 			}
 			else
 			{
-				printf("Dodge Account NOT FOUND ....... : %s\n", l_strInputField);
+				free(COMPTE_DODGEHashArray);
+				free(COMPTE_DODGEHashCtrl);
 			}
-			memcpy(l_strIdLot + DATE_LENGTH, l_strHB_IMPUTATION, CD_TYPIMP_FIELD_LENGTH);
-			memcpy(l_strIdLot + DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH, l_strTOP_INT_EXT, CD_TYPEI_FIELD_LENGTH);
-			if (strcmp(ENTITY,"LCL") == 0)
+			COMPTE_DODGEHashArray      = NULL;
+			COMPTE_DODGEHashCtrl       = NULL;
+			lCOMPTE_DODGEHashArraySize = 0;
+		}
+	}
+}
+
+/*
+ * =============================================================================
+ *   Bit Mask of the Separators among the REF_RCA_CPT_SCAN_WIDTH Characters of
+ *   i_pChars
+ * =============================================================================
+*/
+unsigned int MatchRefRcaCptSeparators (const char *i_pChars)
+{
+#ifdef __SSE2__
+	__m128i			l_Chars			= _mm_loadu_si128((const __m128i *) i_pChars);
+
+	return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Chars, _mm_set1_epi8(REF_RCA_CPT_SEPARATOR[0])));
+#else
+	unsigned int	l_uiMask		= 0;
+	int				l_iIdx			= 0;
+
+	for (l_iIdx = 0; l_iIdx < REF_RCA_CPT_SCAN_WIDTH; l_iIdx++)
+	{
+		if (i_pChars[l_iIdx] == REF_RCA_CPT_SEPARATOR[0])
+		{
+			l_uiMask |= 1U << l_iIdx;
+		}
+	}
+	return l_uiMask;
+#endif
+}
+
+/* 
+ * =============================================================================
+ *       Building COMPTE_DODGE Table using data of REF_RCA_CPT.dat File
+ * =============================================================================
+ */
+int BuildCompteDodgeTable()
+{
+	FILE *l_RefRcaCptFile_Ptr			= NULL;
+	char l_strFullRefRcaCptFileName[MAX_FULL_FILE_NAME_LENGTH];
+	int  l_iIdx							= 0;
+	int  l_iSepPositInRecord			= 0;
+	int  l_iSepPosit					= 0;
+	int  l_iNbSepInRecord				= 0;
+	int  l_iRecNumber					= 0;
+	int  l_iRecordLength				= 0;
+	int  l_iLastSepNeeded				= -1;
+	int  l_iSepNumber					= 0;
+	unsigned int l_uiSepMask			= 0;
+	char l_strRecordTail[REF_RCA_CPT_SCAN_WIDTH];
+	long COMPTE_DODGEHashKey			= 0;
+	long long l_llHashKeyCOMPTE_DODGE	= 0;
+	int  l_iSnapshot					= FALSE;
+	long l_lSnapshotFormat[]			= { sizeof(COMPTE_DODGEHashElt), HASH_MIN_ARRAY_SIZE, HASH_LOAD_FACTOR,
+											tabFieldOfRefRcaCptRecord[0].iFieldStartSepPosition, tabFieldOfRefRcaCptRecord[1].iFieldStartSepPosition,
+											tabFieldOfRefRcaCptRecord[2].iFieldStartSepPosition, tabFieldOfRefRcaCptRecord[3].iFieldStartSepPosition };
+
+
+	/* Opening REF_RCA_CPT.dat File */
+	strcpy(l_strFullRefRcaCptFileName, strConfigurationDirectory);
+	strcat(l_strFullRefRcaCptFileName, "/");
+	strcat(l_strFullRefRcaCptFileName, strRCA_CPT_FILE_NAME);
+
+	/* COMPTE_DODGE Hash Key Table of the Snapshot of REF_RCA_CPT.dat File, if it is up to date */
+	if (getenv(SNAPSHOT_VARIABLE) != NULL)
+	{
+		l_iSnapshot = (OpenSnapshot (&COMPTE_DODGESnapshot, l_strFullRefRcaCptFileName, BuildHashKey ((const char *) l_lSnapshotFormat, sizeof(l_lSnapshotFormat))) == EXIT_OK);
+		if (l_iSnapshot && (LoadCompteDodgeSnapshot () == EXIT_OK))
+		{
+			FinalizeCompteDodgeTable ();
+			return EXIT_OK;
+		}
+	}
+	
+	/* Initializing COMPTE_DODGE Hash Key Table sized by the Number of Records of REF_RCA_CPT.dat File */
+	if (InitializeCOMPTE_DODGEHashKeyTable (CountRecordsInFile (l_strFullRefRcaCptFileName)) == EXIT_ERR)
+	{
+		return EXIT_ERR;
+	}
+	
+	printf("Opening %s File ...\n", l_strFullRefRcaCptFileName);
+	l_RefRcaCptFile_Ptr = fopen(l_strFullRefRcaCptFileName, "r");
+	if (l_RefRcaCptFile_Ptr == NULL)
+	{
+		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefRcaCptFileName);
+		return EXIT_ERR;
+	}
+
+	/* The Separators following the last Field needed are only counted */
+	for (l_iSepNumber = 0; l_iSepNumber < 4; l_iSepNumber++)
+	{
+		if (tabFieldOfRefRcaCptRecord[l_iSepNumber].iFieldStartSepPosition > l_iLastSepNeeded)
+		{
+			l_iLastSepNeeded = tabFieldOfRefRcaCptRecord[l_iSepNumber].iFieldStartSepPosition;
+		}
+	}
+
+	/* Reading Records of REF_RCA_CPT.dat File */
+	l_iRecNumber = -1;
+	while (fgets(RefRcaCpt_Record, REF_RCA_CPT_RECORD_LENGTH, l_RefRcaCptFile_Ptr) != NULL)
+	{
+		l_iRecordLength = strlen(RefRcaCpt_Record);
+		if (l_iRecordLength > 1)
+		{
+			// Handle only not empty records
+			memset(RefRcaCptFile_Struct.strCOMPTE_DODGE, '\0', sizeof(RefRcaCptFile_Struct.strCOMPTE_DODGE));
+			memset(RefRcaCptFile_Struct.strTOP_BILAN,    '\0', sizeof(RefRcaCptFile_Struct.strTOP_BILAN));
+			memset(RefRcaCptFile_Struct.strTOP_INT_EXT,  '\0', sizeof(RefRcaCptFile_Struct.strTOP_INT_EXT));
+			memset(RefRcaCptFile_Struct.strTVA,          '\0', sizeof(RefRcaCptFile_Struct.strTVA));
+			
+			l_iNbSepInRecord=-1;
+			l_iSepPositInRecord=0;
+			l_iRecNumber++;
+			for (l_iIdx = 0; l_iIdx < l_iRecordLength; l_iIdx += REF_RCA_CPT_SCAN_WIDTH)
 			{
-				if (strcmp(l_strInputField,"530001001") == 0 || strcmp(l_strInputField,"530001002") == 0  )
+				if (l_iIdx + REF_RCA_CPT_SCAN_WIDTH <= l_iRecordLength)
 				{
-					printf("Modification Compte DODGE %s pour ENTITY : LCL en 530001003", l_strInputField);
-					strcpy(l_strInputField,"530001003");
-					memcpy(o_OutputRecord + tabFieldOfRecord[19].iFieldStartPosOutput, l_strInputField, 9);
+					l_uiSepMask = MatchRefRcaCptSeparators (RefRcaCpt_Record + l_iIdx);
 				}
-				/*else
+				else
 				{
-					printf("Pas de modification Compte DODGE %s pour ENTITY : LCL en 530001003", l_strInputField);
-				}*/
-
+					// The end of the Record is searched apart, not to read beyond RefRcaCpt_Record
+					memset(l_strRecordTail, '\0', REF_RCA_CPT_SCAN_WIDTH);
+					memcpy(l_strRecordTail, RefRcaCpt_Record + l_iIdx, l_iRecordLength - l_iIdx);
+					l_uiSepMask = MatchRefRcaCptSeparators (l_strRecordTail);
+				}
+				while ((l_uiSepMask != 0) && (l_iNbSepInRecord < l_iLastSepNeeded))
+				{
+					l_iSepPosit = l_iIdx + __builtin_ctz(l_uiSepMask);
+					l_uiSepMask &= l_uiSepMask - 1;
+					l_iNbSepInRecord++;
+					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[0].iFieldStartSepPosition)
+					{
+						memcpy(RefRcaCptFile_Struct.strCOMPTE_DODGE, RefRcaCpt_Record + l_iSepPositInRecord + 1, l_iSepPosit - l_iSepPositInRecord - 1);
+						RefRcaCptFile_Struct.strCOMPTE_DODGE[l_iSepPosit - l_iSepPositInRecord - 1] = '\0';
+					}
+					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[1].iFieldStartSepPosition)
+					{
+						memcpy(RefRcaCptFile_Struct.strTOP_BILAN, RefRcaCpt_Record + l_iSepPositInRecord + 1, l_iSepPosit - l_iSepPositInRecord - 1);
+						RefRcaCptFile_Struct.strTOP_BILAN[l_iSepPosit - l_iSepPositInRecord - 1] = '\0';
+					}
+					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[2].iFieldStartSepPosition)
+					{
+						if (memcmp(RefRcaCpt_Record + l_iSepPositInRecord + 1, "M", CD_TYPEI_FIELD_LENGTH) == 0)
+						{
+							memcpy(RefRcaCptFile_Struct.strTOP_INT_EXT, "I", CD_TYPEI_FIELD_LENGTH);
+							RefRcaCptFile_Struct.strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH] = '\0';
+						}
+						else
+						{
+							memcpy(RefRcaCptFile_Struct.strTOP_INT_EXT, RefRcaCpt_Record + l_iSepPositInRecord + 1 , l_iSepPosit - l_iSepPositInRecord - 1);
+							RefRcaCptFile_Struct.strTOP_INT_EXT[l_iSepPosit - l_iSepPositInRecord - 1] = '\0';
+						}
+					}
+					if (l_iNbSepInRecord == tabFieldOfRefRcaCptRecord[3].iFieldStartSepPosition)
+					{
+						memcpy(RefRcaCptFile_Struct.strTVA, RefRcaCpt_Record + l_iSepPositInRecord + 1 , l_iSepPosit - l_iSepPositInRecord - 1);
+						RefRcaCptFile_Struct.strTVA[l_iSepPosit - l_iSepPositInRecord - 1] = '\0';
+					}
+					l_iSepPositInRecord = l_iSepPosit;
+				}
+				l_iNbSepInRecord += __builtin_popcount(l_uiSepMask);
+			}
+			if (l_iNbSepInRecord + 1 != MAX_SEPARATOR_IN_REF_RCA_CPT)
+			{
+				RefRcaCpt_Record[strlen(RefRcaCpt_Record) - 1] = '\0';
+				printf("Number of separator %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", l_iNbSepInRecord + 1, MAX_SEPARATOR_IN_REF_RCA_CPT, l_strFullRefRcaCptFileName, l_iRecNumber + 1, RefRcaCpt_Record);
+			}
+			else
+			{
+				if (strlen(RefRcaCptFile_Struct.strCOMPTE_DODGE) == 0)
+				{
+					// Record rejected
+					RefRcaCpt_Record[strlen(RefRcaCpt_Record) - 1] = '\0';
+					printf("COMPTE_DODGE Field NOT FOUND in %s File - Record %06d rejected : \"%s\"\n", l_strFullRefRcaCptFileName, l_iRecNumber + 1, RefRcaCpt_Record);
+				}
+				else
+				{
+					// Record taken into account
+					// printf(" - [BuildCompteDodgeTable] - %s Record %03d : %s \t\t| %s \t\t| %s \t\t| %s\n", l_strFullRefRcaCptFileName, l_iRecNumber, RefRcaCptFile_Struct.strCOMPTE_DODGE, RefRcaCptFile_Struct.strTOP_BILAN, RefRcaCptFile_Struct.strTOP_INT_EXT, RefRcaCptFile_Struct.strTVA);
+					if (strlen(RefRcaCptFile_Struct.strCOMPTE_DODGE) > 0)
+					{
+						AddElementInCOMPTE_DODGEHashKeyTable ();
+					}
+				}
 			}
 		}
-		// REF_OPE
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "MAI_REF_OPE") == 0)
+	}
+	/* Closing REF_RCA_CPT.dat File */
+	printf("Closing %s File ...\n", l_strFullRefRcaCptFileName);
+	fclose(l_RefRcaCptFile_Ptr);
+
+	/* Snapshot of the Table for the next Runs */
+	if (l_iSnapshot)
+	{
+		WriteCompteDodgeSnapshot ();
+	}
+	FinalizeCompteDodgeTable ();
+	return EXIT_OK;
+}
+
+/* 
+ * =============================================================================
+ *  Building Format of REF_CURRENCY.dat File using REF_CURRENCY.conf File
+ * =============================================================================
+ */
+int BuildRefCurrencyRecordFormat()
+{
+	FILE *l_CurrencyFile_RecordFormat_Ptr	= NULL;
+	char l_strFullRefCurrencyFormatFileName[MAX_FULL_FILE_NAME_LENGTH];
+	char l_strFieldName[FIELD_NAME_LENGTH];
+	int  l_iRefCurrencyFieldNumber			= -1;
+	int  l_iFieldNumber						= 0;
+
+	/* Initializing the table of Fields of Currency Format File */
+	for (l_iFieldNumber = 0; l_iFieldNumber < MAX_FIELD_NUMBER_CURRENCY; l_iFieldNumber++)
+	{
+		memset(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldName,   '\0', sizeof(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldName));
+		memset(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldFormat, '\0', sizeof(tabFieldOfRefCurrencyRecord[l_iFieldNumber].strFieldFormat));
+		tabFieldOfRefCurrencyRecord[l_iFieldNumber].iFieldFormat           = unknown;
+		tabFieldOfRefCurrencyRecord[l_iFieldNumber].iFieldLength           = -1;
+		tabFieldOfRefCurrencyRecord[l_iFieldNumber].iFieldStartSepPosition = -1;
+	}
+	
+	/* Opening REF_CURRENCY.conf File : structure of REF_CURRENCY.dat File */
+	strcpy(l_strFullRefCurrencyFormatFileName, strConfigurationDirectory);
+	strcat(l_strFullRefCurrencyFormatFileName, "/");
+	strcat(l_strFullRefCurrencyFormatFileName, REF_CURRENCY_FORMAT_FILE_NAME);
+	
+	printf("Opening %s File ...\n", l_strFullRefCurrencyFormatFileName);
+	l_CurrencyFile_RecordFormat_Ptr = fopen(l_strFullRefCurrencyFormatFileName, "r");
+	if (l_CurrencyFile_RecordFormat_Ptr == NULL)
+	{
+		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefCurrencyFormatFileName);
+		return EXIT_ERR;
+	}
+
+	/* Reading Records of REF_CURRENCY.conf File : Each Record gives the Characteristics of a Field of the Currency File Record */
+	while (fgets((char*) &Currency_File_Record_Format_Struct, MAX_CURRENCY_FORMAT_REC_LENGTH, l_CurrencyFile_RecordFormat_Ptr) != NULL)
+	{
+		if (strlen(Currency_File_Record_Format_Struct.CurrencyFormat_Record) > 1)
 		{
-			memcpy(l_strIdLot + DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH, l_strInputField + 11, NUM_CRE_IN_CD_REFOPER_LENGTH);
-			memcpy(l_strAppliEmet, l_strInputField + 17, 3);
-			l_strAppliEmet[3] = '\0';
+			// Handle only not empty records
+			l_iRefCurrencyFieldNumber++;
+			if (l_iRefCurrencyFieldNumber < MAX_FIELD_NUMBER_CURRENCY)
+			{
+				strcpy(l_strFieldName, strtok(Currency_File_Record_Format_Struct.CurrencyFormat_Record, REF_CURRENCY_SEPARATOR));
+				if (memcmp(l_strFieldName, "CURRENCY_CD", 11) == 0)
+				{
+					if (l_iRefCurrencyFieldNumber == 0)
+					{
+						strcpy(tabFieldOfRefCurrencyRecord[0].strFieldName, l_strFieldName);
+						strcpy(tabFieldOfRefCurrencyRecord[0].strFieldFormat, strtok(NULL, REF_CURRENCY_SEPARATOR));
+						tabFieldOfRefCurrencyRecord[0].iFieldFormat = whichOutputFormat(tabFieldOfRefCurrencyRecord[0].strFieldFormat);
+						tabFieldOfRefCurrencyRecord[0].iFieldLength = atoi(strtok(NULL, REF_CURRENCY_SEPARATOR));
+						tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition = tabFieldOfRefCurrencyRecord[0].iFieldLength;
+					}
+					else
+					{
+						// Unexpected Position of CURRENCY_CD in REF_CURRENCY.conf File
+						printf("Unexpected Position of CURRENCY_CD in %s File \n", l_strFullRefCurrencyFormatFileName);
+						return EXIT_ERR;
+					}
+				}
+				else
+				{
+					if (memcmp(l_strFieldName, "DECIMAL_POS", 11) == 0)
+					{
+						if (l_iRefCurrencyFieldNumber == 1)
+						{
+							strcpy(tabFieldOfRefCurrencyRecord[1].strFieldName, l_strFieldName);
+							strcpy(tabFieldOfRefCurrencyRecord[1].strFieldFormat, strtok(NULL, REF_CURRENCY_SEPARATOR));
+							tabFieldOfRefCurrencyRecord[1].iFieldFormat = whichOutputFormat(tabFieldOfRefCurrencyRecord[1].strFieldFormat);
+							tabFieldOfRefCurrencyRecord[1].iFieldLength = atoi(strtok(NULL, REF_CURRENCY_SEPARATOR));
+							tabFieldOfRefCurrencyRecord[1].iFieldStartSepPosition = tabFieldOfRefCurrencyRecord[0].iFieldLength + 1 + tabFieldOfRefCurrencyRecord[1].iFieldLength;
+						}
+						else
+						{
+							// Unexpected Position of DECIMAL_POS in REF_CURRENCY.conf File
+							printf("Unexpected Position of DECIMAL_POS in %s File \n", l_strFullRefCurrencyFormatFileName);
+							return EXIT_ERR;
+						}
+					}
+				}
+			}
+			else
+			{
+				// Unexpected Number of Fields in REF_CURRENCY.conf File
+				printf("Number of Fields %d instead of %d in %s File \n", l_iRefCurrencyFieldNumber + 1, MAX_FIELD_NUMBER_CURRENCY, l_strFullRefCurrencyFormatFileName);
+				return EXIT_ERR;
+			}
 		}
-		l_strIdLot[DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH + NUM_CRE_IN_CD_REFOPER_LENGTH] = '\0';
-		// printf(" - [Create_Output_Record] - l_strHB_IMPUTATION = %s, l_strTOP_INT_EXT = %s, l_strIdLot = %s.\n", l_strHB_IMPUTATION, l_strTOP_INT_EXT, l_strIdLot);
+	}
+	/* Closing REF_CURRENCY.conf File */
+	printf("Closing %s File ...\n", l_strFullRefCurrencyFormatFileName);
+	fclose(l_CurrencyFile_RecordFormat_Ptr);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Building CURRENCY Table using data of REF_CURRENCY.dat File
+ * =============================================================================
+ */
+int BuildCurrencyTable()
+{
+	FILE *l_CurrencyFile_Ptr		= NULL;
+	char l_strFullRefCurrencyFileName[MAX_FULL_FILE_NAME_LENGTH];
+	int  l_iIdx						= 0;
+	int  l_iNbSepInRecord			= 0;
+	int  l_iRecNumber				= -1;
+	int  l_iRecRejected             = -1;
+	int  l_iSnapshot				= FALSE;
+	long l_lSnapshotFormat[]		= { sizeof(CURRENCYDecimalArray), sizeof(CURRENCYOverflowArray), tabFieldOfRefCurrencyRecord[0].iFieldLength, tabFieldOfRefCurrencyRecord[1].iFieldLength, tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition };
+	Snapshot	l_CurrencySnapshot;
+	const void	*l_pSection[CURRENCY_SNAPSHOT_SECTIONS];
+	long		l_lSectionSize[CURRENCY_SNAPSHOT_SECTIONS];
+
+	/* Initializing CURRENCY Table */
+	InitializeCURRENCYTable ();
 	
-		// Check if Fields to add in Ouput Record
-		switch (tabFieldOfRecord[l_iIdx].iFieldType)
+	/* Opening REF_CURRENCY.dat File */
+	strcpy(l_strFullRefCurrencyFileName, strConfigurationDirectory);
+	strcat(l_strFullRefCurrencyFileName, "/");
+	strcat(l_strFullRefCurrencyFileName, REF_CURRENCY_FILE_NAME);
+
+	/* CURRENCY Table copied from the Snapshot of REF_CURRENCY.dat File, if it is up to date */
+	if (getenv(SNAPSHOT_VARIABLE) != NULL)
+	{
+		l_iSnapshot = (OpenSnapshot (&l_CurrencySnapshot, l_strFullRefCurrencyFileName, BuildHashKey ((const char *) l_lSnapshotFormat, sizeof(l_lSnapshotFormat))) == EXIT_OK);
+		if (l_iSnapshot && (LoadSnapshot (&l_CurrencySnapshot, CURRENCY_SNAPSHOT_SECTIONS) == EXIT_OK))
 		{
-			case	ADD_CD_TYPIMP_TYPEI_TVA	: // Add CD_TYPIMP, CD_TYPEI and CD_TVA_APP to Output Record
-					l_iIdx++;
-					memcpy(l_strInputField, l_strHB_IMPUTATION,  tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-					l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-					Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-					memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-					l_iIdx++;
-					memcpy(l_strInputField, l_strTOP_INT_EXT, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-					l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-					Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-					memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-					l_iIdx++;
-					memcpy(l_strInputField, l_strTVA, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-					l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-					Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-					memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-					break;
+			memcpy(CURRENCYDecimalArray,  l_CurrencySnapshot.pSection[0], sizeof(CURRENCYDecimalArray));
+			memcpy(CURRENCYOverflowArray, l_CurrencySnapshot.pSection[1], sizeof(CURRENCYOverflowArray));
+			lCURRENCYOverflowNumber = l_CurrencySnapshot.stKey.llCounter[0];
+			CloseSnapshot (&l_CurrencySnapshot);
+			return EXIT_OK;
+		}
+	}
+	
+	printf("Opening %s File ...\n", l_strFullRefCurrencyFileName);
+	l_CurrencyFile_Ptr = fopen(l_strFullRefCurrencyFileName, "r");
+	if (l_CurrencyFile_Ptr == NULL)
+	{
+		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefCurrencyFileName);
+		return EXIT_ERR;
+	}
+
+	// Reading Records of REF_CURRENCY.dat File : Each Record gives the "CURRENCY_CD" and "DECIMAL_POS" Data
+	while (fgets(RefCurrency_Record, REF_CURRENCY_RECORD_LENGTH, l_CurrencyFile_Ptr) != NULL)
+	{
+		l_iRecNumber++;
+		if (strlen(RefCurrency_Record) > 1)
+		{
+			// Handle only not empty records
+			l_iRecRejected = 0;
+			if (strlen(RefCurrency_Record) == tabFieldOfRefCurrencyRecord[0].iFieldLength + 1 + tabFieldOfRefCurrencyRecord[1].iFieldLength + 1) // 1 + 1 : separator + carriage return
+			{
+				// Correct Record Length
+				memset(RefCurrencyFile_Struct.strCURRENCY_CD, '\0', sizeof(RefCurrencyFile_Struct.strCURRENCY_CD));
+				memset(RefCurrencyFile_Struct.strDECIMAL_POS, '\0', sizeof(RefCurrencyFile_Struct.strDECIMAL_POS));
+
+				l_iNbSepInRecord=-1;
+
+				for(l_iIdx=0; l_iIdx < strlen(RefCurrency_Record); l_iIdx++)
+				{
+					if (memcmp(RefCurrency_Record + l_iIdx, REF_CURRENCY_SEPARATOR, 1) == 0)
+					{
+						l_iNbSepInRecord++;
+						if ((l_iNbSepInRecord == 0) && (l_iIdx == tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition))
+						{
+							// Correct Position of REF_CURRENCY_SEPARATOR
+							memcpy(RefCurrencyFile_Struct.strCURRENCY_CD, RefCurrency_Record, tabFieldOfRefCurrencyRecord[0].iFieldLength);
+							RefCurrencyFile_Struct.strCURRENCY_CD[tabFieldOfRefCurrencyRecord[0].iFieldLength] = '\0';
+							memcpy(RefCurrencyFile_Struct.strDECIMAL_POS, RefCurrency_Record + l_iIdx + 1, tabFieldOfRefCurrencyRecord[1].iFieldLength);
+							RefCurrencyFile_Struct.strDECIMAL_POS[tabFieldOfRefCurrencyRecord[1].iFieldLength] = '\0';
+						}
+						else
+						{
+							// Unexpected Position of separator
+							RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
+							printf("Unexpected Position of separator %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", l_iIdx + 1, tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition + 1, l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
+							l_iRecRejected = 1;
+						}
+						l_iIdx = strlen(RefCurrency_Record);
+					}
+				}
+				if (l_iRecRejected == 0)
+				{
+					if (l_iNbSepInRecord + 1 != MAX_SEPARATOR_IN_REF_CURRENCY)
+					{
+						// Unexpected Number of separators
+						RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
+						printf("Unexpected Number of separators %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", l_iNbSepInRecord + 1, MAX_SEPARATOR_IN_REF_CURRENCY, l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
+					}
+					else
+					{
+						if (! isdigit(RefCurrencyFile_Struct.strDECIMAL_POS[0]))
+						{
+							// Unexpected Value of DECIMAL_POS
+							RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
+							printf("Unexpected Value of DECIMAL_POS %c in %s File - Record %06d rejected : \"%s\"\n", RefCurrencyFile_Struct.strDECIMAL_POS[0], l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
+						}
+						else
+						{
+							// Record taken into account
+							// printf(" - [BuildCurrencyTable] - %s Record %03d : %s \t\t| %s \n", l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrencyFile_Struct.strCURRENCY_CD, RefCurrencyFile_Struct.strDECIMAL_POS);
+							if (strlen(RefCurrencyFile_Struct.strCURRENCY_CD) > 0)
+							{
+								AddElementInCURRENCYTable ();
+							}
+						}
+					}
+				}
+			}
+			else
+			{
+				// Unexpected Record Length
+				RefCurrency_Record[strlen(RefCurrency_Record) - 1] = '\0';
+				printf("Unexpected Record Length %d instead of %d in %s File - Record %06d rejected : \"%s\"\n", strlen(RefCurrency_Record), tabFieldOfRefCurrencyRecord[0].iFieldLength + 1 + tabFieldOfRefCurrencyRecord[1].iFieldLength, l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrency_Record);
+			}
+		}
+	}
+	/* Closing REF_CURRENCY.dat File */
+	printf("Closing %s File ...\n", l_strFullRefCurrencyFileName);
+	fclose(l_CurrencyFile_Ptr);
+
+	/* Snapshot of the Table for the next Runs */
+	if (l_iSnapshot)
+	{
+		l_pSection[0] = CURRENCYDecimalArray;	l_lSectionSize[0] = sizeof(CURRENCYDecimalArray);
+		l_pSection[1] = CURRENCYOverflowArray;	l_lSectionSize[1] = sizeof(CURRENCYOverflowArray);
+		l_CurrencySnapshot.stKey.llCounter[0] = lCURRENCYOverflowNumber;
+		WriteSnapshot (&l_CurrencySnapshot, CURRENCY_SNAPSHOT_SECTIONS, l_pSection, l_lSectionSize);
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Bit Masks of the Digits, the spaces and the Signs among the i_iLength
+ *   Characters of a Numeric Field (at most NUMERIC_SCAN_LENGTH), classified
+ *   NUMERIC_SCAN_WIDTH Characters at once
+ * =============================================================================
+*/
+void MatchNumericField (const char *i_strField, int i_iLength, unsigned long long *o_ullDigit, unsigned long long *o_ullSpace, unsigned long long *o_ullSign)
+{
+	int				l_iIdx			= 0;
+#ifdef __SSE2__
+	char			l_strField[NUMERIC_SCAN_LENGTH];
+	__m128i			l_Chars;
+	__m128i			l_Digits;
+
+	// The Field is copied so that its last Characters can be loaded at once
+	memcpy(l_strField, i_strField, i_iLength);
+	memset(l_strField + i_iLength, '\0', (NUMERIC_SCAN_WIDTH - i_iLength % NUMERIC_SCAN_WIDTH) % NUMERIC_SCAN_WIDTH);
+	*o_ullDigit = 0;
+	*o_ullSpace = 0;
+	*o_ullSign  = 0;
+	for (l_iIdx = 0; l_iIdx < i_iLength; l_iIdx += NUMERIC_SCAN_WIDTH)
+	{
+		l_Chars  = _mm_loadu_si128((const __m128i *) (l_strField + l_iIdx));
+		// '0' to '9' become 0 to 9 : any other Character is negative or over 9
+		l_Digits = _mm_sub_epi8(l_Chars, _mm_set1_epi8('0'));
+		*o_ullDigit |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(l_Digits, _mm_set1_epi8(-1)), _mm_cmplt_epi8(l_Digits, _mm_set1_epi8(10)))) << l_iIdx;
+		*o_ullSpace |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Chars, _mm_set1_epi8(' '))) << l_iIdx;
+		*o_ullSign  |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(l_Chars, _mm_set1_epi8('+')), _mm_cmpeq_epi8(l_Chars, _mm_set1_epi8('-')))) << l_iIdx;
+	}
+#else
+	*o_ullDigit = 0;
+	*o_ullSpace = 0;
+	*o_ullSign  = 0;
+	for (l_iIdx = 0; l_iIdx < i_iLength; l_iIdx++)
+	{
+		if ((i_strField[l_iIdx] >= '0') && (i_strField[l_iIdx] <= '9'))
+		{
+			*o_ullDigit |= 1ULL << l_iIdx;
+		}
+		else if (i_strField[l_iIdx] == ' ')
+		{
+			*o_ullSpace |= 1ULL << l_iIdx;
+		}
+		else if ((i_strField[l_iIdx] == '+') || (i_strField[l_iIdx] == '-'))
+		{
+			*o_ullSign |= 1ULL << l_iIdx;
+		}
+	}
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Convert a Numeric Field (entierEG, entierZG, entierSG, entierSZG, entierSD
+ *   or entierSZD) from the Bit Masks of its Characters, as isNumeric and
+ *   Convert_InputField would : spaces, contiguous Digits and spaces, with one
+ *   Sign at most outside the Digits. The i_iInputLength characters at
+ *   i_pInputField are read in place and the padded Output Field is written
+ *   directly. Returns FALSE for any other Field, which Convert_InputField
+ *   must convert.
+ * =============================================================================
+*/
+int ConvertNumericField (const char *i_pInputField, int i_iInputLength, const FieldPlan *i_pField, char *o_strOutputField)
+{
+	unsigned long long	l_ullDigit			= 0;
+	unsigned long long	l_ullSpace			= 0;
+	unsigned long long	l_ullSign			= 0;
+	unsigned long long	l_ullField			= 0;
+	int					l_iLength			= i_iInputLength;
+	int					l_iOutputLength		= i_pField->iFieldLengthOutput;
+	int					l_iFirstDigit		= 0;
+	int					l_iDigitNumber		= 0;
+	int					l_iSign				= 1;
+	int					l_iSignSide			= 0;		// -1 : Sign at the Left side, 1 : at the Right side, 0 : no Sign
+	char				l_cPadding			= ' ';
+
+	switch (i_pField->iFieldFormat)
+	{
+		case entierEG	:	l_cPadding = ' ';	l_iSignSide =  0;	break;
+		case entierZG	:	l_cPadding = '0';	l_iSignSide =  0;	break;
+		case entierSG	:	l_cPadding = ' ';	l_iSignSide = -1;	break;
+		case entierSZG	:	l_cPadding = '0';	l_iSignSide = -1;	break;
+		case entierSD	:	l_cPadding = ' ';	l_iSignSide =  1;	break;
+		case entierSZD	:	l_cPadding = '0';	l_iSignSide =  1;	break;
+		default			:	return FALSE;
+	}
+	if ((l_iLength <= 0) || (l_iLength > NUMERIC_SCAN_LENGTH) || (l_iOutputLength <= 0))
+	{
+		return FALSE;
+	}
+	MatchNumericField (i_pInputField, l_iLength, &l_ullDigit, &l_ullSpace, &l_ullSign);
+	l_ullField = (l_iLength == NUMERIC_SCAN_LENGTH) ? ~0ULL : (1ULL << l_iLength) - 1;
+	// Only Digits, spaces and one Sign at most
+	if (((l_ullDigit | l_ullSpace | l_ullSign) != l_ullField) || ((l_ullSign & (l_ullSign - 1)) != 0))
+	{
+		return FALSE;
+	}
+	if (l_ullDigit != 0)
+	{
+		l_iFirstDigit  = __builtin_ctzll(l_ullDigit);
+		l_iDigitNumber = 64 - __builtin_clzll(l_ullDigit) - l_iFirstDigit;
+		// The Digits must be contiguous
+		if (((l_ullDigit >> l_iFirstDigit) & ((l_ullDigit >> l_iFirstDigit) + 1)) != 0)
+		{
+			return FALSE;
+		}
+	}
+	if ((l_ullSign != 0) && (i_pInputField[__builtin_ctzll(l_ullSign)] == '-'))
+	{
+		l_iSign = -1;
+	}
+	if (l_iDigitNumber > l_iOutputLength - ((l_iSignSide > 0) ? 1 : 0))
+	{
+		return FALSE;
+	}
+
+	memset(o_strOutputField, l_cPadding, l_iOutputLength);
+	if (l_iSignSide < 0)
+	{
+		o_strOutputField[0] = SIGN(l_iSign);
+	}
+	if (l_iSignSide > 0)
+	{
+		memcpy(o_strOutputField + l_iOutputLength - l_iDigitNumber - 1, i_pInputField + l_iFirstDigit, l_iDigitNumber);
+		o_strOutputField[l_iOutputLength - 1] = SIGN(l_iSign);
+	}
+	else
+	{
+		memcpy(o_strOutputField + l_iOutputLength - l_iDigitNumber, i_pInputField + l_iFirstDigit, l_iDigitNumber);
+	}
+	return TRUE;
+}
+
+/* 
+ * =============================================================================
+ *   Original Value of a Field without Formating : the i_iFieldLength first
+ *   characters of its string copy i_strInputField. When the Input Record is
+ *   truncated in the Field, its '\0' is copied with the characters left after
+ *   it by the previous Fields, and the Output Record ends there.
+ *   An added Field has no Input Length (-1) : only its string is copied.
+ * =============================================================================
+ */
+void CopyOriginalField(char *o_strOutputField, const char *i_strInputField, int i_iFieldLength)
+{
+	if (i_iFieldLength < 0)
+	{
+		strcpy(o_strOutputField, i_strInputField);
+	}
+	else
+	{
+		memcpy(o_strOutputField, i_strInputField, i_iFieldLength);
+	}
+}
+
+/* 
+ * =============================================================================
+ *                       Convert Input Field
+ *  The Input Field is read in place : i_iInputLength characters at
+ *  i_pInputField, without any '\0' among them.
+ * =============================================================================
+ */
+void Convert_InputField (const char *i_pInputField, int i_iInputLength, const int *i_iIdx, char *o_strOutputField)
+{
+	static __thread char l_strInputField[MAX_FIELD_LENGTH];	// Not cleared between the calls : see CopyOriginalField
+	char l_strField[MAX_FIELD_LENGTH];
+	char l_strOutputField[MAX_FIELD_LENGTH];
+	char l_strDecimalNumber[2];
+	int  l_iIdx   			= 0;
+	int  l_iSign  			= 0;
+	int  l_iDecimalNumber   = 0;
+	
+	// Initialize l_iIdx and l_strInputField
+	l_iIdx = *i_iIdx;
+	// The plain Numeric Fields are converted without any copy of the Input Field
+	if (ConvertNumericField(i_pInputField, i_iInputLength, &tabFieldPlan[l_iIdx], o_strOutputField))
+	{
+		return;
+	}
+	// The Field is copied as a string in l_strInputField, over the end of the longer Fields copied before it.
+	// charED and charEG Fields are still trimmed in it, as CopyOriginalField of the next Fields may read this end
+	memcpy(l_strInputField, i_pInputField, i_iInputLength);
+	l_strInputField[i_iInputLength] = '\0';
+	// skip, charED and charEG Fields are read in place : the other ones are converted from a string
+	if ((tabFieldPlan[l_iIdx].iFieldFormat != skip) && (tabFieldPlan[l_iIdx].iFieldFormat != charED) && (tabFieldPlan[l_iIdx].iFieldFormat != charEG))
+	{
+		memcpy(l_strField, i_pInputField, i_iInputLength);
+		l_strField[i_iInputLength] = '\0';
+	}
+	// printf(" - [Convert_InputField] - l_strInputField = %s\n", l_strInputField);
+	// printf(" - [Convert_InputField] - tabFieldOfRecord[%d].iFieldFormat = %d\n", l_iIdx, tabFieldOfRecord[l_iIdx].iFieldFormat);
+	// Check if the Input Field must be converted
+	switch (tabFieldPlan[l_iIdx].iFieldFormat)
+	{
+		case skip		:	// Original Value without Formating
+							CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+							break;
+
+		case charED		:	// Right space filled
+							Trim(l_strInputField);
+							TrimField(&i_pInputField, &i_iInputLength);
+							memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_strOutputField, i_pInputField, i_iInputLength);
+							break;
+
+		case charEG		:	// Left  space filled
+							Trim(l_strInputField);
+							TrimField(&i_pInputField, &i_iInputLength);
+							memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - i_iInputLength, i_pInputField, i_iInputLength);
+							break;
 							
-			case	UPDATE_MAI_MNT_IMP	: // Add VL_SIGIMP and VL_NBDCIMP to MAI_MNT_IMP in Output File
-					break;
-					
-			case	UPDATE_MAI_MNT_GES	: // Add VL_SIGGEST and VL_NBDGEST to MAI_MNT_GES in Output File
-					break;
-			
-			case	UPDATE_MAI_MNT_NOM	: // Add VL_SIGNOM and VL_NBDCNOM to MAI_MNT_NOM in Output File
-					break;
-			
-			default	: // No Field to be added. The Field of the Input Record is mapped in the Output Record
-					break;
+		case entierEG	:	// Unsigned Numeric with Left spaces
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
+							{
+								memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+							}
+							else
+							{
+								// In this case, the Original Value is returned without Formating
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+							}
+							break;
+		
+		case entierZG	:	// Unsigned Numeric with Left zeroes
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
+							{
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+							}
+							else
+							{
+								// In this case, the Original Value is returned without Formating
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+							}
+							break;
+							
+		case entierSG	:	// Signed Numeric with Left spaces - The sign is at the Left side
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
+							{
+								memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								o_strOutputField[0] = SIGN(l_iSign);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+							}
+							else
+							{
+								// In this case, the Original Value is returned without Formating
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+							}
+							break;
+							
+		case entierSZG	:	// Signed Numeric with Left zeroes - The sign is at the Left side
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
+							{
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								o_strOutputField[0] = SIGN(l_iSign);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+							}
+							else
+							{
+								// In this case, the Original Value is returned without Formating
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+							}
+							break;
+							
+		case entierSD	:	// Signed Numeric with Left spaces - The sign is at the Right side
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
+							{
+								memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
+								o_strOutputField[tabFieldPlan[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
+							}
+							else
+							{
+								// In this case, the Original Value is returned without Formating
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+							}
+							break;
+							
+		case entierSZD	:	// Signed Numeric with Left zeroes - The sign is at the Right side
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
+							{
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
+								o_strOutputField[tabFieldPlan[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
+							}
+							else
+							{
+								// In this case, the Original Value is returned without Formating
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+							}
+							break;
+
+		case amount3DEC	:	// Amount with the following Format : Sign, Amount and Number of decimals
+							// This amount will be updated (with 3 Decimals) in CorrectFormatAmount Function
+							if (isValidInputAmount(l_strInputField, l_strOutputField, &l_iSign, &l_iDecimalNumber))
+							{
+								// printf(" - [Convert_InputField] - l_strInputField = %s, l_strOutputField = %s, l_iSign = %d, l_iDecimalNumber = %d.\n", l_strInputField,l_strOutputField, l_iSign, l_iDecimalNumber);
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								o_strOutputField[0]  = SIGN(l_iSign);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strOutputField) - 1, l_strOutputField, strlen(l_strOutputField));
+								sprintf(l_strDecimalNumber, "%d", l_iDecimalNumber);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - 1, l_strDecimalNumber, 1);
+							}
+							else
+							{
+								// The Input Amount is Invalid
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Invalid Amount %s found in Input File\n", l_strInputField);
+							}
+							break;
+
+		default			:	// If unknown Format, we suppose that the Original Value is returned without Formating
+							CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+							PrintRecordLog(" - [Convert_InputField] - Unknown Format %s for Field %s in Input File\n", tabFieldPlan[l_iIdx].iFieldFormat, tabFieldOfRecord[l_iIdx].strFieldName);
+							break;
+	}
+}
+
+/* 
+ * =============================================================================
+ *                 Create Output Record, except its LOT
+ *  The Header is built without LOT_NUM and ID_ECRITU : APPLI_EMET and ID_LOT
+ *  of the LOT are returned in o_strAppliEmet and o_strIdLot.
+ * =============================================================================
+ */
+int Create_Output_Record_Without_LOT(const char *i_InputRecord, char *o_OutputRecord, char *o_strAppliEmet, char *o_strIdLot)
+{
+	const char *l_pInputField	= NULL;
+	int  l_iInputLength		= 0;
+	char l_strDAT_OPE[4 + 1];
+	char l_strOutputField[MAX_FIELD_LENGTH];
+	char l_strHB_IMPUTATION[CD_TYPIMP_FIELD_LENGTH + 1];
+	char l_strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH + 1];
+	char l_strTVA[CD_TVA_APP_FIELD_LENGTH + 1];
+	char l_strDEV_IMP_DECIMAL_POS[1 + 1];
+	char l_strDEV_GES_DECIMAL_POS[1 + 1];
+	char l_strDEV_CTP_DECIMAL_POS[1 + 1];
+	char l_strMAI_MNT_IMP[20 + 1];
+	char l_strMAI_MNT_GES[20 + 1];
+	char l_strMAI_MNT_NOM[20 + 1];
+	char l_strOutputAmount[20 + 1];
+	int  l_iIdx   			= 0;
+	int  l_iSign  			= 0;
+	int  l_iAmountDone		= FALSE;
+	long l_lPositHashKey	= -1;
+
+	// Initialize l_strOutputField
+	memset(l_strOutputField, ' ', MAX_FIELD_LENGTH);
+	
+	// Set Default Values for HB_IMPUTATION, TOP_INT_EXT and TVA
+	memcpy(l_strHB_IMPUTATION, "BR", CD_TYPIMP_FIELD_LENGTH);
+	l_strHB_IMPUTATION[CD_TYPIMP_FIELD_LENGTH] = '\0';
+	memcpy(l_strTOP_INT_EXT, "E", CD_TYPEI_FIELD_LENGTH);
+	l_strTOP_INT_EXT[CD_TYPEI_FIELD_LENGTH] = '\0';
+	memcpy(l_strTVA, "  ", CD_TVA_APP_FIELD_LENGTH);
+	l_strTVA[CD_TVA_APP_FIELD_LENGTH] = '\0';
+	
+	while (l_iIdx < iFieldPlanNumber)
+	{
+		// The Input Field is read in place
+		l_pInputField  = i_InputRecord + tabFieldPlan[l_iIdx].iFieldStartPosInput;
+		l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+		// The Amounts are written with 3 Decimals in one pass, straight in the Output Record
+		switch (tabFieldPlan[l_iIdx].iFieldRole)
+		{
+			case	roleMAI_MNT_IMP	:
+					l_iAmountDone = ConvertInputAmount3DEC (l_pInputField, l_iInputLength, &tabFieldPlan[l_iIdx], l_strDEV_IMP_DECIMAL_POS[0], o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput);
+					break;
+
+			case	roleMAI_MNT_GES	:
+			case	roleMAI_MNT_NOM	:
+					l_iAmountDone = ConvertInputAmount3DEC (l_pInputField, l_iInputLength, &tabFieldPlan[l_iIdx], l_strDEV_GES_DECIMAL_POS[0], o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput);
+					break;
+
+			default	:
+					l_iAmountDone = FALSE;
+					break;
+		}
+		if (! l_iAmountDone)
+		{
+			Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+		}
+		// Currency : MAI_DEV_IMP
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleMAI_DEV_IMP)
+		{
+			// An empty Currency Field gives the Default Decimal Number without any message
+			l_strDEV_IMP_DECIMAL_POS[0] = FindDecimalPosInCURRENCYTable(l_pInputField, l_iInputLength);
+			l_strDEV_IMP_DECIMAL_POS[1] = '\0';
+			if (l_strDEV_IMP_DECIMAL_POS[0] == CURRENCY_DECIMAL_NOT_FOUND)
+			{
+				// Currency not found in CURRENCY Table
+				l_strDEV_IMP_DECIMAL_POS[0] = CURRENCY_DEFAULT_DECIMAL_POS;
+				PrintRecordLog("Currency NOT FOUND ............ : %.*s. Default Decimal Number = %s\n", l_iInputLength, l_pInputField, l_strDEV_IMP_DECIMAL_POS);
+			}
+		}
+		// Amount : MAI_MNT_IMP
+		if ((tabFieldPlan[l_iIdx].iFieldRole == roleMAI_MNT_IMP) && (! l_iAmountDone))
+		{
+			memcpy(l_strMAI_MNT_IMP, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+			l_strMAI_MNT_IMP[tabFieldPlan[l_iIdx].iFieldLengthOutput] = '\0';
+			CorrectFormatAmount(l_strMAI_MNT_IMP, l_strDEV_IMP_DECIMAL_POS, l_strOutputAmount);
+			// printf(" - [Create_Output_Record] - l_strMAI_MNT_IMP = %s, l_strDEV_IMP_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strMAI_MNT_IMP, l_strDEV_IMP_DECIMAL_POS, l_strOutputAmount);
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputAmount, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+		}		
+		// Currency of Management : MAI_DEV_GES
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleMAI_DEV_GES)
+		{
+			// An empty Currency Field gives the Default Decimal Number without any message
+			l_strDEV_GES_DECIMAL_POS[0] = FindDecimalPosInCURRENCYTable(l_pInputField, l_iInputLength);
+			l_strDEV_GES_DECIMAL_POS[1] = '\0';
+			if (l_strDEV_GES_DECIMAL_POS[0] == CURRENCY_DECIMAL_NOT_FOUND)
+			{
+				// Currency not found in CURRENCY Table
+				l_strDEV_GES_DECIMAL_POS[0] = CURRENCY_DEFAULT_DECIMAL_POS;
+				PrintRecordLog("Currency NOT FOUND ............ : %.*s. Default Decimal Number = %s\n", l_iInputLength, l_pInputField, l_strDEV_GES_DECIMAL_POS);
+			}
+		}
+		// Amount : MAI_MNT_GES
+		if ((tabFieldPlan[l_iIdx].iFieldRole == roleMAI_MNT_GES) && (! l_iAmountDone))
+		{
+			memcpy(l_strMAI_MNT_GES, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+			l_strMAI_MNT_GES[tabFieldPlan[l_iIdx].iFieldLengthOutput] = '\0';
+			CorrectFormatAmount(l_strMAI_MNT_GES, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
+			// printf(" - [Create_Output_Record] - l_strMAI_MNT_GES = %s, l_strDEV_GES_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strMAI_MNT_GES, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputAmount, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+		}		
+		// Original Currency of Operation : MAI_DEV_CTP
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleMAI_DEV_CTP)
+		{
+			// An empty Currency Field gives the Default Decimal Number without any message
+			l_strDEV_CTP_DECIMAL_POS[0] = FindDecimalPosInCURRENCYTable(l_pInputField, l_iInputLength);
+			l_strDEV_CTP_DECIMAL_POS[1] = '\0';
+			if (l_strDEV_CTP_DECIMAL_POS[0] == CURRENCY_DECIMAL_NOT_FOUND)
+			{
+				// Currency not found in CURRENCY Table
+				l_strDEV_CTP_DECIMAL_POS[0] = CURRENCY_DEFAULT_DECIMAL_POS;
+				PrintRecordLog("Currency NOT FOUND ............ : %.*s. Default Decimal Number = %s\n", l_iInputLength, l_pInputField, l_strDEV_CTP_DECIMAL_POS);
+			}
+		}
+		// Amount : MAI_MNT_NOM
+		if ((tabFieldPlan[l_iIdx].iFieldRole == roleMAI_MNT_NOM) && (! l_iAmountDone))
+		{
+			memcpy(l_strMAI_MNT_NOM, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+			l_strMAI_MNT_NOM[tabFieldPlan[l_iIdx].iFieldLengthOutput] = '\0';
+			CorrectFormatAmount(l_strMAI_MNT_NOM, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
+			// printf(" - [Create_Output_Record] - l_strMAI_MNT_NOM = %s, l_strDEV_GES_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strMAI_MNT_NOM, l_strDEV_GES_DECIMAL_POS, l_strOutputAmount);
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputAmount, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+		}		
+		// Build LOT Identifier using DODGE Account : MAI_CPT_IMP
+		// For an efficient use of the LOT Hash Key, we have chosen to write o_strIdLot
+		// in the following order : DAT_OPE, l_strHB_IMPUTATION, l_strTOP_INT_EXT, NUM_CRE
+		// instead of the order   : l_strHB_IMPUTATION, l_strTOP_INT_EXT, NUM_CRE, DAT_OPE
+		// DATE_OPE
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleMAI_DAT_OPE)
+		{
+			memcpy(l_strDAT_OPE, l_pInputField, 4);
+			memcpy(o_strIdLot, l_pInputField, DATE_LENGTH);
+		}		
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleMAI_CPT_IMP)
+		{
+			// HB_IMPUTATION, TOP_INT_EXT and TVA
+			 // printf(" - [Create_Output_Record] - Dodge Account = %.*s.\n", l_iInputLength, l_pInputField);
+			if (COMPTE_DODGEPerfectArray != NULL)
+			{
+				if (FindElementInCOMPTE_DODGEPerfectTable(l_pInputField, l_iInputLength, &l_lPositHashKey))
+				{
+					strcpy(l_strHB_IMPUTATION, COMPTE_DODGEPerfectArray[l_lPositHashKey].strHB_IMPUTATION);
+					strcpy(l_strTOP_INT_EXT, COMPTE_DODGEPerfectArray[l_lPositHashKey].strTOP_INT_EXT);
+					strcpy(l_strTVA, COMPTE_DODGEPerfectArray[l_lPositHashKey].strTVA);
+				}
+				else
+				{
+					PrintRecordLog("Dodge Account NOT FOUND ....... : %.*s\n", l_iInputLength, l_pInputField);
+				}
+			}
+			else if (FindElementInCOMPTE_DODGEHashArrayTable(l_pInputField, l_iInputLength, &l_lPositHashKey))
+			{
+				strcpy(l_strHB_IMPUTATION, COMPTE_DODGEHashArray[l_lPositHashKey].strHB_IMPUTATION);
+				strcpy(l_strTOP_INT_EXT, COMPTE_DODGEHashArray[l_lPositHashKey].strTOP_INT_EXT);
+				strcpy(l_strTVA, COMPTE_DODGEHashArray[l_lPositHashKey].strTVA);
+			}
+			else
+			{
+				PrintRecordLog("Dodge Account NOT FOUND ....... : %.*s\n", l_iInputLength, l_pInputField);
+			}
+			memcpy(o_strIdLot + DATE_LENGTH, l_strHB_IMPUTATION, CD_TYPIMP_FIELD_LENGTH);
+			memcpy(o_strIdLot + DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH, l_strTOP_INT_EXT, CD_TYPEI_FIELD_LENGTH);
+			if (strcmp(ENTITY,"LCL") == 0)
+			{
+				if (isEqualToField("530001001", l_pInputField, l_iInputLength) || isEqualToField("530001002", l_pInputField, l_iInputLength))
+				{
+					PrintRecordLog("Modification Compte DODGE %.*s pour ENTITY : LCL en 530001003", l_iInputLength, l_pInputField);
+					memcpy(o_OutputRecord + tabFieldPlan[19].iFieldStartPosOutput, "530001003", 9);
+				}
+				/*else
+				{
+					printf("Pas de modification Compte DODGE %.*s pour ENTITY : LCL en 530001003", l_iInputLength, l_pInputField);
+				}*/
+
+			}
+		}
+		// REF_OPE
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleMAI_REF_OPE)
+		{
+			memcpy(o_strIdLot + DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH, l_pInputField + 11, NUM_CRE_IN_CD_REFOPER_LENGTH);
+			memcpy(o_strAppliEmet, l_pInputField + 17, 3);
+			o_strAppliEmet[3] = '\0';
+		}
+		o_strIdLot[DATE_LENGTH + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH + NUM_CRE_IN_CD_REFOPER_LENGTH] = '\0';
+		// printf(" - [Create_Output_Record] - l_strHB_IMPUTATION = %s, l_strTOP_INT_EXT = %s, o_strIdLot = %s.\n", l_strHB_IMPUTATION, l_strTOP_INT_EXT, o_strIdLot);
+	
+		// Check if Fields to add in Ouput Record
+		switch (tabFieldPlan[l_iIdx].iFieldType)
+		{
+			case	ADD_CD_TYPIMP_TYPEI_TVA	: // Add CD_TYPIMP, CD_TYPEI and CD_TVA_APP to Output Record
+					l_iIdx++;
+					Convert_InputField (l_strHB_IMPUTATION, FieldLength(l_strHB_IMPUTATION, tabFieldPlan[l_iIdx].iFieldLengthOutput), &l_iIdx, l_strOutputField);
+					memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+					l_iIdx++;
+					Convert_InputField (l_strTOP_INT_EXT, FieldLength(l_strTOP_INT_EXT, tabFieldPlan[l_iIdx].iFieldLengthOutput), &l_iIdx, l_strOutputField);
+					memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+					l_iIdx++;
+					Convert_InputField (l_strTVA, FieldLength(l_strTVA, tabFieldPlan[l_iIdx].iFieldLengthOutput), &l_iIdx, l_strOutputField);
+					memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+					break;
+							
+			case	UPDATE_MAI_MNT_IMP	: // Add VL_SIGIMP and VL_NBDCIMP to MAI_MNT_IMP in Output File
+					break;
+					
+			case	UPDATE_MAI_MNT_GES	: // Add VL_SIGGEST and VL_NBDGEST to MAI_MNT_GES in Output File
+					break;
+			
+			case	UPDATE_MAI_MNT_NOM	: // Add VL_SIGNOM and VL_NBDCNOM to MAI_MNT_NOM in Output File
+					break;
+			
+			default	: // No Field to be added. The Field of the Input Record is mapped in the Output Record
+					break;
+		}
+		l_iIdx++;
+	}
+	// printf(" - [Create_Output_Record] - DEV_IMP Decimal Nr : %s.\n", l_strDEV_IMP_DECIMAL_POS);
+	// printf(" - [Create_Output_Record] - DEV_GES Decimal Nr : %s.\n", l_strDEV_GES_DECIMAL_POS);
+	// printf(" - [Create_Output_Record] - DEV_CTP Decimal Nr : %s.\n", l_strDEV_CTP_DECIMAL_POS);
+	
+	// Build the Header of the Output Record : HEADER_CD_CRE is given by the Output Record Template
+	memcpy(o_OutputRecord + HEADER_CD_CRE_LENGTH, l_strDAT_OPE, 4);
+	memcpy(o_OutputRecord + HEADER_CD_CRE_LENGTH + 4, o_strAppliEmet, 3);
+	o_OutputRecord[tabFieldPlan[l_iIdx - 1].iFieldStartPosOutput + tabFieldPlan[l_iIdx - 1].iFieldLengthOutput] = '\0';
+	return EXIT_OK;
+}
+
+/* 
+ * =============================================================================
+ *                Set LOT_NUM and ID_ECRITU in the Output Record
+ * =============================================================================
+ */
+void SetOutputRecordLOT(char *io_OutputRecord, const char *i_strLotNum, const char *i_strIdEcriture)
+{
+	memcpy(io_OutputRecord + HEADER_CD_CRE_LENGTH + 4 + 3, i_strLotNum, 17);
+	memcpy(io_OutputRecord + HEADER_CD_CRE_LENGTH + HEADER_ID_LOT_LENGTH + HEADER_ID_COMPOST_LENGTH, i_strIdEcriture, HEADER_ID_ECRITU_LENGTH);
+}
+
+/* 
+ * =============================================================================
+ *                       Create Output Record
+ * =============================================================================
+ */
+int Create_Output_Record(const char *i_InputRecord, char *o_OutputRecord)
+{
+	char l_strIdLot[17 + 1];
+	char l_strAppliEmet[3 + 1];
+	char l_strLotNum[17 + 1];
+	char l_strIdEcriture[6 + 1];
+
+	Create_Output_Record_Without_LOT(i_InputRecord, o_OutputRecord, l_strAppliEmet, l_strIdLot);
+	if (FindIdLotIdEcriture (l_strAppliEmet, l_strIdLot, l_strLotNum, l_strIdEcriture) == EXIT_ERR)
+	{
+		return EXIT_ERR;
+	}
+	// printf(" - [Create_Output_Record] - l_strAppliEmet = %s, l_strIdLot = %s, l_strLotNum = %s, l_strIdEcriture = %s\n", l_strAppliEmet, l_strIdLot, l_strLotNum, l_strIdEcriture);
+	SetOutputRecordLOT(o_OutputRecord, l_strLotNum, l_strIdEcriture);
+	return EXIT_OK;
+}
+
+/* 
+ * =============================================================================
+ *          Create Output Record with its Header, except its LOT
+ * =============================================================================
+ */
+void BuildOutputRecord (OutputRecord *o_pOutputRecord, const char *i_InputRecord, char *o_strAppliEmet, char *o_strIdLot)
+{
+	memcpy(o_pOutputRecord, &Output_Record_Template, lOutputRecordTemplateLength);
+	Create_Output_Record_Without_LOT(i_InputRecord, (char *) o_pOutputRecord, o_strAppliEmet, o_strIdLot);
+}
+
+/* 
+ * =============================================================================
+ *  Building Format of Output File Record using struct_premai.conf File
+ *  In this File, Each Record corresponds to one Field of the Input File Record
+ * =============================================================================
+ */
+int BuildOutputRecordFormat()
+{
+	FILE *l_InputFile_RecordFormat_Ptr		= NULL;
+	char  l_strFullInputFileFormatName[MAX_FULL_FILE_NAME_LENGTH];
+	int   l_iFieldNumber					= 0;
+	int   l_iRecNumber						= 0;
+	int   l_iPreviousInputFieldNumber 		= 0;
+	int   l_iStartFieldPositionForInput		= 0;
+	int   l_iStartFieldPositionForOutput	= HEADER_LENGTH;
+
+	/* Initializing the table of Fields of Input and Output Files */
+	for (l_iFieldNumber = 0; l_iFieldNumber < MAX_FIELD_NUMBER; l_iFieldNumber++)
+	{
+		memset(tabFieldOfRecord[l_iFieldNumber].strFieldName,   '\0', sizeof(tabFieldOfRecord[l_iFieldNumber].strFieldName));
+		memset(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, '\0', sizeof(tabFieldOfRecord[l_iFieldNumber].strFieldFormat));
+		tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = unknown;
+		tabFieldOfRecord[l_iFieldNumber].iFieldType           = -1;
+		tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput    = -1;
+		tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = -1;
+		tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = -1;
+		tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = -1;
+	}
+	
+	/* Opening struct_premai.conf File */
+	strcpy(l_strFullInputFileFormatName, strConfigurationDirectory);
+	strcat(l_strFullInputFileFormatName, "/");
+	strcat(l_strFullInputFileFormatName, INPUT_FILE_FORMAT_NAME);
+
+	printf("Opening %s File ...\n", l_strFullInputFileFormatName);
+	l_InputFile_RecordFormat_Ptr = fopen(l_strFullInputFileFormatName, "r");
+	if (l_InputFile_RecordFormat_Ptr == NULL)
+	{
+		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullInputFileFormatName);
+		return EXIT_ERR;
+	}
+
+	/* Reading Records of struct_premai.conf File : Each Record gives the Characteristics of a Field of the Input File Record */
+	l_iFieldNumber = -1;
+	while (fgets((char*) &Input_File_Record_Format_Struct, MAX_INPUT_FORMAT_REC_LENGTH, l_InputFile_RecordFormat_Ptr) != NULL)
+	{
+		if (strlen(Input_File_Record_Format_Struct.InputFormat_Record) > 1)
+		{
+			// Handle only not empty records
+			l_iRecNumber++;
+			l_iFieldNumber++;
+			
+			strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, strtok(Input_File_Record_Format_Struct.InputFormat_Record, SEPARATOR));
+			strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, strtok(NULL, SEPARATOR));
+			tabFieldOfRecord[l_iFieldNumber].iFieldFormat = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+			// Start Position of the Field in Input and Output Record
+			if (l_iRecNumber == 1)
+			{
+				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = l_iStartFieldPositionForInput;
+				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = l_iStartFieldPositionForOutput;
+				tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput    = atoi(strtok(NULL, SEPARATOR));
+				tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput;
+			}
+			else
+			{
+				l_iStartFieldPositionForInput  = l_iStartFieldPositionForInput  + tabFieldOfRecord[l_iPreviousInputFieldNumber].iFieldLengthInput;
+				l_iStartFieldPositionForOutput = l_iStartFieldPositionForOutput + tabFieldOfRecord[l_iFieldNumber - 1].iFieldLengthOutput;
+				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = l_iStartFieldPositionForInput;
+				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = l_iStartFieldPositionForOutput;
+				tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput    = atoi(strtok(NULL, SEPARATOR));
+				tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput;
+			}
+			// Input Record Length Calculation
+			iInputRecordLength += tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput;
+			// Amount Handling
+			if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_MNT_IMP") == 0)
+			{
+				tabFieldOfRecord[l_iFieldNumber].iFieldType           = UPDATE_MAI_MNT_IMP;
+				// Add VL_SIGIMP and VL_NBDCIMP to MAI_MNT_IMP in Output File
+				strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "amount3DEC");
+				tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+				tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH;
+				l_iPreviousInputFieldNumber = l_iFieldNumber;
+			}
+			else
+			{
+				if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_MNT_GES") == 0)
+				{
+					tabFieldOfRecord[l_iFieldNumber].iFieldType           = UPDATE_MAI_MNT_GES;
+					// Add VL_SIGGEST and VL_NBDGEST to MAI_MNT_GES in Output File
+					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "amount3DEC");
+					tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+					tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH;
+					l_iPreviousInputFieldNumber = l_iFieldNumber;
+				}
+				else
+				{
+					if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_MNT_NOM") == 0)
+					{
+						tabFieldOfRecord[l_iFieldNumber].iFieldType           = UPDATE_MAI_MNT_NOM;
+						// Add VL_SIGNOM and VL_NBDCNOM to MAI_MNT_NOM in Output File
+						strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "amount3DEC");
+						tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+						tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH;
+						l_iPreviousInputFieldNumber = l_iFieldNumber;
+					}
+					else
+					{
+						if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_TOP_MAJ") == 0)
+						{
+							tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_CD_TYPIMP_TYPEI_TVA;
+							// Add CD_TYPIMP, CD_TYPEI and CD_TVA_APP in Output File
+							l_iPreviousInputFieldNumber = l_iFieldNumber;
+							l_iFieldNumber++;
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName,   "CD_TYPIMP");
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = CD_TYPIMP_FIELD_LENGTH;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = CD_TYPIMP_TYPEI_TVA_INPUT_POSIT;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+							l_iFieldNumber++;
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName,   "CD_TYPEI");
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = CD_TYPEI_FIELD_LENGTH;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = CD_TYPIMP_TYPEI_TVA_INPUT_POSIT;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+							l_iFieldNumber++;
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName,   "CD_TVA_APP");
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = CD_TVA_APP_FIELD_LENGTH;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = CD_TYPIMP_TYPEI_TVA_INPUT_POSIT;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;							
+							l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+						}
+						else
+						{
+							l_iPreviousInputFieldNumber = l_iFieldNumber;
+						}
+					}
+				}
+			}
+		}
+	}
+	
+	/* Closing struct_premai.conf File */
+	printf("Closing %s File ...\n", l_strFullInputFileFormatName);
+	fclose(l_InputFile_RecordFormat_Ptr);
+
+	/* Resolving the Plan of the Output File Record : Create_Output_Record does not use the Names of the Fields */
+	iFieldPlanNumber = 0;
+	while ((iFieldPlanNumber < MAX_FIELD_NUMBER) && (strlen(tabFieldOfRecord[iFieldPlanNumber].strFieldName) > 0))
+	{
+		tabFieldPlan[iFieldPlanNumber].iFieldRole           = whichFieldRole(tabFieldOfRecord[iFieldPlanNumber].strFieldName);
+		tabFieldPlan[iFieldPlanNumber].iFieldFormat         = tabFieldOfRecord[iFieldPlanNumber].iFieldFormat;
+		tabFieldPlan[iFieldPlanNumber].iFieldType           = tabFieldOfRecord[iFieldPlanNumber].iFieldType;
+		tabFieldPlan[iFieldPlanNumber].iFieldLengthInput    = tabFieldOfRecord[iFieldPlanNumber].iFieldLengthInput;
+		tabFieldPlan[iFieldPlanNumber].iFieldLengthOutput   = tabFieldOfRecord[iFieldPlanNumber].iFieldLengthOutput;
+		tabFieldPlan[iFieldPlanNumber].iFieldStartPosInput  = tabFieldOfRecord[iFieldPlanNumber].iFieldStartPosInput;
+		tabFieldPlan[iFieldPlanNumber].iFieldStartPosOutput = tabFieldOfRecord[iFieldPlanNumber].iFieldStartPosOutput;
+		iFieldPlanNumber++;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Write the whole Data in a File or a Pipe
+ *   Returns the Number of write calls, or -1 with errno set
+ * =============================================================================
+*/
+long WriteFully (int i_iFile, const char *i_pData, long i_lLength)
+{
+	long	l_lWritten	= 0;
+	long	l_lPosit	= 0;
+	long	l_lWrites	= 0;
+
+	while (l_lPosit < i_lLength)
+	{
+		l_lWritten = write(i_iFile, i_pData + l_lPosit, i_lLength - l_lPosit);
+		if (l_lWritten < 0)
+		{
+			if (errno != EINTR)
+			{
+				return -1;
+			}
+		}
+		else
+		{
+			l_lPosit += l_lWritten;
+			l_lWrites++;
+		}
+	}
+	return l_lWrites;
+}
+
+/*
+ * =============================================================================
+ *   Compression of the Output File, given by COMPRESSION_OUTPUT_VARIABLE
+ *   ("gzip" or "zstd", followed by ":Level" if needed, from 1 to 9 for gzip
+ *   and from 1 to 22 for zstd)
+ *   Returns COMPRESSION_NONE if the Variable is not set, -1 if the Compression
+ *   or its Level is unknown, or if the Compression is not built in the Program
+ * =============================================================================
+*/
+int EvaluateOutputCompression (int *o_iLevel)
+{
+	char	*l_strCompression	= getenv(COMPRESSION_OUTPUT_VARIABLE);
+	char	*l_strLevel			= NULL;
+	char	*l_pLevelEnd		= NULL;
+	size_t	l_lNameLength		= 0;
+	long	l_lLevel			= 0;
+	int		l_iFormat			= COMPRESSION_NONE;
+	int		l_iIdx				= 0;
+
+	*o_iLevel = 0;
+	if ((l_strCompression == NULL) || (strlen(l_strCompression) == 0))
+	{
+		return COMPRESSION_NONE;
+	}
+	l_strLevel = strchr(l_strCompression, ':');
+	l_lNameLength = (l_strLevel != NULL) ? (size_t) (l_strLevel - l_strCompression) : strlen(l_strCompression);
+	for (l_iIdx = COMPRESSION_GZIP; l_iIdx <= COMPRESSION_ZSTD; l_iIdx++)
+	{
+		if ((strlen(tabCompressionName[l_iIdx]) == l_lNameLength)
+		&&  (strncmp(l_strCompression, tabCompressionName[l_iIdx], strlen(tabCompressionName[l_iIdx])) == 0))
+		{
+			l_iFormat = l_iIdx;
+		}
+	}
+	if ((l_iFormat == COMPRESSION_NONE)
+#ifndef RDJ_WITH_ZLIB
+	||  (l_iFormat == COMPRESSION_GZIP)
+#endif
+#ifndef RDJ_WITH_ZSTD
+	||  (l_iFormat == COMPRESSION_ZSTD)
+#endif
+	   )
+	{
+		printf("Output Compression %s is unknown or not built in the Program\n", l_strCompression);
+		return -1;
+	}
+	if (l_strLevel == NULL)
+	{
+		*o_iLevel = (l_iFormat == COMPRESSION_GZIP) ? COMPRESSION_GZIP_LEVEL : COMPRESSION_ZSTD_LEVEL;
+		return l_iFormat;
+	}
+	// The Level must be a Number in the range of the Compression
+	errno = 0;
+	l_lLevel = strtol(l_strLevel + 1, &l_pLevelEnd, 10);
+	if ((l_pLevelEnd == l_strLevel + 1) || (*l_pLevelEnd != '\0') || (errno != 0)
+	||  (l_lLevel < 1) || (l_lLevel > ((l_iFormat == COMPRESSION_GZIP) ? COMPRESSION_GZIP_LEVEL_MAX : COMPRESSION_ZSTD_LEVEL_MAX)))
+	{
+		printf("Output Compression %s is unknown or not built in the Program\n", l_strCompression);
+		return -1;
+	}
+	*o_iLevel = (int) l_lLevel;
+	return l_iFormat;
+}
+
+/*
+ * =============================================================================
+ *   Start compressing the Output File in i_iFormat
+ * =============================================================================
+*/
+int StartCompressor (Compressor *o_pCompressor, int i_iFormat, int i_iLevel, long i_lBufferSize)
+{
+	memset(o_pCompressor, '\0', sizeof(Compressor));
+	o_pCompressor->iFormat = i_iFormat;
+	o_pCompressor->lBufferSize = i_lBufferSize;
+	o_pCompressor->pBuffer = (char *) malloc(i_lBufferSize);
+	if (o_pCompressor->pBuffer == NULL)
+	{
+		printf("Error %d : '%s' occurs when allocating Output Compression Buffer (%ld Bytes)\n", errno, strerror(errno), i_lBufferSize);
+		return EXIT_ERR;
+	}
+#ifdef RDJ_WITH_ZLIB
+	if (i_iFormat == COMPRESSION_GZIP)
+	{
+		o_pCompressor->pStream = calloc(1, sizeof(z_stream));
+		// 15 + 16 : gzip Header and Trailer around the deflate Data
+		if ((o_pCompressor->pStream == NULL)
+		||  (deflateInit2((z_stream *) o_pCompressor->pStream, i_iLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK))
+		{
+			printf("Error : gzip Compression of the Output File cannot be started (Level %d)\n", i_iLevel);
+			return EXIT_ERR;
+		}
+	}
+#endif
+#ifdef RDJ_WITH_ZSTD
+	if (i_iFormat == COMPRESSION_ZSTD)
+	{
+		o_pCompressor->pStream = ZSTD_createCCtx();
+		if ((o_pCompressor->pStream == NULL)
+		||  (ZSTD_isError(ZSTD_CCtx_setParameter((ZSTD_CCtx *) o_pCompressor->pStream, ZSTD_c_compressionLevel, i_iLevel))))
+		{
+			printf("Error : zstd Compression of the Output File cannot be started (Level %d)\n", i_iLevel);
+			return EXIT_ERR;
+		}
+	}
+#endif
+#if !defined(RDJ_WITH_ZLIB) && !defined(RDJ_WITH_ZSTD)
+	(void) i_iLevel;
+#endif
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Compress i_lLength Bytes and write what is compressed at the current
+ *   Position of the Output File. i_iFinish ends the compressed Stream.
+ * =============================================================================
+*/
+int CompressAndWrite (Compressor *io_pCompressor, int i_iFile, const char *i_pData, long i_lLength, int i_iFinish)
+{
+#if defined(RDJ_WITH_ZLIB) || defined(RDJ_WITH_ZSTD)
+	int		l_iPending		= TRUE;
+	long	l_lProduced		= 0;
+
+	while (l_iPending)
+	{
+		l_lProduced = 0;
+		l_iPending  = FALSE;
+#ifdef RDJ_WITH_ZLIB
+		if (io_pCompressor->iFormat == COMPRESSION_GZIP)
+		{
+			z_stream	*l_pStream	= (z_stream *) io_pCompressor->pStream;
+			int			l_iResult	= Z_OK;
+
+			l_pStream->next_in   = (Bytef *) i_pData;
+			l_pStream->avail_in  = i_lLength;
+			l_pStream->next_out  = (Bytef *) io_pCompressor->pBuffer;
+			l_pStream->avail_out = io_pCompressor->lBufferSize;
+			l_iResult = deflate(l_pStream, (i_iFinish) ? Z_FINISH : Z_NO_FLUSH);
+			if (l_iResult == Z_STREAM_ERROR)
+			{
+				errno = EINVAL;
+				return EXIT_ERR;
+			}
+			l_lProduced = io_pCompressor->lBufferSize - l_pStream->avail_out;
+			i_pData    += i_lLength - l_pStream->avail_in;
+			i_lLength   = l_pStream->avail_in;
+			// The Buffer was filled : deflate may have more to give
+			l_iPending  = (l_pStream->avail_out == 0) || ((i_iFinish) && (l_iResult != Z_STREAM_END));
+		}
+#endif
+#ifdef RDJ_WITH_ZSTD
+		if (io_pCompressor->iFormat == COMPRESSION_ZSTD)
+		{
+			ZSTD_inBuffer	l_stInput	= { i_pData, i_lLength, 0 };
+			ZSTD_outBuffer	l_stOutput	= { io_pCompressor->pBuffer, io_pCompressor->lBufferSize, 0 };
+			size_t			l_lRemaining = 0;
+
+			l_lRemaining = ZSTD_compressStream2((ZSTD_CCtx *) io_pCompressor->pStream, &l_stOutput, &l_stInput, (i_iFinish) ? ZSTD_e_end : ZSTD_e_continue);
+			if (ZSTD_isError(l_lRemaining))
+			{
+				errno = EINVAL;
+				return EXIT_ERR;
+			}
+			l_lProduced = l_stOutput.pos;
+			i_pData    += l_stInput.pos;
+			i_lLength  -= l_stInput.pos;
+			l_iPending  = (i_lLength > 0) || ((i_iFinish) && (l_lRemaining != 0));
+		}
+#endif
+		if ((l_lProduced > 0) && (WriteFully (i_iFile, io_pCompressor->pBuffer, l_lProduced) < 0))
+		{
+			return EXIT_ERR;
+		}
+		io_pCompressor->llBytesOut += l_lProduced;
+	}
+#else
+	// No Compression is built in the Program : EvaluateOutputCompression has refused it
+	(void) io_pCompressor;
+	(void) i_iFile;
+	(void) i_pData;
+	(void) i_lLength;
+	(void) i_iFinish;
+#endif
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                     Stop compressing the Output File
+ * =============================================================================
+*/
+void StopCompressor (Compressor *io_pCompressor)
+{
+#ifdef RDJ_WITH_ZLIB
+	if ((io_pCompressor->iFormat == COMPRESSION_GZIP) && (io_pCompressor->pStream != NULL))
+	{
+		deflateEnd((z_stream *) io_pCompressor->pStream);
+		free(io_pCompressor->pStream);
+	}
+#endif
+#ifdef RDJ_WITH_ZSTD
+	if (io_pCompressor->iFormat == COMPRESSION_ZSTD)
+	{
+		ZSTD_freeCCtx((ZSTD_CCtx *) io_pCompressor->pStream);
+	}
+#endif
+	io_pCompressor->pStream = NULL;
+	free(io_pCompressor->pBuffer);
+	io_pCompressor->pBuffer = NULL;
+}
+
+/*
+ * =============================================================================
+ *   Thread decompressing the Input File into the Pipe read by the Records Loop
+ *   The Format is given by the Magic Bytes : other Data are copied as they are.
+ * =============================================================================
+*/
+void *RunInputDecompressor (void *io_pDecompressor)
+{
+	Decompressor	*l_pDecompressor	= (Decompressor *) io_pDecompressor;
+	unsigned char	*l_pInput			= NULL;
+	char			*l_pOutput			= NULL;
+	long			l_lRead				= 0;
+	int				l_iEnded			= TRUE;		// End of the last compressed Stream (or Member) reached
+#ifdef RDJ_WITH_ZLIB
+	z_stream		l_stZStream;
+	long			l_lProduced			= 0;
+	int				l_iResult			= Z_OK;
+#endif
+#ifdef RDJ_WITH_ZSTD
+	ZSTD_DCtx		*l_pZSTDStream		= NULL;
+	ZSTD_inBuffer	l_stInput;
+	ZSTD_outBuffer	l_stOutput;
+	size_t			l_lRemaining		= 0;
+#endif
+
+	l_pInput  = (unsigned char *) malloc(COMPRESSION_CHUNK_SIZE);
+	l_pOutput = (char *) malloc(COMPRESSION_CHUNK_SIZE);
+	if ((l_pInput == NULL) || (l_pOutput == NULL))
+	{
+		l_pDecompressor->iError = ENOMEM;
+	}
+	while ((l_pDecompressor->iError == 0) && ((l_lRead = fread(l_pInput, 1, COMPRESSION_CHUNK_SIZE, l_pDecompressor->pSource)) > 0))
+	{
+		if (l_pDecompressor->llBytesIn == 0)
+		{
+			if ((l_lRead >= 2) && (l_pInput[0] == 0x1F) && (l_pInput[1] == 0x8B))
+			{
+				l_pDecompressor->iFormat = COMPRESSION_GZIP;
+			}
+			else if ((l_lRead >= 4) && (memcmp(l_pInput, "\x28\xB5\x2F\xFD", 4) == 0))
+			{
+				l_pDecompressor->iFormat = COMPRESSION_ZSTD;
+			}
+#ifdef RDJ_WITH_ZLIB
+			if (l_pDecompressor->iFormat == COMPRESSION_GZIP)
+			{
+				// 15 + 32 : gzip or zlib Header detected by inflate
+				memset(&l_stZStream, '\0', sizeof(l_stZStream));
+				if (inflateInit2(&l_stZStream, 15 + 32) != Z_OK)
+				{
+					l_pDecompressor->iError = ENOMEM;
+				}
+			}
+#endif
+#ifdef RDJ_WITH_ZSTD
+			if (l_pDecompressor->iFormat == COMPRESSION_ZSTD)
+			{
+				l_pZSTDStream = ZSTD_createDCtx();
+				if (l_pZSTDStream == NULL)
+				{
+					l_pDecompressor->iError = ENOMEM;
+				}
+			}
+#endif
+		}
+		l_pDecompressor->llBytesIn += l_lRead;
+
+		if (l_pDecompressor->iFormat == COMPRESSION_NONE)
+		{
+			if (WriteFully (l_pDecompressor->iPipe[1], (char *) l_pInput, l_lRead) < 0)
+			{
+				l_pDecompressor->iError = errno;
+			}
+			l_pDecompressor->llBytesOut += l_lRead;
+		}
+#ifdef RDJ_WITH_ZLIB
+		if (l_pDecompressor->iFormat == COMPRESSION_GZIP)
+		{
+			l_stZStream.next_in  = l_pInput;
+			l_stZStream.avail_in = l_lRead;
+			while ((l_stZStream.avail_in > 0) && (l_pDecompressor->iError == 0))
+			{
+				// Concatenated gzip Members are read one after the other
+				if (l_iEnded)
+				{
+					inflateReset(&l_stZStream);
+					l_iEnded = FALSE;
+				}
+				do
+				{
+					l_stZStream.next_out  = (Bytef *) l_pOutput;
+					l_stZStream.avail_out = COMPRESSION_CHUNK_SIZE;
+					l_iResult = inflate(&l_stZStream, Z_NO_FLUSH);
+					l_lProduced = COMPRESSION_CHUNK_SIZE - l_stZStream.avail_out;
+					if ((l_iResult == Z_BUF_ERROR) && (l_stZStream.avail_in == 0))
+					{
+						// Every Byte read was inflated
+						l_iResult = Z_OK;
+					}
+					if ((l_iResult != Z_OK) && (l_iResult != Z_STREAM_END))
+					{
+						l_pDecompressor->iError = -1;
+					}
+					else if (WriteFully (l_pDecompressor->iPipe[1], l_pOutput, l_lProduced) < 0)
+					{
+						l_pDecompressor->iError = errno;
+					}
+					l_pDecompressor->llBytesOut += l_lProduced;
+				}
+				while ((l_stZStream.avail_out == 0) && (l_iResult == Z_OK) && (l_pDecompressor->iError == 0));
+				l_iEnded = (l_iResult == Z_STREAM_END);
+			}
+		}
+#else
+		if (l_pDecompressor->iFormat == COMPRESSION_GZIP)
+		{
+			l_pDecompressor->iError = ENOTSUP;
+		}
+#endif
+#ifdef RDJ_WITH_ZSTD
+		if (l_pDecompressor->iFormat == COMPRESSION_ZSTD)
+		{
+			l_stInput.src  = l_pInput;
+			l_stInput.size = l_lRead;
+			l_stInput.pos  = 0;
+			do
+			{
+				l_stOutput.dst  = l_pOutput;
+				l_stOutput.size = COMPRESSION_CHUNK_SIZE;
+				l_stOutput.pos  = 0;
+				l_lRemaining = ZSTD_decompressStream(l_pZSTDStream, &l_stOutput, &l_stInput);
+				if (ZSTD_isError(l_lRemaining))
+				{
+					l_pDecompressor->iError = -1;
+				}
+				else if (WriteFully (l_pDecompressor->iPipe[1], l_pOutput, l_stOutput.pos) < 0)
+				{
+					l_pDecompressor->iError = errno;
+				}
+				l_pDecompressor->llBytesOut += l_stOutput.pos;
+			}
+			while (((l_stInput.pos < l_stInput.size) || (l_stOutput.pos == l_stOutput.size)) && (l_pDecompressor->iError == 0));
+			// 0 : the last Frame is complete
+			l_iEnded = (l_lRemaining == 0);
+		}
+#else
+		if (l_pDecompressor->iFormat == COMPRESSION_ZSTD)
+		{
+			l_pDecompressor->iError = ENOTSUP;
+		}
+#endif
+	}
+	if ((l_pDecompressor->iError == 0) && (ferror(l_pDecompressor->pSource)))
+	{
+		l_pDecompressor->iError = EIO;
+	}
+	if ((l_pDecompressor->iError == 0) && (! l_iEnded))
+	{
+		// Truncated compressed Stream
+		l_pDecompressor->iError = -1;
+	}
+#ifdef RDJ_WITH_ZLIB
+	if ((l_pDecompressor->iFormat == COMPRESSION_GZIP) && (l_pDecompressor->llBytesIn > 0))
+	{
+		inflateEnd(&l_stZStream);
+	}
+#endif
+#ifdef RDJ_WITH_ZSTD
+	ZSTD_freeDCtx(l_pZSTDStream);
+#endif
+	free(l_pInput);
+	free(l_pOutput);
+	// The Records Loop reaches the End of the Input File
+	close(l_pDecompressor->iPipe[1]);
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *   Decompress the Input File if it starts as a gzip or zstd File : the
+ *   Records are then read from a Pipe filled by a Thread (io_File_Ptr)
+ * =============================================================================
+*/
+int OpenInputDecompressor (Decompressor *o_pDecompressor, FILE **io_File_Ptr)
+{
+	int		l_iFirstByte	= 0;
+	int		l_iError		= 0;
+
+	memset(o_pDecompressor, '\0', sizeof(Decompressor));
+	l_iFirstByte = fgetc(*io_File_Ptr);
+	if (l_iFirstByte == EOF)
+	{
+		clearerr(*io_File_Ptr);
+		return EXIT_OK;
+	}
+	ungetc(l_iFirstByte, *io_File_Ptr);
+	if ((l_iFirstByte != 0x1F) && (l_iFirstByte != 0x28))
+	{
+		return EXIT_OK;
+	}
+
+	if (pipe(o_pDecompressor->iPipe) != 0)
+	{
+		printf("Error %d : '%s' occurs when creating the Pipe of the Input File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+#ifdef F_SETPIPE_SZ
+	fcntl(o_pDecompressor->iPipe[1], F_SETPIPE_SZ, COMPRESSION_CHUNK_SIZE);
+#endif
+	o_pDecompressor->pSource = *io_File_Ptr;
+	o_pDecompressor->pReadBuffer = (char *) malloc(COMPRESSION_CHUNK_SIZE);
+	*io_File_Ptr = fdopen(o_pDecompressor->iPipe[0], "r");
+	if ((*io_File_Ptr == NULL) || (o_pDecompressor->pReadBuffer == NULL))
+	{
+		printf("Error %d : '%s' occurs when opening the Pipe of the Input File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+	setvbuf(*io_File_Ptr, o_pDecompressor->pReadBuffer, _IOFBF, COMPRESSION_CHUNK_SIZE);
+	l_iError = pthread_create(&o_pDecompressor->stThread, NULL, RunInputDecompressor, o_pDecompressor);
+	if (l_iError != 0)
+	{
+		printf("Error %d : '%s' occurs when starting the Input Decompression Thread\n", l_iError, strerror(l_iError));
+		return EXIT_ERR;
+	}
+	o_pDecompressor->iStarted = TRUE;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   End decompressing the Input File, once its Pipe was read and closed
+ *   Returns EXIT_ERR if the Input File could not be decompressed to its End
+ * =============================================================================
+*/
+int CloseInputDecompressor (Decompressor *io_pDecompressor)
+{
+	if (! io_pDecompressor->iStarted)
+	{
+		return EXIT_OK;
+	}
+	pthread_join(io_pDecompressor->stThread, NULL);
+	io_pDecompressor->iStarted = FALSE;
+	fclose(io_pDecompressor->pSource);
+	free(io_pDecompressor->pReadBuffer);
+	if (io_pDecompressor->iFormat != COMPRESSION_NONE)
+	{
+		printf("Input Decompressed (%s) ..... : %lld Bytes from %lld Bytes\n", tabCompressionName[io_pDecompressor->iFormat], io_pDecompressor->llBytesOut, io_pDecompressor->llBytesIn);
+	}
+	if (io_pDecompressor->iError == ENOTSUP)
+	{
+		printf("Error : the Input File is compressed by %s, not built in the Program\n", tabCompressionName[io_pDecompressor->iFormat]);
+		return EXIT_ERR;
+	}
+	if (io_pDecompressor->iError == -1)
+	{
+		printf("Error : the compressed Input File is corrupted or truncated\n");
+		return EXIT_ERR;
+	}
+	if (io_pDecompressor->iError != 0)
+	{
+		printf("Error %d : '%s' occurs when decompressing Input File\n", io_pDecompressor->iError, strerror(io_pDecompressor->iError));
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Depth of the asynchronous I/O Rings, given by IO_RING_DEPTH_VARIABLE
+ *   0 : the Input File is mapped and the Output File written synchronously
+ * =============================================================================
+*/
+int EvaluateIORingDepth ()
+{
+	char	*l_strDepth		= getenv(IO_RING_DEPTH_VARIABLE);
+	int		l_iDepth		= IO_RING_DEFAULT_DEPTH;
+
+	if (l_strDepth != NULL)
+	{
+		l_iDepth = atoi(l_strDepth);
+	}
+	if (l_iDepth <= 0)
+	{
+		return 0;
+	}
+	// One Buffer is handled while the other ones are read or written
+	if (l_iDepth < IO_RING_MIN_DEPTH)
+	{
+		return IO_RING_MIN_DEPTH;
+	}
+	return (l_iDepth > IO_RING_MAX_DEPTH) ? IO_RING_MAX_DEPTH : l_iDepth;
+}
+
+/*
+ * =============================================================================
+ *   Size of the asynchronous I/O Buffers, given by IO_BUFFER_SIZE_VARIABLE
+ * =============================================================================
+*/
+long EvaluateIOBufferSize ()
+{
+	char	*l_strSize		= getenv(IO_BUFFER_SIZE_VARIABLE);
+	long	l_lSizeMB		= IO_BUFFER_DEFAULT_MB;
+
+	if ((l_strSize != NULL) && (atol(l_strSize) > 0))
+	{
+		l_lSizeMB = atol(l_strSize);
+	}
+	return l_lSizeMB * 1024 * 1024;
+}
+
+/*
+ * =============================================================================
+ *   Read or write the whole Request, in the Worker Thread of the I/O Ring
+ * =============================================================================
+*/
+void HandleIORequest (IORing *io_pRing, IORequest *io_pRequest)
+{
+	long	l_lDone		= 0;
+
+	if ((io_pRing->pCompressor != NULL) && (io_pRequest->iOpcode == IO_REQUEST_WRITE))
+	{
+		if (CompressAndWrite (io_pRing->pCompressor, io_pRequest->iFile, io_pRequest->pBuffer, io_pRequest->lLength, FALSE) == EXIT_ERR)
+		{
+			io_pRequest->iError = errno;
+			return;
+		}
+		io_pRequest->lDone = io_pRequest->lLength;
+	}
+
+	while (io_pRequest->lDone < io_pRequest->lLength)
+	{
+		if (io_pRequest->llOffset < 0)
+		{
+			// Request at the current Position of a Pipe
+			l_lDone = (io_pRequest->iOpcode == IO_REQUEST_READ) ? read(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone)
+																 : write(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone);
+		}
+		else if (io_pRequest->iOpcode == IO_REQUEST_READ)
+		{
+			l_lDone = pread(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone, io_pRequest->llOffset + io_pRequest->lDone);
+		}
+		else
+		{
+			l_lDone = pwrite(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone, io_pRequest->llOffset + io_pRequest->lDone);
+		}
+		if ((l_lDone < 0) && (errno != EINTR))
+		{
+			io_pRequest->iError = errno;
+			return;
+		}
+		if (l_lDone == 0)
+		{
+			// End of File
+			return;
+		}
+		if (l_lDone > 0)
+		{
+			io_pRequest->lDone += l_lDone;
+		}
+	}
+}
+
+/*
+ * =============================================================================
+ *   Worker Thread of an I/O Ring without io_uring : Requests are handled in
+ *   the Order they were submitted
+ * =============================================================================
+*/
+void *RunIOWorker (void *io_pRing)
+{
+	IORing		*l_pRing		= (IORing *) io_pRing;
+	IORequest	*l_pRequest		= NULL;
+
+	pthread_mutex_lock(&l_pRing->stMutex);
+	while (TRUE)
+	{
+		while ((l_pRing->iQueueCount == 0) && (! l_pRing->iStop))
+		{
+			pthread_cond_wait(&l_pRing->stQueued, &l_pRing->stMutex);
+		}
+		if (l_pRing->iQueueCount == 0)
+		{
+			break;
+		}
+		l_pRequest = &l_pRing->stRequest[l_pRing->iQueue[l_pRing->iQueueHead]];
+		pthread_mutex_unlock(&l_pRing->stMutex);
+
+		HandleIORequest (l_pRing, l_pRequest);
+
+		pthread_mutex_lock(&l_pRing->stMutex);
+		l_pRequest->iState = IO_REQUEST_DONE;
+		l_pRing->iQueueHead = (l_pRing->iQueueHead + 1) % IO_RING_MAX_DEPTH;
+		l_pRing->iQueueCount--;
+		pthread_cond_broadcast(&l_pRing->stDone);
+	}
+	pthread_mutex_unlock(&l_pRing->stMutex);
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *   Submit i_uiToSubmit Requests queued in the io_uring and wait for
+ *   i_uiMinComplete Completions
+ * =============================================================================
+*/
+int EnterIOUring (IORing *io_pRing, unsigned int i_uiToSubmit, unsigned int i_uiMinComplete)
+{
+#ifdef IO_URING_SUPPORTED
+	return syscall(__NR_io_uring_enter, io_pRing->iUring, i_uiToSubmit, i_uiMinComplete, (i_uiMinComplete > 0) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Queue the (remaining part of the) Request i_iSlot in the io_uring
+ * =============================================================================
+*/
+int QueueIOUringRequest (IORing *io_pRing, int i_iSlot)
+{
+#ifdef IO_URING_SUPPORTED
+	IORequest			*l_pRequest		= &io_pRing->stRequest[i_iSlot];
+	struct io_uring_sqe	*l_pEntry		= NULL;
+	unsigned int		l_uiTail		= *io_pRing->puiSQTail;
+	unsigned int		l_uiIdx			= l_uiTail & io_pRing->uiSQMask;
+
+	l_pEntry = &((struct io_uring_sqe *) io_pRing->pSQEntries)[l_uiIdx];
+	memset(l_pEntry, '\0', sizeof(struct io_uring_sqe));
+	l_pEntry->opcode    = (l_pRequest->iOpcode == IO_REQUEST_READ) ? IORING_OP_READ : IORING_OP_WRITE;
+	l_pEntry->fd        = l_pRequest->iFile;
+	l_pEntry->addr      = (unsigned long long) (l_pRequest->pBuffer + l_pRequest->lDone);
+	l_pEntry->len       = l_pRequest->lLength - l_pRequest->lDone;
+	l_pEntry->off       = l_pRequest->llOffset + l_pRequest->lDone;
+	l_pEntry->user_data = i_iSlot;
+	io_pRing->puiSQArray[l_uiIdx] = l_uiIdx;
+	__atomic_store_n(io_pRing->puiSQTail, l_uiTail + 1, __ATOMIC_RELEASE);
+
+	while (EnterIOUring (io_pRing, 1, 0) < 0)
+	{
+		if (errno != EINTR)
+		{
+			return EXIT_ERR;
+		}
+	}
+#endif
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Handle the Completions of the io_uring : a short Read or Write is queued
+ *   again for its remaining part
+ * =============================================================================
+*/
+void ReapIOUringCompletions (IORing *io_pRing)
+{
+#ifdef IO_URING_SUPPORTED
+	struct io_uring_cqe	*l_pCompletion	= NULL;
+	IORequest			*l_pRequest		= NULL;
+	unsigned int		l_uiHead		= *io_pRing->puiCQHead;
+	unsigned int		l_uiTail		= __atomic_load_n(io_pRing->puiCQTail, __ATOMIC_ACQUIRE);
+
+	while (l_uiHead != l_uiTail)
+	{
+		l_pCompletion = &((struct io_uring_cqe *) io_pRing->pCQEntries)[l_uiHead & io_pRing->uiCQMask];
+		l_pRequest = &io_pRing->stRequest[l_pCompletion->user_data];
+		if ((l_pCompletion->res == -EINTR) || (l_pCompletion->res == -EAGAIN))
+		{
+			l_pRequest->iState = IO_REQUEST_QUEUED;
+		}
+		else if (l_pCompletion->res < 0)
+		{
+			l_pRequest->iError = -l_pCompletion->res;
+			l_pRequest->iState = IO_REQUEST_DONE;
+		}
+		else
+		{
+			l_pRequest->lDone += l_pCompletion->res;
+			l_pRequest->iState = ((l_pCompletion->res == 0) || (l_pRequest->lDone >= l_pRequest->lLength)) ? IO_REQUEST_DONE : IO_REQUEST_QUEUED;
+		}
+		if ((l_pRequest->iState == IO_REQUEST_QUEUED) && (QueueIOUringRequest (io_pRing, l_pCompletion->user_data) == EXIT_ERR))
+		{
+			l_pRequest->iError = errno;
+			l_pRequest->iState = IO_REQUEST_DONE;
+		}
+		l_uiHead++;
+		__atomic_store_n(io_pRing->puiCQHead, l_uiHead, __ATOMIC_RELEASE);
+	}
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Set up the io_uring of the I/O Ring. Returns EXIT_ERR if the Kernel does
+ *   not provide it : the Requests are then handled by a Worker Thread.
+ * =============================================================================
+*/
+int SetUpIOUring (IORing *io_pRing)
+{
+#ifdef IO_URING_SUPPORTED
+	struct io_uring_params	l_stParams;
+
+	memset(&l_stParams, '\0', sizeof(l_stParams));
+	io_pRing->iUring = syscall(__NR_io_uring_setup, io_pRing->iDepth, &l_stParams);
+	if (io_pRing->iUring < 0)
+	{
+		io_pRing->iUring = -1;
+		return EXIT_ERR;
+	}
+	io_pRing->lSQRingSize = l_stParams.sq_off.array + l_stParams.sq_entries * sizeof(unsigned int);
+	io_pRing->lCQRingSize = l_stParams.cq_off.cqes + l_stParams.cq_entries * sizeof(struct io_uring_cqe);
+	io_pRing->lSQEntriesSize = l_stParams.sq_entries * sizeof(struct io_uring_sqe);
+	io_pRing->pSQRing = (char *) mmap(NULL, io_pRing->lSQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io_pRing->iUring, IORING_OFF_SQ_RING);
+	io_pRing->pCQRing = (char *) mmap(NULL, io_pRing->lCQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io_pRing->iUring, IORING_OFF_CQ_RING);
+	io_pRing->pSQEntries = mmap(NULL, io_pRing->lSQEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io_pRing->iUring, IORING_OFF_SQES);
+	if ((io_pRing->pSQRing == MAP_FAILED) || (io_pRing->pCQRing == MAP_FAILED) || (io_pRing->pSQEntries == MAP_FAILED))
+	{
+		if (io_pRing->pSQRing != MAP_FAILED)
+		{
+			munmap(io_pRing->pSQRing, io_pRing->lSQRingSize);
+		}
+		if (io_pRing->pCQRing != MAP_FAILED)
+		{
+			munmap(io_pRing->pCQRing, io_pRing->lCQRingSize);
+		}
+		if (io_pRing->pSQEntries != MAP_FAILED)
+		{
+			munmap(io_pRing->pSQEntries, io_pRing->lSQEntriesSize);
+		}
+		io_pRing->pSQRing = NULL;
+		close(io_pRing->iUring);
+		io_pRing->iUring = -1;
+		return EXIT_ERR;
+	}
+	io_pRing->puiSQTail  = (unsigned int *) (io_pRing->pSQRing + l_stParams.sq_off.tail);
+	io_pRing->puiSQArray = (unsigned int *) (io_pRing->pSQRing + l_stParams.sq_off.array);
+	io_pRing->uiSQMask   = *(unsigned int *) (io_pRing->pSQRing + l_stParams.sq_off.ring_mask);
+	io_pRing->puiCQHead  = (unsigned int *) (io_pRing->pCQRing + l_stParams.cq_off.head);
+	io_pRing->puiCQTail  = (unsigned int *) (io_pRing->pCQRing + l_stParams.cq_off.tail);
+	io_pRing->uiCQMask   = *(unsigned int *) (io_pRing->pCQRing + l_stParams.cq_off.ring_mask);
+	io_pRing->pCQEntries = io_pRing->pCQRing + l_stParams.cq_off.cqes;
+	return EXIT_OK;
+#else
+	io_pRing->iUring = -1;
+	return EXIT_ERR;
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Start an I/O Ring of i_iDepth Requests : io_uring if the Kernel provides
+ *   it and IO_URING_OFF_VARIABLE is not set, a Worker Thread otherwise.
+ *   The Requests of a Pipe (i_iStream) are handled by the Worker Thread,
+ *   io_uring not keeping their Order.
+ * =============================================================================
+*/
+int StartIORing (IORing *o_pRing, int i_iDepth, int i_iStream)
+{
+	int		l_iError	= 0;
+
+	memset(o_pRing, '\0', sizeof(IORing));
+	o_pRing->iDepth = i_iDepth;
+	o_pRing->iUring = -1;
+	if ((! i_iStream) && (getenv(IO_URING_OFF_VARIABLE) == NULL) && (SetUpIOUring (o_pRing) == EXIT_OK))
+	{
+		return EXIT_OK;
+	}
+	pthread_mutex_init(&o_pRing->stMutex, NULL);
+	pthread_cond_init(&o_pRing->stQueued, NULL);
+	pthread_cond_init(&o_pRing->stDone, NULL);
+	l_iError = pthread_create(&o_pRing->stWorker, NULL, RunIOWorker, o_pRing);
+	if (l_iError != 0)
+	{
+		printf("Error %d : '%s' occurs when starting the I/O Worker Thread\n", l_iError, strerror(l_iError));
+		o_pRing->iDepth = 0;
+		return EXIT_ERR;
+	}
+	o_pRing->iWorkerStarted = TRUE;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Submit the Read or the Write of i_lLength Bytes at i_llOffset in the Slot
+ *   i_iSlot of the I/O Ring. The Slot must have been waited for.
+ * =============================================================================
+*/
+int SubmitIORequest (IORing *io_pRing, int i_iSlot, int i_iFile, int i_iOpcode, char *i_pBuffer, long i_lLength, long long i_llOffset)
+{
+	IORequest	*l_pRequest		= &io_pRing->stRequest[i_iSlot];
+
+	l_pRequest->iFile    = i_iFile;
+	l_pRequest->iOpcode  = i_iOpcode;
+	l_pRequest->pBuffer  = i_pBuffer;
+	l_pRequest->lLength  = i_lLength;
+	l_pRequest->llOffset = i_llOffset;
+	l_pRequest->lDone    = 0;
+	l_pRequest->iError   = 0;
+	if (io_pRing->iUring >= 0)
+	{
+		l_pRequest->iState = IO_REQUEST_QUEUED;
+		if (QueueIOUringRequest (io_pRing, i_iSlot) == EXIT_ERR)
+		{
+			l_pRequest->iError = errno;
+			l_pRequest->iState = IO_REQUEST_DONE;
+		}
+		return EXIT_OK;
+	}
+	pthread_mutex_lock(&io_pRing->stMutex);
+	l_pRequest->iState = IO_REQUEST_QUEUED;
+	io_pRing->iQueue[(io_pRing->iQueueHead + io_pRing->iQueueCount) % IO_RING_MAX_DEPTH] = i_iSlot;
+	io_pRing->iQueueCount++;
+	pthread_cond_signal(&io_pRing->stQueued);
+	pthread_mutex_unlock(&io_pRing->stMutex);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Wait for the Request of the Slot i_iSlot of the I/O Ring
+ *   Returns the Number of Bytes read or written (0 if the Slot is free), or
+ *   -1 with errno set if the Request failed
+ * =============================================================================
+*/
+long WaitIORequest (IORing *io_pRing, int i_iSlot)
+{
+	IORequest	*l_pRequest		= &io_pRing->stRequest[i_iSlot];
+
+	if (l_pRequest->iState == IO_REQUEST_FREE)
+	{
+		return 0;
+	}
+	if (io_pRing->iUring >= 0)
+	{
+		ReapIOUringCompletions (io_pRing);
+		while (l_pRequest->iState != IO_REQUEST_DONE)
+		{
+			if ((EnterIOUring (io_pRing, 0, 1) < 0) && (errno != EINTR))
+			{
+				l_pRequest->iError = errno;
+				l_pRequest->iState = IO_REQUEST_DONE;
+			}
+			ReapIOUringCompletions (io_pRing);
+		}
+	}
+	else
+	{
+		pthread_mutex_lock(&io_pRing->stMutex);
+		while (l_pRequest->iState != IO_REQUEST_DONE)
+		{
+			pthread_cond_wait(&io_pRing->stDone, &io_pRing->stMutex);
+		}
+		pthread_mutex_unlock(&io_pRing->stMutex);
+	}
+	l_pRequest->iState = IO_REQUEST_FREE;
+	if (l_pRequest->iError != 0)
+	{
+		errno = l_pRequest->iError;
+		return -1;
+	}
+	return l_pRequest->lDone;
+}
+
+/*
+ * =============================================================================
+ *   Stop an I/O Ring once each of its Requests was waited for
+ * =============================================================================
+*/
+void StopIORing (IORing *io_pRing)
+{
+	if (io_pRing->iWorkerStarted)
+	{
+		pthread_mutex_lock(&io_pRing->stMutex);
+		io_pRing->iStop = TRUE;
+		pthread_cond_signal(&io_pRing->stQueued);
+		pthread_mutex_unlock(&io_pRing->stMutex);
+		pthread_join(io_pRing->stWorker, NULL);
+		io_pRing->iWorkerStarted = FALSE;
+	}
+	if (io_pRing->pSQRing != NULL)
+	{
+		munmap(io_pRing->pSQRing, io_pRing->lSQRingSize);
+		munmap(io_pRing->pCQRing, io_pRing->lCQRingSize);
+		munmap(io_pRing->pSQEntries, io_pRing->lSQEntriesSize);
+		close(io_pRing->iUring);
+		io_pRing->pSQRing = NULL;
+	}
+	io_pRing->iDepth = 0;
+}
+
+/*
+ * =============================================================================
+ *                     How the I/O Ring handles its Requests
+ * =============================================================================
+*/
+const char *DescribeIORing (const IORing *i_pRing)
+{
+	if (i_pRing->iDepth == 0)
+	{
+		return "synchronous";
+	}
+	return (i_pRing->iUring >= 0) ? "io_uring" : "Worker Thread";
+}
+
+/*
+ * =============================================================================
+ *   Copy in Input_Record_Struct the last Record read in place, as fgets would
+ *   have left it : a short Record is completed by what the former ones left.
+ * =============================================================================
+*/
+void KeepPendingInputRecord (InputMap *io_pMap)
+{
+	if (io_pMap->pPendingRecord != NULL)
+	{
+		memcpy(Input_Record_Struct.Input_Record, io_pMap->pPendingRecord, io_pMap->lPendingLength);
+		Input_Record_Struct.Input_Record[io_pMap->lPendingLength] = '\0';
+		io_pMap->pPendingRecord = NULL;
+		io_pMap->lPendingLength = 0;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Read ahead in the Buffer i_iSlot the next Part of the Input File
+ * =============================================================================
+*/
+void SubmitInputRead (InputMap *io_pMap, int i_iSlot)
+{
+	long	l_lLength	= io_pMap->lBufferSize;
+
+	if (io_pMap->llReadOffset < io_pMap->llFileSize)
+	{
+		if (io_pMap->llReadOffset + l_lLength > io_pMap->llFileSize)
+		{
+			l_lLength = io_pMap->llFileSize - io_pMap->llReadOffset;
+		}
+		SubmitIORequest (&io_pMap->stRing, i_iSlot, io_pMap->iFile, IO_REQUEST_READ, INPUT_BUFFER(io_pMap, i_iSlot) + MAX_INPUT_REC_LENGTH, l_lLength, io_pMap->llReadOffset);
+		io_pMap->llReadOffset += l_lLength;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Move the Window of the Input File to i_llOffset : the Window is mapped
+ *   from the Page of i_llOffset, or is the next Buffer read ahead by the Ring
+ * =============================================================================
+*/
+int MapInputWindow (InputMap *io_pMap, long long i_llOffset)
+{
+	long long	l_llPageSize	= sysconf(_SC_PAGESIZE);
+	char		*l_pWindow		= NULL;
+	long		l_lTail			= 0;
+	long		l_lRead			= 0;
+	int			l_iPrevious		= io_pMap->iBuffer;
+
+	KeepPendingInputRecord (io_pMap);
+	if (io_pMap->stRing.iDepth > 0)
+	{
+		if (io_pMap->pWindow != NULL)
+		{
+			l_lTail = io_pMap->llWindowOffset + io_pMap->lWindowSize - i_llOffset;
+		}
+		io_pMap->iBuffer = (io_pMap->iBuffer + 1) % io_pMap->stRing.iDepth;
+		l_lRead = WaitIORequest (&io_pMap->stRing, io_pMap->iBuffer);
+		if (l_lRead < 0)
+		{
+			printf("Error %d : '%s' occurs when reading Input File at Offset %lld\n", errno, strerror(errno), i_llOffset + l_lTail);
+			return EXIT_ERR;
+		}
+		// The Record going beyond the current Window is completed before the next Buffer
+		l_pWindow = INPUT_BUFFER(io_pMap, io_pMap->iBuffer) + MAX_INPUT_REC_LENGTH - l_lTail;
+		if (io_pMap->pWindow != NULL)
+		{
+			memcpy(l_pWindow, io_pMap->pWindow + (i_llOffset - io_pMap->llWindowOffset), l_lTail);
+			SubmitInputRead (io_pMap, l_iPrevious);
+		}
+		io_pMap->pWindow        = l_pWindow;
+		io_pMap->llWindowOffset = i_llOffset;
+		io_pMap->lWindowSize    = l_lTail + l_lRead;
+		return EXIT_OK;
+	}
+
+	if (io_pMap->pWindow != NULL)
+	{
+		munmap(io_pMap->pWindow, io_pMap->lWindowSize);
+		io_pMap->pWindow = NULL;
+	}
+	io_pMap->llWindowOffset = i_llOffset / l_llPageSize * l_llPageSize;
+	io_pMap->lWindowSize    = INPUT_MAP_WINDOW_SIZE;
+	if (io_pMap->llWindowOffset + io_pMap->lWindowSize > io_pMap->llFileSize)
+	{
+		io_pMap->lWindowSize = io_pMap->llFileSize - io_pMap->llWindowOffset;
+	}
+	l_pWindow = (char *) mmap(NULL, io_pMap->lWindowSize, PROT_READ, MAP_PRIVATE, io_pMap->iFile, io_pMap->llWindowOffset);
+	if (l_pWindow == MAP_FAILED)
+	{
+		printf("Error %d : '%s' occurs when mapping Input File at Offset %lld\n", errno, strerror(errno), io_pMap->llWindowOffset);
+		return EXIT_ERR;
+	}
+	madvise(l_pWindow, io_pMap->lWindowSize, MADV_SEQUENTIAL);
+	io_pMap->pWindow = l_pWindow;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Masks of the '\n' and '\0' of i_lBlocks Blocks of INPUT_SCAN_BLOCK_SIZE
+ *   Bytes : the Bit n of a Mask is set if the Byte n of its Block is found.
+ *   The same Masks are given by the SSE2, AVX2 and AVX-512 Scanners below.
+ * =============================================================================
+*/
+void ScanInputBlocksScalar (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	unsigned long long	l_ullWord		= 0;
+	unsigned long long	l_ullNewLine	= 0;
+	unsigned long long	l_ullNul		= 0;
+	long				l_lBlock		= 0;
+	int					l_iIdx			= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_ullNewLine = 0;
+		l_ullNul     = 0;
+		for (l_iIdx = 0; l_iIdx < INPUT_SCAN_BLOCK_SIZE; l_iIdx += 8)
+		{
+			// 8 Bytes at once : a '\n' is a '\0' once the Word is xored with '\n' Bytes
+			memcpy(&l_ullWord, i_pData + l_iIdx, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			l_ullWord = __builtin_bswap64(l_ullWord);
+#endif
+			l_ullNewLine |= INPUT_SCAN_ZERO_BYTES(l_ullWord ^ 0x0A0A0A0A0A0A0A0AULL) << l_iIdx;
+			l_ullNul     |= INPUT_SCAN_ZERO_BYTES(l_ullWord) << l_iIdx;
+		}
+		o_pullNewLine[l_lBlock] = l_ullNewLine;
+		o_pullNul[l_lBlock]     = l_ullNul;
+	}
+}
+
+#ifdef __SSE2__
+void ScanInputBlocksSSE2 (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	__m128i				l_NewLine		= _mm_set1_epi8('\n');
+	__m128i				l_Nul			= _mm_setzero_si128();
+	__m128i				l_Data;
+	unsigned long long	l_ullNewLine	= 0;
+	unsigned long long	l_ullNul		= 0;
+	long				l_lBlock		= 0;
+	int					l_iIdx			= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_ullNewLine = 0;
+		l_ullNul     = 0;
+		for (l_iIdx = 0; l_iIdx < INPUT_SCAN_BLOCK_SIZE; l_iIdx += 16)
+		{
+			l_Data = _mm_loadu_si128((const __m128i *) (i_pData + l_iIdx));
+			l_ullNewLine |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Data, l_NewLine)) << l_iIdx;
+			l_ullNul     |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Data, l_Nul)) << l_iIdx;
+		}
+		o_pullNewLine[l_lBlock] = l_ullNewLine;
+		o_pullNul[l_lBlock]     = l_ullNul;
+	}
+}
+#endif
+
+#ifdef INPUT_SCAN_DISPATCHED
+__attribute__((target("avx2")))
+void ScanInputBlocksAVX2 (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	__m256i				l_NewLine		= _mm256_set1_epi8('\n');
+	__m256i				l_Nul			= _mm256_setzero_si256();
+	__m256i				l_Low;
+	__m256i				l_High;
+	long				l_lBlock		= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_Low  = _mm256_loadu_si256((const __m256i *) i_pData);
+		l_High = _mm256_loadu_si256((const __m256i *) (i_pData + 32));
+		o_pullNewLine[l_lBlock] = (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_Low, l_NewLine))
+								| (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_High, l_NewLine)) << 32;
+		o_pullNul[l_lBlock]     = (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_Low, l_Nul))
+								| (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_High, l_Nul)) << 32;
+	}
+}
+
+__attribute__((target("avx512bw")))
+void ScanInputBlocksAVX512 (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	__m512i				l_NewLine		= _mm512_set1_epi8('\n');
+	__m512i				l_Nul			= _mm512_setzero_si512();
+	__m512i				l_Data;
+	long				l_lBlock		= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_Data = _mm512_loadu_si512((const void *) i_pData);
+		o_pullNewLine[l_lBlock] = _mm512_cmpeq_epi8_mask(l_Data, l_NewLine);
+		o_pullNul[l_lBlock]     = _mm512_cmpeq_epi8_mask(l_Data, l_Nul);
+	}
+}
+#endif
+
+/*
+ * =============================================================================
+ *   Choose the widest Scanner supported by the Processor, or the one named by
+ *   INPUT_SCAN_VARIABLE if it is narrower
+ * =============================================================================
+*/
+void SelectInputScanner (InputMap *io_pMap)
+{
+	const char	*l_strScanner	= getenv(INPUT_SCAN_VARIABLE);
+
+	io_pMap->pScanBlocks = ScanInputBlocksScalar;
+	if ((l_strScanner != NULL) && (strcmp(l_strScanner, "scalar") == 0))
+	{
+		return;
+	}
+#ifdef __SSE2__
+	io_pMap->pScanBlocks = ScanInputBlocksSSE2;
+	if ((l_strScanner != NULL) && (strcmp(l_strScanner, "sse2") == 0))
+	{
+		return;
+	}
+#endif
+#ifdef INPUT_SCAN_DISPATCHED
+	__builtin_cpu_init();
+	if (! __builtin_cpu_supports("avx2"))
+	{
+		return;
+	}
+	io_pMap->pScanBlocks = ScanInputBlocksAVX2;
+	if (((l_strScanner != NULL) && (strcmp(l_strScanner, "avx2") == 0)) || (! __builtin_cpu_supports("avx512bw")))
+	{
+		return;
+	}
+	io_pMap->pScanBlocks = ScanInputBlocksAVX512;
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Position of the first Bit set in i_pullMasks from i_lFrom, i_lTo if none
+ *   is set before i_lTo
+ * =============================================================================
+*/
+long FindInputScanBit (const unsigned long long *i_pullMasks, long i_lFrom, long i_lTo)
+{
+	long				l_lBlock	= i_lFrom / INPUT_SCAN_BLOCK_SIZE;
+	unsigned long long	l_ullMask	= i_pullMasks[l_lBlock] & (~0ULL << (i_lFrom % INPUT_SCAN_BLOCK_SIZE));
+	long				l_lPosit	= 0;
+
+	while ((l_ullMask == 0) && ((l_lBlock + 1) * INPUT_SCAN_BLOCK_SIZE < i_lTo))
+	{
+		l_lBlock++;
+		l_ullMask = i_pullMasks[l_lBlock];
+	}
+	if (l_ullMask == 0)
+	{
+		return i_lTo;
+	}
+	l_lPosit = l_lBlock * INPUT_SCAN_BLOCK_SIZE + __builtin_ctzll(l_ullMask);
+	return (l_lPosit < i_lTo) ? l_lPosit : i_lTo;
+}
+
+/*
+ * =============================================================================
+ *   Find in one pass the next Records of the Window, from llRecordOffset : the
+ *   Bytes read and the Length given by strlen of each one are those fgets
+ *   would give. The Records found are those read before the Window moves, up
+ *   to INPUT_SCAN_RECORDS and as far as INPUT_SCAN_BLOCKS Blocks are scanned.
+ * =============================================================================
+*/
+void ScanInputRecords (InputMap *io_pMap)
+{
+	const char	*l_pData		= io_pMap->pWindow + (io_pMap->llRecordOffset - io_pMap->llWindowOffset);
+	long long	l_llWindowEnd	= io_pMap->llWindowOffset + io_pMap->lWindowSize;
+	long		l_lScanned		= l_llWindowEnd - io_pMap->llRecordOffset;
+	long		l_lBlocks		= 0;
+	long		l_lStart		= 0;
+	long		l_lChunk		= 0;
+	long		l_lEnd			= 0;
+	char		l_strTail[INPUT_SCAN_BLOCK_SIZE];
+
+	if (l_lScanned > INPUT_SCAN_BLOCKS * INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_lScanned = INPUT_SCAN_BLOCKS * INPUT_SCAN_BLOCK_SIZE;
+	}
+	l_lBlocks = l_lScanned / INPUT_SCAN_BLOCK_SIZE;
+	io_pMap->pScanBlocks (l_pData, l_lBlocks, io_pMap->pullNewLineMasks, io_pMap->pullNulMasks);
+	if (l_lScanned % INPUT_SCAN_BLOCK_SIZE > 0)
+	{
+		// The last Bytes are scanned apart, not to read beyond the Window
+		memset(l_strTail, '\0', INPUT_SCAN_BLOCK_SIZE);
+		memcpy(l_strTail, l_pData + l_lBlocks * INPUT_SCAN_BLOCK_SIZE, l_lScanned % INPUT_SCAN_BLOCK_SIZE);
+		io_pMap->pScanBlocks (l_strTail, 1, io_pMap->pullNewLineMasks + l_lBlocks, io_pMap->pullNulMasks + l_lBlocks);
+	}
+
+	io_pMap->lScanRecords = 0;
+	io_pMap->lScanNext    = 0;
+	while ((io_pMap->lScanRecords < INPUT_SCAN_RECORDS) && (io_pMap->llRecordOffset + l_lStart < io_pMap->llFileSize))
+	{
+		l_lChunk = MAX_INPUT_REC_LENGTH - 1;
+		if (io_pMap->llRecordOffset + l_lStart + l_lChunk > io_pMap->llFileSize)
+		{
+			l_lChunk = io_pMap->llFileSize - io_pMap->llRecordOffset - l_lStart;
+		}
+		// The Window moves before a Record going beyond it
+		if (io_pMap->llRecordOffset + l_lStart + l_lChunk > l_llWindowEnd)
+		{
+			break;
+		}
+		l_lEnd = FindInputScanBit (io_pMap->pullNewLineMasks, l_lStart, (l_lStart + l_lChunk < l_lScanned) ? l_lStart + l_lChunk : l_lScanned);
+		if (l_lEnd < l_lStart + l_lChunk)
+		{
+			if (l_lEnd == l_lScanned)
+			{
+				// The End of the Record is beyond the scanned Bytes : it is found by the next Scan
+				break;
+			}
+			l_lChunk = l_lEnd - l_lStart + 1;
+		}
+		io_pMap->plScanOffset[io_pMap->lScanRecords] = l_pData + l_lStart - io_pMap->pWindow;
+		io_pMap->plScanChunk[io_pMap->lScanRecords]  = l_lChunk;
+		io_pMap->plScanLength[io_pMap->lScanRecords] = FindInputScanBit (io_pMap->pullNulMasks, l_lStart, l_lStart + l_lChunk) - l_lStart;
+		io_pMap->lScanRecords++;
+		l_lStart += l_lChunk;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Map the Input File, or read it ahead through an I/O Ring unless
+ *   IO_RING_DEPTH_VARIABLE is 0. Returns EXIT_ERR if it cannot be mapped (empty
+ *   File, pipe, INPUT_STDIO_VARIABLE set) : the Records are then read with fgets.
+ * =============================================================================
+*/
+int OpenInputMap (InputMap *o_pMap, FILE *i_File_Ptr)
+{
+	struct stat	l_InputFile_Stat;
+	int			l_iIdx			= 0;
+	int			l_iDepth		= EvaluateIORingDepth ();
+
+	memset(o_pMap, '\0', sizeof(InputMap));
+	o_pMap->iFile = fileno(i_File_Ptr);
+	// Create_Output_Record reads the Input Record up to lInputRecordExtent, even if it is read with fgets
+	lInputRecordExtent = 0;
+	while (l_iIdx < iFieldPlanNumber)
+	{
+		if ((tabFieldPlan[l_iIdx].iFieldStartPosInput >= 0) && (tabFieldPlan[l_iIdx].iFieldLengthInput >= 0)
+		&&  (tabFieldPlan[l_iIdx].iFieldStartPosInput + tabFieldPlan[l_iIdx].iFieldLengthInput > lInputRecordExtent))
+		{
+			lInputRecordExtent = tabFieldPlan[l_iIdx].iFieldStartPosInput + tabFieldPlan[l_iIdx].iFieldLengthInput;
+		}
+		l_iIdx++;
+	}
+
+	if ((getenv(INPUT_STDIO_VARIABLE) != NULL)
+	||  (fstat(o_pMap->iFile, &l_InputFile_Stat) != 0)
+	||  (! S_ISREG(l_InputFile_Stat.st_mode))
+	||  (l_InputFile_Stat.st_size == 0))
+	{
+		return EXIT_ERR;
+	}
+	o_pMap->llFileSize = l_InputFile_Stat.st_size;
+
+	// One Mask of each Kind more for the last Bytes of the Window
+	o_pMap->pullNewLineMasks = (unsigned long long *) malloc(2 * (INPUT_SCAN_BLOCKS + 1) * sizeof(unsigned long long));
+	o_pMap->plScanOffset     = (long *) malloc(3 * INPUT_SCAN_RECORDS * sizeof(long));
+	if ((o_pMap->pullNewLineMasks == NULL) || (o_pMap->plScanOffset == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating the Scanner of the Input File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+	o_pMap->pullNulMasks = o_pMap->pullNewLineMasks + INPUT_SCAN_BLOCKS + 1;
+	o_pMap->plScanChunk  = o_pMap->plScanOffset + INPUT_SCAN_RECORDS;
+	o_pMap->plScanLength = o_pMap->plScanChunk + INPUT_SCAN_RECORDS;
+	SelectInputScanner (o_pMap);
+
+	if (l_iDepth > 0)
+	{
+		o_pMap->lBufferSize = EvaluateIOBufferSize ();
+		o_pMap->pBuffers = (char *) malloc(l_iDepth * (MAX_INPUT_REC_LENGTH + o_pMap->lBufferSize));
+		if (o_pMap->pBuffers == NULL)
+		{
+			printf("Error %d : '%s' occurs when allocating Input Buffers, Input File mapped\n", errno, strerror(errno));
+		}
+		else if (StartIORing (&o_pMap->stRing, l_iDepth, FALSE) == EXIT_ERR)
+		{
+			free(o_pMap->pBuffers);
+			o_pMap->pBuffers = NULL;
+		}
+		else
+		{
+			// Each Buffer is read ahead : the first Window is the Buffer 0
+			for (l_iIdx = 0; l_iIdx < l_iDepth; l_iIdx++)
+			{
+				SubmitInputRead (o_pMap, l_iIdx);
+			}
+			o_pMap->iBuffer = l_iDepth - 1;
+		}
+	}
+	return MapInputWindow (o_pMap, 0);
+}
+
+/*
+ * =============================================================================
+ *   Read the next Record of the Input File, as fgets into Input_Record_Struct
+ *   would : up to MAX_INPUT_REC_LENGTH - 1 characters, ended by its '\n'.
+ *   o_lLength is the Length given by strlen. Returns FALSE at the End of File.
+ *   A mapped Record long enough for Create_Output_Record is read in place,
+ *   as found by the last Scan of the Window.
+ * =============================================================================
+*/
+int ReadInputRecord (FILE *i_File_Ptr, InputMap *io_pMap, const char **o_pRecord, long *o_lLength)
+{
+	const char	*l_pRecord		= NULL;
+	long		l_lChunk		= 0;
+
+	if (io_pMap->pWindow == NULL)
+	{
+		if (fgets((char*) &Input_Record_Struct, MAX_INPUT_REC_LENGTH, i_File_Ptr) == NULL)
+		{
+			return FALSE;
+		}
+		*o_pRecord = Input_Record_Struct.Input_Record;
+		*o_lLength = strlen(Input_Record_Struct.Input_Record);
+		return TRUE;
+	}
+
+	if (io_pMap->llRecordOffset >= io_pMap->llFileSize)
+	{
+		return FALSE;
+	}
+	if (io_pMap->lScanNext == io_pMap->lScanRecords)
+	{
+		l_lChunk = MAX_INPUT_REC_LENGTH - 1;
+		if (io_pMap->llRecordOffset + l_lChunk > io_pMap->llFileSize)
+		{
+			l_lChunk = io_pMap->llFileSize - io_pMap->llRecordOffset;
+		}
+		// The next Window starts with the Record going beyond the current one
+		if (io_pMap->llRecordOffset + l_lChunk > io_pMap->llWindowOffset + io_pMap->lWindowSize)
+		{
+			if (MapInputWindow (io_pMap, io_pMap->llRecordOffset) == EXIT_ERR)
+			{
+				return FALSE;
+			}
+		}
+		ScanInputRecords (io_pMap);
+	}
+	l_pRecord  = io_pMap->pWindow + io_pMap->plScanOffset[io_pMap->lScanNext];
+	l_lChunk   = io_pMap->plScanChunk[io_pMap->lScanNext];
+	*o_lLength = io_pMap->plScanLength[io_pMap->lScanNext];
+	io_pMap->lScanNext++;
+	io_pMap->llRecordOffset += l_lChunk;
+
+	if (l_lChunk >= lInputRecordExtent)
+	{
+		io_pMap->pPendingRecord = l_pRecord;
+		io_pMap->lPendingLength = l_lChunk;
+		*o_pRecord = l_pRecord;
+	}
+	else
+	{
+		KeepPendingInputRecord (io_pMap);
+		memcpy(Input_Record_Struct.Input_Record, l_pRecord, l_lChunk);
+		Input_Record_Struct.Input_Record[l_lChunk] = '\0';
+		*o_pRecord = Input_Record_Struct.Input_Record;
+	}
+	return TRUE;
+}
+
+/*
+ * =============================================================================
+ *                 Unmap the Input File, or stop its I/O Ring
+ * =============================================================================
+*/
+void CloseInputMap (InputMap *io_pMap)
+{
+	int		l_iIdx		= 0;
+
+	if (io_pMap->stRing.iDepth > 0)
+	{
+		// Reads still in flight are waited for before their Buffers are freed
+		for (l_iIdx = 0; l_iIdx < io_pMap->stRing.iDepth; l_iIdx++)
+		{
+			WaitIORequest (&io_pMap->stRing, l_iIdx);
+		}
+		StopIORing (&io_pMap->stRing);
+		free(io_pMap->pBuffers);
+		io_pMap->pBuffers = NULL;
+		io_pMap->pWindow  = NULL;
+	}
+	else if (io_pMap->pWindow != NULL)
+	{
+		munmap(io_pMap->pWindow, io_pMap->lWindowSize);
+		io_pMap->pWindow = NULL;
+	}
+	free(io_pMap->pullNewLineMasks);
+	free(io_pMap->plScanOffset);
+	io_pMap->pullNewLineMasks = NULL;
+	io_pMap->plScanOffset     = NULL;
+}
+
+/*
+ * =============================================================================
+ *   Length of the Output Record given by the Fields of tabFieldOfRecord
+ * =============================================================================
+*/
+long EvaluateOutputRecordLength ()
+{
+	long	l_lLength	= HEADER_LENGTH;
+	int		l_iIdx		= 0;
+
+	while (l_iIdx < iFieldPlanNumber)
+	{
+		if (tabFieldPlan[l_iIdx].iFieldStartPosOutput + tabFieldPlan[l_iIdx].iFieldLengthOutput > l_lLength)
+		{
+			l_lLength = tabFieldPlan[l_iIdx].iFieldStartPosOutput + tabFieldPlan[l_iIdx].iFieldLengthOutput;
+		}
+		l_iIdx++;
+	}
+	return l_lLength;
+}
+
+/*
+ * =============================================================================
+ *   Build the Output Record Template, once the Plan of the Output Record is
+ *   known : the Header filled by spaces with HEADER_CD_CRE, and the Detail
+ *   filled by spaces. Each Output Record starts from a copy of this Template
+ *   instead of being filled again.
+ * =============================================================================
+*/
+void BuildOutputRecordTemplate ()
+{
+	memset(&Output_Record_Template, '\0', sizeof(OutputRecord));
+	memset(Output_Record_Template.Output_Header, ' ', HEADER_LENGTH);
+	memcpy(Output_Record_Template.Output_Header, HEADER_CD_CRE, strlen(HEADER_CD_CRE));
+	memset(Output_Record_Template.Output_Record, ' ', MAX_INPUT_REC_LENGTH + 3 * (SIGN_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH) + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH + CD_TVA_APP_FIELD_LENGTH);
+	// An Output Record ends by '\0' after its last Field : the Bytes beyond are not copied
+	lOutputRecordTemplateLength = EvaluateOutputRecordLength ();
+	if (lOutputRecordTemplateLength > (long) sizeof(OutputRecord))
+	{
+		lOutputRecordTemplateLength = sizeof(OutputRecord);
+	}
+}
+
+/*
+ * =============================================================================
+ *   Start writing the Output File by large Blocks. The File is allocated at
+ *   once to i_llExpectedSize Bytes (0 if unknown), unless it is a Pipe
+ *   (i_iStream) or compressed (i_iCompression). The Blocks are written behind
+ *   through an I/O Ring unless IO_RING_DEPTH_VARIABLE is 0.
+ * =============================================================================
+*/
+int OpenOutputWriter (OutputWriter *o_pWriter, FILE *i_File_Ptr, long long i_llExpectedSize, int i_iStream, int i_iCompression, int i_iCompressionLevel)
+{
+	int		l_iDepth		= EvaluateIORingDepth ();
+
+	memset(o_pWriter, '\0', sizeof(OutputWriter));
+	o_pWriter->iFile = fileno(i_File_Ptr);
+	o_pWriter->iStream = (i_iStream) || (i_iCompression != COMPRESSION_NONE);
+	o_pWriter->lBufferSize = EvaluateIOBufferSize ();
+	if (posix_memalign((void **) &o_pWriter->pBuffers, OUTPUT_BUFFER_ALIGNMENT, ((l_iDepth > 0) ? l_iDepth : 1) * o_pWriter->lBufferSize) != 0)
+	{
+		printf("Error : '%s' occurs when allocating Output Buffers (%d x %ld Bytes)\n", strerror(ENOMEM), l_iDepth, o_pWriter->lBufferSize);
+		o_pWriter->pBuffers = NULL;
+		return EXIT_ERR;
+	}
+	o_pWriter->pBuffer = o_pWriter->pBuffers;
+	if ((i_iCompression != COMPRESSION_NONE) && (StartCompressor (&o_pWriter->stCompressor, i_iCompression, i_iCompressionLevel, o_pWriter->lBufferSize) == EXIT_ERR))
+	{
+		return EXIT_ERR;
+	}
+	if (l_iDepth > 0)
+	{
+		// If the Ring cannot be started, the Output File is written synchronously
+		StartIORing (&o_pWriter->stRing, l_iDepth, o_pWriter->iStream);
+		if (i_iCompression != COMPRESSION_NONE)
+		{
+			o_pWriter->stRing.pCompressor = &o_pWriter->stCompressor;
+		}
+	}
+	if ((i_llExpectedSize > 0) && (! o_pWriter->iStream))
+	{
+		// Records are fixed width : the File is truncated to the Bytes written when closed
+		posix_fallocate(o_pWriter->iFile, 0, i_llExpectedSize);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &o_pWriter->stStartTime);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                 Write the Output Buffer in the Output File
+ * =============================================================================
+*/
+int FlushOutputWriter (OutputWriter *io_pWriter)
+{
+	long	l_lWrites	= 0;
+
+	if ((io_pWriter->stRing.iDepth > 0) && (io_pWriter->lBufferUsed > 0))
+	{
+		// The Buffer is written behind : the next one is filled once its former Write is over
+		SubmitIORequest (&io_pWriter->stRing, io_pWriter->iBuffer, io_pWriter->iFile, IO_REQUEST_WRITE, io_pWriter->pBuffer, io_pWriter->lBufferUsed,
+						 (io_pWriter->iStream) ? -1 : io_pWriter->llBytesWritten);
+		io_pWriter->llBytesWritten += io_pWriter->lBufferUsed;
+		io_pWriter->lBufferUsed = 0;
+		io_pWriter->lWrites++;
+		io_pWriter->iBuffer = (io_pWriter->iBuffer + 1) % io_pWriter->stRing.iDepth;
+		io_pWriter->pBuffer = io_pWriter->pBuffers + io_pWriter->iBuffer * io_pWriter->lBufferSize;
+		if (WaitIORequest (&io_pWriter->stRing, io_pWriter->iBuffer) < 0)
+		{
+			printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+			return EXIT_ERR;
+		}
+		return EXIT_OK;
+	}
+
+	if (io_pWriter->stCompressor.iFormat != COMPRESSION_NONE)
+	{
+		l_lWrites = (CompressAndWrite (&io_pWriter->stCompressor, io_pWriter->iFile, io_pWriter->pBuffer, io_pWriter->lBufferUsed, FALSE) == EXIT_ERR) ? -1 : 1;
+	}
+	else
+	{
+		l_lWrites = WriteFully (io_pWriter->iFile, io_pWriter->pBuffer, io_pWriter->lBufferUsed);
+	}
+	if (l_lWrites < 0)
+	{
+		printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+	io_pWriter->lWrites += l_lWrites;
+	io_pWriter->llBytesWritten += io_pWriter->lBufferUsed;
+	io_pWriter->lBufferUsed = 0;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Add an Output Record and its '\n' in the Output Buffer. As with "%s", the
+ *   Record ends at its first '\0' : at most i_lMaxLength characters are read.
+ * =============================================================================
+*/
+int WriteOutputRecord (OutputWriter *io_pWriter, const char *i_pRecord, long i_lMaxLength)
+{
+	const char	*l_pEnd		= NULL;
+	long		l_lLength	= 0;
+
+	l_pEnd = (const char *) memchr(i_pRecord, '\0', i_lMaxLength);
+	l_lLength = (l_pEnd != NULL) ? l_pEnd - i_pRecord : i_lMaxLength;
+	if (io_pWriter->lBufferUsed + l_lLength + 1 > io_pWriter->lBufferSize)
+	{
+		if (FlushOutputWriter (io_pWriter) == EXIT_ERR)
+		{
+			return EXIT_ERR;
+		}
+	}
+	memcpy(io_pWriter->pBuffer + io_pWriter->lBufferUsed, i_pRecord, l_lLength);
+	io_pWriter->pBuffer[io_pWriter->lBufferUsed + l_lLength] = '\n';
+	io_pWriter->lBufferUsed += l_lLength + 1;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Map the Output File up to i_llRecords Slots at least. The File grows by
+ *   doubling its Size : no Record may be written in the former Mapping.
+ * =============================================================================
+*/
+int ReserveOutputMapping (OutputWriter *io_pWriter, long long i_llRecords)
+{
+	char		*l_pMapping		= NULL;
+	long long	l_llSize		= i_llRecords * io_pWriter->lSlotSize;
+
+	if (l_llSize <= io_pWriter->llMappingSize)
+	{
+		return EXIT_OK;
+	}
+	if (l_llSize < 2 * io_pWriter->llMappingSize)
+	{
+		l_llSize = 2 * io_pWriter->llMappingSize;
+	}
+	if (ftruncate(io_pWriter->iFile, l_llSize) != 0)
+	{
+		printf("Error %d : '%s' occurs when mapping Output File (%lld Bytes)\n", errno, strerror(errno), l_llSize);
+		return EXIT_ERR;
+	}
+	l_pMapping = (char *) mmap(NULL, l_llSize, PROT_READ | PROT_WRITE, MAP_SHARED, io_pWriter->iFile, 0);
+	if (l_pMapping == MAP_FAILED)
+	{
+		printf("Error %d : '%s' occurs when mapping Output File (%lld Bytes)\n", errno, strerror(errno), l_llSize);
+		return EXIT_ERR;
+	}
+	if (io_pWriter->pMapping != NULL)
+	{
+		munmap(io_pWriter->pMapping, io_pWriter->llMappingSize);
+	}
+	io_pWriter->pMapping      = l_pMapping;
+	io_pWriter->llMappingSize = l_llSize;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Map the Output File for the Enrichment Threads : each Record is written
+ *   in its Slot of i_lSlotSize Bytes, given by its Number. Not done for a
+ *   Pipe or a compressed File, or if OUTPUT_MAPPED_OFF_VARIABLE is set : the
+ *   Records are then written through the Output Buffers.
+ * =============================================================================
+*/
+int MapOutputWriter (OutputWriter *io_pWriter, long i_lSlotSize, long long i_llExpectedRecords)
+{
+	if ((io_pWriter->iStream) || (getenv(OUTPUT_MAPPED_OFF_VARIABLE) != NULL) || (io_pWriter->llBytesWritten + io_pWriter->lBufferUsed > 0))
+	{
+		return EXIT_ERR;
+	}
+	io_pWriter->lSlotSize = i_lSlotSize;
+	return ReserveOutputMapping (io_pWriter, (i_llExpectedRecords > 0) ? i_llExpectedRecords : 1);
+}
+
+/*
+ * =============================================================================
+ *   Keep an Output Record written with its '\n' in its Slot of the mapped
+ *   Output File. Once a former Record was shorter than its Slot, the Records
+ *   are moved back, so that they follow each other as if they were written.
+ * =============================================================================
+*/
+void WriteMappedOutputRecord (OutputWriter *io_pWriter, const char *i_pSlot, long i_lLength)
+{
+	if (i_pSlot != io_pWriter->pMapping + io_pWriter->llBytesWritten)
+	{
+		memmove(io_pWriter->pMapping + io_pWriter->llBytesWritten, i_pSlot, i_lLength + 1);
+	}
+	io_pWriter->llBytesWritten += i_lLength + 1;
+}
+
+/*
+ * =============================================================================
+ *   End writing the Output File : what was allocated beyond the written Bytes
+ *   is released, and the Throughput is reported.
+ * =============================================================================
+*/
+int CloseOutputWriter (OutputWriter *io_pWriter)
+{
+	struct timespec	l_stEndTime;
+	double			l_dSeconds		= 0;
+	int				l_iResult		= EXIT_OK;
+	int				l_iIdx			= 0;
+	const char		*l_strMode		= (io_pWriter->pMapping != NULL) ? "mapped" : DescribeIORing (&io_pWriter->stRing);
+
+	if (io_pWriter->pBuffers == NULL)
+	{
+		return EXIT_OK;
+	}
+	l_iResult = FlushOutputWriter (io_pWriter);
+	// Writes still in flight are waited for before the Buffers are freed
+	for (l_iIdx = 0; l_iIdx < io_pWriter->stRing.iDepth; l_iIdx++)
+	{
+		if (WaitIORequest (&io_pWriter->stRing, l_iIdx) < 0)
+		{
+			printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+			l_iResult = EXIT_ERR;
+		}
+	}
+	StopIORing (&io_pWriter->stRing);
+	if (io_pWriter->stCompressor.iFormat != COMPRESSION_NONE)
+	{
+		// End of the compressed Stream, once every Block was compressed
+		if (CompressAndWrite (&io_pWriter->stCompressor, io_pWriter->iFile, NULL, 0, TRUE) == EXIT_ERR)
+		{
+			printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+			l_iResult = EXIT_ERR;
+		}
+		StopCompressor (&io_pWriter->stCompressor);
+	}
+	if (io_pWriter->pMapping != NULL)
+	{
+		munmap(io_pWriter->pMapping, io_pWriter->llMappingSize);
+		io_pWriter->pMapping = NULL;
+	}
+	if (! io_pWriter->iStream)
+	{
+		ftruncate(io_pWriter->iFile, io_pWriter->llBytesWritten);
+	}
+	free(io_pWriter->pBuffers);
+	io_pWriter->pBuffers = NULL;
+	io_pWriter->pBuffer  = NULL;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_stEndTime);
+	l_dSeconds = (l_stEndTime.tv_sec - io_pWriter->stStartTime.tv_sec) + (l_stEndTime.tv_nsec - io_pWriter->stStartTime.tv_nsec) / 1e9;
+	printf("Output Bytes Written .......... : %lld in %ld write(s) - %.1f MB/s (%s)\n", io_pWriter->llBytesWritten, io_pWriter->lWrites,
+				(l_dSeconds > 0) ? io_pWriter->llBytesWritten / l_dSeconds / 1e6 : 0.0, l_strMode);
+	if (io_pWriter->stCompressor.iFormat != COMPRESSION_NONE)
+	{
+		printf("Output Compressed (%s) ...... : %lld Bytes\n", tabCompressionName[io_pWriter->stCompressor.iFormat], io_pWriter->stCompressor.llBytesOut);
+	}
+	return l_iResult;
+}
+
+/*
+ * =============================================================================
+ *   Number of Enrichment Threads, given by ENRICH_THREADS_VARIABLE
+ *   1 : the Output Records are created by main
+ * =============================================================================
+*/
+int EvaluateEnrichThreads ()
+{
+	char	*l_strThreads	= getenv(ENRICH_THREADS_VARIABLE);
+	long	l_lThreads		= 1;
+
+	if (l_strThreads == NULL)
+	{
+		return 1;
+	}
+	l_lThreads = atol(l_strThreads);
+	if (l_lThreads <= 0)
+	{
+		l_lThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	if (l_lThreads < 1)
+	{
+		return 1;
+	}
+	return (l_lThreads > ENRICH_MAX_THREADS) ? ENRICH_MAX_THREADS : (int) l_lThreads;
+}
+
+/*
+ * =============================================================================
+ *   Find the LOT of a Record in the LOT Table of its Batch. The LOTs are kept
+ *   in the Order of their first Record, each Record with its Rank in its LOT.
+ * =============================================================================
+*/
+void AddRecordInBatchLOT (RecordBatch *io_pBatch, long i_lRecord, const char *i_strAPPLI_EMET, const char *i_strID_LOT)
+{
+	LOTKey				l_stKey;
+	BatchLOT			*l_pLOT				= NULL;
+	char				l_strAPPLI_EMET_ID_LOT[20 + 1];
+	unsigned long long	l_ullHashKey		= 0;
+	long				l_lSlot				= 0;
+
+	BuildLOTKey (i_strAPPLI_EMET, i_strID_LOT, &l_stKey, l_strAPPLI_EMET_ID_LOT);
+	l_ullHashKey = BuildHashKey ((const char *) &l_stKey, sizeof(l_stKey));
+
+	// Linear Probing from the Home Slot of the Key : a Batch has less LOTs than half of its Slots
+	l_lSlot = (long) (l_ullHashKey & (unsigned long long) (ENRICH_BATCH_LOT_SLOTS - 1));
+	while (io_pBatch->plLOTSlots[l_lSlot] != 0)
+	{
+		l_pLOT = &io_pBatch->pLOTs[io_pBatch->plLOTSlots[l_lSlot] - 1];
+		if (l_pLOT->stKey.ullID_LOT     == l_stKey.ullID_LOT
+		 && l_pLOT->stKey.ullAPPLI_EMET == l_stKey.ullAPPLI_EMET
+		 && (l_stKey.ullAPPLI_EMET != LOT_KEY_IRREGULAR || strcmp(l_pLOT->strAPPLI_EMET_ID_LOT, l_strAPPLI_EMET_ID_LOT) == 0))
+		{
+			break;
+		}
+		l_lSlot = (l_lSlot + 1) & (ENRICH_BATCH_LOT_SLOTS - 1);
+	}
+	if (io_pBatch->plLOTSlots[l_lSlot] == 0)
+	{
+		// First Record of the Batch in this LOT
+		l_pLOT = &io_pBatch->pLOTs[io_pBatch->lLOTs];
+		l_pLOT->stKey        = l_stKey;
+		l_pLOT->ullHashKey   = l_ullHashKey;
+		strcpy(l_pLOT->strAPPLI_EMET_ID_LOT, l_strAPPLI_EMET_ID_LOT);
+		l_pLOT->lFirstRecord = i_lRecord;
+		l_pLOT->lRecords     = 0;
+		io_pBatch->lLOTs++;
+		io_pBatch->plLOTSlots[l_lSlot] = io_pBatch->lLOTs;
+	}
+	l_pLOT->lRecords++;
+	io_pBatch->plRecordLOT[i_lRecord]  = io_pBatch->plLOTSlots[l_lSlot] - 1;
+	io_pBatch->plRecordRank[i_lRecord] = l_pLOT->lRecords;
+}
+
+/*
+ * =============================================================================
+ *   Create the Output Records of a Batch in the Context of an Enrichment
+ *   Thread, except their LOT_NUM and ID_ECRITU. The Messages are kept with
+ *   the Batch, to be given by main in the Order of the Input File.
+ * =============================================================================
+*/
+void EnrichRecordBatch (EnrichThread *io_pThread, RecordBatch *io_pBatch)
+{
+	EnrichPool	*l_pPool		= io_pThread->pPool;
+	const char	*l_pEnd			= NULL;
+	char		*l_pSlot		= NULL;
+	char		l_strIdLot[17 + 1];
+	char		l_strAppliEmet[3 + 1];
+	long		l_lOutputUsed	= 0;
+	long		l_lIdx			= 0;
+
+	io_pBatch->pLog     = NULL;
+	io_pBatch->lLogSize = 0;
+	RecordLog_Ptr = open_memstream(&io_pBatch->pLog, &io_pBatch->lLogSize);
+
+	io_pBatch->lLOTs = 0;
+	memset(io_pBatch->plLOTSlots, '\0', ENRICH_BATCH_LOT_SLOTS * sizeof(long));
+	for (l_lIdx = 0; l_lIdx < io_pBatch->lRecords; l_lIdx++)
+	{
+		BuildOutputRecord(&io_pThread->stOutputRecord, io_pBatch->pInput + io_pBatch->plInputOffset[l_lIdx], l_strAppliEmet, l_strIdLot);
+		AddRecordInBatchLOT (io_pBatch, l_lIdx, l_strAppliEmet, l_strIdLot);
+		// Create_Output_Record ends the Record after its last Field
+		l_pEnd = (const char *) memchr(&io_pThread->stOutputRecord, '\0', l_pPool->lOutputRecordLength);
+		io_pBatch->plOutputLength[l_lIdx] = (l_pEnd != NULL) ? l_pEnd - (const char *) &io_pThread->stOutputRecord : l_pPool->lOutputRecordLength;
+		if (l_pPool->pWriter->pMapping != NULL)
+		{
+			// The Record and its '\n' are written in its Slot of the mapped Output File
+			l_pSlot = l_pPool->pWriter->pMapping + (io_pBatch->lFirstRecord - 1 + l_lIdx) * l_pPool->pWriter->lSlotSize;
+			memcpy(l_pSlot, &io_pThread->stOutputRecord, io_pBatch->plOutputLength[l_lIdx]);
+			l_pSlot[io_pBatch->plOutputLength[l_lIdx]] = '\n';
+		}
+		else
+		{
+			memcpy(io_pBatch->pOutput + l_lOutputUsed, &io_pThread->stOutputRecord, io_pBatch->plOutputLength[l_lIdx]);
+			l_lOutputUsed += io_pBatch->plOutputLength[l_lIdx];
+		}
+	}
+
+	if (RecordLog_Ptr != NULL)
+	{
+		fclose(RecordLog_Ptr);
+		RecordLog_Ptr = NULL;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Enrichment Thread : the Batches are taken in the Order they were submitted
+ * =============================================================================
+*/
+void *RunEnrichThread (void *io_pThread)
+{
+	EnrichThread	*l_pThread		= (EnrichThread *) io_pThread;
+	EnrichPool		*l_pPool		= l_pThread->pPool;
+	RecordBatch		*l_pBatch		= NULL;
+
+	pthread_mutex_lock(&l_pPool->stMutex);
+	while (TRUE)
+	{
+		while ((l_pPool->lTaken == l_pPool->lSubmitted) && (! l_pPool->iStop))
+		{
+			pthread_cond_wait(&l_pPool->stQueued, &l_pPool->stMutex);
+		}
+		if (l_pPool->iStop)
+		{
+			break;
+		}
+		l_pBatch = &l_pPool->pBatches[l_pPool->lTaken % l_pPool->iBatches];
+		l_pPool->lTaken++;
+		pthread_mutex_unlock(&l_pPool->stMutex);
+
+		EnrichRecordBatch (l_pThread, l_pBatch);
+
+		pthread_mutex_lock(&l_pPool->stMutex);
+		l_pBatch->iState = ENRICH_BATCH_DONE;
+		pthread_cond_broadcast(&l_pPool->stDone);
+	}
+	pthread_mutex_unlock(&l_pPool->stMutex);
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *                 Stop the Enrichment Threads and free their Batches
+ * =============================================================================
+*/
+void StopEnrichPool (EnrichPool *io_pPool)
+{
+	int		l_iIdx		= 0;
+
+	if (io_pPool->iThreads > 0)
+	{
+		pthread_mutex_lock(&io_pPool->stMutex);
+		io_pPool->iStop = TRUE;
+		pthread_cond_broadcast(&io_pPool->stQueued);
+		pthread_mutex_unlock(&io_pPool->stMutex);
+		for (l_iIdx = 0; l_iIdx < io_pPool->iThreads; l_iIdx++)
+		{
+			pthread_join(io_pPool->pThreads[l_iIdx].stThread, NULL);
+		}
+		io_pPool->iThreads = 0;
+	}
+	if (io_pPool->pBatches != NULL)
+	{
+		for (l_iIdx = 0; l_iIdx < io_pPool->iBatches; l_iIdx++)
+		{
+			free(io_pPool->pBatches[l_iIdx].pInput);
+			free(io_pPool->pBatches[l_iIdx].plInputOffset);
+			free(io_pPool->pBatches[l_iIdx].plInputLength);
+			free(io_pPool->pBatches[l_iIdx].pOutput);
+			free(io_pPool->pBatches[l_iIdx].plOutputLength);
+			free(io_pPool->pBatches[l_iIdx].pLOTs);
+			free(io_pPool->pBatches[l_iIdx].plLOTSlots);
+			free(io_pPool->pBatches[l_iIdx].plRecordLOT);
+			free(io_pPool->pBatches[l_iIdx].plRecordRank);
+			free(io_pPool->pBatches[l_iIdx].pLog);
+		}
+		free(io_pPool->pBatches);
+		io_pPool->pBatches = NULL;
+	}
+	free(io_pPool->pThreads);
+	io_pPool->pThreads = NULL;
+}
+
+/*
+ * =============================================================================
+ *   Start i_iThreads Enrichment Threads, if there are more than one.
+ *   Returns EXIT_ERR if they cannot be started : the Output Records are then
+ *   created by main.
+ * =============================================================================
+*/
+int StartEnrichPool (EnrichPool *o_pPool, int i_iThreads)
+{
+	RecordBatch	*l_pBatch		= NULL;
+	int			l_iIdx			= 0;
+	int			l_iError		= 0;
+
+	memset(o_pPool, '\0', sizeof(EnrichPool));
+	if (i_iThreads <= 1)
+	{
+		return EXIT_ERR;
+	}
+	o_pPool->lOutputRecordLength = EvaluateOutputRecordLength ();
+	o_pPool->iBatches            = i_iThreads * ENRICH_BATCHES_BY_THREAD;
+	o_pPool->pBatches            = (RecordBatch *) calloc(o_pPool->iBatches, sizeof(RecordBatch));
+	o_pPool->pThreads            = (EnrichThread *) calloc(i_iThreads, sizeof(EnrichThread));
+	if ((o_pPool->pBatches == NULL) || (o_pPool->pThreads == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating Enrichment Threads, Records handled by main\n", errno, strerror(errno));
+		StopEnrichPool (o_pPool);
+		return EXIT_ERR;
+	}
+	for (l_iIdx = 0; l_iIdx < o_pPool->iBatches; l_iIdx++)
+	{
+		// A Batch is submitted once ENRICH_BATCH_SIZE is reached : its last Input Record may go beyond
+		l_pBatch = &o_pPool->pBatches[l_iIdx];
+		l_pBatch->pInput         = (char *) malloc(ENRICH_BATCH_SIZE + ((lInputRecordExtent > MAX_INPUT_REC_LENGTH) ? lInputRecordExtent : MAX_INPUT_REC_LENGTH));
+		l_pBatch->plInputOffset  = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		l_pBatch->plInputLength  = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		l_pBatch->pOutput        = (char *) malloc(ENRICH_BATCH_RECORDS * o_pPool->lOutputRecordLength);
+		l_pBatch->plOutputLength = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		l_pBatch->pLOTs          = (BatchLOT *) malloc(ENRICH_BATCH_RECORDS * sizeof(BatchLOT));
+		l_pBatch->plLOTSlots     = (long *) malloc(ENRICH_BATCH_LOT_SLOTS * sizeof(long));
+		l_pBatch->plRecordLOT    = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		l_pBatch->plRecordRank   = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		if ((l_pBatch->pInput == NULL) || (l_pBatch->plInputOffset == NULL) || (l_pBatch->plInputLength == NULL) || (l_pBatch->pOutput == NULL) || (l_pBatch->plOutputLength == NULL)
+		||  (l_pBatch->pLOTs == NULL) || (l_pBatch->plLOTSlots == NULL) || (l_pBatch->plRecordLOT == NULL) || (l_pBatch->plRecordRank == NULL))
+		{
+			printf("Error %d : '%s' occurs when allocating Enrichment Batches, Records handled by main\n", errno, strerror(errno));
+			StopEnrichPool (o_pPool);
+			return EXIT_ERR;
+		}
+	}
+
+	pthread_mutex_init(&o_pPool->stMutex, NULL);
+	pthread_cond_init(&o_pPool->stQueued, NULL);
+	pthread_cond_init(&o_pPool->stDone, NULL);
+	for (l_iIdx = 0; l_iIdx < i_iThreads; l_iIdx++)
+	{
+		o_pPool->pThreads[l_iIdx].pPool = o_pPool;
+		l_iError = pthread_create(&o_pPool->pThreads[l_iIdx].stThread, NULL, RunEnrichThread, &o_pPool->pThreads[l_iIdx]);
+		if (l_iError != 0)
+		{
+			printf("Error %d : '%s' occurs when starting the Enrichment Thread %d\n", l_iError, strerror(l_iError), l_iIdx + 1);
+			break;
+		}
+		o_pPool->iThreads++;
+	}
+	if (o_pPool->iThreads == 0)
+	{
+		StopEnrichPool (o_pPool);
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                 Submit a Batch to the Enrichment Threads
+ * =============================================================================
+*/
+void SubmitRecordBatch (EnrichPool *io_pPool, RecordBatch *io_pBatch)
+{
+	pthread_mutex_lock(&io_pPool->stMutex);
+	io_pBatch->iState = ENRICH_BATCH_QUEUED;
+	io_pPool->lSubmitted++;
+	pthread_cond_signal(&io_pPool->stQueued);
+	pthread_mutex_unlock(&io_pPool->stMutex);
+}
+
+/*
+ * =============================================================================
+ *   Give LOT_NUM and ID_ECRITU to the LOTs of a Batch, in the Order of their
+ *   first Record : LOTHashArray is then as if each Record had been added.
+ *   Returns the Index of the Record rejected, -1 if none.
+ * =============================================================================
+*/
+long NumberBatchLOTs (RecordBatch *io_pBatch)
+{
+	BatchLOT	*l_pLOT			= NULL;
+	LOTHashElt	*l_pLOTHashElt	= NULL;
+	long		l_lIdx			= 0;
+
+	for (l_lIdx = 0; l_lIdx < io_pBatch->lLOTs; l_lIdx++)
+	{
+		l_pLOT = &io_pBatch->pLOTs[l_lIdx];
+		if (FindOrAddElementInLOTHashKeyTable (&l_pLOT->stKey, l_pLOT->ullHashKey, l_pLOT->strAPPLI_EMET_ID_LOT, &l_pLOTHashElt) == EXIT_ERR)
+		{
+			return l_pLOT->lFirstRecord;
+		}
+		// The Records of the Batch follow the former ones of the LOT
+		l_pLOT->iLOT_NUM   = l_pLOTHashElt->iLOT_NUM;
+		l_pLOT->iID_ECRITU = l_pLOTHashElt->iID_ECRITU;
+		l_pLOTHashElt->iID_ECRITU = (l_pLOT->iID_ECRITU + l_pLOT->lRecords - 1) % MAX_ID_ECRITU + 1;
+	}
+	// LOTHashArray would have been resized by the last Record if it was not the first one of its LOT
+	if ((io_pBatch->lRecords > 0) && (io_pBatch->plRecordRank[io_pBatch->lRecords - 1] > 1) && (ReserveLOTHashKeyTable () == EXIT_ERR))
+	{
+		return io_pBatch->lRecords - 1;
+	}
+	return -1;
+}
+
+/*
+ * =============================================================================
+ *   Wait for the oldest Batch not written, then write its Output Records, as
+ *   main would have done : its Messages first, then the Records with their
+ *   LOT_NUM and ID_ECRITU, up to the rejected one.
+ * =============================================================================
+*/
+int WriteRecordBatch (EnrichPool *io_pPool, OutputWriter *io_pWriter)
+{
+	RecordBatch	*l_pBatch		= &io_pPool->pBatches[io_pPool->lWritten % io_pPool->iBatches];
+	BatchLOT	*l_pLOT			= NULL;
+	char		*l_pOutput		= NULL;
+	char		l_strLotNum[17 + 1];
+	char		l_strIdEcriture[6 + 1];
+	long		l_lOutputUsed	= 0;
+	long		l_lRejected		= -1;
+	long		l_lRecords		= 0;
+	long		l_lIdx			= 0;
+
+	pthread_mutex_lock(&io_pPool->stMutex);
+	while (l_pBatch->iState != ENRICH_BATCH_DONE)
+	{
+		pthread_cond_wait(&io_pPool->stDone, &io_pPool->stMutex);
+	}
+	pthread_mutex_unlock(&io_pPool->stMutex);
+
+	if (l_pBatch->pLog != NULL)
+	{
+		fwrite(l_pBatch->pLog, 1, l_pBatch->lLogSize, stdout);
+		free(l_pBatch->pLog);
+		l_pBatch->pLog = NULL;
+	}
+
+	l_lRejected = NumberBatchLOTs (l_pBatch);
+	l_lRecords  = (l_lRejected >= 0) ? l_lRejected : l_pBatch->lRecords;
+	for (l_lIdx = 0; l_lIdx < l_lRecords; l_lIdx++)
+	{
+		l_pOutput = (io_pWriter->pMapping != NULL) ? io_pWriter->pMapping + (l_pBatch->lFirstRecord - 1 + l_lIdx) * io_pWriter->lSlotSize : l_pBatch->pOutput + l_lOutputUsed;
+		l_pLOT = &l_pBatch->pLOTs[l_pBatch->plRecordLOT[l_lIdx]];
+		sprintf(l_strLotNum,     "%017ld", l_pLOT->iLOT_NUM);
+		snprintf(l_strIdEcriture, sizeof(l_strIdEcriture), "%06d", (int) ((unsigned long) (l_pLOT->iID_ECRITU + l_pBatch->plRecordRank[l_lIdx] - 1) % MAX_ID_ECRITU + 1));
+		SetOutputRecordLOT(l_pOutput, l_strLotNum, l_strIdEcriture);
+		if (io_pWriter->pMapping != NULL)
+		{
+			WriteMappedOutputRecord (io_pWriter, l_pOutput, l_pBatch->plOutputLength[l_lIdx]);
 		}
-		l_iIdx++;
+		else if (WriteOutputRecord (io_pWriter, l_pOutput, l_pBatch->plOutputLength[l_lIdx]) == EXIT_ERR)
+		{
+			printf("Process aborting. Record Nr %ld not written\n", l_pBatch->lFirstRecord + l_lIdx);
+			return EXIT_ERR;
+		}
+		l_lOutputUsed += l_pBatch->plOutputLength[l_lIdx];
 	}
-	// printf(" - [Create_Output_Record] - DEV_IMP : %s, Decimal Nr : %s.\n", l_strDEV_IMP, l_strDEV_IMP_DECIMAL_POS);
-	// printf(" - [Create_Output_Record] - DEV_GES : %s, Decimal Nr : %s.\n", l_strDEV_GES, l_strDEV_GES_DECIMAL_POS);
-	// printf(" - [Create_Output_Record] - DEV_CTP : %s, Decimal Nr : %s.\n", l_strDEV_CTP, l_strDEV_CTP_DECIMAL_POS);
-	
-	// Build the Header of the Output Record
-	memcpy(o_OutputRecord, HEADER_CD_CRE, strlen(HEADER_CD_CRE));
-	memcpy(o_OutputRecord + HEADER_CD_CRE_LENGTH, l_strDAT_OPE, 4);
-	FindIdLotIdEcriture (l_strAppliEmet, l_strIdLot, l_strLotNum, l_strIdEcriture);
-	// printf(" - [Create_Output_Record] - l_strAppliEmet = %s, l_strIdLot = %s, l_strLotNum = %s, l_strIdEcriture = %s\n", l_strAppliEmet, l_strIdLot, l_strLotNum, l_strIdEcriture);
-	memcpy(o_OutputRecord + HEADER_CD_CRE_LENGTH + 4, l_strAppliEmet, 3);
-	memcpy(o_OutputRecord + HEADER_CD_CRE_LENGTH + 4 + 3, l_strLotNum, 17);
-	memcpy(o_OutputRecord + HEADER_CD_CRE_LENGTH + HEADER_ID_LOT_LENGTH + HEADER_ID_COMPOST_LENGTH, l_strIdEcriture, HEADER_ID_ECRITU_LENGTH);
-	o_OutputRecord[tabFieldOfRecord[l_iIdx - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iIdx - 1].iFieldLengthOutput] = '\0';
+	if (l_lRejected >= 0)
+	{
+		printf("Process aborting. Record Nr %ld rejected : %.*s\n", l_pBatch->lFirstRecord + l_lRejected,
+					(int) l_pBatch->plInputLength[l_lRejected], l_pBatch->pInput + l_pBatch->plInputOffset[l_lRejected]);
+		// The Threads may still write the following Batches in the mapped Output File
+		StopEnrichPool (io_pPool);
+		CloseOutputWriter (io_pWriter);
+		return EXIT_ERR;
+	}
+	l_pBatch->iState = ENRICH_BATCH_FREE;
+	io_pPool->lWritten++;
 	return EXIT_OK;
 }
 
-/* 
+/*
  * =============================================================================
- *  Building Format of Output File Record using struct_premai.conf File
- *  In this File, Each Record corresponds to one Field of the Input File Record
+ *   Write every Batch submitted and not written yet
  * =============================================================================
- */
-int BuildOutputRecordFormat()
+*/
+int WriteRecordBatches (EnrichPool *io_pPool, OutputWriter *io_pWriter)
 {
-	FILE *l_InputFile_RecordFormat_Ptr		= NULL;
-	char  l_strFullInputFileFormatName[MAX_FULL_FILE_NAME_LENGTH];
-	int   l_iFieldNumber					= 0;
-	int   l_iRecNumber						= 0;
-	int   l_iPreviousInputFieldNumber 		= 0;
-	int   l_iStartFieldPositionForInput		= 0;
-	int   l_iStartFieldPositionForOutput	= HEADER_LENGTH;
-
-	/* Initializing the table of Fields of Input and Output Files */
-	for (l_iFieldNumber = 0; l_iFieldNumber < MAX_FIELD_NUMBER; l_iFieldNumber++)
+	while (io_pPool->lWritten < io_pPool->lSubmitted)
 	{
-		memset(tabFieldOfRecord[l_iFieldNumber].strFieldName,   '\0', sizeof(tabFieldOfRecord[l_iFieldNumber].strFieldName));
-		memset(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, '\0', sizeof(tabFieldOfRecord[l_iFieldNumber].strFieldFormat));
-		tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = unknown;
-		tabFieldOfRecord[l_iFieldNumber].iFieldType           = -1;
-		tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput    = -1;
-		tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = -1;
-		tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = -1;
-		tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = -1;
+		if (WriteRecordBatch (io_pPool, io_pWriter) == EXIT_ERR)
+		{
+			return EXIT_ERR;
+		}
 	}
-	
-	/* Opening struct_premai.conf File */
-	strcpy(l_strFullInputFileFormatName, strConfigurationDirectory);
-	strcat(l_strFullInputFileFormatName, "/");
-	strcat(l_strFullInputFileFormatName, INPUT_FILE_FORMAT_NAME);
+	return EXIT_OK;
+}
 
-	printf("Opening %s File ...\n", l_strFullInputFileFormatName);
-	l_InputFile_RecordFormat_Ptr = fopen(l_strFullInputFileFormatName, "r");
-	if (l_InputFile_RecordFormat_Ptr == NULL)
-	{
-		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullInputFileFormatName);
-		return EXIT_ERR;
-	}
+/*
+ * =============================================================================
+ *   Handle the Input Records through the Enrichment Threads : the Records are
+ *   copied by Batches, as Create_Output_Record would read them, and the Output
+ *   Records are written in the Order of the Input File. A Record of
+ *   unexpected Length stops the Handling once the former ones are written.
+ * =============================================================================
+*/
+int EnrichRecordsInParallel (EnrichPool *io_pPool, FILE *i_File_Ptr, InputMap *io_pMap, OutputWriter *io_pWriter, long *io_lRecordNumber, long *io_lEmptyRecordNumber)
+{
+	RecordBatch	*l_pBatch				= NULL;
+	const char	*l_pInputRecord			= NULL;
+	long		l_lInputRecordLength	= 0;
+	long		l_lCopied				= 0;
 
-	/* Reading Records of struct_premai.conf File : Each Record gives the Characteristics of a Field of the Input File Record */
-	l_iFieldNumber = -1;
-	while (fgets((char*) &Input_File_Record_Format_Struct, MAX_INPUT_FORMAT_REC_LENGTH, l_InputFile_RecordFormat_Ptr) != NULL)
+	io_pPool->pWriter = io_pWriter;
+	while (ReadInputRecord (i_File_Ptr, io_pMap, &l_pInputRecord, &l_lInputRecordLength))
 	{
-		if (strlen(Input_File_Record_Format_Struct.InputFormat_Record) > 1)
+		if (l_lInputRecordLength > 1)
 		{
 			// Handle only not empty records
-			l_iRecNumber++;
-			l_iFieldNumber++;
-			
-			strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, strtok(Input_File_Record_Format_Struct.InputFormat_Record, SEPARATOR));
-			strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, strtok(NULL, SEPARATOR));
-			tabFieldOfRecord[l_iFieldNumber].iFieldFormat = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-			// Start Position of the Field in Input and Output Record
-			if (l_iRecNumber == 1)
-			{
-				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = l_iStartFieldPositionForInput;
-				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = l_iStartFieldPositionForOutput;
-				tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput    = atoi(strtok(NULL, SEPARATOR));
-				tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput;
-			}
-			else
+			(*io_lRecordNumber)++;
+			if (l_lInputRecordLength != iInputRecordLength)
 			{
-				l_iStartFieldPositionForInput  = l_iStartFieldPositionForInput  + tabFieldOfRecord[l_iPreviousInputFieldNumber].iFieldLengthInput;
-				l_iStartFieldPositionForOutput = l_iStartFieldPositionForOutput + tabFieldOfRecord[l_iFieldNumber - 1].iFieldLengthOutput;
-				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = l_iStartFieldPositionForInput;
-				tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = l_iStartFieldPositionForOutput;
-				tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput    = atoi(strtok(NULL, SEPARATOR));
-				tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput;
-			}
-			// Input Record Length Calculation
-			iInputRecordLength += tabFieldOfRecord[l_iFieldNumber].iFieldLengthInput;
-			// Amount Handling
-			if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_MNT_IMP") == 0)
-			{
-				tabFieldOfRecord[l_iFieldNumber].iFieldType           = UPDATE_MAI_MNT_IMP;
-				// Add VL_SIGIMP and VL_NBDCIMP to MAI_MNT_IMP in Output File
-				strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "amount3DEC");
-				tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-				tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH;
-				l_iPreviousInputFieldNumber = l_iFieldNumber;
+				// Invalid Input Record Length
+				if (l_pBatch != NULL)
+				{
+					SubmitRecordBatch (io_pPool, l_pBatch);
+				}
+				if (WriteRecordBatches (io_pPool, io_pWriter) == EXIT_ERR)
+				{
+					return EXIT_ERR;
+				}
+				printf("Process aborting. Unexpected Record Length : %ld instead of %ld. Record Nr %ld rejected : %.*s\n", l_lInputRecordLength, iInputRecordLength, *io_lRecordNumber, (int) l_lInputRecordLength, l_pInputRecord);
+				CloseOutputWriter (io_pWriter);
+				return EXIT_ERR;
 			}
-			else
+			if (l_pBatch == NULL)
 			{
-				if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_MNT_GES") == 0)
+				// Every Batch is in use : the oldest one is written first
+				if ((io_pPool->lSubmitted - io_pPool->lWritten == io_pPool->iBatches) && (WriteRecordBatch (io_pPool, io_pWriter) == EXIT_ERR))
 				{
-					tabFieldOfRecord[l_iFieldNumber].iFieldType           = UPDATE_MAI_MNT_GES;
-					// Add VL_SIGGEST and VL_NBDGEST to MAI_MNT_GES in Output File
-					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "amount3DEC");
-					tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-					tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH;
-					l_iPreviousInputFieldNumber = l_iFieldNumber;
+					return EXIT_ERR;
 				}
-				else
+				if ((io_pWriter->pMapping != NULL) && ((*io_lRecordNumber - 1 + ENRICH_BATCH_RECORDS) * io_pWriter->lSlotSize > io_pWriter->llMappingSize))
 				{
-					if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_MNT_NOM") == 0)
+					// The mapped Output File grows once every Batch is written
+					if (WriteRecordBatches (io_pPool, io_pWriter) == EXIT_ERR)
 					{
-						tabFieldOfRecord[l_iFieldNumber].iFieldType           = UPDATE_MAI_MNT_NOM;
-						// Add VL_SIGNOM and VL_NBDCNOM to MAI_MNT_NOM in Output File
-						strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "amount3DEC");
-						tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-						tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH;
-						l_iPreviousInputFieldNumber = l_iFieldNumber;
+						return EXIT_ERR;
 					}
-					else
+					if (ReserveOutputMapping (io_pWriter, *io_lRecordNumber - 1 + ENRICH_BATCH_RECORDS) == EXIT_ERR)
 					{
-						if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "MAI_TOP_MAJ") == 0)
-						{
-							tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_CD_TYPIMP_TYPEI_TVA;
-							// Add CD_TYPIMP, CD_TYPEI and CD_TVA_APP in Output File
-							l_iPreviousInputFieldNumber = l_iFieldNumber;
-							l_iFieldNumber++;
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName,   "CD_TYPIMP");
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = CD_TYPIMP_FIELD_LENGTH;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = CD_TYPIMP_TYPEI_TVA_INPUT_POSIT;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-							l_iFieldNumber++;
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName,   "CD_TYPEI");
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = CD_TYPEI_FIELD_LENGTH;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = CD_TYPIMP_TYPEI_TVA_INPUT_POSIT;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-							l_iFieldNumber++;
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName,   "CD_TVA_APP");
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = CD_TVA_APP_FIELD_LENGTH;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = CD_TYPIMP_TYPEI_TVA_INPUT_POSIT;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;							
-							l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-						}
-						else
-						{
-							l_iPreviousInputFieldNumber = l_iFieldNumber;
-						}
+						printf("Process aborting. Record Nr %ld not written\n", *io_lRecordNumber);
+						return EXIT_ERR;
 					}
 				}
+				l_pBatch = &io_pPool->pBatches[io_pPool->lSubmitted % io_pPool->iBatches];
+				l_pBatch->lFirstRecord = *io_lRecordNumber;
+				l_pBatch->lRecords     = 0;
+				l_pBatch->lInputUsed   = 0;
+			}
+			// Create_Output_Record may read beyond the End of the Record
+			l_lCopied = (l_lInputRecordLength > lInputRecordExtent) ? l_lInputRecordLength : lInputRecordExtent;
+			memcpy(l_pBatch->pInput + l_pBatch->lInputUsed, l_pInputRecord, l_lCopied);
+			l_pBatch->plInputOffset[l_pBatch->lRecords] = l_pBatch->lInputUsed;
+			l_pBatch->plInputLength[l_pBatch->lRecords] = l_lInputRecordLength;
+			l_pBatch->lInputUsed += l_lCopied;
+			l_pBatch->lRecords++;
+			if ((l_pBatch->lRecords == ENRICH_BATCH_RECORDS) || (l_pBatch->lInputUsed >= ENRICH_BATCH_SIZE))
+			{
+				SubmitRecordBatch (io_pPool, l_pBatch);
+				l_pBatch = NULL;
 			}
 		}
+		else
+		{
+			(*io_lEmptyRecordNumber)++;
+		}
 	}
-	
-	/* Closing struct_premai.conf File */
-	printf("Closing %s File ...\n", l_strFullInputFileFormatName);
-	fclose(l_InputFile_RecordFormat_Ptr);
-	return EXIT_OK;
+	if (l_pBatch != NULL)
+	{
+		SubmitRecordBatch (io_pPool, l_pBatch);
+	}
+	return WriteRecordBatches (io_pPool, io_pWriter);
 }
 
 /* 
@@ -2174,6 +6272,26 @@ main(int argc, char *argv[])
 	long l_lIdx					= 0;
 	long Record_Number       	= 0;
 	long Empty_Record_Number 	= 0;
+	long l_lNbExpectedRecords	= 0;
+	long l_lInputRecordLength	= 0;
+	const char *l_pInputRecord	= NULL;
+	int l_iStreamOutputFile		= -1;
+	int l_iOutputCompression	= COMPRESSION_NONE;
+	int l_iOutputCompressionLevel	= 0;
+	char *l_pStreamInputBuffer	= NULL;
+	int l_iResult				= EXIT_OK;
+	struct stat InputFile_Stat;
+
+	/* Streaming : stdout is kept for the Output Records, the Logs go to stderr */
+	if ((argc > 1) && (strcmp(argv[1], STREAM_FILE_NAME) == 0))
+	{
+		l_iStreamOutputFile = dup(STDOUT_FILENO);
+		if ((l_iStreamOutputFile < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+		{
+			fprintf(stderr, "Error %d : '%s' occurs when redirecting stdout to stderr\n", errno, strerror(errno));
+			return EXIT_ERR;
+		}
+	}
 
 	/* Start of Program */
 	printf("Start Har_Transco_PreMai Program ...\n");
@@ -2197,6 +6315,7 @@ main(int argc, char *argv[])
 		printf("Bad Number of Parameters. This Number must be %d or %d instead of %d\n", NB_PARAM - 1, NB_PARAM , argc - 1);
 		printf("---                                   U S A G E                                   ---\n");
 		printf("   - Parameter 1 : Input File                                          [Mandatory]\n");
+		printf("                   \"-\" : stdin to stdout, Logs to stderr\n");
 		printf("   - Parameter 2 : Accounting Date in YYYYMMDD Format                  [Mandatory]\n");
 		printf("   - Parameter 3 : Site : CASA or LCL                                  [Optionnal]\n");
 		return EXIT_ERR;
@@ -2220,7 +6339,7 @@ main(int argc, char *argv[])
 	printf("Checking Parameters ...\n");
 	
 	// Input File
-	InputFile_Name = (char*) malloc(strlen(argv[1]) * sizeof(char));        
+	InputFile_Name = (char*) malloc((1 + strlen(argv[1])) * sizeof(char));        
    	strncpy(InputFile_Name, argv[1], strlen(argv[1]));
 	InputFile_Name[strlen(argv[1])] = '\0';
 
@@ -2290,6 +6409,9 @@ main(int argc, char *argv[])
 		}
 	}*/
 
+	/* Building the Template of the Output Records */
+	BuildOutputRecordTemplate ();
+
 	/* Getting the REF_RCA_CPT.dat File Format using REF_RCA_CPT.conf File */
 	if (BuildRefRcaCptRecordFormat() == EXIT_ERR)
 	{
@@ -2319,21 +6441,18 @@ main(int argc, char *argv[])
 	}
 	/*else
 	{
-		for (l_lIdX = 0; l_lIdX < HASH_DODGE_ARRAY_SIZE; l_lIdX++)
+		for (l_lIdx = 0; l_lIdx < lCOMPTE_DODGEHashArraySize; l_lIdx++)
 		{
-			for (l_lIdY = 0; l_lIdY < HASH_DODGE_ARRAY_SIZE; l_lIdY++)
+			if (COMPTE_DODGEHashCtrl[l_lIdx] != HASH_CTRL_EMPTY)
 			{
-				if (COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].COMPTE_DODGEHashKey >= 0)
-				{
-					printf (" - [main] - COMPTE_DODGEHashArray - Record l_lIdX = %03ld , l_lIdY = %03ld : %lld | \t\t%s | \t\t%s | \t\t%s | \t\t%s | \t\t%s\n",	
-								l_lIdX, l_lIdY,
-								COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].COMPTE_DODGEHashKey,
-								COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strCOMPTE_DODGE,
-								COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTOP_BILAN,
-								COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strHB_IMPUTATION,
-								COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTOP_INT_EXT,
-								COMPTE_DODGEHashArray[l_lIdX].stElt[l_lIdY].strTVA);
-				}
+				printf (" - [main] - COMPTE_DODGEHashArray - Record l_lIdx = %06ld : %lld | \t\t%s | \t\t%s | \t\t%s | \t\t%s | \t\t%s\n",	
+							l_lIdx,
+							COMPTE_DODGEHashArray[l_lIdx].COMPTE_DODGEHashKey,
+							COMPTE_DODGEHashArray[l_lIdx].strCOMPTE_DODGE,
+							COMPTE_DODGEHashArray[l_lIdx].strTOP_BILAN,
+							COMPTE_DODGEHashArray[l_lIdx].strHB_IMPUTATION,
+							COMPTE_DODGEHashArray[l_lIdx].strTOP_INT_EXT,
+							COMPTE_DODGEHashArray[l_lIdx].strTVA);
 			}
 		}
 	}
@@ -2362,20 +6481,25 @@ main(int argc, char *argv[])
 	}
 	/*else
 	{	
-		for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+		for (l_lIdX = 0; l_lIdX < CURRENCY_EMPTY_INDEX; l_lIdX++)
 		{
-			for (l_lIdY = 0; l_lIdY < HASH_CURRENCY_ARRAY_SIZE; l_lIdY++)
+			if (CURRENCYDecimalArray[l_lIdX] != CURRENCY_DECIMAL_NOT_FOUND)
 			{
-				if (CURRENCYHashArray[l_lIdX].stElt[l_lIdY].CURRENCYHashKey >= 0)
-				{
-					printf (" - [main] - CURRENCYHashArray - Record %03ld , %03ld : %lld | \t\t%s | \t\t%s\n",	
-								l_lIdX, l_lIdY,
-								CURRENCYHashArray[l_lIdX].stElt[l_lIdY].CURRENCYHashKey,
-								CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strCURRENCY_CD,
-								CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strDECIMAL_POS);
-				}
+				printf (" - [main] - CURRENCYDecimalArray - Record %05ld : %c%c%c | \t\t%c\n",	
+							l_lIdX,
+							(char) ('A' + l_lIdX / (CURRENCY_LETTER_NUMBER * CURRENCY_LETTER_NUMBER)),
+							(char) ('A' + (l_lIdX / CURRENCY_LETTER_NUMBER) % CURRENCY_LETTER_NUMBER),
+							(char) ('A' + l_lIdX % CURRENCY_LETTER_NUMBER),
+							CURRENCYDecimalArray[l_lIdX]);
 			}
 		}
+		for (l_lIdX = 0; l_lIdX < lCURRENCYOverflowNumber; l_lIdX++)
+		{
+			printf (" - [main] - CURRENCYOverflowArray - Record %03ld : %s | \t\t%s\n",	
+						l_lIdX,
+						CURRENCYOverflowArray[l_lIdX].strCURRENCY_CD,
+						CURRENCYOverflowArray[l_lIdX].strDECIMAL_POS);
+		}
 	}
 	printf("\n");*/
 	
@@ -2384,20 +6508,56 @@ main(int argc, char *argv[])
 
 	/* Opening Input File */
 	printf("Opening Input  File ........... : %s\n", InputFile_Name);
-	InputFile_Ptr = fopen(InputFile_Name, "r");
+	if (l_iStreamOutputFile >= 0)
+	{
+		// stdin is read by large Blocks too, unless it can be mapped
+		InputFile_Ptr = stdin;
+		l_pStreamInputBuffer = (char *) malloc(EvaluateIOBufferSize ());
+		if (l_pStreamInputBuffer != NULL)
+		{
+			setvbuf(InputFile_Ptr, l_pStreamInputBuffer, _IOFBF, EvaluateIOBufferSize ());
+		}
+	}
+	else
+	{
+		InputFile_Ptr = fopen(InputFile_Name, "r");
+	}
 	if (InputFile_Ptr == NULL)
 	{
 		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), InputFile_Name);
 		free(InputFile_Name);
 		return EXIT_ERR;
 	}	
+
+	/* Decompressing Input File : if it is compressed, its Records are read from a Pipe */
+	if (OpenInputDecompressor (&InputFile_Decompressor, &InputFile_Ptr) == EXIT_ERR)
+	{
+		free(InputFile_Name);
+		return EXIT_ERR;
+	}
 	
 	/* Opening Ouput File */
-	OutputFile_Name = (char*) malloc((1 + strlen(argv[1]) + strlen(OUTPUT_FILE_EXTENSION)) * sizeof(char));
-	strcpy(OutputFile_Name, InputFile_Name);
-	strcat(OutputFile_Name, OUTPUT_FILE_EXTENSION);
-	printf("Opening Output File ........... : %s\n", OutputFile_Name);
-	OutputFile_Ptr = fopen(OutputFile_Name, "w");
+	l_iOutputCompression = EvaluateOutputCompression (&l_iOutputCompressionLevel);
+	if (l_iOutputCompression < 0)
+	{
+		free(InputFile_Name);
+		return EXIT_ERR;
+	}
+	OutputFile_Name = (char*) malloc((1 + strlen(argv[1]) + strlen(OUTPUT_FILE_EXTENSION) + strlen(STREAM_OUTPUT_FILE_NAME) + strlen(tabCompressionExtension[l_iOutputCompression])) * sizeof(char));
+	if (l_iStreamOutputFile >= 0)
+	{
+		strcpy(OutputFile_Name, STREAM_OUTPUT_FILE_NAME);
+		printf("Opening Output File ........... : %s\n", OutputFile_Name);
+		OutputFile_Ptr = fdopen(l_iStreamOutputFile, "w");
+	}
+	else
+	{
+		strcpy(OutputFile_Name, InputFile_Name);
+		strcat(OutputFile_Name, OUTPUT_FILE_EXTENSION);
+		strcat(OutputFile_Name, tabCompressionExtension[l_iOutputCompression]);
+		printf("Opening Output File ........... : %s\n", OutputFile_Name);
+		OutputFile_Ptr = fopen(OutputFile_Name, "w+");
+	}
 	if (OutputFile_Ptr == NULL)
 	{
 		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), OutputFile_Name);
@@ -2405,80 +6565,150 @@ main(int argc, char *argv[])
 		return EXIT_ERR;
 	}   
 	
-	/* Initializing LOTHashKeyTable Table */
-	InitializeLOTHashKeyTable();
+	/* Initializing LOTHashKeyTable Table sized by the maximal Number of Records of Input File */
+	if (fstat(fileno(InputFile_Ptr), &InputFile_Stat) == 0)
+	{
+		l_lNbExpectedRecords = (long) (InputFile_Stat.st_size / iInputRecordLength) + 1;
+	}
+	if (InitializeLOTHashKeyTable(l_lNbExpectedRecords) == EXIT_ERR)
+	{
+		free(InputFile_Name);
+		free(OutputFile_Name);
+		return EXIT_ERR;
+	}
 	
+	/* Mapping Input File : if it cannot be mapped, it is read with fgets */
+	OpenInputMap (&InputFile_Map, InputFile_Ptr);
+
+	/* Output File allocated for one Output Record by Input Record */
+	if (OpenOutputWriter (&OutputFile_Writer, OutputFile_Ptr, (long long) l_lNbExpectedRecords * (EvaluateOutputRecordLength () + 1), (l_iStreamOutputFile >= 0), l_iOutputCompression, l_iOutputCompressionLevel) == EXIT_ERR)
+	{
+		free(InputFile_Name);
+		free(OutputFile_Name);
+		return EXIT_ERR;
+	}
+
 	/* Handling Input Data and Creating Output File */
-	while (fgets((char*) &Input_Record_Struct, MAX_INPUT_REC_LENGTH, InputFile_Ptr) != NULL)
+	if (StartEnrichPool (&Enrich_Pool, EvaluateEnrichThreads ()) == EXIT_OK)
+	{
+		printf("Enrichment Threads ............ : %d\n", Enrich_Pool.iThreads);
+		// The Enrichment Threads write the Records in place : the Input File gives the Number of Records at most
+		MapOutputWriter (&OutputFile_Writer, Enrich_Pool.lOutputRecordLength + 1, l_lNbExpectedRecords);
+		l_iResult = EnrichRecordsInParallel (&Enrich_Pool, InputFile_Ptr, &InputFile_Map, &OutputFile_Writer, &Record_Number, &Empty_Record_Number);
+		StopEnrichPool (&Enrich_Pool);
+		if (l_iResult == EXIT_ERR)
+		{
+			free(InputFile_Name);
+			free(OutputFile_Name);
+			return EXIT_ERR;
+		}
+	}
+	else
 	{
-		if (strlen(Input_Record_Struct.Input_Record) > 1)
+		while (ReadInputRecord (InputFile_Ptr, &InputFile_Map, &l_pInputRecord, &l_lInputRecordLength))
 		{
-			// Handle only not empty Records
-			Record_Number++;
-			if (strlen(Input_Record_Struct.Input_Record) == iInputRecordLength)
+			if (l_lInputRecordLength > 1)
 			{
-				// Create Output Record
-				memset(Output_Record_Struct.Output_Header, ' ', HEADER_LENGTH);
-				memset(Output_Record_Struct.Output_Record, ' ', MAX_INPUT_REC_LENGTH + 3 * (SIGN_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH) + CD_TYPIMP_FIELD_LENGTH + CD_TYPEI_FIELD_LENGTH + CD_TVA_APP_FIELD_LENGTH);
-				if (Create_Output_Record(Input_Record_Struct.Input_Record, (char *) &Output_Record_Struct) == EXIT_ERR)
+				// Handle only not empty Records
+				Record_Number++;
+				if (l_lInputRecordLength == iInputRecordLength)
 				{
-					printf("Process aborting. Record Nr %ld rejected : %s\n", Record_Number, Input_Record_Struct.Input_Record);
-					free(InputFile_Name);
-					free(OutputFile_Name);
-					return EXIT_ERR;
+					// Create Output Record
+					memcpy(&Output_Record_Struct, &Output_Record_Template, lOutputRecordTemplateLength);
+					if (Create_Output_Record(l_pInputRecord, (char *) &Output_Record_Struct) == EXIT_ERR)
+					{
+						printf("Process aborting. Record Nr %ld rejected : %.*s\n", Record_Number, (int) l_lInputRecordLength, l_pInputRecord);
+						CloseOutputWriter (&OutputFile_Writer);
+						free(InputFile_Name);
+						free(OutputFile_Name);
+						return EXIT_ERR;
+					}
+					else
+					{
+						if (WriteOutputRecord (&OutputFile_Writer, (char *) &Output_Record_Struct, sizeof(Output_Record_Struct)) == EXIT_ERR)
+						{
+							printf("Process aborting. Record Nr %ld not written\n", Record_Number);
+							free(InputFile_Name);
+							free(OutputFile_Name);
+							return EXIT_ERR;
+						}
+					}
 				}
 				else
 				{
-					fprintf(OutputFile_Ptr, "%s\n", (char *) &Output_Record_Struct);
+					// Invalid Input Record Length
+					printf("Process aborting. Unexpected Record Length : %ld instead of %ld. Record Nr %ld rejected : %.*s\n", l_lInputRecordLength, iInputRecordLength, Record_Number, (int) l_lInputRecordLength, l_pInputRecord);
+					CloseOutputWriter (&OutputFile_Writer);
+					free(InputFile_Name);
+					free(OutputFile_Name);
+					return EXIT_ERR;				
 				}
 			}
 			else
 			{
-				// Invalid Input Record Length
-				printf("Process aborting. Unexpected Record Length : %ld instead of %ld. Record Nr %ld rejected : %s\n", strlen(Input_Record_Struct.Input_Record), iInputRecordLength, Record_Number, Input_Record_Struct.Input_Record);
-				free(InputFile_Name);
-				free(OutputFile_Name);
-				return EXIT_ERR;				
+				Empty_Record_Number++;
 			}
 		}
-		else
-		{
-			Empty_Record_Number++;
-		}
 	}
 	
-	/*for (l_lIdX = 0; l_lIdX < HASH_LOT_ARRAY_SIZE; l_lIdX++)
+	/*for (l_lIdx = 0; l_lIdx < lLOTHashArraySize; l_lIdx++)
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_LOT_ARRAY_SIZE; l_lIdY++)
+		if (LOTHashArray[l_lIdx].iLOT_NUM > 0)
 		{
-			if (LOTHashArray[l_lIdX].stElt[l_lIdY].iLOT_NUM > 0)
-			{
-				printf (" - [main] - LOTHashArray - Record l_lIdX = %03ld , l_lIdY = %03ld : %s | \t\t%s | \t\t%s | \t\t%017d | \t\t%06d\n",	
-							l_lIdX, l_lIdY,
-							LOTHashArray[l_lIdX].stElt[l_lIdY].strAPPLI_EMET_ID_LOT,
-							LOTHashArray[l_lIdX].stElt[l_lIdY].strAPPLI_EMET,
-							LOTHashArray[l_lIdX].stElt[l_lIdY].strID_LOT,
-							LOTHashArray[l_lIdX].stElt[l_lIdY].iLOT_NUM,
-							LOTHashArray[l_lIdX].stElt[l_lIdY].iID_ECRITU);
-			}
+			printf (" - [main] - LOTHashArray - Record l_lIdx = %06ld : %016llx | \t\t%016llx | \t\t%s | \t\t%017d | \t\t%06d\n",	
+						l_lIdx,
+						LOTHashArray[l_lIdx].stKey.ullID_LOT,
+						LOTHashArray[l_lIdx].stKey.ullAPPLI_EMET,
+						LOTHashArray[l_lIdx].strAPPLI_EMET_ID_LOT,
+						LOTHashArray[l_lIdx].iLOT_NUM,
+						LOTHashArray[l_lIdx].iID_ECRITU);
 		}
 	}
 	printf("\n");*/
 	
 	printf("Total Number of Records Read .. : %ld\n", Record_Number + Empty_Record_Number);
 	printf("Total Number of Handled Records : %ld\n", Record_Number);
+	printf("Total Number of LOT ........... : %ld\n", lLOTHashArrayElements);
+	printf("LOT Table Peak Size ........... : %ld Slots, %ld Resize(s)\n", lLOTHashArrayPeakSize, lLOTHashArrayResizes);
 
 	/* End Input File Handling */
 	printf("End   Handling of %s File\n", InputFile_Name);
 	
 	/* Closing Files */
 	printf("Closing %s and %s Files ...\n", OutputFile_Name, InputFile_Name);
+	if (CloseOutputWriter (&OutputFile_Writer) == EXIT_ERR)
+	{
+		printf("Error : Output File %s is incomplete\n", OutputFile_Name);
+	}
 	fclose(OutputFile_Ptr);
+	CloseInputMap (&InputFile_Map);
 	fclose(InputFile_Ptr);
+	free(l_pStreamInputBuffer);
+	if (CloseInputDecompressor (&InputFile_Decompressor) == EXIT_ERR)
+	{
+		printf("Process aborting. Input File %s was not read to its End\n", InputFile_Name);
+		free(InputFile_Name);
+		free(OutputFile_Name);
+		return EXIT_ERR;
+	}
 
 	/* Free memory allocation */
 	free(InputFile_Name);
 	free(OutputFile_Name);
+	if (COMPTE_DODGESnapshot.pMapping != NULL)
+	{
+		// COMPTE_DODGE Hash Key Table is mapped from the Snapshot of REF_RCA_CPT.dat File
+		CloseSnapshot (&COMPTE_DODGESnapshot);
+	}
+	else
+	{
+		free(COMPTE_DODGEHashArray);
+		free(COMPTE_DODGEHashCtrl);
+	}
+	free(COMPTE_DODGEPerfectArray);
+	free(COMPTE_DODGEPerfectPilot);
+	free(LOTHashArray);
+	free(LOTFormerHashArray);
 	
 	/* End of Program */
 	printf("End   Har_Transco_PreMai Program ...\n");
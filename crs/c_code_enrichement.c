@@ -9,6 +9,8 @@
  *
  *         Har_Transco_PESTD <Parameter 1> <Parameter 2>
  *       - Parameter 1 : Input File                         [Mandatory]
+ *                       "-" : Records read from stdin and written to stdout, Logs written to stderr
+ *                       gzip or zstd compressed Input is detected, RDJ_OUTPUT_COMPRESSION compresses the Output
  *       - Parameter 2 : Accounting Date in YYYYMMDD Format [Mandatory]
  *
  *=======================================================================================
@@ -23,17 +25,42 @@
 /* Includes */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
 #include <errno.h>
 #include <time.h>
 #include <math.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/timeb.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#define IO_URING_SUPPORTED
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define INPUT_SCAN_DISPATCHED					// AVX2 and AVX-512 Scanners of the Input File chosen at run time
+#endif
+#ifdef RDJ_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef RDJ_WITH_ZSTD
+#include <zstd.h>
+#endif
 
 /* Additional Functions */
 #define SIGN(x)  ((x) < 0 ? ('-') : ('+'))
 #define ROUND(x) ((x - floor(x)) < 0.5 ? (floor(x)) : (ceil(x)))
+#define DIGIT(x) (((x) >= '0') && ((x) <= '9') ? ((x) - '0') : 0)
 
 /* Common Constants */
 #define DATE_LENGTH						8
@@ -52,16 +79,42 @@
 #define FIELD_NAME_LENGTH				50
 #define FIELD_FORMAT_LENGTH				20
 #define MAX_FIELD_LENGTH				500				
+#define NUMERIC_SCAN_WIDTH				16	// Characters of a Numeric Field classified at once
+#define NUMERIC_SCAN_LENGTH				64	// Longest Numeric Field converted by ConvertNumericField
 #define MAX_FIELD_NUMBER				400
 #define SEPARATOR 						";"
 
 /* Hash Key Handling */
-#define HASH_ARRAY_SIZE		  			1500
-#define HASH_CURRENCY_ARRAY_SIZE		50
+#define HASH_MIN_ARRAY_SIZE				1024	// Hash Tables are sized at run time : power of 2, at least HASH_LOAD_FACTOR times the Number of Records
+#define HASH_LOAD_FACTOR				2
+#define HASH_GROUP_SIZE					16		// Number of Slots whose Control Bytes are compared at once
+#define HASH_CTRL_EMPTY					0x00	// Control Byte of a free Slot
+#define HASH_CTRL_USED					0x80	// Control Byte of a used Slot : HASH_CTRL_USED | 7 bits Fingerprint of the Hash Key
 #define HASH_KEY_FOUND			   		1
 #define HASH_KEY_NOT_FOUND				0
-#define MAX_HASH_KEY_LENGTH				18	// Hash Key is a 'long long' variable. Its Maximal Value is : 9 223 372 036 854 775 807
+#define MAX_HASH_KEY_LENGTH				18	// Former Hash Key was a 'long long' variable. Its Maximal Value is : 9 223 372 036 854 775 807
 											// The string "zzzzzzzzzzzzzzzzzz" gives the highest value of Hash Key : 9 999 999 999 999 999 990
+#define HASH_FORMER_ARRAY_SIZE			1500	// Size of the former static Hash Key Tables, used by the Hash Key Report
+#define HASH_KEY_SEED					0x9E3779B97F4A7C15ULL
+#define HASH_KEY_MULTIPLIER				0xBF58476D1CE4E5B9ULL
+#define HASH_REPORT_VARIABLE			"RDJ_HASH_REPORT"	// If this environment variable is set, the Distribution of the Hash Keys is printed
+#define BLOOM_BITS_PER_KEY				16		// Size of the Bloom Filters of SIAM and RTS Tables
+#define BLOOM_BITS_PER_WORD				64
+#define TIERS_ARENA_INITIAL_SIZE		65536	// Initial Size of TiersArena in Bytes, doubled when full
+#define TIERS_ARENA_EMPTY_STRING		0		// Offset of the empty String, stored first in TiersArena
+#define TIERS_ARENA_FULL				0xFFFFFFFFU	// Offsets are 32 bits : TiersArena cannot go over 4 GB
+#define TIERS_STRINGS_PER_RECORD		4		// SIAM, RICOS_SC_ID, RICOS_CPY_ID and RTS_SC_ID Strings of a REF_TIERS.dat Record
+
+/* Snapshot of the Reference Tables */
+#define SNAPSHOT_VARIABLE				"RDJ_REF_SNAPSHOT"	// If this environment variable is set, the Tables built from a .dat File are kept in a Snapshot File
+#define SNAPSHOT_FILE_EXTENSION			".pestd.snp"	// The Snapshot File is written next to its .dat File
+#define SNAPSHOT_MAGIC					"RDJSNAP"
+#define SNAPSHOT_VERSION				1		// To be increased when BuildHashKey or the Layout of a Table changes
+#define SNAPSHOT_ALIGNMENT				64		// Each Table of the Snapshot starts on a Cache Line
+#define SNAPSHOT_MAX_SECTIONS			8		// Maximal Number of Tables in a Snapshot
+#define SNAPSHOT_MAX_COUNTERS			4
+#define TIERS_SNAPSHOT_SECTIONS			7		// SIAM Array, Control Bytes and Bloom Filter, the same for RTS, TiersArena
+#define CURRENCY_SNAPSHOT_SECTIONS		2		// CURRENCYDecimalArray and CURRENCYOverflowArray
 
 /* File Handling */
 #define MAX_INPUT_REC_LENGTH			3500
@@ -70,6 +123,59 @@
 #define HEADER_MVT_LABEL				"INV_MARCHE"
 #define HEADER_MVT_LABEL_LENGTH			20
 #define OUTPUT_FILE_EXTENSION			".out"
+
+/* Input File mapped by Windows */
+#define INPUT_MAP_WINDOW_SIZE			(256L * 1024 * 1024)	// Size of the mapped Windows of the Input File
+#define INPUT_STDIO_VARIABLE			"RDJ_INPUT_STDIO"	// If this environment variable is set, the Input File is read with fgets instead of being mapped
+#define INPUT_SCAN_BLOCK_SIZE			64					// Bytes scanned at once for their '\n' and '\0' : one Bit each in a Mask
+#define INPUT_SCAN_BLOCKS				4096				// Blocks scanned in one pass (256 KB)
+#define INPUT_SCAN_RECORDS				4096				// Maximal Number of Records found in one pass
+#define INPUT_SCAN_VARIABLE				"RDJ_INPUT_SCAN"	// "scalar", "sse2" or "avx2" : the Scanner used if it is narrower than the widest one supported
+#define INPUT_SCAN_ZERO_BYTES(w)		((((~((((w) & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | (w))) & 0x8080808080808080ULL) >> 7) * 0x0102040810204080ULL >> 56)	// Bit n set if the Byte n of the Word w is '\0'
+
+/* Output File written by large Blocks */
+#define OUTPUT_BUFFER_ALIGNMENT			4096				// Alignment of the Output Buffers
+#define OUTPUT_MAPPED_OFF_VARIABLE		"RDJ_OUTPUT_MAPPED_OFF"	// If this environment variable is set, the Enrichment Threads hand their Records to main instead of writing them in the mapped Output File
+
+/* Asynchronous I/O : Input File read ahead and Output File written behind the Records handled */
+#define IO_RING_DEPTH_VARIABLE			"RDJ_IO_RING_DEPTH"	// Number of Buffers read or written in flight (0 : Input File mapped, Output File written synchronously)
+#define IO_RING_DEFAULT_DEPTH			4
+#define IO_RING_MIN_DEPTH				2
+#define IO_RING_MAX_DEPTH				64
+#define IO_BUFFER_SIZE_VARIABLE			"RDJ_IO_BUFFER_MB"	// Size of each Buffer, in MB
+#define IO_BUFFER_DEFAULT_MB			8
+#define IO_URING_OFF_VARIABLE			"RDJ_IO_URING_OFF"	// If this environment variable is set, the Requests are handled by a Worker Thread instead of io_uring
+#define IO_REQUEST_READ					0
+#define IO_REQUEST_WRITE				1
+#define IO_REQUEST_FREE					0					// States of a Request
+#define IO_REQUEST_QUEUED				1
+#define IO_REQUEST_DONE					2
+
+/* Streaming inside a Pipe */
+#define STREAM_FILE_NAME				"-"					// Input File read from stdin and Output File written to stdout, the Logs going to stderr
+#define STREAM_OUTPUT_FILE_NAME			"(stdout)"
+
+/* Output Records created in parallel, written in the Order of the Input File */
+#define ENRICH_THREADS_VARIABLE			"RDJ_ENRICH_THREADS"	// Number of Threads creating the Output Records (0 : one by CPU). Default : 1, the Records are created by main
+#define ENRICH_MAX_THREADS				64
+#define ENRICH_BATCHES_BY_THREAD		2					// Batches created while the former ones are written
+#define ENRICH_BATCH_RECORDS			2048				// Maximal Number of Records of a Batch
+#define ENRICH_BATCH_SIZE				(1024L * 1024)		// Size of the Input Records of a Batch, beyond which it is submitted
+#define ENRICH_BATCH_FREE				0					// States of a Batch
+#define ENRICH_BATCH_QUEUED				1
+#define ENRICH_BATCH_DONE				2
+
+/* Compressed Input and Output Files : gzip built with -DRDJ_WITH_ZLIB -lz, zstd with -DRDJ_WITH_ZSTD -lzstd (libzstd 1.4 or later, for ZSTD_compressStream2) */
+#define COMPRESSION_NONE				0
+#define COMPRESSION_GZIP				1
+#define COMPRESSION_ZSTD				2
+#define COMPRESSION_OUTPUT_VARIABLE		"RDJ_OUTPUT_COMPRESSION"	// "gzip" or "zstd", followed by ":Level" if needed : the Output File is compressed
+#define COMPRESSION_GZIP_LEVEL			6
+#define COMPRESSION_GZIP_LEVEL_MAX		9
+#define COMPRESSION_ZSTD_LEVEL			3
+#define COMPRESSION_ZSTD_LEVEL_MAX		22
+#define COMPRESSION_CHUNK_SIZE			(1024L * 1024)		// Size of the Blocks read and written when decompressing the Input File
+
 #define CONFIGURATION_DIRECTORY			"RDJ_DAT"
 #define INPUT_FILE_FORMAT_NAME			"struct_pestd.conf"
 #define INPUT_FILE_SEPARATOR			"|"
@@ -104,6 +210,13 @@
 #define MAX_FIELD_NUMBER_CURRENCY		2	// Number of records in REF_CURRENCY.conf File
 #define CURRENCY_CD_LENGTH				3
 #define EMPTY_CURRENCY					"   "
+#define CURRENCY_LETTER_NUMBER			26	// Codes made of 3 upper case Letters are indexed directly in CURRENCYDecimalArray
+#define CURRENCY_EMPTY_INDEX			(CURRENCY_LETTER_NUMBER * CURRENCY_LETTER_NUMBER * CURRENCY_LETTER_NUMBER)
+#define CURRENCY_DIRECT_ARRAY_SIZE		(CURRENCY_EMPTY_INDEX + 1)
+#define CURRENCY_NOT_INDEXED			-1
+#define CURRENCY_DECIMAL_NOT_FOUND		'\0'
+#define CURRENCY_DEFAULT_DECIMAL_POS	'3'
+#define MAX_CURRENCY_OVERFLOW			50	// Codes of REF_CURRENCY.dat File which are not 3 upper case Letters
 
 char strRefTiersFileFormat[REF_TIERS_RECORD_LENGTH];
 char RefTiersRicos_Record[REF_TIERS_RECORD_LENGTH];
@@ -125,6 +238,17 @@ typedef enum
 	unknown=-1		// Unknown Format
 }	enumFieldFormat;
 
+/* Role of a Field of the Input Record in the building of the Output Record */
+typedef enum 
+{
+	roleMapped=0,				// Field only converted and mapped in the Output Record
+	roleEMISS_CRS=1,			// Emission Date : EMISS_CRS
+	roleCODE_DEVISE_ISO=2,		// Currency : CODE_DEVISE_ISO
+	roleQTE_DECIMALES=3,		// Number of decimals of Amount : QTE_DECIMALES
+	roleI_SIGN_MNT_DEVISE=4,	// Sign of Amount : I_SIGN_MNT_DEVISE
+	roleZ_MNT_ESTD_DEVISE=5		// Amount : Z_MNT_ESTD_DEVISE
+}	enumFieldRole;
+
 /* Data of REF_CURRENCY.dat File */ 
 struct
 {
@@ -143,46 +267,92 @@ struct
 	char strSIA_CIT_TYPE[TIERS_RICOS_LENGTH];
 }	RefTiersFile_Struct;
 
+/* TiersArena : Strings of REF_TIERS.dat File, each distinct String stored once */
+/* SIAMHashArray and RTSHashArray Tables only hold Offsets of these Strings   */
+char			*TiersArena				= NULL;
+unsigned int	uiTiersArenaSize		= 0;
+unsigned int	uiTiersArenaUsed		= 0;
+unsigned int	*TiersInternArray		= NULL;		// Offsets of the Strings of TiersArena by Hash Key - 0 is a free Slot
+long			lTiersInternArraySize	= 0;
+long			lTiersInternStrings		= 0;
+long			lTiersInternRequests	= 0;
+
+#define TIERS_STRING(offset)			(TiersArena + (offset))
+
 /* SIAMHashArray Table */
 typedef struct stSIAMHashElt
 {
-	long long	SIAMHashKey;
-	char 		strSIAM[TIERS_RICOS_LENGTH];
-	char 		strRICOS_SC_ID[TIERS_RICOS_LENGTH];
-	char 		strRICOS_CPY_ID[TIERS_RICOS_LENGTH];
+	long long		SIAMHashKey;
+	unsigned int	uiSIAM;
+	unsigned int	uiRICOS_SC_ID;
+	unsigned int	uiRICOS_CPY_ID;
 }	SIAMHashElt;
 
-struct
-{
-	SIAMHashElt		stElt[HASH_ARRAY_SIZE];
-}	SIAMHashArray[HASH_ARRAY_SIZE];
+SIAMHashElt		*SIAMHashArray			= NULL;
+unsigned char	*SIAMHashCtrl				= NULL;		// One Control Byte per Slot of SIAMHashArray
+long			lSIAMHashArraySize		= 0;
+unsigned long long	*SIAMBloomFilter		= NULL;		// A Key missing in this Filter is missing in SIAMHashArray
+long			lSIAMBloomFilterSize	= 0;
+__thread long	lSIAMKeyFound			= 0;		// Counted by each Thread creating Output Records, then added to the Counters of main
+__thread long	lSIAMKeyNotFound		= 0;
+__thread long	lSIAMKeyFiltered		= 0;		// Keys NOT FOUND by the Bloom Filter only
 
 /* RTSHashArray Table */
 typedef struct stRTSHashElt
 {
-	long long	RTSHashKey;
-	char 		strRTS_SC_ID[TIERS_RICOS_LENGTH];
-	char 		strRICOS_SC_ID[TIERS_RICOS_LENGTH];
-	char 		strRICOS_CPY_ID[TIERS_RICOS_LENGTH];
+	long long		RTSHashKey;
+	unsigned int	uiRTS_SC_ID;
+	unsigned int	uiRICOS_SC_ID;
+	unsigned int	uiRICOS_CPY_ID;
 }	RTSHashElt;
 
-struct
-{
-	RTSHashElt		stElt[HASH_ARRAY_SIZE];
-}	RTSHashArray[HASH_ARRAY_SIZE];
+RTSHashElt		*RTSHashArray			= NULL;
+unsigned char	*RTSHashCtrl				= NULL;		// One Control Byte per Slot of RTSHashArray
+long			lRTSHashArraySize		= 0;
+unsigned long long	*RTSBloomFilter			= NULL;		// A Key missing in this Filter is missing in RTSHashArray
+long			lRTSBloomFilterSize		= 0;
+__thread long	lRTSKeyFound			= 0;		// Counted by each Thread creating Output Records, then added to the Counters of main
+__thread long	lRTSKeyNotFound			= 0;
+__thread long	lRTSKeyFiltered			= 0;		// Keys NOT FOUND by the Bloom Filter only
+
+/* CURRENCY Table : Number of Decimals of each Currency Code, CURRENCY_DECIMAL_NOT_FOUND if the Code is unknown */
+char	CURRENCYDecimalArray[CURRENCY_DIRECT_ARRAY_SIZE];
 
-/* CURRENCYHashArray Table */
-typedef struct stCURRENCYHashElt
+/* Codes of REF_CURRENCY.dat File which cannot be indexed in CURRENCYDecimalArray Table */
+typedef struct stCURRENCYOverflowElt
 {
-	long long	CURRENCYHashKey;
 	char 		strCURRENCY_CD[CURRENCY_CD_LENGTH + 1];
 	char		strDECIMAL_POS[1 + 1];
-}	CURRENCYHashElt;
+}	CURRENCYOverflowElt;
 
-struct
+CURRENCYOverflowElt		CURRENCYOverflowArray[MAX_CURRENCY_OVERFLOW];
+long					lCURRENCYOverflowNumber		= 0;
+
+/* Snapshot File : Header followed by the Tables (Sections) built from a .dat File */
+typedef struct stSnapshotHeader
 {
-	CURRENCYHashElt		stElt[HASH_CURRENCY_ARRAY_SIZE];
-}	CURRENCYHashArray[HASH_CURRENCY_ARRAY_SIZE];
+	char				strMagic[8];
+	unsigned int		uiVersion;
+	unsigned int		uiNbSections;
+	long long			llSourceSize;			// Key of the .dat File : Size, Modification Time and Content Hash
+	long long			llSourceMtime;
+	unsigned long long	ullSourceHash;
+	unsigned long long	ullFormatKey;			// Key of the Layout of the Tables and of the .conf File used
+	unsigned long long	ullPayloadHash;			// Checksum of the Sections
+	long long			llSectionSize[SNAPSHOT_MAX_SECTIONS];
+	long long			llCounter[SNAPSHOT_MAX_COUNTERS];
+}	SnapshotHeader;
+
+typedef struct stSnapshot
+{
+	char			strFileName[MAX_FULL_FILE_NAME_LENGTH + 16];
+	SnapshotHeader	stKey;					// Key expected, then Header of the mapped Snapshot
+	char			*pMapping;				// NULL if the Snapshot is not mapped
+	long			lMappingSize;
+	char			*pSection[SNAPSHOT_MAX_SECTIONS];
+}	Snapshot;
+
+Snapshot				TiersSnapshot;				// SIAM, RTS and TiersArena Tables are in TiersSnapshot when it is mapped
 
 /* Table of the different Fields of the Output File Record */
 struct
@@ -197,6 +367,24 @@ struct
 	int				iFieldStartPosOutput;
 }	tabFieldOfRecord[MAX_FIELD_NUMBER];
 
+/* Plan of the Output File Record : tabFieldOfRecord without the Names and Formats of its Fields, resolved once by BuildOutputRecordFormat */
+typedef struct stFieldPlan
+{
+	enumFieldRole	iFieldRole;
+	enumFieldFormat	iFieldFormat;			// Conversion done by Convert_InputField
+	int				iFieldType;
+	int				iFieldLengthInput;
+	int				iFieldLengthOutput;
+	int				iFieldStartPosInput;
+	int				iFieldStartPosOutput;
+}	FieldPlan;
+
+FieldPlan	tabFieldPlan[MAX_FIELD_NUMBER];
+int			iFieldPlanNumber		= 0;		// Number of Fields in tabFieldPlan
+
+/* Powers of 10 used to rescale the Amounts */
+unsigned long long	ullPowerOf10[AMOUNT_FIELD_LENGTH + 1] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL};
+
 /* Table of the different Fields of the REF_CURRENCY.dat File */
 struct
 {
@@ -225,12 +413,196 @@ struct
 	char Input_Record[MAX_INPUT_REC_LENGTH];
 }	Input_Record_Struct;
 
+/* Compression of the Output File */
+const char *tabCompressionName[]		= { "none", "gzip", "zstd" };
+const char *tabCompressionExtension[]	= { "", ".gz", ".zst" };
+
+typedef struct stCompressor
+{
+	int			iFormat;				// COMPRESSION_GZIP or COMPRESSION_ZSTD
+	void		*pStream;				// z_stream or ZSTD_CCtx
+	char		*pBuffer;				// Compressed Data to write
+	long		lBufferSize;
+	long long	llBytesOut;				// Bytes written in the Output File
+}	Compressor;
+
+/* Input File decompressed by a Thread into a Pipe */
+typedef struct stDecompressor
+{
+	FILE		*pSource;				// Compressed Input File
+	int			iFormat;				// Given by the Magic Bytes of the Input File
+	int			iPipe[2];
+	char		*pReadBuffer;			// stdio Buffer of the Pipe
+	long long	llBytesIn;
+	long long	llBytesOut;
+	int			iError;					// errno, or -1 if the compressed Data are corrupted
+	pthread_t	stThread;
+	int			iStarted;
+}	Decompressor;
+
+Decompressor	InputFile_Decompressor;
+
+/* Request of an asynchronous I/O Ring */
+typedef struct stIORequest
+{
+	int			iFile;
+	int			iOpcode;				// IO_REQUEST_READ or IO_REQUEST_WRITE
+	char		*pBuffer;
+	long		lLength;
+	long long	llOffset;
+	long		lDone;					// Bytes read or written
+	int			iError;					// errno of a failed Request
+	int			iState;					// IO_REQUEST_FREE, IO_REQUEST_QUEUED or IO_REQUEST_DONE
+}	IORequest;
+
+/* Asynchronous I/O Ring : its Requests are handled by io_uring, or by a Worker Thread */
+typedef struct stIORing
+{
+	int				iDepth;					// 0 if the Ring is not started
+	IORequest		stRequest[IO_RING_MAX_DEPTH];
+	int				iUring;					// io_uring File Descriptor, -1 without io_uring
+	char			*pSQRing;
+	long			lSQRingSize;
+	char			*pCQRing;
+	long			lCQRingSize;
+	void			*pSQEntries;
+	long			lSQEntriesSize;
+	unsigned int	*puiSQTail;
+	unsigned int	*puiSQArray;
+	unsigned int	uiSQMask;
+	unsigned int	*puiCQHead;
+	unsigned int	*puiCQTail;
+	unsigned int	uiCQMask;
+	void			*pCQEntries;
+	pthread_t		stWorker;
+	int				iWorkerStarted;
+	pthread_mutex_t	stMutex;
+	pthread_cond_t	stQueued;
+	pthread_cond_t	stDone;
+	int				iQueue[IO_RING_MAX_DEPTH];	// Slots submitted to the Worker Thread, in Order
+	int				iQueueHead;
+	int				iQueueCount;
+	int				iStop;
+	Compressor		*pCompressor;			// Written Blocks compressed first by the Worker Thread
+}	IORing;
+
+/* Input File mapped by Windows : its Records are read in place, as fgets would read them */
+typedef struct stInputMap
+{
+	int			iFile;
+	long long	llFileSize;
+	long long	llWindowOffset;			// Offset in the Input File of the mapped Window
+	long		lWindowSize;
+	char		*pWindow;				// NULL if the Input File is read with fgets
+	long long	llRecordOffset;			// Offset in the Input File of the next Record
+	const char	*pPendingRecord;		// Last Record read in place, not copied in Input_Record_Struct
+	long		lPendingLength;
+	IORing		stRing;					// Started if the Input File is read ahead instead of mapped
+	char		*pBuffers;				// Buffers read ahead, each one after MAX_INPUT_REC_LENGTH free Bytes
+	long		lBufferSize;
+	int			iBuffer;				// Buffer of the current Window
+	long long	llReadOffset;			// Offset in the Input File of the next Read
+	void		(*pScanBlocks)(const char *, long, unsigned long long *, unsigned long long *);
+	unsigned long long	*pullNewLineMasks;	// Masks of the '\n' and '\0' of the scanned Part of the Window
+	unsigned long long	*pullNulMasks;
+	long		*plScanOffset;			// Records found by the last Scan : Offset in the Window,
+	long		*plScanChunk;			// Bytes read up to the '\n' included,
+	long		*plScanLength;			// and Length given by strlen
+	long		lScanRecords;
+	long		lScanNext;				// Next Record of the last Scan to be read
+}	InputMap;
+
+#define INPUT_BUFFER(map, slot)			((map)->pBuffers + (slot) * (MAX_INPUT_REC_LENGTH + (map)->lBufferSize))
+
+InputMap	InputFile_Map;
+long		lInputRecordExtent		= 0;	// Create_Output_Record reads the Input Record up to this Position
+
+/* Output File written by large Blocks from an aligned Buffer */
+typedef struct stOutputWriter
+{
+	int				iFile;
+	char			*pBuffers;				// One Buffer by Slot of the I/O Ring
+	char			*pBuffer;				// Buffer being filled
+	long			lBufferSize;
+	int				iBuffer;
+	IORing			stRing;					// Started if the Buffers are written behind
+	int				iStream;				// TRUE if the Output File is a Pipe or compressed, written at its current Position
+	Compressor		stCompressor;
+	long			lBufferUsed;
+	long long		llBytesWritten;
+	long			lWrites;				// Number of write calls
+	char			*pMapping;				// Output File mapped while the Enrichment Threads write each Record in its Slot
+	long long		llMappingSize;
+	long			lSlotSize;				// Maximal Length of an Output Record and its '\n'
+	struct timespec	stStartTime;
+}	OutputWriter;
+
+OutputWriter	OutputFile_Writer;
+
 /* Output File */
-struct
+typedef struct stOutputRecord
 {
 	char Output_Header[HEADER_LENGTH];
 	char Output_Record[MAX_INPUT_REC_LENGTH + TIERS_RICOS_FIELD_NUMBER * TIERS_RICOS_FIELD_LENGTH];
-}	Output_Record_Struct;
+}	OutputRecord;
+
+OutputRecord	Output_Record_Struct;		// Output Record created by main, each Enrichment Thread having its own one
+OutputRecord	Output_Record_Template;		// Constant Bytes of every Output Record, built by BuildOutputRecordTemplate
+long			lOutputRecordTemplateLength	= 0;	// Bytes of Output_Record_Template copied for each Output Record
+
+/* Messages printed while an Output Record is created : in the Log of its Batch for an Enrichment Thread, stdout if NULL */
+__thread FILE	*RecordLog_Ptr			= NULL;
+
+/* Batch of Records handed to an Enrichment Thread */
+typedef struct stRecordBatch
+{
+	char		*pInput;				// Input Records, each one as Create_Output_Record would read it in Input_Record_Struct
+	long		lInputUsed;
+	long		*plInputOffset;
+	long		*plInputLength;			// Length given by ReadInputRecord
+	char		*pOutput;				// Output Records, without their '\n'
+	long		*plOutputLength;
+	long		lRecords;
+	long		lFirstRecord;			// Number of the first Record of the Batch
+	long		lRejected;				// Index of the Record rejected by Create_Output_Record, -1 if none
+	char		*pLog;					// Messages printed while the Output Records were created
+	size_t		lLogSize;
+	long		lSIAMKeyFound;			// Counters of the Thread while the Output Records were created
+	long		lSIAMKeyNotFound;
+	long		lSIAMKeyFiltered;
+	long		lRTSKeyFound;
+	long		lRTSKeyNotFound;
+	long		lRTSKeyFiltered;
+	int			iState;					// ENRICH_BATCH_FREE, ENRICH_BATCH_QUEUED or ENRICH_BATCH_DONE
+}	RecordBatch;
+
+/* Enrichment Thread : its Context replaces Output_Record_Struct */
+typedef struct stEnrichThread
+{
+	struct stEnrichPool	*pPool;
+	pthread_t			stThread;
+	OutputRecord		stOutputRecord;
+}	EnrichThread;
+
+/* Enrichment Threads : the Batches are taken in the Order they were submitted, and written in the same Order */
+typedef struct stEnrichPool
+{
+	int				iThreads;				// 0 if the Pool is not started : the Output Records are created by main
+	EnrichThread	*pThreads;
+	RecordBatch		*pBatches;
+	int				iBatches;
+	long			lOutputRecordLength;	// Maximal Length of an Output Record
+	OutputWriter	*pWriter;				// If its Output File is mapped, the Records are written in it by the Threads
+	long			lSubmitted;				// Numbers of Batches submitted, taken by a Thread and written
+	long			lTaken;
+	long			lWritten;
+	pthread_mutex_t	stMutex;
+	pthread_cond_t	stQueued;
+	pthread_cond_t	stDone;
+	int				iStop;
+}	EnrichPool;
+
+EnrichPool		Enrich_Pool;
 
 /* 
  * =============================================================================
@@ -282,6 +654,36 @@ int whichOutputFormat (const char *i_strFieldFormat)
 	return unknown;
 }
 
+/* 
+ * =============================================================================
+ *            Which Role for the Field in the Output Record ?
+ * =============================================================================
+ */
+int whichFieldRole (const char *i_strFieldName)
+{
+	if (strcmp(i_strFieldName, "EMISS_CRS") == 0)
+	{
+		return roleEMISS_CRS;
+	}
+	if (strcmp(i_strFieldName, "CODE_DEVISE_ISO") == 0)
+	{
+		return roleCODE_DEVISE_ISO;
+	}
+	if (strcmp(i_strFieldName, "QTE_DECIMALES") == 0)
+	{
+		return roleQTE_DECIMALES;
+	}
+	if (strcmp(i_strFieldName, "I_SIGN_MNT_DEVISE") == 0)
+	{
+		return roleI_SIGN_MNT_DEVISE;
+	}
+	if (strcmp(i_strFieldName, "Z_MNT_ESTD_DEVISE") == 0)
+	{
+		return roleZ_MNT_ESTD_DEVISE;
+	}
+	return roleMapped;
+}
+
 /* 
  * =============================================================================
  *              Is the Year of the Accounting Date a Leap Year ?
@@ -531,6 +933,48 @@ void Trim(char *i_strField)
 	RTrim(i_strField);
 }
 
+/* 
+ * =============================================================================
+ *   Length of a Field read in place : as a string, it ends at its first '\0'
+ * =============================================================================
+ */
+int FieldLength(const char *i_pField, int i_iMaxLength)
+{
+	const char	*l_pEnd		= NULL;
+
+	l_pEnd = (const char *) memchr(i_pField, '\0', i_iMaxLength);
+	return (l_pEnd != NULL) ? l_pEnd - i_pField : i_iMaxLength;
+}
+
+/* 
+ * =============================================================================
+ *   Suppress spaces at the Left and the Right sides of a Field read in place.
+ *   Only its Bounds are moved : the Field itself is not modified.
+ * =============================================================================
+ */
+void TrimField(const char **io_pField, int *io_iLength)
+{
+	while ((*io_iLength > 0) && (**io_pField == ' '))
+	{
+		(*io_pField)++;
+		(*io_iLength)--;
+	}
+	while ((*io_iLength > 0) && ((*io_pField)[*io_iLength - 1] == ' '))
+	{
+		(*io_iLength)--;
+	}
+}
+
+/* 
+ * =============================================================================
+ *   Is a string equal to the i_iLength characters of a Field read in place ?
+ * =============================================================================
+ */
+int isEqualToField(const char *i_strString, const char *i_pField, int i_iLength)
+{
+	return (strncmp(i_strString, i_pField, i_iLength) == 0) && (i_strString[i_iLength] == '\0');
+}
+
 /* 
  * =============================================================================
  *          Is the Field Numeric ? Which is its Sign ?
@@ -754,75 +1198,316 @@ void CorrectFormatAmount(const char *i_strAmount, const char *i_strCurDecimalNr,
 
 /*
  * =============================================================================
- *              Initialize SIAM Hash Key Table
+ *   Write an Amount with 3 Decimals from its Value i_ullAmount, given with
+ *   i_iAmtDecimalNr decimals, as CorrectFormatAmount writes it : Sign, Amount
+ *   (AMOUNT_FIELD_LENGTH digits) and Number of decimals. The rescaling is done
+ *   with integers : no Digit is lost above 2^53 and the Ratio is rounded half
+ *   up. Returns FALSE for the Numbers of decimals of the Currency over 3 which
+ *   CorrectFormatAmount cannot handle.
  * =============================================================================
 */
-void InitializeSIAMHashKeyTable	()
+int FormatAmount3DEC (char i_cSign, unsigned long long i_ullAmount, int i_iAmtDecimalNr, int i_iCurDecimalNr, char *o_strAmount)
 {
-	long	l_lIdX;
-	long	l_lIdY;
-	
-	for (l_lIdX = 0; l_lIdX < HASH_ARRAY_SIZE; l_lIdX++)
+	unsigned long long	l_ullAmount		= i_ullAmount;
+	unsigned long long	l_ullDivisor	= 0;
+	int					l_iShift		= 0;
+	int					l_iIdx			= 0;
+
+	if (i_iCurDecimalNr == i_iAmtDecimalNr)
+	{
+		if (i_iCurDecimalNr > 3)
+		{
+			return FALSE;
+		}
+		l_iShift = 3 - i_iCurDecimalNr;
+	}
+	else
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_ARRAY_SIZE; l_lIdY++)
+		if (i_iCurDecimalNr > i_iAmtDecimalNr)
+		{
+			l_iShift = i_iCurDecimalNr - i_iAmtDecimalNr;
+		}
+		else
 		{
-			SIAMHashArray[l_lIdX].stElt[l_lIdY].SIAMHashKey = -1;
-			memset(SIAMHashArray[l_lIdX].stElt[l_lIdY].strSIAM,        '\0', sizeof(SIAMHashArray[l_lIdX].stElt[l_lIdY].strSIAM));
-			memset(SIAMHashArray[l_lIdX].stElt[l_lIdY].strRICOS_SC_ID, '\0', sizeof(SIAMHashArray[l_lIdX].stElt[l_lIdY].strRICOS_SC_ID));
-			memset(SIAMHashArray[l_lIdX].stElt[l_lIdY].strRICOS_CPY_ID,'\0', sizeof(SIAMHashArray[l_lIdX].stElt[l_lIdY].strRICOS_CPY_ID));
+			if (i_iCurDecimalNr > 3)
+			{
+				return FALSE;
+			}
+			l_ullDivisor = ullPowerOf10[i_iAmtDecimalNr - i_iCurDecimalNr];
+			l_ullAmount  = (l_ullAmount + l_ullDivisor / 2) / l_ullDivisor;
+			l_iShift     = 3 - i_iCurDecimalNr;
 		}
 	}
+	// The Digits moved beyond AMOUNT_FIELD_LENGTH are lost, as in CorrectFormatAmount
+	l_ullAmount = (l_ullAmount % ullPowerOf10[AMOUNT_FIELD_LENGTH - l_iShift]) * ullPowerOf10[l_iShift];
+
+	o_strAmount[0] = i_cSign;
+	for (l_iIdx = AMOUNT_FIELD_LENGTH; l_iIdx > 0; l_iIdx--)
+	{
+		o_strAmount[l_iIdx] = '0' + (char) (l_ullAmount % 10);
+		l_ullAmount /= 10;
+	}
+	o_strAmount[SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH] = AMOUNT_DECIMAL_NR[0];
+	return TRUE;
 }
 
 /*
  * =============================================================================
- *              Initialize RTS Hash Key Table
+ *   Same as CorrectFormatAmount for an Amount made of a Sign, AMOUNT_FIELD_LENGTH
+ *   Digits and its Number of decimals, with integers instead of doubles.
+ *   Returns FALSE for any other Amount, which CorrectFormatAmount must handle.
  * =============================================================================
 */
-void InitializeRTSHashKeyTable	()
+int RescaleAmount3DEC (const char *i_strAmount, char i_cCurDecimalNr, char *o_strAmount)
 {
-	long	l_lIdX;
-	long	l_lIdY;
-	
-	for (l_lIdX = 0; l_lIdX < HASH_ARRAY_SIZE; l_lIdX++)
+	unsigned long long	l_ullAmount	= 0;
+	char				l_cAmtDecimalNr	= i_strAmount[SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH];
+	int					l_iIdx		= 0;
+
+	if ((i_strAmount[0] == '\0') || (l_cAmtDecimalNr == '\0') || (i_strAmount[SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH] != '\0'))
+	{
+		return FALSE;
+	}
+	for (l_iIdx = SIGN_FIELD_LENGTH; l_iIdx < SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH; l_iIdx++)
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_ARRAY_SIZE; l_lIdY++)
+		if ((i_strAmount[l_iIdx] < '0') || (i_strAmount[l_iIdx] > '9'))
 		{
-			RTSHashArray[l_lIdX].stElt[l_lIdY].RTSHashKey = -1;
-			memset(RTSHashArray[l_lIdX].stElt[l_lIdY].strRTS_SC_ID,   '\0', sizeof(RTSHashArray[l_lIdX].stElt[l_lIdY].strRTS_SC_ID));
-			memset(RTSHashArray[l_lIdX].stElt[l_lIdY].strRICOS_SC_ID, '\0', sizeof(RTSHashArray[l_lIdX].stElt[l_lIdY].strRICOS_SC_ID));
-			memset(RTSHashArray[l_lIdX].stElt[l_lIdY].strRICOS_CPY_ID,'\0', sizeof(RTSHashArray[l_lIdX].stElt[l_lIdY].strRICOS_CPY_ID));
+			return FALSE;
 		}
+		l_ullAmount = l_ullAmount * 10 + (i_strAmount[l_iIdx] - '0');
+	}
+	if (! FormatAmount3DEC (i_strAmount[0], l_ullAmount, DIGIT(l_cAmtDecimalNr), DIGIT(i_cCurDecimalNr), o_strAmount))
+	{
+		return FALSE;
 	}
+	o_strAmount[SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH + DECIMAL_NR_FIELD_LENGTH] = '\0';
+	return TRUE;
 }
 
 /*
  * =============================================================================
- *              Initialize CURRENCY Hash Key Table
+ *          Count the Records of a File to size its Hash Key Tables
  * =============================================================================
 */
-void InitializeCURRENCYHashKeyTable	()
+long CountRecordsInFile (const char *i_strFullFileName)
 {
-	long	l_lIdX;
-	long	l_lIdY;
-	
-	for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+	FILE	*l_File_Ptr			= NULL;
+	char	l_strBuffer[65536];
+	char	*l_pCurrent			= NULL;
+	size_t	l_lNbRead			= 0;
+	long	l_lNbRecords		= 0;
+
+	l_File_Ptr = fopen(i_strFullFileName, "r");
+	if (l_File_Ptr == NULL)
 	{
-		for (l_lIdY = 0; l_lIdY < HASH_CURRENCY_ARRAY_SIZE; l_lIdY++)
+		return 0;
+	}
+	while ((l_lNbRead = fread(l_strBuffer, 1, sizeof(l_strBuffer), l_File_Ptr)) > 0)
+	{
+		l_pCurrent = l_strBuffer;
+		while ((l_pCurrent = memchr(l_pCurrent, '\n', l_strBuffer + l_lNbRead - l_pCurrent)) != NULL)
 		{
-			CURRENCYHashArray[l_lIdX].stElt[l_lIdY].CURRENCYHashKey = -1;
-			memset(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strCURRENCY_CD, '\0', sizeof(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strCURRENCY_CD));
-			memset(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strDECIMAL_POS, '\0', sizeof(CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strDECIMAL_POS));
+			l_lNbRecords++;
+			l_pCurrent++;
 		}
 	}
+	fclose(l_File_Ptr);
+	// The last Record may not be ended by '\n'
+	return l_lNbRecords + 1;
+}
+
+/*
+ * =============================================================================
+ *          Evaluate the Size of a Hash Key Table for a Number of Records
+ * =============================================================================
+*/
+long EvaluateHashArraySize (long i_lNbRecords)
+{
+	long	l_lHashArraySize	= HASH_MIN_ARRAY_SIZE;
+
+	while (l_lHashArraySize < i_lNbRecords * HASH_LOAD_FACTOR)
+	{
+		l_lHashArraySize *= 2;
+	}
+	return l_lHashArraySize;
+}
+
+/*
+ * =============================================================================
+ *                       Blocked Bloom Filter
+ *  Each Key sets 4 Bits of a single 64 Bits Word : the Word is given by the
+ *  low Bits of the Hash Key and the 4 Bits by its high Bits. A Key whose Bits
+ *  are not all set has never been added, so a Miss never reaches the Table.
+ * =============================================================================
+*/
+unsigned long long *InitializeBloomFilter (long i_lNbRecords, long *o_lFilterSize)
+{
+	long	l_lFilterSize	= 1;
+
+	while (l_lFilterSize * BLOOM_BITS_PER_WORD < i_lNbRecords * BLOOM_BITS_PER_KEY)
+	{
+		l_lFilterSize *= 2;
+	}
+	*o_lFilterSize = l_lFilterSize;
+	return (unsigned long long *) calloc(l_lFilterSize, sizeof(unsigned long long));
+}
+
+unsigned long long BuildBloomMask (unsigned long long i_ullHashKey)
+{
+	return (1ULL << ((i_ullHashKey >> 40) & 63))
+		 | (1ULL << ((i_ullHashKey >> 46) & 63))
+		 | (1ULL << ((i_ullHashKey >> 52) & 63))
+		 | (1ULL << ((i_ullHashKey >> 58) & 63));
+}
+
+void AddKeyInBloomFilter (unsigned long long *i_pFilter, long i_lFilterSize, unsigned long long i_ullHashKey)
+{
+	i_pFilter[i_ullHashKey & (unsigned long long) (i_lFilterSize - 1)] |= BuildBloomMask (i_ullHashKey);
+}
+
+int FindKeyInBloomFilter (const unsigned long long *i_pFilter, long i_lFilterSize, unsigned long long i_ullHashKey)
+{
+	unsigned long long	l_ullMask	= BuildBloomMask (i_ullHashKey);
+
+	if ((i_pFilter[i_ullHashKey & (unsigned long long) (i_lFilterSize - 1)] & l_ullMask) == l_ullMask)
+	{
+		return HASH_KEY_FOUND;
+	}
+	return HASH_KEY_NOT_FOUND;
+}
+
+/*
+ * =============================================================================
+ *              Initialize SIAM Hash Key Table
+ *  The Tables are allocated with calloc : a zero Control Byte is a free Slot.
+ * =============================================================================
+*/
+int InitializeSIAMHashKeyTable (long i_lNbRecords)
+{
+	lSIAMHashArraySize = EvaluateHashArraySize (i_lNbRecords);
+	SIAMHashArray = (SIAMHashElt *) calloc(lSIAMHashArraySize, sizeof(SIAMHashElt));
+	SIAMHashCtrl  = (unsigned char *) calloc(lSIAMHashArraySize, sizeof(unsigned char));
+	SIAMBloomFilter = InitializeBloomFilter (i_lNbRecords, &lSIAMBloomFilterSize);
+	if ((SIAMHashArray == NULL) || (SIAMHashCtrl == NULL) || (SIAMBloomFilter == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating SIAMHashArray Table (%ld Elements)\n", errno, strerror(errno), lSIAMHashArraySize);
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *              Initialize RTS Hash Key Table
+ *  The Tables are allocated with calloc : a zero Control Byte is a free Slot.
+ * =============================================================================
+*/
+int InitializeRTSHashKeyTable (long i_lNbRecords)
+{
+	lRTSHashArraySize = EvaluateHashArraySize (i_lNbRecords);
+	RTSHashArray = (RTSHashElt *) calloc(lRTSHashArraySize, sizeof(RTSHashElt));
+	RTSHashCtrl  = (unsigned char *) calloc(lRTSHashArraySize, sizeof(unsigned char));
+	RTSBloomFilter = InitializeBloomFilter (i_lNbRecords, &lRTSBloomFilterSize);
+	if ((RTSHashArray == NULL) || (RTSHashCtrl == NULL) || (RTSBloomFilter == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating RTSHashArray Table (%ld Elements)\n", errno, strerror(errno), lRTSHashArraySize);
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *              Initialize CURRENCY Table
+ * =============================================================================
+*/
+void InitializeCURRENCYTable	()
+{
+	memset(CURRENCYDecimalArray, CURRENCY_DECIMAL_NOT_FOUND, sizeof(CURRENCYDecimalArray));
+	lCURRENCYOverflowNumber = 0;
+
+	// An empty Currency Field gives the Default Decimal Number
+	CURRENCYDecimalArray[CURRENCY_EMPTY_INDEX] = CURRENCY_DEFAULT_DECIMAL_POS;
 }	
 
 /*
  * =============================================================================
- *               Build Hash Key used to access SIAM, RTS and  CURRENCY Tables
+ *   Build Hash Key used to access SIAM and RTS Tables
+ *   The Key is read 8 characters at a time : each Word is mixed into the Hash
+ *   Key by a multiplication, the last Word being completed with zeroes. The
+ *   whole Key is used, whatever its Length.
+ * =============================================================================
+*/
+unsigned long long BuildHashKey (const char i_strKey[], long i_lLength)
+{
+	unsigned long long	l_ullHashKey	= HASH_KEY_SEED ^ (unsigned long long) i_lLength;
+	unsigned long long	l_ullWord		= 0;
+	long				l_lIdx			= 0;
+
+	for (l_lIdx = 0; l_lIdx + 8 <= i_lLength; l_lIdx += 8)
+	{
+		memcpy(&l_ullWord, i_strKey + l_lIdx, 8);
+		l_ullHashKey  = (l_ullHashKey ^ l_ullWord) * HASH_KEY_MULTIPLIER;
+		l_ullHashKey ^= l_ullHashKey >> 29;
+	}
+	if (l_lIdx < i_lLength)
+	{
+		l_ullWord = 0;
+		memcpy(&l_ullWord, i_strKey + l_lIdx, i_lLength - l_lIdx);
+		l_ullHashKey  = (l_ullHashKey ^ l_ullWord) * HASH_KEY_MULTIPLIER;
+		l_ullHashKey ^= l_ullHashKey >> 29;
+	}
+	// Final Mixing : every Bit of the Key has an effect on the low Bits (Group) and the high Bits (Fingerprint)
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	l_ullHashKey *= 0xFF51AFD7ED558CCDULL;
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	l_ullHashKey *= 0xC4CEB9FE1A85EC53ULL;
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	// printf(" - [BuildHashKey] - i_strKey = %s, l_ullHashKey = %016llx\n", i_strKey, l_ullHashKey);
+	return l_ullHashKey;
+}
+
+/*
+ * =============================================================================
+ *   Build Hash Key of a Key read in place followed by a Separator : the same
+ *   Hash Key as BuildHashKey gives for the Key and its Separator written one
+ *   after the other.
+ * =============================================================================
+*/
+unsigned long long BuildHashKeyWithSeparator (const char *i_pKey, long i_lLength, char i_cSeparator)
+{
+	unsigned long long	l_ullHashKey	= HASH_KEY_SEED ^ (unsigned long long) (i_lLength + 1);
+	unsigned long long	l_ullWord		= 0;
+	long				l_lIdx			= 0;
+
+	for (l_lIdx = 0; l_lIdx + 8 <= i_lLength; l_lIdx += 8)
+	{
+		memcpy(&l_ullWord, i_pKey + l_lIdx, 8);
+		l_ullHashKey  = (l_ullHashKey ^ l_ullWord) * HASH_KEY_MULTIPLIER;
+		l_ullHashKey ^= l_ullHashKey >> 29;
+	}
+	// Last Word : the end of the Key, then the Separator, completed with zeroes
+	l_ullWord = 0;
+	memcpy(&l_ullWord, i_pKey + l_lIdx, i_lLength - l_lIdx);
+	((char *) &l_ullWord)[i_lLength - l_lIdx] = i_cSeparator;
+	l_ullHashKey  = (l_ullHashKey ^ l_ullWord) * HASH_KEY_MULTIPLIER;
+	l_ullHashKey ^= l_ullHashKey >> 29;
+	// Final Mixing, as in BuildHashKey
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	l_ullHashKey *= 0xFF51AFD7ED558CCDULL;
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	l_ullHashKey *= 0xC4CEB9FE1A85EC53ULL;
+	l_ullHashKey ^= l_ullHashKey >> 33;
+	return l_ullHashKey;
+}
+
+/*
+ * =============================================================================
+ *   Former Hash Key : base 10 Number built from the last MAX_HASH_KEY_LENGTH
+ *   characters of the Key. Only used by ReportHashKeyTable for comparison.
  * =============================================================================
 */
-long BuildHashKey (const char i_strKey[], const long i_HashArraySize, long long *o_llHashKey)
+long BuildFormerHashKey (const char i_strKey[], const long i_HashArraySize, long long *o_llHashKey)
 {
 	long		l_lIdY				= 0;
 	long		l_lLength			= strlen (i_strKey);
@@ -830,7 +1515,7 @@ long BuildHashKey (const char i_strKey[], const long i_HashArraySize, long long
 	long long	l_llCoef			= 1;
 	long long	l_llHashKey			= 0;
 
-	// printf(" - [BuildHashKey] - i_strKey = %s, l_lLength = %ld\n", i_strKey, l_lLength);
+	// printf(" - [BuildFormerHashKey] - i_strKey = %s, l_lLength = %ld\n", i_strKey, l_lLength);
 	for (l_lIdY = l_lLength - 1; l_lIdY >= 0; l_lIdY--)
 	{
 		if ((l_lLength - l_lIdY) <= MAX_HASH_KEY_LENGTH)
@@ -847,183 +1532,496 @@ long BuildHashKey (const char i_strKey[], const long i_HashArraySize, long long
 		}
 		else
 		{
-			// Unexpected Key Length
-			printf(" - [BuildHashKey] - Unexpected Key Length : %ld > %ld. Truncated Hash Key %lld built for Key %s\n", l_lLength, MAX_HASH_KEY_LENGTH, l_llHashKey, i_strKey);
+			// Key truncated
 			l_lIdY = -1;
 		}
 	}
 
 	l_lPositYHashKey = l_llHashKey	% i_HashArraySize;
 	*o_llHashKey     = l_llHashKey;
-	// printf(" - [BuildHashKey] - l_llHashKey = %lld, l_lPositYHashKey = %ld\n", l_llHashKey, l_lPositYHashKey);
+	// printf(" - [BuildFormerHashKey] - l_llHashKey = %lld, l_lPositYHashKey = %ld\n", l_llHashKey, l_lPositYHashKey);
 	return l_lPositYHashKey;
 }
 
 /*
  * =============================================================================
- *                   Add SIAM HaskKey in SIAMHashArray Table
+ *   Locate a Hash Key in a grouped Hash Key Table
+ *   The Slots of a Table are split into Groups of HASH_GROUP_SIZE consecutive
+ *   Slots. The low Bits of the Hash Key give the first Group to probe and its
+ *   7 high Bits the Fingerprint stored in the Control Byte of the Slot, apart
+ *   from the Key strings.
  * =============================================================================
 */
-void AddElementInSIAMHashKeyTable ()
+long LocateHashKey (unsigned long long i_ullHashKey, long i_lHashArraySize, unsigned char *o_ucCtrl)
 {
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	long long   l_llHashKey			= 0;
-
-	l_lPositYHashKey = BuildHashKey (RefTiersFile_Struct.strSIAM, HASH_ARRAY_SIZE, &l_llHashKey);
-
-	for (l_lIdX = 0; l_lIdX < HASH_ARRAY_SIZE; l_lIdX++)
-	{
-		if (SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].SIAMHashKey != -1)
-		{
-			// Free Position not found. Check Duplicate Key
-			if (strcmp(SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strSIAM, RefTiersFile_Struct.strSIAM) == 0)
-			{
-				// printf(" - AddElementInSIAMHashKeyTable - Duplicate Key : Key %s already added in Hash Table\n", RefTiersFile_Struct.strSIAM);
-				l_lIdX = HASH_ARRAY_SIZE;
-			}
-		}
-		else
-		{
-			// Free Position found. Add SIAM HaskKey in SIAMHashArray Table
-			SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].SIAMHashKey = l_llHashKey;
-			strcpy(SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strSIAM, RefTiersFile_Struct.strSIAM);
-			strcpy(SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strRICOS_SC_ID, RefTiersFile_Struct.strRICOS_SC_ID);
-			strcpy(SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strRICOS_CPY_ID, RefTiersFile_Struct.strRICOS_CPY_ID);
-			l_lIdX = HASH_ARRAY_SIZE;
-		}
-	}
+	*o_ucCtrl = HASH_CTRL_USED | (unsigned char) (i_ullHashKey >> 57);
+	return (long) (i_ullHashKey & (unsigned long long) (i_lHashArraySize / HASH_GROUP_SIZE - 1));
 }
 
 /*
  * =============================================================================
- *                   Add RTS_SC_ID HaskKey in RTSHashArray Table
+ *   Bit Mask of the Slots of a Group whose Control Byte is equal to i_ucCtrl
  * =============================================================================
 */
-void AddElementInRTSHashKeyTable ()
+unsigned int MatchHashGroup (const unsigned char *i_pGroupCtrl, unsigned char i_ucCtrl)
 {
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	long long   l_llHashKey			= 0;
+#ifdef __SSE2__
+	__m128i			l_GroupCtrl		= _mm_loadu_si128((const __m128i *) i_pGroupCtrl);
 
-	l_lPositYHashKey = BuildHashKey (RefTiersFile_Struct.strRTS_SC_ID, HASH_ARRAY_SIZE, &l_llHashKey);
+	return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_GroupCtrl, _mm_set1_epi8((char) i_ucCtrl)));
+#else
+	unsigned int	l_uiMask		= 0;
+	int				l_iIdx			= 0;
 
-	for (l_lIdX = 0; l_lIdX < HASH_ARRAY_SIZE; l_lIdX++)
+	for (l_iIdx = 0; l_iIdx < HASH_GROUP_SIZE; l_iIdx++)
 	{
-		if (RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].RTSHashKey != -1)
-		{
-			// Free Position not found. Check Duplicate Key
-			if (strcmp(RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRTS_SC_ID, RefTiersFile_Struct.strRTS_SC_ID) == 0)
-			{
-				// printf(" - AddElementInRTSHashKeyTable - Duplicate Key : Key %s already added in Hash Table\n", RefTiersFile_Struct.strRTS_SC_ID);
-				l_lIdX = HASH_ARRAY_SIZE;
-			}
-		}
-		else
+		if (i_pGroupCtrl[l_iIdx] == i_ucCtrl)
 		{
-			// Free Position found. Add RTS_SC_ID HaskKey in RTSHashArray Table
-			RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].RTSHashKey = l_llHashKey;
-			strcpy(RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRTS_SC_ID, RefTiersFile_Struct.strRTS_SC_ID);
-			strcpy(RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRICOS_SC_ID, RefTiersFile_Struct.strRICOS_SC_ID);
-			strcpy(RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRICOS_CPY_ID, RefTiersFile_Struct.strRICOS_CPY_ID);
-			l_lIdX = HASH_ARRAY_SIZE;
+			l_uiMask |= 1U << l_iIdx;
 		}
 	}
+	return l_uiMask;
+#endif
 }
 
 /*
  * =============================================================================
- *                   Add CURRENCY HaskKey in CURRENCYHashArray Table
+ *   Report the Distribution of the Keys of a grouped Hash Key Table
+ *   The former Hash Key (former static Table of HASH_FORMER_ARRAY_SIZE Chains)
+ *   is compared with the current one : used Buckets and longest Chain against
+ *   used Groups and longest Probe. Probes are counted in Key comparisons for
+ *   the former Table and in Groups for the current one.
  * =============================================================================
 */
-void AddElementInCURRENCYHashKeyTable ()
+void ReportHashKeyTable (const char *i_strTableName, const unsigned char *i_pCtrl, const unsigned int *i_puiFirstKey, size_t i_lEltSize, long i_lHashArraySize)
 {
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	long long   l_llHashKey			= 0;
+	long			*l_plFormerChain		= NULL;
+	const char		*l_pKey					= NULL;
+	long			l_lNbGroups				= i_lHashArraySize / HASH_GROUP_SIZE;
+	long			l_lIdx					= 0;
+	long			l_lPositYHashKey		= 0;
+	long			l_lProbe				= 0;
+	long			l_lNbKeys				= 0;
+	long			l_lNbTruncatedKeys		= 0;
+	long			l_lFormerUsedBuckets	= 0;
+	long			l_lFormerLongestChain	= 0;
+	long			l_lFormerProbes			= 0;
+	long			l_lUsedGroups			= 0;
+	long			l_lLongestProbe			= 0;
+	long			l_lProbes				= 0;
+	long long		l_llFormerHashKey		= 0;
+	unsigned char	l_ucCtrl				= 0;
 
-	l_lPositYHashKey = BuildHashKey (RefCurrencyFile_Struct.strCURRENCY_CD, HASH_CURRENCY_ARRAY_SIZE, &l_llHashKey);
-
-	for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+	l_plFormerChain = (long *) calloc(HASH_FORMER_ARRAY_SIZE, sizeof(long));
+	if (l_plFormerChain == NULL)
+	{
+		return;
+	}
+	for (l_lIdx = 0; l_lIdx < i_lHashArraySize; l_lIdx++)
 	{
-		if (CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].CURRENCYHashKey != -1)
+		if (i_pCtrl[l_lIdx] != HASH_CTRL_EMPTY)
 		{
-			// Free Position not found. Check Duplicate Key
-			if (strcmp(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD) == 0)
+			l_pKey = TIERS_STRING(*(const unsigned int *) ((const char *) i_puiFirstKey + l_lIdx * i_lEltSize));
+			l_lNbKeys++;
+			if (strlen(l_pKey) > MAX_HASH_KEY_LENGTH)
+			{
+				l_lNbTruncatedKeys++;
+			}
+			// Former Hash Key : the Key is at the end of the Chain of its Bucket
+			l_lPositYHashKey = BuildFormerHashKey (l_pKey, HASH_FORMER_ARRAY_SIZE, &l_llFormerHashKey);
+			l_plFormerChain[l_lPositYHashKey]++;
+			l_lFormerProbes += l_plFormerChain[l_lPositYHashKey];
+			// Current Hash Key : Number of Groups probed from the Home Group
+			l_lProbe = (l_lIdx / HASH_GROUP_SIZE - LocateHashKey (BuildHashKey (l_pKey, strlen(l_pKey)), i_lHashArraySize, &l_ucCtrl) + l_lNbGroups) % l_lNbGroups + 1;
+			l_lProbes += l_lProbe;
+			if (l_lProbe > l_lLongestProbe)
 			{
-				// printf(" - [AddElementInCURRENCYHashKeyTable] - Duplicate Key : Key %s already added in Hash Table\n", RefCurrencyFile_Struct.strCURRENCY_CD);
-				l_lIdX = HASH_CURRENCY_ARRAY_SIZE;
+				l_lLongestProbe = l_lProbe;
 			}
 		}
-		else
+	}
+	for (l_lIdx = 0; l_lIdx < HASH_FORMER_ARRAY_SIZE; l_lIdx++)
+	{
+		if (l_plFormerChain[l_lIdx] > 0)
 		{
-			// Free Position found. Add CURRENCY HaskKey in CURRENCYHashArray Table
-			CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].CURRENCYHashKey = l_llHashKey;
-			strcpy(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD);
-			strcpy(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strDECIMAL_POS, RefCurrencyFile_Struct.strDECIMAL_POS);
-			l_lIdX = HASH_CURRENCY_ARRAY_SIZE;
+			l_lFormerUsedBuckets++;
 		}
+		if (l_plFormerChain[l_lIdx] > l_lFormerLongestChain)
+		{
+			l_lFormerLongestChain = l_plFormerChain[l_lIdx];
+		}
+	}
+	for (l_lIdx = 0; l_lIdx < l_lNbGroups; l_lIdx++)
+	{
+		if (MatchHashGroup (i_pCtrl + l_lIdx * HASH_GROUP_SIZE, HASH_CTRL_EMPTY) != (1U << HASH_GROUP_SIZE) - 1)
+		{
+			l_lUsedGroups++;
+		}
+	}
+	free(l_plFormerChain);
+
+	printf("Hash Key Report - %s Table : %ld Keys (%ld longer than %d characters)\n", i_strTableName, l_lNbKeys, l_lNbTruncatedKeys, MAX_HASH_KEY_LENGTH);
+	if (l_lNbKeys > 0)
+	{
+		printf("   - Former  Hash Key : %6ld / %6ld Buckets used - Longest Chain %6ld Keys   - Average Probe %.2f Keys\n",
+					l_lFormerUsedBuckets, (long) HASH_FORMER_ARRAY_SIZE, l_lFormerLongestChain, (double) l_lFormerProbes / l_lNbKeys);
+		printf("   - Current Hash Key : %6ld / %6ld Groups  used - Longest Probe %6ld Groups - Average Probe %.2f Groups\n",
+					l_lUsedGroups, l_lNbGroups, l_lLongestProbe, (double) l_lProbes / l_lNbKeys);
 	}
 }
 
 /*
  * =============================================================================
- *                 Find an Element in SIAMHashArray Table
+ *              Initialize TiersArena and its Intern Table
+ *  The empty String is stored first, at Offset TIERS_ARENA_EMPTY_STRING.
  * =============================================================================
 */
-long FindElementInSIAMHashArrayTable (const char i_strKey[], long *o_lPositXHashKey, long *o_lPositYHashKey)
+int InitializeTiersArena (long i_lNbRecords)
 {
-	char 		l_strKey[MAX_FIELD_LENGTH];
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	int  		l_iSign  			= 0;
-	long long   l_llHashKey			= 0;
+	uiTiersArenaSize = TIERS_ARENA_INITIAL_SIZE;
+	uiTiersArenaUsed = 1;
+	TiersArena = (char *) calloc(uiTiersArenaSize, sizeof(char));
+	lTiersInternArraySize = EvaluateHashArraySize (i_lNbRecords * TIERS_STRINGS_PER_RECORD);
+	TiersInternArray = (unsigned int *) calloc(lTiersInternArraySize, sizeof(unsigned int));
+	if ((TiersArena == NULL) || (TiersInternArray == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating TiersArena Table (%ld Elements)\n", errno, strerror(errno), lTiersInternArraySize);
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
 
-	// Initialize l_strKey
-	strcpy(l_strKey, i_strKey);
-	// Suppress spaces at the Left and the Right sides of l_strKey 
-	Trim(l_strKey);
-	strcat(l_strKey,";");
+/*
+ * =============================================================================
+ *                   Intern a String in TiersArena Table
+ *  Returns the Offset of the String, added if not already in TiersArena,
+ *  or TIERS_ARENA_FULL if TiersArena cannot grow.
+ * =============================================================================
+*/
+unsigned int InternStringInTiersArena (const char i_strString[])
+{
+	long			l_lPosit			= 0;
+	long			l_lLength			= 0;
+	unsigned int	l_uiOffset			= 0;
+	unsigned long long	l_ullNewSize		= 0;
+	char			*l_pNewArena		= NULL;
 
-	// printf(" - [FindElementInSIAMHashArrayTable] - i_strKey = %s, l_strKey = %s.\n", i_strKey, l_strKey);
+	l_lLength = strlen(i_strString);
+	if (l_lLength == 0)
+	{
+		return TIERS_ARENA_EMPTY_STRING;
+	}
+	lTiersInternRequests++;
 
-	if (strlen(l_strKey) > 0)
+	// Linear probing : TiersInternArray is at most half full, a free Slot is always found
+	l_lPosit = BuildHashKey (i_strString, l_lLength) & (lTiersInternArraySize - 1);
+	while (TiersInternArray[l_lPosit] != TIERS_ARENA_EMPTY_STRING)
 	{
-		l_lPositYHashKey = BuildHashKey (l_strKey, HASH_ARRAY_SIZE, &l_llHashKey);
+		if (strcmp(TIERS_STRING(TiersInternArray[l_lPosit]), i_strString) == 0)
+		{
+			return TiersInternArray[l_lPosit];
+		}
+		l_lPosit = (l_lPosit + 1) & (lTiersInternArraySize - 1);
+	}
 
-		// Find l_lIdX Position in SIAMHashArray Table
-		for (l_lIdX = 0; l_lIdX < HASH_ARRAY_SIZE; l_lIdX++)
+	// New String : append it at the end of TiersArena, doubling TiersArena if needed
+	if (uiTiersArenaUsed + (unsigned long long) l_lLength + 1 > uiTiersArenaSize)
+	{
+		l_ullNewSize = uiTiersArenaSize;
+		while (uiTiersArenaUsed + (unsigned long long) l_lLength + 1 > l_ullNewSize)
 		{
-			if (strlen(SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strSIAM) > 0)
-			{		
-				// printf(" - [FindElementInSIAMHashArrayTable] - SIAMHashArray[%03ld].stElt[%03ld].strSIAM = %s.\n", l_lIdX, l_lPositYHashKey, SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strSIAM);
-				if (memcmp(SIAMHashArray[l_lIdX].stElt[l_lPositYHashKey].strSIAM, l_strKey, strlen(l_strKey)) == 0)
-				{
-					// Key found in SIAMHashArray Table
-					*o_lPositXHashKey = l_lIdX;
-					*o_lPositYHashKey = l_lPositYHashKey;
-					return HASH_KEY_FOUND;
-				}
+			l_ullNewSize *= 2;
+		}
+		if (l_ullNewSize > TIERS_ARENA_FULL)
+		{
+			l_ullNewSize = TIERS_ARENA_FULL;
+		}
+		l_pNewArena = (l_ullNewSize > uiTiersArenaSize) ? (char *) realloc(TiersArena, l_ullNewSize) : NULL;
+		if ((l_pNewArena == NULL) || (uiTiersArenaUsed + (unsigned long long) l_lLength + 1 > l_ullNewSize))
+		{
+			printf("Error %d : '%s' occurs when growing TiersArena Table (%u Bytes)\n", errno, strerror(errno), uiTiersArenaSize);
+			return TIERS_ARENA_FULL;
+		}
+		TiersArena = l_pNewArena;
+		uiTiersArenaSize = (unsigned int) l_ullNewSize;
+	}
+	l_uiOffset = uiTiersArenaUsed;
+	memcpy(TiersArena + l_uiOffset, i_strString, l_lLength + 1);
+	uiTiersArenaUsed += l_lLength + 1;
+	TiersInternArray[l_lPosit] = l_uiOffset;
+	lTiersInternStrings++;
+	return l_uiOffset;
+}
+
+/*
+ * =============================================================================
+ *                   Add SIAM HaskKey in SIAMHashArray Table
+ * =============================================================================
+*/
+int AddElementInSIAMHashKeyTable ()
+{
+	long			l_lGroup			= 0;
+	long			l_lPositHashKey		= 0;
+	long			l_lIdx				= 0;
+	unsigned long long	l_ullHashKey		= 0;
+	unsigned int	l_uiMask			= 0;
+	unsigned char	l_ucCtrl			= 0;
+	unsigned int	l_uiKey				= 0;
+	unsigned int	l_uiRICOS_SC_ID		= 0;
+	unsigned int	l_uiRICOS_CPY_ID	= 0;
+
+	l_ullHashKey = BuildHashKey (RefTiersFile_Struct.strSIAM, strlen(RefTiersFile_Struct.strSIAM));
+	l_lGroup = LocateHashKey (l_ullHashKey, lSIAMHashArraySize, &l_ucCtrl);
+
+	for (l_lIdx = 0; l_lIdx < lSIAMHashArraySize / HASH_GROUP_SIZE; l_lIdx++)
+	{
+		// Check Duplicate Key among the Slots of the Group having the same Fingerprint
+		l_uiMask = MatchHashGroup (SIAMHashCtrl + l_lGroup * HASH_GROUP_SIZE, l_ucCtrl);
+		while (l_uiMask != 0)
+		{
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			if (strcmp(TIERS_STRING(SIAMHashArray[l_lPositHashKey].uiSIAM), RefTiersFile_Struct.strSIAM) == 0)
+			{
+				// printf(" - AddElementInSIAMHashKeyTable - Duplicate Key : Key %s already added in Hash Table\n", RefTiersFile_Struct.strSIAM);
+				return EXIT_OK;
 			}
-			else
+			l_uiMask &= l_uiMask - 1;
+		}
+		l_uiMask = MatchHashGroup (SIAMHashCtrl + l_lGroup * HASH_GROUP_SIZE, HASH_CTRL_EMPTY);
+		if (l_uiMask != 0)
+		{
+			// Free Position found. Add SIAM HaskKey in SIAMHashArray Table
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			l_uiKey          = InternStringInTiersArena (RefTiersFile_Struct.strSIAM);
+			l_uiRICOS_SC_ID  = InternStringInTiersArena (RefTiersFile_Struct.strRICOS_SC_ID);
+			l_uiRICOS_CPY_ID = InternStringInTiersArena (RefTiersFile_Struct.strRICOS_CPY_ID);
+			if ((l_uiKey == TIERS_ARENA_FULL) || (l_uiRICOS_SC_ID == TIERS_ARENA_FULL) || (l_uiRICOS_CPY_ID == TIERS_ARENA_FULL))
 			{
-				l_lIdX = HASH_ARRAY_SIZE;
-			}				
+				return EXIT_ERR;
+			}
+			SIAMHashCtrl[l_lPositHashKey] = l_ucCtrl;
+			SIAMHashArray[l_lPositHashKey].SIAMHashKey = l_ullHashKey;
+			AddKeyInBloomFilter (SIAMBloomFilter, lSIAMBloomFilterSize, l_ullHashKey);
+			SIAMHashArray[l_lPositHashKey].uiSIAM = l_uiKey;
+			SIAMHashArray[l_lPositHashKey].uiRICOS_SC_ID = l_uiRICOS_SC_ID;
+			SIAMHashArray[l_lPositHashKey].uiRICOS_CPY_ID = l_uiRICOS_CPY_ID;
+			return EXIT_OK;
 		}
-		// Key NOT found in SIAMHashArray Table
-		printf(" - [FindElementInSIAMHashArrayTable] - SIAM Key %s NOT FOUND in SIAMHashArray Table\n", l_strKey);
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		// Group full : probe the next Group
+		l_lGroup = (l_lGroup + 1) % (lSIAMHashArraySize / HASH_GROUP_SIZE);
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                   Add RTS_SC_ID HaskKey in RTSHashArray Table
+ * =============================================================================
+*/
+int AddElementInRTSHashKeyTable ()
+{
+	long			l_lGroup			= 0;
+	long			l_lPositHashKey		= 0;
+	long			l_lIdx				= 0;
+	unsigned long long	l_ullHashKey		= 0;
+	unsigned int	l_uiMask			= 0;
+	unsigned char	l_ucCtrl			= 0;
+	unsigned int	l_uiKey				= 0;
+	unsigned int	l_uiRICOS_SC_ID		= 0;
+	unsigned int	l_uiRICOS_CPY_ID	= 0;
+
+	l_ullHashKey = BuildHashKey (RefTiersFile_Struct.strRTS_SC_ID, strlen(RefTiersFile_Struct.strRTS_SC_ID));
+	l_lGroup = LocateHashKey (l_ullHashKey, lRTSHashArraySize, &l_ucCtrl);
+
+	for (l_lIdx = 0; l_lIdx < lRTSHashArraySize / HASH_GROUP_SIZE; l_lIdx++)
+	{
+		// Check Duplicate Key among the Slots of the Group having the same Fingerprint
+		l_uiMask = MatchHashGroup (RTSHashCtrl + l_lGroup * HASH_GROUP_SIZE, l_ucCtrl);
+		while (l_uiMask != 0)
+		{
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			if (strcmp(TIERS_STRING(RTSHashArray[l_lPositHashKey].uiRTS_SC_ID), RefTiersFile_Struct.strRTS_SC_ID) == 0)
+			{
+				// printf(" - AddElementInRTSHashKeyTable - Duplicate Key : Key %s already added in Hash Table\n", RefTiersFile_Struct.strRTS_SC_ID);
+				return EXIT_OK;
+			}
+			l_uiMask &= l_uiMask - 1;
+		}
+		l_uiMask = MatchHashGroup (RTSHashCtrl + l_lGroup * HASH_GROUP_SIZE, HASH_CTRL_EMPTY);
+		if (l_uiMask != 0)
+		{
+			// Free Position found. Add RTS_SC_ID HaskKey in RTSHashArray Table
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			l_uiKey          = InternStringInTiersArena (RefTiersFile_Struct.strRTS_SC_ID);
+			l_uiRICOS_SC_ID  = InternStringInTiersArena (RefTiersFile_Struct.strRICOS_SC_ID);
+			l_uiRICOS_CPY_ID = InternStringInTiersArena (RefTiersFile_Struct.strRICOS_CPY_ID);
+			if ((l_uiKey == TIERS_ARENA_FULL) || (l_uiRICOS_SC_ID == TIERS_ARENA_FULL) || (l_uiRICOS_CPY_ID == TIERS_ARENA_FULL))
+			{
+				return EXIT_ERR;
+			}
+			RTSHashCtrl[l_lPositHashKey] = l_ucCtrl;
+			RTSHashArray[l_lPositHashKey].RTSHashKey = l_ullHashKey;
+			AddKeyInBloomFilter (RTSBloomFilter, lRTSBloomFilterSize, l_ullHashKey);
+			RTSHashArray[l_lPositHashKey].uiRTS_SC_ID = l_uiKey;
+			RTSHashArray[l_lPositHashKey].uiRICOS_SC_ID = l_uiRICOS_SC_ID;
+			RTSHashArray[l_lPositHashKey].uiRICOS_CPY_ID = l_uiRICOS_CPY_ID;
+			return EXIT_OK;
+		}
+		// Group full : probe the next Group
+		l_lGroup = (l_lGroup + 1) % (lRTSHashArraySize / HASH_GROUP_SIZE);
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *         Build the Index of a Currency Code in CURRENCYDecimalArray Table
+ *   "AAA" .. "ZZZ" give 0 .. 17575, EMPTY_CURRENCY gives CURRENCY_EMPTY_INDEX
+ *   Any other Code gives CURRENCY_NOT_INDEXED. The Code is given by its
+ *   i_iLength characters at i_pCurrency.
+ * =============================================================================
+*/
+long BuildCurrencyIndex (const char *i_pCurrency, int i_iLength)
+{
+	if (i_iLength == 3
+	 && (unsigned char) (i_pCurrency[0] - 'A') < CURRENCY_LETTER_NUMBER
+	 && (unsigned char) (i_pCurrency[1] - 'A') < CURRENCY_LETTER_NUMBER
+	 && (unsigned char) (i_pCurrency[2] - 'A') < CURRENCY_LETTER_NUMBER)
+	{
+		return ((i_pCurrency[0] - 'A') * CURRENCY_LETTER_NUMBER + (i_pCurrency[1] - 'A')) * CURRENCY_LETTER_NUMBER + (i_pCurrency[2] - 'A');
+	}
+	if (isEqualToField(EMPTY_CURRENCY, i_pCurrency, i_iLength))
+	{
+		return CURRENCY_EMPTY_INDEX;
+	}
+	return CURRENCY_NOT_INDEXED;
+}
+
+/*
+ * =============================================================================
+ *                   Add CURRENCY Code in CURRENCYDecimalArray Table
+ * =============================================================================
+*/
+void AddElementInCURRENCYTable ()
+{
+	long		l_lIndex			= 0;
+	long		l_lIdX				= 0;
+
+	l_lIndex = BuildCurrencyIndex (RefCurrencyFile_Struct.strCURRENCY_CD, strlen(RefCurrencyFile_Struct.strCURRENCY_CD));
+	if ((l_lIndex != CURRENCY_NOT_INDEXED) && (l_lIndex != CURRENCY_EMPTY_INDEX))
+	{
+		if (CURRENCYDecimalArray[l_lIndex] == CURRENCY_DECIMAL_NOT_FOUND)
+		{
+			CURRENCYDecimalArray[l_lIndex] = RefCurrencyFile_Struct.strDECIMAL_POS[0];
+		}
+		// else
+		// {
+		// 	printf(" - [AddElementInCURRENCYTable] - Duplicate Key : Key %s already added in CURRENCY Table\n", RefCurrencyFile_Struct.strCURRENCY_CD);
+		// }
 	}
 	else
 	{
-		// Key is only filled by spaces
-		// printf(" - [FindElementInSIAMHashArrayTable] - SIAM Key is Empty\n");
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		// Code with spaces, digits or lower case Letters : kept in CURRENCYOverflowArray Table
+		for (l_lIdX = 0; l_lIdX < lCURRENCYOverflowNumber; l_lIdX++)
+		{
+			if (strcmp(CURRENCYOverflowArray[l_lIdX].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD) == 0)
+			{
+				// printf(" - [AddElementInCURRENCYTable] - Duplicate Key : Key %s already added in CURRENCY Table\n", RefCurrencyFile_Struct.strCURRENCY_CD);
+				return;
+			}
+		}
+		if (lCURRENCYOverflowNumber < MAX_CURRENCY_OVERFLOW)
+		{
+			strcpy(CURRENCYOverflowArray[lCURRENCYOverflowNumber].strCURRENCY_CD, RefCurrencyFile_Struct.strCURRENCY_CD);
+			strcpy(CURRENCYOverflowArray[lCURRENCYOverflowNumber].strDECIMAL_POS, RefCurrencyFile_Struct.strDECIMAL_POS);
+			lCURRENCYOverflowNumber++;
+		}
+		else
+		{
+			printf("Too many Currency Codes which are not 3 upper case Letters : Currency \"%s\" ignored\n", RefCurrencyFile_Struct.strCURRENCY_CD);
+		}
+	}
+}
+
+/*
+ * =============================================================================
+ *   Print a Message about the Record being created, in RecordLog_Ptr
+ * =============================================================================
+*/
+void PrintRecordLog (const char *i_strFormat, ...)
+{
+	va_list		l_Arguments;
+
+	va_start(l_Arguments, i_strFormat);
+	vfprintf((RecordLog_Ptr != NULL) ? RecordLog_Ptr : stdout, i_strFormat, l_Arguments);
+	va_end(l_Arguments);
+}
+
+/*
+ * =============================================================================
+ *                 Find an Element in SIAMHashArray Table
+ * =============================================================================
+*/
+long FindElementInSIAMHashArrayTable (const char *i_pKey, int i_iKeyLength, long *o_lPositHashKey)
+{
+	const char		*l_pSIAM			= NULL;
+	long			l_lGroup			= 0;
+	long			l_lPositHashKey		= 0;
+	long			l_lIdx				= 0;
+	unsigned long long	l_ullHashKey		= 0;
+	unsigned int	l_uiMask			= 0;
+	unsigned char	l_ucCtrl			= 0;
+
+	// Suppress spaces at the Left and the Right sides of the Key, read in place
+	TrimField(&i_pKey, &i_iKeyLength);
+
+	// printf(" - [FindElementInSIAMHashArrayTable] - Key = %.*s;.\n", i_iKeyLength, i_pKey);
+
+	// The SIAM Keys of the Table end with ';' : the Key with its ';' is never empty, even when only filled by spaces
+	l_ullHashKey = BuildHashKeyWithSeparator (i_pKey, i_iKeyLength, ';');
+	l_lGroup = LocateHashKey (l_ullHashKey, lSIAMHashArraySize, &l_ucCtrl);
+
+	// Probe the Groups up to the first one having a free Slot, unless the Bloom Filter tells that the Key is missing
+	if (FindKeyInBloomFilter (SIAMBloomFilter, lSIAMBloomFilterSize, l_ullHashKey) == HASH_KEY_NOT_FOUND)
+	{
+		l_lIdx = lSIAMHashArraySize;
+		lSIAMKeyFiltered++;
+	}
+	else
+	{
+		l_lIdx = 0;
+	}
+	for (; l_lIdx < lSIAMHashArraySize / HASH_GROUP_SIZE; l_lIdx++)
+	{
+		l_uiMask = MatchHashGroup (SIAMHashCtrl + l_lGroup * HASH_GROUP_SIZE, l_ucCtrl);
+		while (l_uiMask != 0)
+		{
+			l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+			l_pSIAM = TIERS_STRING(SIAMHashArray[l_lPositHashKey].uiSIAM);
+			// printf(" - [FindElementInSIAMHashArrayTable] - SIAMHashArray[%06ld].uiSIAM = %s.\n", l_lPositHashKey, l_pSIAM);
+			if ((strncmp(l_pSIAM, i_pKey, i_iKeyLength) == 0) && (l_pSIAM[i_iKeyLength] == ';') && (l_pSIAM[i_iKeyLength + 1] == '\0'))
+			{
+				// Key found in SIAMHashArray Table
+				lSIAMKeyFound++;
+				*o_lPositHashKey = l_lPositHashKey;
+				return HASH_KEY_FOUND;
+			}
+			l_uiMask &= l_uiMask - 1;
+		}
+		if (MatchHashGroup (SIAMHashCtrl + l_lGroup * HASH_GROUP_SIZE, HASH_CTRL_EMPTY) != 0)
+		{
+			l_lIdx = lSIAMHashArraySize;
+		}
+		else
+		{
+			l_lGroup = (l_lGroup + 1) % (lSIAMHashArraySize / HASH_GROUP_SIZE);
+		}
 	}
+	// Key NOT found in SIAMHashArray Table
+	PrintRecordLog(" - [FindElementInSIAMHashArrayTable] - SIAM Key %.*s; NOT FOUND in SIAMHashArray Table\n", i_iKeyLength, i_pKey);
+	lSIAMKeyNotFound++;
+	*o_lPositHashKey = -1;
+	return HASH_KEY_NOT_FOUND;
 }
 
 /*
@@ -1031,199 +2029,494 @@ long FindElementInSIAMHashArrayTable (const char i_strKey[], long *o_lPositXHash
  *                 Find an Element in RTSHashArray Table
  * =============================================================================
 */
-long FindElementInRTSHashArrayTable (const char i_strKey[], long *o_lPositXHashKey, long *o_lPositYHashKey)
+long FindElementInRTSHashArrayTable (const char *i_pKey, int i_iKeyLength, long *o_lPositHashKey)
 {
-	char 		l_strKey[MAX_FIELD_LENGTH];
-	long		l_lPositYHashKey	= 0;
-	long		l_lIdX				= 0;
-	int  		l_iSign  			= 0;
-	long long   l_llHashKey			= 0;
+	const char		*l_pRTS				= NULL;
+	long			l_lGroup			= 0;
+	long			l_lPositHashKey		= 0;
+	long			l_lIdx				= 0;
+	unsigned long long	l_ullHashKey		= 0;
+	unsigned int	l_uiMask			= 0;
+	unsigned char	l_ucCtrl			= 0;
 
-	// Initialize l_strKey
-	strcpy(l_strKey, i_strKey);
-	// Suppress spaces at the Left and the Right sides of l_strKey 
-	Trim(l_strKey);
+	// Suppress spaces at the Left and the Right sides of the Key, read in place
+	TrimField(&i_pKey, &i_iKeyLength);
 
-	// printf(" - [FindElementInRTSHashArrayTable] - i_strKey = %s, l_strKey = %s.\n", i_strKey, l_strKey);
-	
-	if (strlen(l_strKey) > 0)
+	// printf(" - [FindElementInRTSHashArrayTable] - Key = %.*s.\n", i_iKeyLength, i_pKey);
+
+	if (i_iKeyLength > 0)
 	{
-		l_lPositYHashKey = BuildHashKey (l_strKey, HASH_ARRAY_SIZE, &l_llHashKey);
+		l_ullHashKey = BuildHashKey (i_pKey, i_iKeyLength);
+		l_lGroup = LocateHashKey (l_ullHashKey, lRTSHashArraySize, &l_ucCtrl);
 
-		// Find l_lIdX Position in RTSHashArray Table
-		for (l_lIdX = 0; l_lIdX < HASH_ARRAY_SIZE; l_lIdX++)
+		// Probe the Groups up to the first one having a free Slot, unless the Bloom Filter tells that the Key is missing
+		if (FindKeyInBloomFilter (RTSBloomFilter, lRTSBloomFilterSize, l_ullHashKey) == HASH_KEY_NOT_FOUND)
+		{
+			l_lIdx = lRTSHashArraySize;
+			lRTSKeyFiltered++;
+		}
+		else
+		{
+			l_lIdx = 0;
+		}
+		for (; l_lIdx < lRTSHashArraySize / HASH_GROUP_SIZE; l_lIdx++)
 		{
-			if (strlen(RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRTS_SC_ID) > 0)
-			{		
-				// printf(" - [FindElementInRTSHashArrayTable] - RTSHashArray[%03ld].stElt[%03ld].strRTS_SC_ID = %s.\n", l_lIdX, l_lPositYHashKey, RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRTS_SC_ID);
-				if (memcmp(RTSHashArray[l_lIdX].stElt[l_lPositYHashKey].strRTS_SC_ID, l_strKey, strlen(l_strKey)) == 0)
+			l_uiMask = MatchHashGroup (RTSHashCtrl + l_lGroup * HASH_GROUP_SIZE, l_ucCtrl);
+			while (l_uiMask != 0)
+			{
+				l_lPositHashKey = l_lGroup * HASH_GROUP_SIZE + __builtin_ctz(l_uiMask);
+				l_pRTS = TIERS_STRING(RTSHashArray[l_lPositHashKey].uiRTS_SC_ID);
+				// printf(" - [FindElementInRTSHashArrayTable] - RTSHashArray[%06ld].uiRTS_SC_ID = %s.\n", l_lPositHashKey, l_pRTS);
+				if (isEqualToField(l_pRTS, i_pKey, i_iKeyLength))
 				{
 					// Key found in RTSHashArray Table
-					*o_lPositXHashKey = l_lIdX;
-					*o_lPositYHashKey = l_lPositYHashKey;
+					lRTSKeyFound++;
+					*o_lPositHashKey = l_lPositHashKey;
 					return HASH_KEY_FOUND;
 				}
+				l_uiMask &= l_uiMask - 1;
+			}
+			if (MatchHashGroup (RTSHashCtrl + l_lGroup * HASH_GROUP_SIZE, HASH_CTRL_EMPTY) != 0)
+			{
+				l_lIdx = lRTSHashArraySize;
 			}
 			else
 			{
-				l_lIdX = HASH_ARRAY_SIZE;
-			}			
+				l_lGroup = (l_lGroup + 1) % (lRTSHashArraySize / HASH_GROUP_SIZE);
+			}
 		}
 		// Key NOT found in RTSHashArray Table
-		printf(" - [FindElementInRTSHashArrayTable] - RTS Key %s NOT FOUND in RTSHashArray Table\n", l_strKey);
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
+		PrintRecordLog(" - [FindElementInRTSHashArrayTable] - RTS Key %.*s NOT FOUND in RTSHashArray Table\n", i_iKeyLength, i_pKey);
+		lRTSKeyNotFound++;
+		*o_lPositHashKey = -1;
 		return HASH_KEY_NOT_FOUND;
 	}
 	else
 	{
 		// Key is only filled by spaces
 		// printf(" - [FindElementInRTSHashArrayTable] - RTS Key is Empty\n");
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
+		*o_lPositHashKey = -1;
 		return HASH_KEY_NOT_FOUND;
 	}
 }
 
 /*
  * =============================================================================
- *                 Find an Element in CURRENCYHashArray Table
+ *                 Find the Decimal Number of a Currency Code
+ *   Returns CURRENCY_DECIMAL_NOT_FOUND if the Code is unknown. The Code is
+ *   read in place : i_iLength characters at i_pCurrency.
  * =============================================================================
 */
-long FindElementInCURRENCYHashArrayTable (const char i_strKey[], long *o_lPositXHashKey, long *o_lPositYHashKey)
+char FindDecimalPosInCURRENCYTable (const char *i_pCurrency, int i_iLength)
 {
-	char 		l_strKey[MAX_FIELD_LENGTH];
-	long		l_lPositYHashKey	= 0;
+	long		l_lIndex			= 0;
 	long		l_lIdX				= 0;
-	int  		l_iSign  			= 0;
-	long long   l_llHashKey			= 0;
 
-	// Initialize l_strKey
-	strcpy(l_strKey, i_strKey);
+	// Usual Case : 3 upper case Letters or EMPTY_CURRENCY, only one access to CURRENCYDecimalArray Table
+	l_lIndex = BuildCurrencyIndex (i_pCurrency, i_iLength);
+	if (l_lIndex != CURRENCY_NOT_INDEXED)
+	{
+		return CURRENCYDecimalArray[l_lIndex];
+	}
 
-	// Suppress spaces at the Left and the Right sides of l_strKey
-	Trim(l_strKey);
+	// Suppress spaces at the Left and the Right sides of the Code
+	TrimField(&i_pCurrency, &i_iLength);
 	
-	if (strlen(l_strKey) > 0)
+	if (i_iLength > 0)
 	{
-		l_lPositYHashKey = BuildHashKey (l_strKey, HASH_CURRENCY_ARRAY_SIZE, &l_llHashKey);
-
-		// Find l_lIdX Position in CURRENCYHashArray Table
-		for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+		l_lIndex = BuildCurrencyIndex (i_pCurrency, i_iLength);
+		if (l_lIndex != CURRENCY_NOT_INDEXED)
 		{
-			if (strcmp(CURRENCYHashArray[l_lIdX].stElt[l_lPositYHashKey].strCURRENCY_CD, l_strKey) == 0)
+			return CURRENCYDecimalArray[l_lIndex];
+		}
+		for (l_lIdX = 0; l_lIdX < lCURRENCYOverflowNumber; l_lIdX++)
+		{
+			if (isEqualToField(CURRENCYOverflowArray[l_lIdX].strCURRENCY_CD, i_pCurrency, i_iLength))
 			{
-				// Key found in CURRENCYHashArray Table
-				*o_lPositXHashKey = l_lIdX;
-				*o_lPositYHashKey = l_lPositYHashKey;
-				return HASH_KEY_FOUND;
+				return CURRENCYOverflowArray[l_lIdX].strDECIMAL_POS[0];
 			}
 		}
-		// Key not found in CURRENCYHashArray Table
-		// printf(" - [FindElementInCURRENCYHashArrayTable] - CURRENCY Key %s NOT FOUND in CURRENCYHashArray Table\n", l_strKey);
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		// printf(" - [FindDecimalPosInCURRENCYTable] - CURRENCY Key %.*s NOT FOUND in CURRENCY Table\n", i_iLength, i_pCurrency);
 	}
-	else
+	// else
+	// {
+	// 	Key is only filled by spaces
+	// 	printf(" - [FindDecimalPosInCURRENCYTable] - CURRENCY Key is Empty\n");
+	// }
+	return CURRENCY_DECIMAL_NOT_FOUND;
+}
+
+/*
+ * =============================================================================
+ *   Unmap the Snapshot of a Reference File
+ * =============================================================================
+*/
+void CloseSnapshot (Snapshot *io_pSnapshot)
+{
+	if (io_pSnapshot->pMapping != NULL)
 	{
-		// Key is only filled by spaces
-		// printf(" - [FindElementInCURRENCYHashArrayTable] - CURRENCY Key is Empty\n");
-		*o_lPositXHashKey = -1;
-		*o_lPositYHashKey = -1;
-		return HASH_KEY_NOT_FOUND;
+		munmap(io_pSnapshot->pMapping, io_pSnapshot->lMappingSize);
+		io_pSnapshot->pMapping     = NULL;
+		io_pSnapshot->lMappingSize = 0;
 	}
 }
 
-/* 
+/*
  * =============================================================================
- *  Building Format of REF_TIERS.dat File using REF_TIERS.conf File
+ *   Open the Snapshot of a Reference File : Key of the Source File
+ *   The Key is the Size, the Modification Time and the Content Hash of the
+ *   .dat File, with the Layout of the Tables built from it (i_ullFormatKey).
  * =============================================================================
- */
-int BuildRefTiersRecordFormat()
+*/
+int OpenSnapshot (Snapshot *o_pSnapshot, const char *i_strSourceFileName, unsigned long long i_ullFormatKey)
 {
-	FILE *l_RefTiersFile_RecordFormat_Ptr	= NULL;
-	char  l_strFullRefTiersFileFormatName[MAX_FULL_FILE_NAME_LENGTH];
-	char  l_strRefTiersField[REF_TIERS_FIELD_NAME_LENGTH];
-	int   l_iTiersFieldNumber				= -1;
-	int   l_iTiersFieldLength				= 0;
+	struct stat	l_SourceFile_Stat;
+	int			l_iSourceFile		= -1;
+	char		*l_pSource			= NULL;
 
-	/* Opening REF_TIERS.conf File : structure of REF_TIERS.dat File */
-	strcpy(l_strFullRefTiersFileFormatName, strConfigurationDirectory);
-	strcat(l_strFullRefTiersFileFormatName, "/");
-	strcat(l_strFullRefTiersFileFormatName, REF_TIERS_FORMAT_FILE_NAME);
-	
-	printf("Opening %s File ...\n", l_strFullRefTiersFileFormatName);
-	l_RefTiersFile_RecordFormat_Ptr = fopen(l_strFullRefTiersFileFormatName, "r");
-	if (l_RefTiersFile_RecordFormat_Ptr == NULL)
-	{
-		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefTiersFileFormatName);
-		return EXIT_ERR;
-	}
+	memset(o_pSnapshot, '\0', sizeof(Snapshot));
+	strcpy(o_pSnapshot->strFileName, i_strSourceFileName);
+	strcat(o_pSnapshot->strFileName, SNAPSHOT_FILE_EXTENSION);
 
-	/* Reading Records of REF_TIERS.conf File : Each Record gives the Name of a Field of REF_TIERS.dat File Record */
-	while (fgets(l_strRefTiersField, REF_TIERS_FIELD_NAME_LENGTH, l_RefTiersFile_RecordFormat_Ptr) != NULL)
+	l_iSourceFile = open(i_strSourceFileName, O_RDONLY);
+	if ((l_iSourceFile < 0) || (fstat(l_iSourceFile, &l_SourceFile_Stat) != 0))
 	{
-		if (strlen(l_strRefTiersField) > 1)
+		if (l_iSourceFile >= 0)
 		{
-			// Handle only not empty records
-			l_iTiersFieldNumber++;
-			
-			if (memcmp(l_strRefTiersField, "SIA_CIT_TYPE", 12) == 0)
-			{
-				// Last Field of REF_TIERS.conf File
-				memcpy(strRefTiersFileFormat + l_iTiersFieldLength, l_strRefTiersField, strlen(l_strRefTiersField) - 1);
-				l_iTiersFieldLength = l_iTiersFieldLength + strlen(l_strRefTiersField) - 1;
-				strRefTiersFileFormat[l_iTiersFieldLength] = '\0';
-			}
-			else
-			{
-				memcpy(strRefTiersFileFormat + l_iTiersFieldLength, l_strRefTiersField, strlen(l_strRefTiersField) - 1);
-				l_iTiersFieldLength = l_iTiersFieldLength + strlen(l_strRefTiersField) - 1;
-				memcpy(strRefTiersFileFormat + l_iTiersFieldLength, REF_TIERS_SEPARATOR, 1);
-				l_iTiersFieldLength = l_iTiersFieldLength + 1;
-			}
+			close(l_iSourceFile);
 		}
+		return EXIT_ERR;
 	}
-	// strRefTiersFileFormat must be equal to : "SIAM;RICOS_SC_ID;RICOS_CPY_ID;RTS_SC_ID;SC_INTITULE_USUEL;SIA_CIT_TYPE"
-	if (memcmp(strRefTiersFileFormat, "SIAM;RICOS_SC_ID;RICOS_CPY_ID;RTS_SC_ID;SC_INTITULE_USUEL;SIA_CIT_TYPE", 70) != 0)
+	if (l_SourceFile_Stat.st_size > 0)
 	{
-		printf("Unexpected Format for %s File : %s\n", l_strFullRefTiersFileFormatName, strRefTiersFileFormat);
-		return EXIT_ERR;
+		l_pSource = (char *) mmap(NULL, l_SourceFile_Stat.st_size, PROT_READ, MAP_PRIVATE, l_iSourceFile, 0);
+		if (l_pSource == MAP_FAILED)
+		{
+			close(l_iSourceFile);
+			return EXIT_ERR;
+		}
+		o_pSnapshot->stKey.ullSourceHash = BuildHashKey (l_pSource, l_SourceFile_Stat.st_size);
+		munmap(l_pSource, l_SourceFile_Stat.st_size);
 	}
-	/* Closing REF_TIERS.conf File */
-	printf("Closing %s File ...\n", l_strFullRefTiersFileFormatName);
-	fclose(l_RefTiersFile_RecordFormat_Ptr);
+	close(l_iSourceFile);
+
+	memcpy(o_pSnapshot->stKey.strMagic, SNAPSHOT_MAGIC, sizeof(o_pSnapshot->stKey.strMagic));
+	o_pSnapshot->stKey.uiVersion     = SNAPSHOT_VERSION;
+	o_pSnapshot->stKey.llSourceSize  = l_SourceFile_Stat.st_size;
+	o_pSnapshot->stKey.llSourceMtime = l_SourceFile_Stat.st_mtime;
+	o_pSnapshot->stKey.ullFormatKey  = i_ullFormatKey;
 	return EXIT_OK;
 }
 
-/* 
+/*
  * =============================================================================
- *  Building TIERS RICOS Tables using SIAM and RTS TIERS in REF_TIERS.dat File
+ *   Map the Snapshot of a Reference File read-only
+ *   Returns EXIT_ERR if the Snapshot is missing, stale or corrupted : the
+ *   .dat File must then be parsed. Otherwise pSection gives each Table.
  * =============================================================================
- */
-int BuildTiersRicosTables()
+*/
+int LoadSnapshot (Snapshot *io_pSnapshot, int i_iNbSections)
 {
-	FILE *l_RefTiersRicosFile_Ptr	= NULL;
-	char  l_strFullRefTiersFileName[MAX_FULL_FILE_NAME_LENGTH];
-	int  l_iIdx						= 0;
-	int  l_iSepPositInRecord		= 0;
-	int  l_iNbSepInRecord			= 0;
-	int  l_iRecNumber				= 0;
-	long SIAMHashKey				= 0;
-	long RTSHashKey					= 0;
-	long long l_llHashKeySIAM		= 0;
-	long long l_llHashKeyRTS		= 0;
+	struct stat		l_SnapshotFile_Stat;
+	SnapshotHeader	*l_pHeader				= NULL;
+	int				l_iSnapshotFile			= -1;
+	int				l_iIdx					= 0;
+	long long		l_llPayloadSize			= 0;
+
+	l_iSnapshotFile = open(io_pSnapshot->strFileName, O_RDONLY);
+	if (l_iSnapshotFile < 0)
+	{
+		return EXIT_ERR;
+	}
+	if ((fstat(l_iSnapshotFile, &l_SnapshotFile_Stat) != 0) || (l_SnapshotFile_Stat.st_size < (off_t) sizeof(SnapshotHeader)))
+	{
+		close(l_iSnapshotFile);
+		return EXIT_ERR;
+	}
+	io_pSnapshot->pMapping = (char *) mmap(NULL, l_SnapshotFile_Stat.st_size, PROT_READ, MAP_PRIVATE, l_iSnapshotFile, 0);
+	close(l_iSnapshotFile);
+	if (io_pSnapshot->pMapping == MAP_FAILED)
+	{
+		io_pSnapshot->pMapping = NULL;
+		return EXIT_ERR;
+	}
+	io_pSnapshot->lMappingSize = l_SnapshotFile_Stat.st_size;
+	l_pHeader = (SnapshotHeader *) io_pSnapshot->pMapping;
+
+	// Same Version, same Source File and same Layout
+	if ((memcmp(l_pHeader->strMagic, io_pSnapshot->stKey.strMagic, sizeof(l_pHeader->strMagic)) != 0)
+	||  (l_pHeader->uiVersion     != io_pSnapshot->stKey.uiVersion)
+	||  (l_pHeader->uiNbSections  != (unsigned int) i_iNbSections)
+	||  (l_pHeader->llSourceSize  != io_pSnapshot->stKey.llSourceSize)
+	||  (l_pHeader->llSourceMtime != io_pSnapshot->stKey.llSourceMtime)
+	||  (l_pHeader->ullSourceHash != io_pSnapshot->stKey.ullSourceHash)
+	||  (l_pHeader->ullFormatKey  != io_pSnapshot->stKey.ullFormatKey))
+	{
+		printf("Snapshot %s is stale ...\n", io_pSnapshot->strFileName);
+		CloseSnapshot (io_pSnapshot);
+		return EXIT_ERR;
+	}
+
+	// Sections are stored after the Header, each one aligned on SNAPSHOT_ALIGNMENT Bytes
+	l_llPayloadSize = 0;
+	for (l_iIdx = 0; l_iIdx < i_iNbSections; l_iIdx++)
+	{
+		if ((l_pHeader->llSectionSize[l_iIdx] < 0) || (l_pHeader->llSectionSize[l_iIdx] > io_pSnapshot->lMappingSize))
+		{
+			l_llPayloadSize = io_pSnapshot->lMappingSize;
+			l_iIdx = i_iNbSections;
+		}
+		else
+		{
+			io_pSnapshot->pSection[l_iIdx] = io_pSnapshot->pMapping + sizeof(SnapshotHeader) + l_llPayloadSize;
+			l_llPayloadSize += (l_pHeader->llSectionSize[l_iIdx] + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+		}
+	}
+	if (((long long) sizeof(SnapshotHeader) + l_llPayloadSize != io_pSnapshot->lMappingSize)
+	||  (BuildHashKey (io_pSnapshot->pMapping + sizeof(SnapshotHeader), l_llPayloadSize) != l_pHeader->ullPayloadHash))
+	{
+		printf("Snapshot %s is corrupted ...\n", io_pSnapshot->strFileName);
+		CloseSnapshot (io_pSnapshot);
+		return EXIT_ERR;
+	}
+	io_pSnapshot->stKey = *l_pHeader;
+	printf("Loading %s Snapshot ...\n", io_pSnapshot->strFileName);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Write the Snapshot of a Reference File once its Tables are built
+ *   The Snapshot is written in a temporary File renamed at the end, so that a
+ *   concurrent Run never maps a partial Snapshot. A failure is only reported.
+ * =============================================================================
+*/
+void WriteSnapshot (Snapshot *io_pSnapshot, int i_iNbSections, const void *i_pSection[], const long i_lSectionSize[])
+{
+	FILE		*l_SnapshotFile_Ptr		= NULL;
+	char		l_strTmpFileName[MAX_FULL_FILE_NAME_LENGTH + 32];
+	char		*l_pPayload				= NULL;
+	long long	l_llPayloadSize			= 0;
+	long long	l_llSectionPosit		= 0;
+	int			l_iIdx					= 0;
+	int			l_iWritten				= 0;
+
+	io_pSnapshot->stKey.uiNbSections = i_iNbSections;
+	for (l_iIdx = 0; l_iIdx < i_iNbSections; l_iIdx++)
+	{
+		io_pSnapshot->stKey.llSectionSize[l_iIdx] = i_lSectionSize[l_iIdx];
+		l_llPayloadSize += (i_lSectionSize[l_iIdx] + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	}
+
+	// The Checksum is computed on the Payload as written, Padding included
+	l_pPayload = (char *) calloc(l_llPayloadSize + 1, sizeof(char));
+	if (l_pPayload == NULL)
+	{
+		printf("Error %d : '%s' occurs when writing %s Snapshot\n", errno, strerror(errno), io_pSnapshot->strFileName);
+		return;
+	}
+	for (l_iIdx = 0; l_iIdx < i_iNbSections; l_iIdx++)
+	{
+		memcpy(l_pPayload + l_llSectionPosit, i_pSection[l_iIdx], i_lSectionSize[l_iIdx]);
+		l_llSectionPosit += (i_lSectionSize[l_iIdx] + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	}
+	io_pSnapshot->stKey.ullPayloadHash = BuildHashKey (l_pPayload, l_llPayloadSize);
+
+	sprintf(l_strTmpFileName, "%s.%ld", io_pSnapshot->strFileName, (long) getpid());
+	l_SnapshotFile_Ptr = fopen(l_strTmpFileName, "w");
+	if (l_SnapshotFile_Ptr != NULL)
+	{
+		l_iWritten = (fwrite(&io_pSnapshot->stKey, sizeof(SnapshotHeader), 1, l_SnapshotFile_Ptr) == 1)
+				  && ((l_llPayloadSize == 0) || (fwrite(l_pPayload, l_llPayloadSize, 1, l_SnapshotFile_Ptr) == 1));
+		l_iWritten = (fclose(l_SnapshotFile_Ptr) == 0) && l_iWritten;
+		l_iWritten = l_iWritten && (rename(l_strTmpFileName, io_pSnapshot->strFileName) == 0);
+	}
+	if (l_iWritten)
+	{
+		printf("Writing %s Snapshot ...\n", io_pSnapshot->strFileName);
+	}
+	else
+	{
+		printf("Error %d : '%s' occurs when writing %s Snapshot\n", errno, strerror(errno), io_pSnapshot->strFileName);
+		remove(l_strTmpFileName);
+	}
+	free(l_pPayload);
+}
+
+/* 
+ * =============================================================================
+ *  Building Format of REF_TIERS.dat File using REF_TIERS.conf File
+ * =============================================================================
+ */
+int BuildRefTiersRecordFormat()
+{
+	FILE *l_RefTiersFile_RecordFormat_Ptr	= NULL;
+	char  l_strFullRefTiersFileFormatName[MAX_FULL_FILE_NAME_LENGTH];
+	char  l_strRefTiersField[REF_TIERS_FIELD_NAME_LENGTH];
+	int   l_iTiersFieldNumber				= -1;
+	int   l_iTiersFieldLength				= 0;
 
-	/* Initializing SIAM and RTS Hash Key Tables */
-	InitializeSIAMHashKeyTable ();
-	InitializeRTSHashKeyTable ();
+	/* Opening REF_TIERS.conf File : structure of REF_TIERS.dat File */
+	strcpy(l_strFullRefTiersFileFormatName, strConfigurationDirectory);
+	strcat(l_strFullRefTiersFileFormatName, "/");
+	strcat(l_strFullRefTiersFileFormatName, REF_TIERS_FORMAT_FILE_NAME);
 	
+	printf("Opening %s File ...\n", l_strFullRefTiersFileFormatName);
+	l_RefTiersFile_RecordFormat_Ptr = fopen(l_strFullRefTiersFileFormatName, "r");
+	if (l_RefTiersFile_RecordFormat_Ptr == NULL)
+	{
+		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), l_strFullRefTiersFileFormatName);
+		return EXIT_ERR;
+	}
+
+	/* Reading Records of REF_TIERS.conf File : Each Record gives the Name of a Field of REF_TIERS.dat File Record */
+	while (fgets(l_strRefTiersField, REF_TIERS_FIELD_NAME_LENGTH, l_RefTiersFile_RecordFormat_Ptr) != NULL)
+	{
+		if (strlen(l_strRefTiersField) > 1)
+		{
+			// Handle only not empty records
+			l_iTiersFieldNumber++;
+			
+			if (memcmp(l_strRefTiersField, "SIA_CIT_TYPE", 12) == 0)
+			{
+				// Last Field of REF_TIERS.conf File
+				memcpy(strRefTiersFileFormat + l_iTiersFieldLength, l_strRefTiersField, strlen(l_strRefTiersField) - 1);
+				l_iTiersFieldLength = l_iTiersFieldLength + strlen(l_strRefTiersField) - 1;
+				strRefTiersFileFormat[l_iTiersFieldLength] = '\0';
+			}
+			else
+			{
+				memcpy(strRefTiersFileFormat + l_iTiersFieldLength, l_strRefTiersField, strlen(l_strRefTiersField) - 1);
+				l_iTiersFieldLength = l_iTiersFieldLength + strlen(l_strRefTiersField) - 1;
+				memcpy(strRefTiersFileFormat + l_iTiersFieldLength, REF_TIERS_SEPARATOR, 1);
+				l_iTiersFieldLength = l_iTiersFieldLength + 1;
+			}
+		}
+	}
+	// strRefTiersFileFormat must be equal to : "SIAM;RICOS_SC_ID;RICOS_CPY_ID;RTS_SC_ID;SC_INTITULE_USUEL;SIA_CIT_TYPE"
+	if (memcmp(strRefTiersFileFormat, "SIAM;RICOS_SC_ID;RICOS_CPY_ID;RTS_SC_ID;SC_INTITULE_USUEL;SIA_CIT_TYPE", 70) != 0)
+	{
+		printf("Unexpected Format for %s File : %s\n", l_strFullRefTiersFileFormatName, strRefTiersFileFormat);
+		return EXIT_ERR;
+	}
+	/* Closing REF_TIERS.conf File */
+	printf("Closing %s File ...\n", l_strFullRefTiersFileFormatName);
+	fclose(l_RefTiersFile_RecordFormat_Ptr);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *       Map SIAM, RTS and TiersArena Tables from the Snapshot of REF_TIERS.dat
+ * =============================================================================
+*/
+int LoadTiersRicosSnapshot ()
+{
+	if (LoadSnapshot (&TiersSnapshot, TIERS_SNAPSHOT_SECTIONS) == EXIT_ERR)
+	{
+		return EXIT_ERR;
+	}
+	SIAMHashArray			= (SIAMHashElt *) TiersSnapshot.pSection[0];
+	SIAMHashCtrl			= (unsigned char *) TiersSnapshot.pSection[1];
+	SIAMBloomFilter			= (unsigned long long *) TiersSnapshot.pSection[2];
+	RTSHashArray			= (RTSHashElt *) TiersSnapshot.pSection[3];
+	RTSHashCtrl				= (unsigned char *) TiersSnapshot.pSection[4];
+	RTSBloomFilter			= (unsigned long long *) TiersSnapshot.pSection[5];
+	TiersArena				= TiersSnapshot.pSection[6];
+	lSIAMHashArraySize		= TiersSnapshot.stKey.llSectionSize[0] / sizeof(SIAMHashElt);
+	lSIAMBloomFilterSize	= TiersSnapshot.stKey.llSectionSize[2] / sizeof(unsigned long long);
+	lRTSHashArraySize		= TiersSnapshot.stKey.llSectionSize[3] / sizeof(RTSHashElt);
+	lRTSBloomFilterSize		= TiersSnapshot.stKey.llSectionSize[5] / sizeof(unsigned long long);
+	uiTiersArenaSize		= TiersSnapshot.stKey.llSectionSize[6];
+	uiTiersArenaUsed		= TiersSnapshot.stKey.llSectionSize[6];
+	lTiersInternStrings		= TiersSnapshot.stKey.llCounter[0];
+	lTiersInternRequests	= TiersSnapshot.stKey.llCounter[1];
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *         Write SIAM, RTS and TiersArena Tables in the Snapshot of REF_TIERS.dat
+ * =============================================================================
+*/
+void WriteTiersRicosSnapshot ()
+{
+	const void	*l_pSection[TIERS_SNAPSHOT_SECTIONS];
+	long		l_lSectionSize[TIERS_SNAPSHOT_SECTIONS];
+
+	l_pSection[0] = SIAMHashArray;		l_lSectionSize[0] = lSIAMHashArraySize * sizeof(SIAMHashElt);
+	l_pSection[1] = SIAMHashCtrl;		l_lSectionSize[1] = lSIAMHashArraySize * sizeof(unsigned char);
+	l_pSection[2] = SIAMBloomFilter;	l_lSectionSize[2] = lSIAMBloomFilterSize * sizeof(unsigned long long);
+	l_pSection[3] = RTSHashArray;		l_lSectionSize[3] = lRTSHashArraySize * sizeof(RTSHashElt);
+	l_pSection[4] = RTSHashCtrl;		l_lSectionSize[4] = lRTSHashArraySize * sizeof(unsigned char);
+	l_pSection[5] = RTSBloomFilter;		l_lSectionSize[5] = lRTSBloomFilterSize * sizeof(unsigned long long);
+	l_pSection[6] = TiersArena;			l_lSectionSize[6] = uiTiersArenaUsed;
+	TiersSnapshot.stKey.llCounter[0] = lTiersInternStrings;
+	TiersSnapshot.stKey.llCounter[1] = lTiersInternRequests;
+	WriteSnapshot (&TiersSnapshot, TIERS_SNAPSHOT_SECTIONS, l_pSection, l_lSectionSize);
+}
+
+/*
+ * =============================================================================
+ *          Report on SIAM, RTS and TiersArena Tables once they are built
+ * =============================================================================
+*/
+void ReportTiersRicosTables ()
+{
+	printf("REF_TIERS String Arena ........ : %u Bytes, %ld Strings (%ld Strings shared)\n", uiTiersArenaUsed, lTiersInternStrings, lTiersInternRequests - lTiersInternStrings);
+
+	/* Distribution of the Keys in SIAM and RTS Hash Key Tables */
+	if (getenv(HASH_REPORT_VARIABLE) != NULL)
+	{
+		ReportHashKeyTable ("SIAM", SIAMHashCtrl, &SIAMHashArray[0].uiSIAM,     sizeof(SIAMHashElt), lSIAMHashArraySize);
+		ReportHashKeyTable ("RTS",  RTSHashCtrl,  &RTSHashArray[0].uiRTS_SC_ID, sizeof(RTSHashElt),  lRTSHashArraySize);
+	}
+}
+
+/* 
+ * =============================================================================
+ *  Building TIERS RICOS Tables using SIAM and RTS TIERS in REF_TIERS.dat File
+ * =============================================================================
+ */
+int BuildTiersRicosTables()
+{
+	FILE *l_RefTiersRicosFile_Ptr	= NULL;
+	char  l_strFullRefTiersFileName[MAX_FULL_FILE_NAME_LENGTH];
+	int  l_iIdx						= 0;
+	int  l_iSepPositInRecord		= 0;
+	int  l_iNbSepInRecord			= 0;
+	int  l_iRecNumber				= 0;
+	long SIAMHashKey				= 0;
+	long RTSHashKey					= 0;
+	long long l_llHashKeySIAM		= 0;
+	long long l_llHashKeyRTS		= 0;
+	long l_lNbRecords				= 0;
+	int  l_iSnapshot				= FALSE;
+	long l_lSnapshotFormat[]		= { sizeof(SIAMHashElt), sizeof(RTSHashElt), HASH_MIN_ARRAY_SIZE, HASH_LOAD_FACTOR, BLOOM_BITS_PER_KEY };
+
 	/* Opening REF_TIERS.dat File */
 	strcpy(l_strFullRefTiersFileName, strConfigurationDirectory);
 	strcat(l_strFullRefTiersFileName, "/");
 	strcat(l_strFullRefTiersFileName, REF_TIERS_FILE_NAME);
 
+	/* SIAM and RTS Hash Key Tables of the Snapshot of REF_TIERS.dat File, if it is up to date */
+	if (getenv(SNAPSHOT_VARIABLE) != NULL)
+	{
+		l_iSnapshot = (OpenSnapshot (&TiersSnapshot, l_strFullRefTiersFileName, BuildHashKey ((const char *) l_lSnapshotFormat, sizeof(l_lSnapshotFormat))) == EXIT_OK);
+		if (l_iSnapshot && (LoadTiersRicosSnapshot () == EXIT_OK))
+		{
+			ReportTiersRicosTables ();
+			return EXIT_OK;
+		}
+	}
+
+	/* Initializing SIAM and RTS Hash Key Tables sized by the Number of Records of REF_TIERS.dat File */
+	l_lNbRecords = CountRecordsInFile (l_strFullRefTiersFileName);
+	if ((InitializeSIAMHashKeyTable (l_lNbRecords) == EXIT_ERR) || (InitializeRTSHashKeyTable (l_lNbRecords) == EXIT_ERR) || (InitializeTiersArena (l_lNbRecords) == EXIT_ERR))
+	{
+		return EXIT_ERR;
+	}
+
 	printf("Opening %s File ...\n", l_strFullRefTiersFileName);
 	l_RefTiersRicosFile_Ptr = fopen(l_strFullRefTiersFileName, "r");
 	if (l_RefTiersRicosFile_Ptr == NULL)
@@ -1300,11 +2593,19 @@ int BuildTiersRicosTables()
 					// printf(" - [BuildTiersRicosTables] - %s Record %03d : %s. \t\t| %s. \t\t| %s. \t\t| %s. \t\t| %s. \t\t| %s.\n", REF_TIERS_FILE_NAME, l_iRecNumber, RefTiersFile_Struct.strSIAM, RefTiersFile_Struct.strRICOS_SC_ID, RefTiersFile_Struct.strRICOS_CPY_ID, RefTiersFile_Struct.strRTS_SC_ID, RefTiersFile_Struct.strSC_INTITULE_USUEL, RefTiersFile_Struct.strSIA_CIT_TYPE);
 					if (strlen(RefTiersFile_Struct.strSIAM) > 0)
 					{
-						AddElementInSIAMHashKeyTable ();
+						if (AddElementInSIAMHashKeyTable () == EXIT_ERR)
+						{
+							fclose(l_RefTiersRicosFile_Ptr);
+							return EXIT_ERR;
+						}
 					}
 					if (strlen(RefTiersFile_Struct.strRTS_SC_ID) > 0)
 					{
-						AddElementInRTSHashKeyTable ();
+						if (AddElementInRTSHashKeyTable () == EXIT_ERR)
+						{
+							fclose(l_RefTiersRicosFile_Ptr);
+							return EXIT_ERR;
+						}
 					}
 				}
 			}
@@ -1313,6 +2614,13 @@ int BuildTiersRicosTables()
 	/* Closing REF_TIERS.dat File */
 	printf("Closing %s File ...\n", l_strFullRefTiersFileName);
 	fclose(l_RefTiersRicosFile_Ptr);
+	ReportTiersRicosTables ();
+
+	/* Snapshot of the Tables for the next Runs */
+	if (l_iSnapshot)
+	{
+		WriteTiersRicosSnapshot ();
+	}
 	return EXIT_OK;
 }	
 
@@ -1427,16 +2735,33 @@ int BuildCurrencyTable()
 	int  l_iNbSepInRecord			= 0;
 	int  l_iRecNumber				= -1;
 	int  l_iRecRejected             = -1;
-	long CURRENCYHashKey			= 0;
-	long long l_llHashKeyCURRENCY	= 0;
+	int  l_iSnapshot				= FALSE;
+	long l_lSnapshotFormat[]		= { sizeof(CURRENCYDecimalArray), sizeof(CURRENCYOverflowArray), tabFieldOfRefCurrencyRecord[0].iFieldLength, tabFieldOfRefCurrencyRecord[1].iFieldLength, tabFieldOfRefCurrencyRecord[0].iFieldStartSepPosition };
+	Snapshot	l_CurrencySnapshot;
+	const void	*l_pSection[CURRENCY_SNAPSHOT_SECTIONS];
+	long		l_lSectionSize[CURRENCY_SNAPSHOT_SECTIONS];
 
-	/* Initializing CURRENCY Hash Key Table */
-	InitializeCURRENCYHashKeyTable ();
+	/* Initializing CURRENCY Table */
+	InitializeCURRENCYTable ();
 	
 	/* Opening REF_CURRENCY.dat File */
 	strcpy(l_strFullRefCurrencyFileName, strConfigurationDirectory);
 	strcat(l_strFullRefCurrencyFileName, "/");
 	strcat(l_strFullRefCurrencyFileName, REF_CURRENCY_FILE_NAME);
+
+	/* CURRENCY Table copied from the Snapshot of REF_CURRENCY.dat File, if it is up to date */
+	if (getenv(SNAPSHOT_VARIABLE) != NULL)
+	{
+		l_iSnapshot = (OpenSnapshot (&l_CurrencySnapshot, l_strFullRefCurrencyFileName, BuildHashKey ((const char *) l_lSnapshotFormat, sizeof(l_lSnapshotFormat))) == EXIT_OK);
+		if (l_iSnapshot && (LoadSnapshot (&l_CurrencySnapshot, CURRENCY_SNAPSHOT_SECTIONS) == EXIT_OK))
+		{
+			memcpy(CURRENCYDecimalArray,  l_CurrencySnapshot.pSection[0], sizeof(CURRENCYDecimalArray));
+			memcpy(CURRENCYOverflowArray, l_CurrencySnapshot.pSection[1], sizeof(CURRENCYOverflowArray));
+			lCURRENCYOverflowNumber = l_CurrencySnapshot.stKey.llCounter[0];
+			CloseSnapshot (&l_CurrencySnapshot);
+			return EXIT_OK;
+		}
+	}
 	
 	printf("Opening %s File ...\n", l_strFullRefCurrencyFileName);
 	l_CurrencyFile_Ptr = fopen(l_strFullRefCurrencyFileName, "r");
@@ -1507,7 +2832,7 @@ int BuildCurrencyTable()
 							// printf(" - [BuildCurrencyTable] - %s Record %03d : %s \t\t| %s \n", l_strFullRefCurrencyFileName, l_iRecNumber + 1, RefCurrencyFile_Struct.strCURRENCY_CD, RefCurrencyFile_Struct.strDECIMAL_POS);
 							if (strlen(RefCurrencyFile_Struct.strCURRENCY_CD) > 0)
 							{
-								AddElementInCURRENCYHashKeyTable ();
+								AddElementInCURRENCYTable ();
 							}
 						}
 					}
@@ -1524,17 +2849,184 @@ int BuildCurrencyTable()
 	/* Closing REF_CURRENCY.dat File */
 	printf("Closing %s File ...\n", l_strFullRefCurrencyFileName);
 	fclose(l_CurrencyFile_Ptr);
+
+	/* Snapshot of the Table for the next Runs */
+	if (l_iSnapshot)
+	{
+		l_pSection[0] = CURRENCYDecimalArray;	l_lSectionSize[0] = sizeof(CURRENCYDecimalArray);
+		l_pSection[1] = CURRENCYOverflowArray;	l_lSectionSize[1] = sizeof(CURRENCYOverflowArray);
+		l_CurrencySnapshot.stKey.llCounter[0] = lCURRENCYOverflowNumber;
+		WriteSnapshot (&l_CurrencySnapshot, CURRENCY_SNAPSHOT_SECTIONS, l_pSection, l_lSectionSize);
+	}
 	return EXIT_OK;
 }
 
+/*
+ * =============================================================================
+ *   Bit Masks of the Digits, the spaces and the Signs among the i_iLength
+ *   Characters of a Numeric Field (at most NUMERIC_SCAN_LENGTH), classified
+ *   NUMERIC_SCAN_WIDTH Characters at once
+ * =============================================================================
+*/
+void MatchNumericField (const char *i_strField, int i_iLength, unsigned long long *o_ullDigit, unsigned long long *o_ullSpace, unsigned long long *o_ullSign)
+{
+	int				l_iIdx			= 0;
+#ifdef __SSE2__
+	char			l_strField[NUMERIC_SCAN_LENGTH];
+	__m128i			l_Chars;
+	__m128i			l_Digits;
+
+	// The Field is copied so that its last Characters can be loaded at once
+	memcpy(l_strField, i_strField, i_iLength);
+	memset(l_strField + i_iLength, '\0', (NUMERIC_SCAN_WIDTH - i_iLength % NUMERIC_SCAN_WIDTH) % NUMERIC_SCAN_WIDTH);
+	*o_ullDigit = 0;
+	*o_ullSpace = 0;
+	*o_ullSign  = 0;
+	for (l_iIdx = 0; l_iIdx < i_iLength; l_iIdx += NUMERIC_SCAN_WIDTH)
+	{
+		l_Chars  = _mm_loadu_si128((const __m128i *) (l_strField + l_iIdx));
+		// '0' to '9' become 0 to 9 : any other Character is negative or over 9
+		l_Digits = _mm_sub_epi8(l_Chars, _mm_set1_epi8('0'));
+		*o_ullDigit |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(l_Digits, _mm_set1_epi8(-1)), _mm_cmplt_epi8(l_Digits, _mm_set1_epi8(10)))) << l_iIdx;
+		*o_ullSpace |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Chars, _mm_set1_epi8(' '))) << l_iIdx;
+		*o_ullSign  |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(l_Chars, _mm_set1_epi8('+')), _mm_cmpeq_epi8(l_Chars, _mm_set1_epi8('-')))) << l_iIdx;
+	}
+#else
+	*o_ullDigit = 0;
+	*o_ullSpace = 0;
+	*o_ullSign  = 0;
+	for (l_iIdx = 0; l_iIdx < i_iLength; l_iIdx++)
+	{
+		if ((i_strField[l_iIdx] >= '0') && (i_strField[l_iIdx] <= '9'))
+		{
+			*o_ullDigit |= 1ULL << l_iIdx;
+		}
+		else if (i_strField[l_iIdx] == ' ')
+		{
+			*o_ullSpace |= 1ULL << l_iIdx;
+		}
+		else if ((i_strField[l_iIdx] == '+') || (i_strField[l_iIdx] == '-'))
+		{
+			*o_ullSign |= 1ULL << l_iIdx;
+		}
+	}
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Convert a Numeric Field (entierEG, entierZG, entierSG, entierSZG, entierSD
+ *   or entierSZD) from the Bit Masks of its Characters, as isNumeric and
+ *   Convert_InputField would : spaces, contiguous Digits and spaces, with one
+ *   Sign at most outside the Digits. The i_iInputLength characters at
+ *   i_pInputField are read in place and the padded Output Field is written
+ *   directly. Returns FALSE for any other Field, which Convert_InputField
+ *   must convert.
+ * =============================================================================
+*/
+int ConvertNumericField (const char *i_pInputField, int i_iInputLength, const FieldPlan *i_pField, char *o_strOutputField)
+{
+	unsigned long long	l_ullDigit			= 0;
+	unsigned long long	l_ullSpace			= 0;
+	unsigned long long	l_ullSign			= 0;
+	unsigned long long	l_ullField			= 0;
+	int					l_iLength			= i_iInputLength;
+	int					l_iOutputLength		= i_pField->iFieldLengthOutput;
+	int					l_iFirstDigit		= 0;
+	int					l_iDigitNumber		= 0;
+	int					l_iSign				= 1;
+	int					l_iSignSide			= 0;		// -1 : Sign at the Left side, 1 : at the Right side, 0 : no Sign
+	char				l_cPadding			= ' ';
+
+	switch (i_pField->iFieldFormat)
+	{
+		case entierEG	:	l_cPadding = ' ';	l_iSignSide =  0;	break;
+		case entierZG	:	l_cPadding = '0';	l_iSignSide =  0;	break;
+		case entierSG	:	l_cPadding = ' ';	l_iSignSide = -1;	break;
+		case entierSZG	:	l_cPadding = '0';	l_iSignSide = -1;	break;
+		case entierSD	:	l_cPadding = ' ';	l_iSignSide =  1;	break;
+		case entierSZD	:	l_cPadding = '0';	l_iSignSide =  1;	break;
+		default			:	return FALSE;
+	}
+	if ((l_iLength <= 0) || (l_iLength > NUMERIC_SCAN_LENGTH) || (l_iOutputLength <= 0))
+	{
+		return FALSE;
+	}
+	MatchNumericField (i_pInputField, l_iLength, &l_ullDigit, &l_ullSpace, &l_ullSign);
+	l_ullField = (l_iLength == NUMERIC_SCAN_LENGTH) ? ~0ULL : (1ULL << l_iLength) - 1;
+	// Only Digits, spaces and one Sign at most
+	if (((l_ullDigit | l_ullSpace | l_ullSign) != l_ullField) || ((l_ullSign & (l_ullSign - 1)) != 0))
+	{
+		return FALSE;
+	}
+	if (l_ullDigit != 0)
+	{
+		l_iFirstDigit  = __builtin_ctzll(l_ullDigit);
+		l_iDigitNumber = 64 - __builtin_clzll(l_ullDigit) - l_iFirstDigit;
+		// The Digits must be contiguous
+		if (((l_ullDigit >> l_iFirstDigit) & ((l_ullDigit >> l_iFirstDigit) + 1)) != 0)
+		{
+			return FALSE;
+		}
+	}
+	if ((l_ullSign != 0) && (i_pInputField[__builtin_ctzll(l_ullSign)] == '-'))
+	{
+		l_iSign = -1;
+	}
+	if (l_iDigitNumber > l_iOutputLength - ((l_iSignSide > 0) ? 1 : 0))
+	{
+		return FALSE;
+	}
+
+	memset(o_strOutputField, l_cPadding, l_iOutputLength);
+	if (l_iSignSide < 0)
+	{
+		o_strOutputField[0] = SIGN(l_iSign);
+	}
+	if (l_iSignSide > 0)
+	{
+		memcpy(o_strOutputField + l_iOutputLength - l_iDigitNumber - 1, i_pInputField + l_iFirstDigit, l_iDigitNumber);
+		o_strOutputField[l_iOutputLength - 1] = SIGN(l_iSign);
+	}
+	else
+	{
+		memcpy(o_strOutputField + l_iOutputLength - l_iDigitNumber, i_pInputField + l_iFirstDigit, l_iDigitNumber);
+	}
+	return TRUE;
+}
+
+/* 
+ * =============================================================================
+ *   Original Value of a Field without Formating : the i_iFieldLength first
+ *   characters of its string copy i_strInputField. When the Input Record is
+ *   truncated in the Field, its '\0' is copied with the characters left after
+ *   it by the previous Fields, and the Output Record ends there.
+ *   An added Field has no Input Length (-1) : only its string is copied.
+ * =============================================================================
+ */
+void CopyOriginalField(char *o_strOutputField, const char *i_strInputField, int i_iFieldLength)
+{
+	if (i_iFieldLength < 0)
+	{
+		strcpy(o_strOutputField, i_strInputField);
+	}
+	else
+	{
+		memcpy(o_strOutputField, i_strInputField, i_iFieldLength);
+	}
+}
+
 /* 
  * =============================================================================
  *                       Convert Input Field
+ *  The Input Field is read in place : i_iInputLength characters at
+ *  i_pInputField, without any '\0' among them.
  * =============================================================================
  */
-void Convert_InputField (const char *i_strInputField, const int *i_iIdx, char *o_strOutputField)
+void Convert_InputField (const char *i_pInputField, int i_iInputLength, const int *i_iIdx, char *o_strOutputField)
 {
-	char l_strInputField[MAX_FIELD_LENGTH];
+	static __thread char l_strInputField[MAX_FIELD_LENGTH];	// Not cleared between the calls : see CopyOriginalField
+	char l_strField[MAX_FIELD_LENGTH];
 	char l_strOutputField[MAX_FIELD_LENGTH];
 	char l_strDecimalNumber[2];
 	int  l_iIdx   			= 0;
@@ -1543,114 +3035,130 @@ void Convert_InputField (const char *i_strInputField, const int *i_iIdx, char *o
 	
 	// Initialize l_iIdx and l_strInputField
 	l_iIdx = *i_iIdx;
-	strcpy(l_strInputField, i_strInputField);
+	// The plain Numeric Fields are converted without any copy of the Input Field
+	if (ConvertNumericField(i_pInputField, i_iInputLength, &tabFieldPlan[l_iIdx], o_strOutputField))
+	{
+		return;
+	}
+	// The Field is copied as a string in l_strInputField, over the end of the longer Fields copied before it.
+	// charED and charEG Fields are still trimmed in it, as CopyOriginalField of the next Fields may read this end
+	memcpy(l_strInputField, i_pInputField, i_iInputLength);
+	l_strInputField[i_iInputLength] = '\0';
+	// skip, charED and charEG Fields are read in place : the other ones are converted from a string
+	if ((tabFieldPlan[l_iIdx].iFieldFormat != skip) && (tabFieldPlan[l_iIdx].iFieldFormat != charED) && (tabFieldPlan[l_iIdx].iFieldFormat != charEG))
+	{
+		memcpy(l_strField, i_pInputField, i_iInputLength);
+		l_strField[i_iInputLength] = '\0';
+	}
 	// printf(" - [Convert_InputField] - l_strInputField = %s\n", l_strInputField);
 	// printf(" - [Convert_InputField] - tabFieldOfRecord[%d].iFieldFormat = %d\n", l_iIdx, tabFieldOfRecord[l_iIdx].iFieldFormat);
 	// Check if the Input Field must be converted
-	switch (tabFieldOfRecord[l_iIdx].iFieldFormat)
+	switch (tabFieldPlan[l_iIdx].iFieldFormat)
 	{
 		case skip		:	// Original Value without Formating
-							memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
+							CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
 							break;
 
 		case charED		:	// Right space filled
 							Trim(l_strInputField);
-							memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_strOutputField, l_strInputField, strlen(l_strInputField));
+							TrimField(&i_pInputField, &i_iInputLength);
+							memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_strOutputField, i_pInputField, i_iInputLength);
 							break;
 
 		case charEG		:	// Left  space filled
 							Trim(l_strInputField);
-							memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+							TrimField(&i_pInputField, &i_iInputLength);
+							memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - i_iInputLength, i_pInputField, i_iInputLength);
 							break;
 							
 		case entierEG	:	// Unsigned Numeric with Left spaces
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
 							{
-								memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+								memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
 							}
 							else
 							{
 								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
 							}
 							break;
 		
 		case entierZG	:	// Unsigned Numeric with Left zeroes
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
 							{
-								// printf(" - [Convert_InputField] - i_strInputField = %s, l_strInputField = %s, l_iSign = %d.\n", i_strInputField, l_strInputField, l_iSign);
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+								// printf(" - [Convert_InputField] - l_strField = %s, l_strInputField = %s, l_iSign = %d.\n", l_strField, l_strInputField, l_iSign);
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
 							}
 							else
 							{
 								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
 							}
 							break;
 							
 		case entierSG	:	// Signed Numeric with Left spaces - The sign is at the Left side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
 							{
-								memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+								memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
 								o_strOutputField[0] = SIGN(l_iSign);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
 							}
 							else
 							{
 								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
 							}
 							break;
 							
 		case entierSZG	:	// Signed Numeric with Left zeroes - The sign is at the Left side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
 							{
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
 								o_strOutputField[0] = SIGN(l_iSign);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField), l_strInputField, strlen(l_strInputField));
 							}
 							else
 							{
 								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
 							}
 							break;
 							
 		case entierSD	:	// Signed Numeric with Left spaces - The sign is at the Right side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
 							{
-								memset(o_strOutputField, ' ', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
-								o_strOutputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
+								memset(o_strOutputField, ' ', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
+								o_strOutputField[tabFieldPlan[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
 							}
 							else
 							{
 								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
 							}
 							break;
 							
 		case entierSZD	:	// Signed Numeric with Left zeroes - The sign is at the Right side
-							if (isNumeric(i_strInputField, l_strInputField, &l_iSign))
+							if (isNumeric(l_strField, l_strInputField, &l_iSign))
 							{
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
-								o_strOutputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strInputField) - 1, l_strInputField, strlen(l_strInputField));
+								o_strOutputField[tabFieldPlan[l_iIdx].iFieldLengthOutput - 1] = SIGN(l_iSign);
 							}
 							else
 							{
 								// In this case, the Original Value is returned without Formating
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Unexpected Non Numeric Field %s found in Input File\n", l_strInputField);
 							}
 							break;
 
@@ -1660,23 +3168,23 @@ void Convert_InputField (const char *i_strInputField, const int *i_iIdx, char *o
 							if (isValidInputAmount(l_strInputField, l_strOutputField, &l_iSign, &l_iDecimalNumber))
 							{
 								// printf(" - [Convert_InputField] - l_strInputField = %s, l_strOutputField = %s, l_iSign = %d, l_iDecimalNumber = %d.\n", l_strInputField,l_strOutputField, l_iSign, l_iDecimalNumber);
-								memset(o_strOutputField, '0', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+								memset(o_strOutputField, '0', tabFieldPlan[l_iIdx].iFieldLengthOutput);
 								o_strOutputField[0]  = SIGN(l_iSign);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - strlen(l_strOutputField) - 1, l_strOutputField, strlen(l_strOutputField));
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - strlen(l_strOutputField) - 1, l_strOutputField, strlen(l_strOutputField));
 								sprintf(l_strDecimalNumber, "%d", l_iDecimalNumber);
-								memcpy(o_strOutputField + tabFieldOfRecord[l_iIdx].iFieldLengthOutput - 1, l_strDecimalNumber, 1);
+								memcpy(o_strOutputField + tabFieldPlan[l_iIdx].iFieldLengthOutput - 1, l_strDecimalNumber, 1);
 							}
 							else
 							{
 								// The Input Amount is Invalid
-								memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-								printf(" - [Convert_InputField] - Invalid Amount %s found in Input File\n", l_strInputField);
+								CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+								PrintRecordLog(" - [Convert_InputField] - Invalid Amount %s found in Input File\n", l_strInputField);
 							}
 							break;
 
 		default			:	// If unknown Format, we suppose that the Original Value is returned without Formating
-							memcpy(o_strOutputField, l_strInputField, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-							printf(" - [Convert_InputField] - Unknown Format %s for Field %s in Input File\n", tabFieldOfRecord[l_iIdx].iFieldFormat, tabFieldOfRecord[l_iIdx].strFieldName);
+							CopyOriginalField(o_strOutputField, l_strInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+							PrintRecordLog(" - [Convert_InputField] - Unknown Format %s for Field %s in Input File\n", tabFieldPlan[l_iIdx].iFieldFormat, tabFieldOfRecord[l_iIdx].strFieldName);
 							break;
 	}
 }
@@ -1690,22 +3198,20 @@ int Create_Output_Record(const char *i_InputRecord, char *o_OutputRecord)
 {
 	int  l_iIdx   			= 0;
 	int  l_iSign  			= 0;
-	long l_lPositXHashKey	= -1;
-	long l_lPositYHashKey	= -1;
+	long l_lPositHashKey	= -1;
+	const char *l_pInputField	= NULL;
+	int  l_iInputLength		= 0;
 	char l_strOutputAmount[20 + 1];
-	char l_strInputField[MAX_FIELD_LENGTH];
 	char l_strOutputField[MAX_FIELD_LENGTH];
-	char l_strDEVISE_ISO[3 + 1];
 	char l_strDEVISE_ISO_DECIMAL_POS[1 + 1];
 	char l_strZ_MNT_ESTD_DEVISE[20 + 1];
 	char l_strEMISS_CRS_Date[DATE_LENGTH + 1];
 	char l_strEMISS_CRS_Time[TIME_LENGTH + 1];
 
-	// Initialze l_strInputField and l_strOutputField
-	memset(l_strInputField,  ' ', MAX_FIELD_LENGTH);
+	// Initialze l_strOutputField
 	memset(l_strOutputField, ' ', MAX_FIELD_LENGTH);
 	
-	while (strlen(tabFieldOfRecord[l_iIdx].strFieldName) > 0)
+	while (l_iIdx < iFieldPlanNumber)
 	{
 		// Check position of separator in Input Record
 		/*if (memcmp(i_InputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosInput + tabFieldOfRecord[l_iIdx].iFieldLengthInput, INPUT_FILE_SEPARATOR, 1) != 0)
@@ -1715,13 +3221,17 @@ int Create_Output_Record(const char *i_InputRecord, char *o_OutputRecord)
 			return EXIT_ERR;
 		}*/
 		// Correct position of separator in Input Record
-		memcpy(l_strInputField, i_InputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosInput, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-		l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthInput] = '\0';
-		Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-		memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+		// The Input Field is read in place
+		l_pInputField  = i_InputRecord + tabFieldPlan[l_iIdx].iFieldStartPosInput;
+		l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthInput);
+		Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+		if (tabFieldPlan[l_iIdx].iFieldRole != roleQTE_DECIMALES)
+		{
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+		}
 
 		// Emission Date : EMISS_CRS
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "EMISS_CRS") == 0)
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleEMISS_CRS)
 		{
 			// For unknown reasons, we do not check if the Emission Date is valid in EMISS_CRS
 			// Valid Emission Time in EMISS_CRS ?			
@@ -1733,161 +3243,156 @@ int Create_Output_Record(const char *i_InputRecord, char *o_OutputRecord)
 				memcpy(l_strEMISS_CRS_Time, DEFAULT_INPUT_TIME, TIME_LENGTH);
 				l_strEMISS_CRS_Time[TIME_LENGTH] = '\0';
 			}
-			memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput + DATE_LENGTH, l_strEMISS_CRS_Time, TIME_LENGTH);
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput + DATE_LENGTH, l_strEMISS_CRS_Time, TIME_LENGTH);
 		}
 		// Currency : CODE_DEVISE_ISO
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "CODE_DEVISE_ISO") == 0)
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleCODE_DEVISE_ISO)
 		{
-			strcpy(l_strDEVISE_ISO, l_strInputField);
-			if (strcmp(l_strDEVISE_ISO, EMPTY_CURRENCY) == 0)
+			l_strDEVISE_ISO_DECIMAL_POS[0] = FindDecimalPosInCURRENCYTable(l_pInputField, l_iInputLength);
+			l_strDEVISE_ISO_DECIMAL_POS[1] = '\0';
+			if (l_strDEVISE_ISO_DECIMAL_POS[0] == CURRENCY_DECIMAL_NOT_FOUND)
 			{
-				// Currency Field Empty
-				l_strDEVISE_ISO_DECIMAL_POS[0] = '3';
-				l_strDEVISE_ISO_DECIMAL_POS[1] = '\0';
-				printf("Currency Field Empty. Default Decimal Number = %s\n", l_strDEVISE_ISO_DECIMAL_POS);
+				// Currency not found in CURRENCY Table
+				l_strDEVISE_ISO_DECIMAL_POS[0] = CURRENCY_DEFAULT_DECIMAL_POS;
+				PrintRecordLog("Currency NOT FOUND ............ : %.*s. Default Decimal Number = %s\n", l_iInputLength, l_pInputField, l_strDEVISE_ISO_DECIMAL_POS);
 			}
-			else
+			else if (isEqualToField(EMPTY_CURRENCY, l_pInputField, l_iInputLength))
 			{
-				if (FindElementInCURRENCYHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
-				{
-					strcpy(l_strDEVISE_ISO_DECIMAL_POS, CURRENCYHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strDECIMAL_POS);
-				}
-				else
-				{
-					// Currency not found in CURRENCYHashArray Table
-					l_strDEVISE_ISO_DECIMAL_POS[0] = '3';
-					l_strDEVISE_ISO_DECIMAL_POS[1] = '\0';
-					printf("Currency NOT FOUND ............ : %s. Default Decimal Number = %s\n", l_strDEVISE_ISO, l_strDEVISE_ISO_DECIMAL_POS);
-				}
+				// Currency Field Empty : the Default Decimal Number is given by the CURRENCY Table
+				PrintRecordLog("Currency Field Empty. Default Decimal Number = %s\n", l_strDEVISE_ISO_DECIMAL_POS);
 			}
 		}
 		// Number of decimals of Amount : QTE_DECIMALES
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "QTE_DECIMALES") == 0)
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleQTE_DECIMALES)
 		{
-			memcpy(l_strZ_MNT_ESTD_DEVISE + SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH, i_InputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosInput, tabFieldOfRecord[l_iIdx].iFieldLengthInput);
-			// As we have not a Field to identify the Number of Decimals in the Output Amount, we force the value to AMOUNT_DECIMAL_NR = 3 in QTE_DECIMALES Field
+			memcpy(l_strZ_MNT_ESTD_DEVISE + SIGN_FIELD_LENGTH + AMOUNT_FIELD_LENGTH, i_InputRecord + tabFieldPlan[l_iIdx].iFieldStartPosInput, tabFieldPlan[l_iIdx].iFieldLengthInput);
+			// As we have not a Field to identify the Number of Decimals in the Output Amount, QTE_DECIMALES Field keeps the value AMOUNT_DECIMAL_NR = 3
+			// of the Output Record Template : the converted Field is not written
 			// memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strDEVISE_ISO_DECIMAL_POS, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-			memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, AMOUNT_DECIMAL_NR, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
 		}
 		// Sign : I_SIGN_MNT_DEVISE
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "I_SIGN_MNT_DEVISE") == 0)
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleI_SIGN_MNT_DEVISE)
 		{
-			memcpy(l_strZ_MNT_ESTD_DEVISE, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+			memcpy(l_strZ_MNT_ESTD_DEVISE, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 		}
 		// Amount : Z_MNT_ESTD_DEVISE
-		if (strcmp(tabFieldOfRecord[l_iIdx].strFieldName, "Z_MNT_ESTD_DEVISE") == 0)
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleZ_MNT_ESTD_DEVISE)
 		{
 			// To convert Amount, we will use here the Function defined in Har_Transco_PreMai.c named CorrectFormatAmount()
 			// The First  Argument of this Function is the Amount l_strZ_MNT_ESTD_DEVISE which has the folling Format : Sign, Amount, Number od decimals of the Amount
 			// The Second Argument is the Number of decimals of the Currency
 			// The third  Argument is the Converted Amount with AMOUNT_DECIMAL_NR decimals
-			memcpy(l_strZ_MNT_ESTD_DEVISE + SIGN_FIELD_LENGTH, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-			l_strZ_MNT_ESTD_DEVISE[SIGN_FIELD_LENGTH + tabFieldOfRecord[l_iIdx].iFieldLengthOutput + 1] = '\0';
-			CorrectFormatAmount(l_strZ_MNT_ESTD_DEVISE, l_strDEVISE_ISO_DECIMAL_POS, l_strOutputAmount);
+			// RescaleAmount3DEC gives the same Amount with integers : CorrectFormatAmount is only called for the Amounts it does not handle
+			memcpy(l_strZ_MNT_ESTD_DEVISE + SIGN_FIELD_LENGTH, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+			l_strZ_MNT_ESTD_DEVISE[SIGN_FIELD_LENGTH + tabFieldPlan[l_iIdx].iFieldLengthOutput + 1] = '\0';
+			if (! RescaleAmount3DEC(l_strZ_MNT_ESTD_DEVISE, l_strDEVISE_ISO_DECIMAL_POS[0], l_strOutputAmount))
+			{
+				CorrectFormatAmount(l_strZ_MNT_ESTD_DEVISE, l_strDEVISE_ISO_DECIMAL_POS, l_strOutputAmount);
+			}
 			// printf(" - [Create_Output_Record] - l_strZ_MNT_ESTD_DEVISE = %s, l_strDEVISE_ISO_DECIMAL_POS = %s, l_strOutputAmount= %s\n", l_strZ_MNT_ESTD_DEVISE, l_strDEVISE_ISO_DECIMAL_POS, l_strOutputAmount);
-			memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputAmount + SIGN_FIELD_LENGTH, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+			memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputAmount + SIGN_FIELD_LENGTH, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 		}
 		
 		// Check if SIAM or RTS Field in Input Record
-		switch (tabFieldOfRecord[l_iIdx].iFieldType)
+		switch (tabFieldPlan[l_iIdx].iFieldType)
 		{
 			case	ADD_RICOS_SC_CPY_USING_SIAM : // The Field is a SIAM Field - Find RICOS_SC_ID and RICOS_CPY_ID using SIAM Field and add them in Output Record
-					if (strlen(l_strInputField) > 0)
+					if (l_iInputLength > 0)
 					{
-						if (FindElementInSIAMHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
+						if (FindElementInSIAMHashArrayTable(l_pInputField, l_iInputLength, &l_lPositHashKey))
 						{
 							l_iIdx++;
-							memcpy(l_strInputField, SIAMHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strRICOS_SC_ID,  tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-							Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							l_pInputField  = TIERS_STRING(SIAMHashArray[l_lPositHashKey].uiRICOS_SC_ID);
+							l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 							l_iIdx++;
-							memcpy(l_strInputField, SIAMHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strRICOS_CPY_ID, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-							Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							l_pInputField  = TIERS_STRING(SIAMHashArray[l_lPositHashKey].uiRICOS_CPY_ID);
+							l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						}
 						else
 						{
 							l_iIdx++;
-							memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 							l_iIdx++;
-							memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						}
 					}
 					else
 					{
 						l_iIdx++;
-						memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-						memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+						memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+						memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						l_iIdx++;
-						memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-						memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+						memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+						memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 					}
 					break;
 							
 			case	ADD_RICOS_SC_CPY_USING_RTS : // The Field is an RTS Field - Find RICOS_SC_ID and RICOS_CPY_ID using RTS Field and add them in Output Record
-					if (strlen(l_strInputField) > 0)
+					if (l_iInputLength > 0)
 					{
-						if (FindElementInRTSHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
+						if (FindElementInRTSHashArrayTable(l_pInputField, l_iInputLength, &l_lPositHashKey))
 						{
 							l_iIdx++;
-							memcpy(l_strInputField, RTSHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strRICOS_SC_ID,  tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-							Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							l_pInputField  = TIERS_STRING(RTSHashArray[l_lPositHashKey].uiRICOS_SC_ID);
+							l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 							l_iIdx++;
-							memcpy(l_strInputField, RTSHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strRICOS_CPY_ID, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-							Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							l_pInputField  = TIERS_STRING(RTSHashArray[l_lPositHashKey].uiRICOS_CPY_ID);
+							l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						}
 						else
 						{
 							l_iIdx++;
-							memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 							l_iIdx++;
-							memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						}
 					}
 					else
 					{
 						l_iIdx++;
-						memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-						memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+						memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+						memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						l_iIdx++;
-						memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-						memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+						memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+						memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 					}
 					break;
 			
 			case	ADD_RICOS_SC_USING_RTS : // The Field is an RTS Field - Find RICOS_SC_ID using RTS Field and add it in Output Record
-					if (strlen(l_strInputField) > 0)
+					if (l_iInputLength > 0)
 					{
-						if (FindElementInRTSHashArrayTable(l_strInputField, &l_lPositXHashKey, &l_lPositYHashKey))
+						if (FindElementInRTSHashArrayTable(l_pInputField, l_iInputLength, &l_lPositHashKey))
 						{
 							l_iIdx++;
-							memcpy(l_strInputField, RTSHashArray[l_lPositXHashKey].stElt[l_lPositYHashKey].strRICOS_SC_ID,  tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							l_strInputField[tabFieldOfRecord[l_iIdx].iFieldLengthOutput] = '\0';
-							Convert_InputField (l_strInputField, &l_iIdx, l_strOutputField);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							l_pInputField  = TIERS_STRING(RTSHashArray[l_lPositHashKey].uiRICOS_SC_ID);
+							l_iInputLength = FieldLength(l_pInputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							Convert_InputField (l_pInputField, l_iInputLength, &l_iIdx, l_strOutputField);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						}
 						else
 						{
 							l_iIdx++;
-							memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-							memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+							memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+							memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 						}
 					}
 					else
 					{
 						l_iIdx++;
-						memset(l_strOutputField, '#', tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
-						memcpy(o_OutputRecord + tabFieldOfRecord[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldOfRecord[l_iIdx].iFieldLengthOutput);
+						memset(l_strOutputField, '#', tabFieldPlan[l_iIdx].iFieldLengthOutput);
+						memcpy(o_OutputRecord + tabFieldPlan[l_iIdx].iFieldStartPosOutput, l_strOutputField, tabFieldPlan[l_iIdx].iFieldLengthOutput);
 					}							
 					break;
 			
@@ -1896,10 +3401,22 @@ int Create_Output_Record(const char *i_InputRecord, char *o_OutputRecord)
 		}
 		l_iIdx++;
 	}
-	o_OutputRecord[tabFieldOfRecord[l_iIdx - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iIdx - 1].iFieldLengthOutput] = '\0';
+	o_OutputRecord[tabFieldPlan[l_iIdx - 1].iFieldStartPosOutput + tabFieldPlan[l_iIdx - 1].iFieldLengthOutput] = '\0';
 	return EXIT_OK;
 }
 
+/* 
+ * =============================================================================
+ *               Create Output Record with its Header
+ * =============================================================================
+ */
+int BuildOutputRecord (OutputRecord *o_pOutputRecord, const char *i_InputRecord)
+{
+	// Create Output Record Header and Detail from the Output Record Template
+	memcpy(o_pOutputRecord, &Output_Record_Template, lOutputRecordTemplateLength);
+	return Create_Output_Record(i_InputRecord, (char *) o_pOutputRecord);
+}
+
 /* 
  * =============================================================================
  *  Building Format of Output File Record using struct_pestd.conf File
@@ -1995,157 +3512,2324 @@ int BuildOutputRecordFormat()
 				}
 			else
 			{
-				if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_TIERS") == 0)
+				if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_TIERS") == 0)
+				{
+					tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_CPY_USING_RTS;
+					// Add TIERS_EXT_RICOS and TIERS_EXT_RICOS_CY in Output File
+					l_iPreviousInputFieldNumber = l_iFieldNumber;
+					l_iFieldNumber++;
+					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EXT_RICOS");
+					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+					tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+					tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_CPY_RTS_INPUT_POSIT;
+					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber - 1].iFieldLengthOutput;
+					l_iFieldNumber++;
+					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EXT_RICOS_CY");
+					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "entierZG");
+					tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+					tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_CPY_RTS_INPUT_POSIT;
+					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+					l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+				}
+				else
+				{
+					if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_EMPPRET") == 0)
+					{
+						tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+						// Add TIERS_EMPPRET_RICOS in Output File
+						l_iPreviousInputFieldNumber = l_iFieldNumber;
+						l_iFieldNumber++;
+						strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EMPPRET_RICOS");
+						strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+						tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+						tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+						tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+						tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+						l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+					}
+					else
+					{
+						if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_GARANT")  == 0)
+						{
+							tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+							// Add TIERS_GARANT_RICOS in Output File
+							l_iPreviousInputFieldNumber = l_iFieldNumber;
+							l_iFieldNumber++;
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_GARANT_RICOS");
+							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+							l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+						}
+						else
+						{
+							if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_EMETTIT") == 0)
+							{
+								tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+								// Add TIERS_EMETTIT_RICOS in Output File
+								l_iPreviousInputFieldNumber = l_iFieldNumber;
+								l_iFieldNumber++;
+								strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EMETTIT_RICOS");
+								strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+								tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+								tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+								tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+								tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+								l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+							}
+							else
+							{
+								if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_DEPOSIT") == 0)
+								{
+									tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+									// Add TIERS_DEPOSIT_RICOS in Output File
+									l_iPreviousInputFieldNumber = l_iFieldNumber;
+									l_iFieldNumber++;
+									strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_DEPOSIT_RICOS");
+									strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+									tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+									tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+									tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+									tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+									l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+								}
+								else
+								{
+									if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_EMETSSJ") == 0)
+									{
+										tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+										// Add TIERS_EMETSSJ_RICOS in Output File
+										l_iPreviousInputFieldNumber = l_iFieldNumber;
+										l_iFieldNumber++;
+										strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EMETSSJ_RICOS");
+										strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+										tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+										tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+										tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+										tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+										l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+									}
+									else
+									{
+										if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_ACTR") == 0)
+										{
+											tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+											// Add TIERS_ACTR_RICOS in Output File
+											l_iPreviousInputFieldNumber = l_iFieldNumber;
+											l_iFieldNumber++;
+											strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_ACTR_RICOS");
+											strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+											tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+											tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+											tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+											tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+											l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+										}
+										else
+										{
+											if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_TIERORI") == 0)
+											{
+												tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
+												// Add TIERS_ORI_RICOS in Output File
+												l_iPreviousInputFieldNumber = l_iFieldNumber;
+												l_iFieldNumber++;
+												strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_ORI_RICOS");
+												strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
+												tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
+												tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
+												tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
+												tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
+												l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+											}
+											else
+											{
+												l_iPreviousInputFieldNumber = l_iFieldNumber;
+											}
+										}
+									}
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	/* Closing struct_pestd.conf File */
+	printf("Closing %s File ...\n", l_strFullInputFileFormatName);
+	fclose(l_InputFile_RecordFormat_Ptr);
+
+	/* Resolving the Plan of the Output File Record : Create_Output_Record does not use the Names of the Fields */
+	iFieldPlanNumber = 0;
+	while ((iFieldPlanNumber < MAX_FIELD_NUMBER) && (strlen(tabFieldOfRecord[iFieldPlanNumber].strFieldName) > 0))
+	{
+		tabFieldPlan[iFieldPlanNumber].iFieldRole           = whichFieldRole(tabFieldOfRecord[iFieldPlanNumber].strFieldName);
+		tabFieldPlan[iFieldPlanNumber].iFieldFormat         = tabFieldOfRecord[iFieldPlanNumber].iFieldFormat;
+		tabFieldPlan[iFieldPlanNumber].iFieldType           = tabFieldOfRecord[iFieldPlanNumber].iFieldType;
+		tabFieldPlan[iFieldPlanNumber].iFieldLengthInput    = tabFieldOfRecord[iFieldPlanNumber].iFieldLengthInput;
+		tabFieldPlan[iFieldPlanNumber].iFieldLengthOutput   = tabFieldOfRecord[iFieldPlanNumber].iFieldLengthOutput;
+		tabFieldPlan[iFieldPlanNumber].iFieldStartPosInput  = tabFieldOfRecord[iFieldPlanNumber].iFieldStartPosInput;
+		tabFieldPlan[iFieldPlanNumber].iFieldStartPosOutput = tabFieldOfRecord[iFieldPlanNumber].iFieldStartPosOutput;
+		iFieldPlanNumber++;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Write the whole Data in a File or a Pipe
+ *   Returns the Number of write calls, or -1 with errno set
+ * =============================================================================
+*/
+long WriteFully (int i_iFile, const char *i_pData, long i_lLength)
+{
+	long	l_lWritten	= 0;
+	long	l_lPosit	= 0;
+	long	l_lWrites	= 0;
+
+	while (l_lPosit < i_lLength)
+	{
+		l_lWritten = write(i_iFile, i_pData + l_lPosit, i_lLength - l_lPosit);
+		if (l_lWritten < 0)
+		{
+			if (errno != EINTR)
+			{
+				return -1;
+			}
+		}
+		else
+		{
+			l_lPosit += l_lWritten;
+			l_lWrites++;
+		}
+	}
+	return l_lWrites;
+}
+
+/*
+ * =============================================================================
+ *   Compression of the Output File, given by COMPRESSION_OUTPUT_VARIABLE
+ *   ("gzip" or "zstd", followed by ":Level" if needed, from 1 to 9 for gzip
+ *   and from 1 to 22 for zstd)
+ *   Returns COMPRESSION_NONE if the Variable is not set, -1 if the Compression
+ *   or its Level is unknown, or if the Compression is not built in the Program
+ * =============================================================================
+*/
+int EvaluateOutputCompression (int *o_iLevel)
+{
+	char	*l_strCompression	= getenv(COMPRESSION_OUTPUT_VARIABLE);
+	char	*l_strLevel			= NULL;
+	char	*l_pLevelEnd		= NULL;
+	size_t	l_lNameLength		= 0;
+	long	l_lLevel			= 0;
+	int		l_iFormat			= COMPRESSION_NONE;
+	int		l_iIdx				= 0;
+
+	*o_iLevel = 0;
+	if ((l_strCompression == NULL) || (strlen(l_strCompression) == 0))
+	{
+		return COMPRESSION_NONE;
+	}
+	l_strLevel = strchr(l_strCompression, ':');
+	l_lNameLength = (l_strLevel != NULL) ? (size_t) (l_strLevel - l_strCompression) : strlen(l_strCompression);
+	for (l_iIdx = COMPRESSION_GZIP; l_iIdx <= COMPRESSION_ZSTD; l_iIdx++)
+	{
+		if ((strlen(tabCompressionName[l_iIdx]) == l_lNameLength)
+		&&  (strncmp(l_strCompression, tabCompressionName[l_iIdx], strlen(tabCompressionName[l_iIdx])) == 0))
+		{
+			l_iFormat = l_iIdx;
+		}
+	}
+	if ((l_iFormat == COMPRESSION_NONE)
+#ifndef RDJ_WITH_ZLIB
+	||  (l_iFormat == COMPRESSION_GZIP)
+#endif
+#ifndef RDJ_WITH_ZSTD
+	||  (l_iFormat == COMPRESSION_ZSTD)
+#endif
+	   )
+	{
+		printf("Output Compression %s is unknown or not built in the Program\n", l_strCompression);
+		return -1;
+	}
+	if (l_strLevel == NULL)
+	{
+		*o_iLevel = (l_iFormat == COMPRESSION_GZIP) ? COMPRESSION_GZIP_LEVEL : COMPRESSION_ZSTD_LEVEL;
+		return l_iFormat;
+	}
+	// The Level must be a Number in the range of the Compression
+	errno = 0;
+	l_lLevel = strtol(l_strLevel + 1, &l_pLevelEnd, 10);
+	if ((l_pLevelEnd == l_strLevel + 1) || (*l_pLevelEnd != '\0') || (errno != 0)
+	||  (l_lLevel < 1) || (l_lLevel > ((l_iFormat == COMPRESSION_GZIP) ? COMPRESSION_GZIP_LEVEL_MAX : COMPRESSION_ZSTD_LEVEL_MAX)))
+	{
+		printf("Output Compression %s is unknown or not built in the Program\n", l_strCompression);
+		return -1;
+	}
+	*o_iLevel = (int) l_lLevel;
+	return l_iFormat;
+}
+
+/*
+ * =============================================================================
+ *   Start compressing the Output File in i_iFormat
+ * =============================================================================
+*/
+int StartCompressor (Compressor *o_pCompressor, int i_iFormat, int i_iLevel, long i_lBufferSize)
+{
+	memset(o_pCompressor, '\0', sizeof(Compressor));
+	o_pCompressor->iFormat = i_iFormat;
+	o_pCompressor->lBufferSize = i_lBufferSize;
+	o_pCompressor->pBuffer = (char *) malloc(i_lBufferSize);
+	if (o_pCompressor->pBuffer == NULL)
+	{
+		printf("Error %d : '%s' occurs when allocating Output Compression Buffer (%ld Bytes)\n", errno, strerror(errno), i_lBufferSize);
+		return EXIT_ERR;
+	}
+#ifdef RDJ_WITH_ZLIB
+	if (i_iFormat == COMPRESSION_GZIP)
+	{
+		o_pCompressor->pStream = calloc(1, sizeof(z_stream));
+		// 15 + 16 : gzip Header and Trailer around the deflate Data
+		if ((o_pCompressor->pStream == NULL)
+		||  (deflateInit2((z_stream *) o_pCompressor->pStream, i_iLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK))
+		{
+			printf("Error : gzip Compression of the Output File cannot be started (Level %d)\n", i_iLevel);
+			return EXIT_ERR;
+		}
+	}
+#endif
+#ifdef RDJ_WITH_ZSTD
+	if (i_iFormat == COMPRESSION_ZSTD)
+	{
+		o_pCompressor->pStream = ZSTD_createCCtx();
+		if ((o_pCompressor->pStream == NULL)
+		||  (ZSTD_isError(ZSTD_CCtx_setParameter((ZSTD_CCtx *) o_pCompressor->pStream, ZSTD_c_compressionLevel, i_iLevel))))
+		{
+			printf("Error : zstd Compression of the Output File cannot be started (Level %d)\n", i_iLevel);
+			return EXIT_ERR;
+		}
+	}
+#endif
+#if !defined(RDJ_WITH_ZLIB) && !defined(RDJ_WITH_ZSTD)
+	(void) i_iLevel;
+#endif
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Compress i_lLength Bytes and write what is compressed at the current
+ *   Position of the Output File. i_iFinish ends the compressed Stream.
+ * =============================================================================
+*/
+int CompressAndWrite (Compressor *io_pCompressor, int i_iFile, const char *i_pData, long i_lLength, int i_iFinish)
+{
+#if defined(RDJ_WITH_ZLIB) || defined(RDJ_WITH_ZSTD)
+	int		l_iPending		= TRUE;
+	long	l_lProduced		= 0;
+
+	while (l_iPending)
+	{
+		l_lProduced = 0;
+		l_iPending  = FALSE;
+#ifdef RDJ_WITH_ZLIB
+		if (io_pCompressor->iFormat == COMPRESSION_GZIP)
+		{
+			z_stream	*l_pStream	= (z_stream *) io_pCompressor->pStream;
+			int			l_iResult	= Z_OK;
+
+			l_pStream->next_in   = (Bytef *) i_pData;
+			l_pStream->avail_in  = i_lLength;
+			l_pStream->next_out  = (Bytef *) io_pCompressor->pBuffer;
+			l_pStream->avail_out = io_pCompressor->lBufferSize;
+			l_iResult = deflate(l_pStream, (i_iFinish) ? Z_FINISH : Z_NO_FLUSH);
+			if (l_iResult == Z_STREAM_ERROR)
+			{
+				errno = EINVAL;
+				return EXIT_ERR;
+			}
+			l_lProduced = io_pCompressor->lBufferSize - l_pStream->avail_out;
+			i_pData    += i_lLength - l_pStream->avail_in;
+			i_lLength   = l_pStream->avail_in;
+			// The Buffer was filled : deflate may have more to give
+			l_iPending  = (l_pStream->avail_out == 0) || ((i_iFinish) && (l_iResult != Z_STREAM_END));
+		}
+#endif
+#ifdef RDJ_WITH_ZSTD
+		if (io_pCompressor->iFormat == COMPRESSION_ZSTD)
+		{
+			ZSTD_inBuffer	l_stInput	= { i_pData, i_lLength, 0 };
+			ZSTD_outBuffer	l_stOutput	= { io_pCompressor->pBuffer, io_pCompressor->lBufferSize, 0 };
+			size_t			l_lRemaining = 0;
+
+			l_lRemaining = ZSTD_compressStream2((ZSTD_CCtx *) io_pCompressor->pStream, &l_stOutput, &l_stInput, (i_iFinish) ? ZSTD_e_end : ZSTD_e_continue);
+			if (ZSTD_isError(l_lRemaining))
+			{
+				errno = EINVAL;
+				return EXIT_ERR;
+			}
+			l_lProduced = l_stOutput.pos;
+			i_pData    += l_stInput.pos;
+			i_lLength  -= l_stInput.pos;
+			l_iPending  = (i_lLength > 0) || ((i_iFinish) && (l_lRemaining != 0));
+		}
+#endif
+		if ((l_lProduced > 0) && (WriteFully (i_iFile, io_pCompressor->pBuffer, l_lProduced) < 0))
+		{
+			return EXIT_ERR;
+		}
+		io_pCompressor->llBytesOut += l_lProduced;
+	}
+#else
+	// No Compression is built in the Program : EvaluateOutputCompression has refused it
+	(void) io_pCompressor;
+	(void) i_iFile;
+	(void) i_pData;
+	(void) i_lLength;
+	(void) i_iFinish;
+#endif
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                     Stop compressing the Output File
+ * =============================================================================
+*/
+void StopCompressor (Compressor *io_pCompressor)
+{
+#ifdef RDJ_WITH_ZLIB
+	if ((io_pCompressor->iFormat == COMPRESSION_GZIP) && (io_pCompressor->pStream != NULL))
+	{
+		deflateEnd((z_stream *) io_pCompressor->pStream);
+		free(io_pCompressor->pStream);
+	}
+#endif
+#ifdef RDJ_WITH_ZSTD
+	if (io_pCompressor->iFormat == COMPRESSION_ZSTD)
+	{
+		ZSTD_freeCCtx((ZSTD_CCtx *) io_pCompressor->pStream);
+	}
+#endif
+	io_pCompressor->pStream = NULL;
+	free(io_pCompressor->pBuffer);
+	io_pCompressor->pBuffer = NULL;
+}
+
+/*
+ * =============================================================================
+ *   Thread decompressing the Input File into the Pipe read by the Records Loop
+ *   The Format is given by the Magic Bytes : other Data are copied as they are.
+ * =============================================================================
+*/
+void *RunInputDecompressor (void *io_pDecompressor)
+{
+	Decompressor	*l_pDecompressor	= (Decompressor *) io_pDecompressor;
+	unsigned char	*l_pInput			= NULL;
+	char			*l_pOutput			= NULL;
+	long			l_lRead				= 0;
+	int				l_iEnded			= TRUE;		// End of the last compressed Stream (or Member) reached
+#ifdef RDJ_WITH_ZLIB
+	z_stream		l_stZStream;
+	long			l_lProduced			= 0;
+	int				l_iResult			= Z_OK;
+#endif
+#ifdef RDJ_WITH_ZSTD
+	ZSTD_DCtx		*l_pZSTDStream		= NULL;
+	ZSTD_inBuffer	l_stInput;
+	ZSTD_outBuffer	l_stOutput;
+	size_t			l_lRemaining		= 0;
+#endif
+
+	l_pInput  = (unsigned char *) malloc(COMPRESSION_CHUNK_SIZE);
+	l_pOutput = (char *) malloc(COMPRESSION_CHUNK_SIZE);
+	if ((l_pInput == NULL) || (l_pOutput == NULL))
+	{
+		l_pDecompressor->iError = ENOMEM;
+	}
+	while ((l_pDecompressor->iError == 0) && ((l_lRead = fread(l_pInput, 1, COMPRESSION_CHUNK_SIZE, l_pDecompressor->pSource)) > 0))
+	{
+		if (l_pDecompressor->llBytesIn == 0)
+		{
+			if ((l_lRead >= 2) && (l_pInput[0] == 0x1F) && (l_pInput[1] == 0x8B))
+			{
+				l_pDecompressor->iFormat = COMPRESSION_GZIP;
+			}
+			else if ((l_lRead >= 4) && (memcmp(l_pInput, "\x28\xB5\x2F\xFD", 4) == 0))
+			{
+				l_pDecompressor->iFormat = COMPRESSION_ZSTD;
+			}
+#ifdef RDJ_WITH_ZLIB
+			if (l_pDecompressor->iFormat == COMPRESSION_GZIP)
+			{
+				// 15 + 32 : gzip or zlib Header detected by inflate
+				memset(&l_stZStream, '\0', sizeof(l_stZStream));
+				if (inflateInit2(&l_stZStream, 15 + 32) != Z_OK)
+				{
+					l_pDecompressor->iError = ENOMEM;
+				}
+			}
+#endif
+#ifdef RDJ_WITH_ZSTD
+			if (l_pDecompressor->iFormat == COMPRESSION_ZSTD)
+			{
+				l_pZSTDStream = ZSTD_createDCtx();
+				if (l_pZSTDStream == NULL)
+				{
+					l_pDecompressor->iError = ENOMEM;
+				}
+			}
+#endif
+		}
+		l_pDecompressor->llBytesIn += l_lRead;
+
+		if (l_pDecompressor->iFormat == COMPRESSION_NONE)
+		{
+			if (WriteFully (l_pDecompressor->iPipe[1], (char *) l_pInput, l_lRead) < 0)
+			{
+				l_pDecompressor->iError = errno;
+			}
+			l_pDecompressor->llBytesOut += l_lRead;
+		}
+#ifdef RDJ_WITH_ZLIB
+		if (l_pDecompressor->iFormat == COMPRESSION_GZIP)
+		{
+			l_stZStream.next_in  = l_pInput;
+			l_stZStream.avail_in = l_lRead;
+			while ((l_stZStream.avail_in > 0) && (l_pDecompressor->iError == 0))
+			{
+				// Concatenated gzip Members are read one after the other
+				if (l_iEnded)
+				{
+					inflateReset(&l_stZStream);
+					l_iEnded = FALSE;
+				}
+				do
+				{
+					l_stZStream.next_out  = (Bytef *) l_pOutput;
+					l_stZStream.avail_out = COMPRESSION_CHUNK_SIZE;
+					l_iResult = inflate(&l_stZStream, Z_NO_FLUSH);
+					l_lProduced = COMPRESSION_CHUNK_SIZE - l_stZStream.avail_out;
+					if ((l_iResult == Z_BUF_ERROR) && (l_stZStream.avail_in == 0))
+					{
+						// Every Byte read was inflated
+						l_iResult = Z_OK;
+					}
+					if ((l_iResult != Z_OK) && (l_iResult != Z_STREAM_END))
+					{
+						l_pDecompressor->iError = -1;
+					}
+					else if (WriteFully (l_pDecompressor->iPipe[1], l_pOutput, l_lProduced) < 0)
+					{
+						l_pDecompressor->iError = errno;
+					}
+					l_pDecompressor->llBytesOut += l_lProduced;
+				}
+				while ((l_stZStream.avail_out == 0) && (l_iResult == Z_OK) && (l_pDecompressor->iError == 0));
+				l_iEnded = (l_iResult == Z_STREAM_END);
+			}
+		}
+#else
+		if (l_pDecompressor->iFormat == COMPRESSION_GZIP)
+		{
+			l_pDecompressor->iError = ENOTSUP;
+		}
+#endif
+#ifdef RDJ_WITH_ZSTD
+		if (l_pDecompressor->iFormat == COMPRESSION_ZSTD)
+		{
+			l_stInput.src  = l_pInput;
+			l_stInput.size = l_lRead;
+			l_stInput.pos  = 0;
+			do
+			{
+				l_stOutput.dst  = l_pOutput;
+				l_stOutput.size = COMPRESSION_CHUNK_SIZE;
+				l_stOutput.pos  = 0;
+				l_lRemaining = ZSTD_decompressStream(l_pZSTDStream, &l_stOutput, &l_stInput);
+				if (ZSTD_isError(l_lRemaining))
+				{
+					l_pDecompressor->iError = -1;
+				}
+				else if (WriteFully (l_pDecompressor->iPipe[1], l_pOutput, l_stOutput.pos) < 0)
+				{
+					l_pDecompressor->iError = errno;
+				}
+				l_pDecompressor->llBytesOut += l_stOutput.pos;
+			}
+			while (((l_stInput.pos < l_stInput.size) || (l_stOutput.pos == l_stOutput.size)) && (l_pDecompressor->iError == 0));
+			// 0 : the last Frame is complete
+			l_iEnded = (l_lRemaining == 0);
+		}
+#else
+		if (l_pDecompressor->iFormat == COMPRESSION_ZSTD)
+		{
+			l_pDecompressor->iError = ENOTSUP;
+		}
+#endif
+	}
+	if ((l_pDecompressor->iError == 0) && (ferror(l_pDecompressor->pSource)))
+	{
+		l_pDecompressor->iError = EIO;
+	}
+	if ((l_pDecompressor->iError == 0) && (! l_iEnded))
+	{
+		// Truncated compressed Stream
+		l_pDecompressor->iError = -1;
+	}
+#ifdef RDJ_WITH_ZLIB
+	if ((l_pDecompressor->iFormat == COMPRESSION_GZIP) && (l_pDecompressor->llBytesIn > 0))
+	{
+		inflateEnd(&l_stZStream);
+	}
+#endif
+#ifdef RDJ_WITH_ZSTD
+	ZSTD_freeDCtx(l_pZSTDStream);
+#endif
+	free(l_pInput);
+	free(l_pOutput);
+	// The Records Loop reaches the End of the Input File
+	close(l_pDecompressor->iPipe[1]);
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *   Decompress the Input File if it starts as a gzip or zstd File : the
+ *   Records are then read from a Pipe filled by a Thread (io_File_Ptr)
+ * =============================================================================
+*/
+int OpenInputDecompressor (Decompressor *o_pDecompressor, FILE **io_File_Ptr)
+{
+	int		l_iFirstByte	= 0;
+	int		l_iError		= 0;
+
+	memset(o_pDecompressor, '\0', sizeof(Decompressor));
+	l_iFirstByte = fgetc(*io_File_Ptr);
+	if (l_iFirstByte == EOF)
+	{
+		clearerr(*io_File_Ptr);
+		return EXIT_OK;
+	}
+	ungetc(l_iFirstByte, *io_File_Ptr);
+	if ((l_iFirstByte != 0x1F) && (l_iFirstByte != 0x28))
+	{
+		return EXIT_OK;
+	}
+
+	if (pipe(o_pDecompressor->iPipe) != 0)
+	{
+		printf("Error %d : '%s' occurs when creating the Pipe of the Input File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+#ifdef F_SETPIPE_SZ
+	fcntl(o_pDecompressor->iPipe[1], F_SETPIPE_SZ, COMPRESSION_CHUNK_SIZE);
+#endif
+	o_pDecompressor->pSource = *io_File_Ptr;
+	o_pDecompressor->pReadBuffer = (char *) malloc(COMPRESSION_CHUNK_SIZE);
+	*io_File_Ptr = fdopen(o_pDecompressor->iPipe[0], "r");
+	if ((*io_File_Ptr == NULL) || (o_pDecompressor->pReadBuffer == NULL))
+	{
+		printf("Error %d : '%s' occurs when opening the Pipe of the Input File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+	setvbuf(*io_File_Ptr, o_pDecompressor->pReadBuffer, _IOFBF, COMPRESSION_CHUNK_SIZE);
+	l_iError = pthread_create(&o_pDecompressor->stThread, NULL, RunInputDecompressor, o_pDecompressor);
+	if (l_iError != 0)
+	{
+		printf("Error %d : '%s' occurs when starting the Input Decompression Thread\n", l_iError, strerror(l_iError));
+		return EXIT_ERR;
+	}
+	o_pDecompressor->iStarted = TRUE;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   End decompressing the Input File, once its Pipe was read and closed
+ *   Returns EXIT_ERR if the Input File could not be decompressed to its End
+ * =============================================================================
+*/
+int CloseInputDecompressor (Decompressor *io_pDecompressor)
+{
+	if (! io_pDecompressor->iStarted)
+	{
+		return EXIT_OK;
+	}
+	pthread_join(io_pDecompressor->stThread, NULL);
+	io_pDecompressor->iStarted = FALSE;
+	fclose(io_pDecompressor->pSource);
+	free(io_pDecompressor->pReadBuffer);
+	if (io_pDecompressor->iFormat != COMPRESSION_NONE)
+	{
+		printf("Input Decompressed (%s) ..... : %lld Bytes from %lld Bytes\n", tabCompressionName[io_pDecompressor->iFormat], io_pDecompressor->llBytesOut, io_pDecompressor->llBytesIn);
+	}
+	if (io_pDecompressor->iError == ENOTSUP)
+	{
+		printf("Error : the Input File is compressed by %s, not built in the Program\n", tabCompressionName[io_pDecompressor->iFormat]);
+		return EXIT_ERR;
+	}
+	if (io_pDecompressor->iError == -1)
+	{
+		printf("Error : the compressed Input File is corrupted or truncated\n");
+		return EXIT_ERR;
+	}
+	if (io_pDecompressor->iError != 0)
+	{
+		printf("Error %d : '%s' occurs when decompressing Input File\n", io_pDecompressor->iError, strerror(io_pDecompressor->iError));
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Depth of the asynchronous I/O Rings, given by IO_RING_DEPTH_VARIABLE
+ *   0 : the Input File is mapped and the Output File written synchronously
+ * =============================================================================
+*/
+int EvaluateIORingDepth ()
+{
+	char	*l_strDepth		= getenv(IO_RING_DEPTH_VARIABLE);
+	int		l_iDepth		= IO_RING_DEFAULT_DEPTH;
+
+	if (l_strDepth != NULL)
+	{
+		l_iDepth = atoi(l_strDepth);
+	}
+	if (l_iDepth <= 0)
+	{
+		return 0;
+	}
+	// One Buffer is handled while the other ones are read or written
+	if (l_iDepth < IO_RING_MIN_DEPTH)
+	{
+		return IO_RING_MIN_DEPTH;
+	}
+	return (l_iDepth > IO_RING_MAX_DEPTH) ? IO_RING_MAX_DEPTH : l_iDepth;
+}
+
+/*
+ * =============================================================================
+ *   Size of the asynchronous I/O Buffers, given by IO_BUFFER_SIZE_VARIABLE
+ * =============================================================================
+*/
+long EvaluateIOBufferSize ()
+{
+	char	*l_strSize		= getenv(IO_BUFFER_SIZE_VARIABLE);
+	long	l_lSizeMB		= IO_BUFFER_DEFAULT_MB;
+
+	if ((l_strSize != NULL) && (atol(l_strSize) > 0))
+	{
+		l_lSizeMB = atol(l_strSize);
+	}
+	return l_lSizeMB * 1024 * 1024;
+}
+
+/*
+ * =============================================================================
+ *   Read or write the whole Request, in the Worker Thread of the I/O Ring
+ * =============================================================================
+*/
+void HandleIORequest (IORing *io_pRing, IORequest *io_pRequest)
+{
+	long	l_lDone		= 0;
+
+	if ((io_pRing->pCompressor != NULL) && (io_pRequest->iOpcode == IO_REQUEST_WRITE))
+	{
+		if (CompressAndWrite (io_pRing->pCompressor, io_pRequest->iFile, io_pRequest->pBuffer, io_pRequest->lLength, FALSE) == EXIT_ERR)
+		{
+			io_pRequest->iError = errno;
+			return;
+		}
+		io_pRequest->lDone = io_pRequest->lLength;
+	}
+
+	while (io_pRequest->lDone < io_pRequest->lLength)
+	{
+		if (io_pRequest->llOffset < 0)
+		{
+			// Request at the current Position of a Pipe
+			l_lDone = (io_pRequest->iOpcode == IO_REQUEST_READ) ? read(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone)
+																 : write(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone);
+		}
+		else if (io_pRequest->iOpcode == IO_REQUEST_READ)
+		{
+			l_lDone = pread(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone, io_pRequest->llOffset + io_pRequest->lDone);
+		}
+		else
+		{
+			l_lDone = pwrite(io_pRequest->iFile, io_pRequest->pBuffer + io_pRequest->lDone, io_pRequest->lLength - io_pRequest->lDone, io_pRequest->llOffset + io_pRequest->lDone);
+		}
+		if ((l_lDone < 0) && (errno != EINTR))
+		{
+			io_pRequest->iError = errno;
+			return;
+		}
+		if (l_lDone == 0)
+		{
+			// End of File
+			return;
+		}
+		if (l_lDone > 0)
+		{
+			io_pRequest->lDone += l_lDone;
+		}
+	}
+}
+
+/*
+ * =============================================================================
+ *   Worker Thread of an I/O Ring without io_uring : Requests are handled in
+ *   the Order they were submitted
+ * =============================================================================
+*/
+void *RunIOWorker (void *io_pRing)
+{
+	IORing		*l_pRing		= (IORing *) io_pRing;
+	IORequest	*l_pRequest		= NULL;
+
+	pthread_mutex_lock(&l_pRing->stMutex);
+	while (TRUE)
+	{
+		while ((l_pRing->iQueueCount == 0) && (! l_pRing->iStop))
+		{
+			pthread_cond_wait(&l_pRing->stQueued, &l_pRing->stMutex);
+		}
+		if (l_pRing->iQueueCount == 0)
+		{
+			break;
+		}
+		l_pRequest = &l_pRing->stRequest[l_pRing->iQueue[l_pRing->iQueueHead]];
+		pthread_mutex_unlock(&l_pRing->stMutex);
+
+		HandleIORequest (l_pRing, l_pRequest);
+
+		pthread_mutex_lock(&l_pRing->stMutex);
+		l_pRequest->iState = IO_REQUEST_DONE;
+		l_pRing->iQueueHead = (l_pRing->iQueueHead + 1) % IO_RING_MAX_DEPTH;
+		l_pRing->iQueueCount--;
+		pthread_cond_broadcast(&l_pRing->stDone);
+	}
+	pthread_mutex_unlock(&l_pRing->stMutex);
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *   Submit i_uiToSubmit Requests queued in the io_uring and wait for
+ *   i_uiMinComplete Completions
+ * =============================================================================
+*/
+int EnterIOUring (IORing *io_pRing, unsigned int i_uiToSubmit, unsigned int i_uiMinComplete)
+{
+#ifdef IO_URING_SUPPORTED
+	return syscall(__NR_io_uring_enter, io_pRing->iUring, i_uiToSubmit, i_uiMinComplete, (i_uiMinComplete > 0) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Queue the (remaining part of the) Request i_iSlot in the io_uring
+ * =============================================================================
+*/
+int QueueIOUringRequest (IORing *io_pRing, int i_iSlot)
+{
+#ifdef IO_URING_SUPPORTED
+	IORequest			*l_pRequest		= &io_pRing->stRequest[i_iSlot];
+	struct io_uring_sqe	*l_pEntry		= NULL;
+	unsigned int		l_uiTail		= *io_pRing->puiSQTail;
+	unsigned int		l_uiIdx			= l_uiTail & io_pRing->uiSQMask;
+
+	l_pEntry = &((struct io_uring_sqe *) io_pRing->pSQEntries)[l_uiIdx];
+	memset(l_pEntry, '\0', sizeof(struct io_uring_sqe));
+	l_pEntry->opcode    = (l_pRequest->iOpcode == IO_REQUEST_READ) ? IORING_OP_READ : IORING_OP_WRITE;
+	l_pEntry->fd        = l_pRequest->iFile;
+	l_pEntry->addr      = (unsigned long long) (l_pRequest->pBuffer + l_pRequest->lDone);
+	l_pEntry->len       = l_pRequest->lLength - l_pRequest->lDone;
+	l_pEntry->off       = l_pRequest->llOffset + l_pRequest->lDone;
+	l_pEntry->user_data = i_iSlot;
+	io_pRing->puiSQArray[l_uiIdx] = l_uiIdx;
+	__atomic_store_n(io_pRing->puiSQTail, l_uiTail + 1, __ATOMIC_RELEASE);
+
+	while (EnterIOUring (io_pRing, 1, 0) < 0)
+	{
+		if (errno != EINTR)
+		{
+			return EXIT_ERR;
+		}
+	}
+#endif
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Handle the Completions of the io_uring : a short Read or Write is queued
+ *   again for its remaining part
+ * =============================================================================
+*/
+void ReapIOUringCompletions (IORing *io_pRing)
+{
+#ifdef IO_URING_SUPPORTED
+	struct io_uring_cqe	*l_pCompletion	= NULL;
+	IORequest			*l_pRequest		= NULL;
+	unsigned int		l_uiHead		= *io_pRing->puiCQHead;
+	unsigned int		l_uiTail		= __atomic_load_n(io_pRing->puiCQTail, __ATOMIC_ACQUIRE);
+
+	while (l_uiHead != l_uiTail)
+	{
+		l_pCompletion = &((struct io_uring_cqe *) io_pRing->pCQEntries)[l_uiHead & io_pRing->uiCQMask];
+		l_pRequest = &io_pRing->stRequest[l_pCompletion->user_data];
+		if ((l_pCompletion->res == -EINTR) || (l_pCompletion->res == -EAGAIN))
+		{
+			l_pRequest->iState = IO_REQUEST_QUEUED;
+		}
+		else if (l_pCompletion->res < 0)
+		{
+			l_pRequest->iError = -l_pCompletion->res;
+			l_pRequest->iState = IO_REQUEST_DONE;
+		}
+		else
+		{
+			l_pRequest->lDone += l_pCompletion->res;
+			l_pRequest->iState = ((l_pCompletion->res == 0) || (l_pRequest->lDone >= l_pRequest->lLength)) ? IO_REQUEST_DONE : IO_REQUEST_QUEUED;
+		}
+		if ((l_pRequest->iState == IO_REQUEST_QUEUED) && (QueueIOUringRequest (io_pRing, l_pCompletion->user_data) == EXIT_ERR))
+		{
+			l_pRequest->iError = errno;
+			l_pRequest->iState = IO_REQUEST_DONE;
+		}
+		l_uiHead++;
+		__atomic_store_n(io_pRing->puiCQHead, l_uiHead, __ATOMIC_RELEASE);
+	}
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Set up the io_uring of the I/O Ring. Returns EXIT_ERR if the Kernel does
+ *   not provide it : the Requests are then handled by a Worker Thread.
+ * =============================================================================
+*/
+int SetUpIOUring (IORing *io_pRing)
+{
+#ifdef IO_URING_SUPPORTED
+	struct io_uring_params	l_stParams;
+
+	memset(&l_stParams, '\0', sizeof(l_stParams));
+	io_pRing->iUring = syscall(__NR_io_uring_setup, io_pRing->iDepth, &l_stParams);
+	if (io_pRing->iUring < 0)
+	{
+		io_pRing->iUring = -1;
+		return EXIT_ERR;
+	}
+	io_pRing->lSQRingSize = l_stParams.sq_off.array + l_stParams.sq_entries * sizeof(unsigned int);
+	io_pRing->lCQRingSize = l_stParams.cq_off.cqes + l_stParams.cq_entries * sizeof(struct io_uring_cqe);
+	io_pRing->lSQEntriesSize = l_stParams.sq_entries * sizeof(struct io_uring_sqe);
+	io_pRing->pSQRing = (char *) mmap(NULL, io_pRing->lSQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io_pRing->iUring, IORING_OFF_SQ_RING);
+	io_pRing->pCQRing = (char *) mmap(NULL, io_pRing->lCQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io_pRing->iUring, IORING_OFF_CQ_RING);
+	io_pRing->pSQEntries = mmap(NULL, io_pRing->lSQEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io_pRing->iUring, IORING_OFF_SQES);
+	if ((io_pRing->pSQRing == MAP_FAILED) || (io_pRing->pCQRing == MAP_FAILED) || (io_pRing->pSQEntries == MAP_FAILED))
+	{
+		if (io_pRing->pSQRing != MAP_FAILED)
+		{
+			munmap(io_pRing->pSQRing, io_pRing->lSQRingSize);
+		}
+		if (io_pRing->pCQRing != MAP_FAILED)
+		{
+			munmap(io_pRing->pCQRing, io_pRing->lCQRingSize);
+		}
+		if (io_pRing->pSQEntries != MAP_FAILED)
+		{
+			munmap(io_pRing->pSQEntries, io_pRing->lSQEntriesSize);
+		}
+		io_pRing->pSQRing = NULL;
+		close(io_pRing->iUring);
+		io_pRing->iUring = -1;
+		return EXIT_ERR;
+	}
+	io_pRing->puiSQTail  = (unsigned int *) (io_pRing->pSQRing + l_stParams.sq_off.tail);
+	io_pRing->puiSQArray = (unsigned int *) (io_pRing->pSQRing + l_stParams.sq_off.array);
+	io_pRing->uiSQMask   = *(unsigned int *) (io_pRing->pSQRing + l_stParams.sq_off.ring_mask);
+	io_pRing->puiCQHead  = (unsigned int *) (io_pRing->pCQRing + l_stParams.cq_off.head);
+	io_pRing->puiCQTail  = (unsigned int *) (io_pRing->pCQRing + l_stParams.cq_off.tail);
+	io_pRing->uiCQMask   = *(unsigned int *) (io_pRing->pCQRing + l_stParams.cq_off.ring_mask);
+	io_pRing->pCQEntries = io_pRing->pCQRing + l_stParams.cq_off.cqes;
+	return EXIT_OK;
+#else
+	io_pRing->iUring = -1;
+	return EXIT_ERR;
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Start an I/O Ring of i_iDepth Requests : io_uring if the Kernel provides
+ *   it and IO_URING_OFF_VARIABLE is not set, a Worker Thread otherwise.
+ *   The Requests of a Pipe (i_iStream) are handled by the Worker Thread,
+ *   io_uring not keeping their Order.
+ * =============================================================================
+*/
+int StartIORing (IORing *o_pRing, int i_iDepth, int i_iStream)
+{
+	int		l_iError	= 0;
+
+	memset(o_pRing, '\0', sizeof(IORing));
+	o_pRing->iDepth = i_iDepth;
+	o_pRing->iUring = -1;
+	if ((! i_iStream) && (getenv(IO_URING_OFF_VARIABLE) == NULL) && (SetUpIOUring (o_pRing) == EXIT_OK))
+	{
+		return EXIT_OK;
+	}
+	pthread_mutex_init(&o_pRing->stMutex, NULL);
+	pthread_cond_init(&o_pRing->stQueued, NULL);
+	pthread_cond_init(&o_pRing->stDone, NULL);
+	l_iError = pthread_create(&o_pRing->stWorker, NULL, RunIOWorker, o_pRing);
+	if (l_iError != 0)
+	{
+		printf("Error %d : '%s' occurs when starting the I/O Worker Thread\n", l_iError, strerror(l_iError));
+		o_pRing->iDepth = 0;
+		return EXIT_ERR;
+	}
+	o_pRing->iWorkerStarted = TRUE;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Submit the Read or the Write of i_lLength Bytes at i_llOffset in the Slot
+ *   i_iSlot of the I/O Ring. The Slot must have been waited for.
+ * =============================================================================
+*/
+int SubmitIORequest (IORing *io_pRing, int i_iSlot, int i_iFile, int i_iOpcode, char *i_pBuffer, long i_lLength, long long i_llOffset)
+{
+	IORequest	*l_pRequest		= &io_pRing->stRequest[i_iSlot];
+
+	l_pRequest->iFile    = i_iFile;
+	l_pRequest->iOpcode  = i_iOpcode;
+	l_pRequest->pBuffer  = i_pBuffer;
+	l_pRequest->lLength  = i_lLength;
+	l_pRequest->llOffset = i_llOffset;
+	l_pRequest->lDone    = 0;
+	l_pRequest->iError   = 0;
+	if (io_pRing->iUring >= 0)
+	{
+		l_pRequest->iState = IO_REQUEST_QUEUED;
+		if (QueueIOUringRequest (io_pRing, i_iSlot) == EXIT_ERR)
+		{
+			l_pRequest->iError = errno;
+			l_pRequest->iState = IO_REQUEST_DONE;
+		}
+		return EXIT_OK;
+	}
+	pthread_mutex_lock(&io_pRing->stMutex);
+	l_pRequest->iState = IO_REQUEST_QUEUED;
+	io_pRing->iQueue[(io_pRing->iQueueHead + io_pRing->iQueueCount) % IO_RING_MAX_DEPTH] = i_iSlot;
+	io_pRing->iQueueCount++;
+	pthread_cond_signal(&io_pRing->stQueued);
+	pthread_mutex_unlock(&io_pRing->stMutex);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Wait for the Request of the Slot i_iSlot of the I/O Ring
+ *   Returns the Number of Bytes read or written (0 if the Slot is free), or
+ *   -1 with errno set if the Request failed
+ * =============================================================================
+*/
+long WaitIORequest (IORing *io_pRing, int i_iSlot)
+{
+	IORequest	*l_pRequest		= &io_pRing->stRequest[i_iSlot];
+
+	if (l_pRequest->iState == IO_REQUEST_FREE)
+	{
+		return 0;
+	}
+	if (io_pRing->iUring >= 0)
+	{
+		ReapIOUringCompletions (io_pRing);
+		while (l_pRequest->iState != IO_REQUEST_DONE)
+		{
+			if ((EnterIOUring (io_pRing, 0, 1) < 0) && (errno != EINTR))
+			{
+				l_pRequest->iError = errno;
+				l_pRequest->iState = IO_REQUEST_DONE;
+			}
+			ReapIOUringCompletions (io_pRing);
+		}
+	}
+	else
+	{
+		pthread_mutex_lock(&io_pRing->stMutex);
+		while (l_pRequest->iState != IO_REQUEST_DONE)
+		{
+			pthread_cond_wait(&io_pRing->stDone, &io_pRing->stMutex);
+		}
+		pthread_mutex_unlock(&io_pRing->stMutex);
+	}
+	l_pRequest->iState = IO_REQUEST_FREE;
+	if (l_pRequest->iError != 0)
+	{
+		errno = l_pRequest->iError;
+		return -1;
+	}
+	return l_pRequest->lDone;
+}
+
+/*
+ * =============================================================================
+ *   Stop an I/O Ring once each of its Requests was waited for
+ * =============================================================================
+*/
+void StopIORing (IORing *io_pRing)
+{
+	if (io_pRing->iWorkerStarted)
+	{
+		pthread_mutex_lock(&io_pRing->stMutex);
+		io_pRing->iStop = TRUE;
+		pthread_cond_signal(&io_pRing->stQueued);
+		pthread_mutex_unlock(&io_pRing->stMutex);
+		pthread_join(io_pRing->stWorker, NULL);
+		io_pRing->iWorkerStarted = FALSE;
+	}
+	if (io_pRing->pSQRing != NULL)
+	{
+		munmap(io_pRing->pSQRing, io_pRing->lSQRingSize);
+		munmap(io_pRing->pCQRing, io_pRing->lCQRingSize);
+		munmap(io_pRing->pSQEntries, io_pRing->lSQEntriesSize);
+		close(io_pRing->iUring);
+		io_pRing->pSQRing = NULL;
+	}
+	io_pRing->iDepth = 0;
+}
+
+/*
+ * =============================================================================
+ *                     How the I/O Ring handles its Requests
+ * =============================================================================
+*/
+const char *DescribeIORing (const IORing *i_pRing)
+{
+	if (i_pRing->iDepth == 0)
+	{
+		return "synchronous";
+	}
+	return (i_pRing->iUring >= 0) ? "io_uring" : "Worker Thread";
+}
+
+/*
+ * =============================================================================
+ *   Copy in Input_Record_Struct the last Record read in place, as fgets would
+ *   have left it : a short Record is completed by what the former ones left.
+ * =============================================================================
+*/
+void KeepPendingInputRecord (InputMap *io_pMap)
+{
+	if (io_pMap->pPendingRecord != NULL)
+	{
+		memcpy(Input_Record_Struct.Input_Record, io_pMap->pPendingRecord, io_pMap->lPendingLength);
+		Input_Record_Struct.Input_Record[io_pMap->lPendingLength] = '\0';
+		io_pMap->pPendingRecord = NULL;
+		io_pMap->lPendingLength = 0;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Read ahead in the Buffer i_iSlot the next Part of the Input File
+ * =============================================================================
+*/
+void SubmitInputRead (InputMap *io_pMap, int i_iSlot)
+{
+	long	l_lLength	= io_pMap->lBufferSize;
+
+	if (io_pMap->llReadOffset < io_pMap->llFileSize)
+	{
+		if (io_pMap->llReadOffset + l_lLength > io_pMap->llFileSize)
+		{
+			l_lLength = io_pMap->llFileSize - io_pMap->llReadOffset;
+		}
+		SubmitIORequest (&io_pMap->stRing, i_iSlot, io_pMap->iFile, IO_REQUEST_READ, INPUT_BUFFER(io_pMap, i_iSlot) + MAX_INPUT_REC_LENGTH, l_lLength, io_pMap->llReadOffset);
+		io_pMap->llReadOffset += l_lLength;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Move the Window of the Input File to i_llOffset : the Window is mapped
+ *   from the Page of i_llOffset, or is the next Buffer read ahead by the Ring
+ * =============================================================================
+*/
+int MapInputWindow (InputMap *io_pMap, long long i_llOffset)
+{
+	long long	l_llPageSize	= sysconf(_SC_PAGESIZE);
+	char		*l_pWindow		= NULL;
+	long		l_lTail			= 0;
+	long		l_lRead			= 0;
+	int			l_iPrevious		= io_pMap->iBuffer;
+
+	KeepPendingInputRecord (io_pMap);
+	if (io_pMap->stRing.iDepth > 0)
+	{
+		if (io_pMap->pWindow != NULL)
+		{
+			l_lTail = io_pMap->llWindowOffset + io_pMap->lWindowSize - i_llOffset;
+		}
+		io_pMap->iBuffer = (io_pMap->iBuffer + 1) % io_pMap->stRing.iDepth;
+		l_lRead = WaitIORequest (&io_pMap->stRing, io_pMap->iBuffer);
+		if (l_lRead < 0)
+		{
+			printf("Error %d : '%s' occurs when reading Input File at Offset %lld\n", errno, strerror(errno), i_llOffset + l_lTail);
+			return EXIT_ERR;
+		}
+		// The Record going beyond the current Window is completed before the next Buffer
+		l_pWindow = INPUT_BUFFER(io_pMap, io_pMap->iBuffer) + MAX_INPUT_REC_LENGTH - l_lTail;
+		if (io_pMap->pWindow != NULL)
+		{
+			memcpy(l_pWindow, io_pMap->pWindow + (i_llOffset - io_pMap->llWindowOffset), l_lTail);
+			SubmitInputRead (io_pMap, l_iPrevious);
+		}
+		io_pMap->pWindow        = l_pWindow;
+		io_pMap->llWindowOffset = i_llOffset;
+		io_pMap->lWindowSize    = l_lTail + l_lRead;
+		return EXIT_OK;
+	}
+
+	if (io_pMap->pWindow != NULL)
+	{
+		munmap(io_pMap->pWindow, io_pMap->lWindowSize);
+		io_pMap->pWindow = NULL;
+	}
+	io_pMap->llWindowOffset = i_llOffset / l_llPageSize * l_llPageSize;
+	io_pMap->lWindowSize    = INPUT_MAP_WINDOW_SIZE;
+	if (io_pMap->llWindowOffset + io_pMap->lWindowSize > io_pMap->llFileSize)
+	{
+		io_pMap->lWindowSize = io_pMap->llFileSize - io_pMap->llWindowOffset;
+	}
+	l_pWindow = (char *) mmap(NULL, io_pMap->lWindowSize, PROT_READ, MAP_PRIVATE, io_pMap->iFile, io_pMap->llWindowOffset);
+	if (l_pWindow == MAP_FAILED)
+	{
+		printf("Error %d : '%s' occurs when mapping Input File at Offset %lld\n", errno, strerror(errno), io_pMap->llWindowOffset);
+		return EXIT_ERR;
+	}
+	madvise(l_pWindow, io_pMap->lWindowSize, MADV_SEQUENTIAL);
+	io_pMap->pWindow = l_pWindow;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Masks of the '\n' and '\0' of i_lBlocks Blocks of INPUT_SCAN_BLOCK_SIZE
+ *   Bytes : the Bit n of a Mask is set if the Byte n of its Block is found.
+ *   The same Masks are given by the SSE2, AVX2 and AVX-512 Scanners below.
+ * =============================================================================
+*/
+void ScanInputBlocksScalar (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	unsigned long long	l_ullWord		= 0;
+	unsigned long long	l_ullNewLine	= 0;
+	unsigned long long	l_ullNul		= 0;
+	long				l_lBlock		= 0;
+	int					l_iIdx			= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_ullNewLine = 0;
+		l_ullNul     = 0;
+		for (l_iIdx = 0; l_iIdx < INPUT_SCAN_BLOCK_SIZE; l_iIdx += 8)
+		{
+			// 8 Bytes at once : a '\n' is a '\0' once the Word is xored with '\n' Bytes
+			memcpy(&l_ullWord, i_pData + l_iIdx, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			l_ullWord = __builtin_bswap64(l_ullWord);
+#endif
+			l_ullNewLine |= INPUT_SCAN_ZERO_BYTES(l_ullWord ^ 0x0A0A0A0A0A0A0A0AULL) << l_iIdx;
+			l_ullNul     |= INPUT_SCAN_ZERO_BYTES(l_ullWord) << l_iIdx;
+		}
+		o_pullNewLine[l_lBlock] = l_ullNewLine;
+		o_pullNul[l_lBlock]     = l_ullNul;
+	}
+}
+
+#ifdef __SSE2__
+void ScanInputBlocksSSE2 (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	__m128i				l_NewLine		= _mm_set1_epi8('\n');
+	__m128i				l_Nul			= _mm_setzero_si128();
+	__m128i				l_Data;
+	unsigned long long	l_ullNewLine	= 0;
+	unsigned long long	l_ullNul		= 0;
+	long				l_lBlock		= 0;
+	int					l_iIdx			= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_ullNewLine = 0;
+		l_ullNul     = 0;
+		for (l_iIdx = 0; l_iIdx < INPUT_SCAN_BLOCK_SIZE; l_iIdx += 16)
+		{
+			l_Data = _mm_loadu_si128((const __m128i *) (i_pData + l_iIdx));
+			l_ullNewLine |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Data, l_NewLine)) << l_iIdx;
+			l_ullNul     |= (unsigned long long) (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(l_Data, l_Nul)) << l_iIdx;
+		}
+		o_pullNewLine[l_lBlock] = l_ullNewLine;
+		o_pullNul[l_lBlock]     = l_ullNul;
+	}
+}
+#endif
+
+#ifdef INPUT_SCAN_DISPATCHED
+__attribute__((target("avx2")))
+void ScanInputBlocksAVX2 (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	__m256i				l_NewLine		= _mm256_set1_epi8('\n');
+	__m256i				l_Nul			= _mm256_setzero_si256();
+	__m256i				l_Low;
+	__m256i				l_High;
+	long				l_lBlock		= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_Low  = _mm256_loadu_si256((const __m256i *) i_pData);
+		l_High = _mm256_loadu_si256((const __m256i *) (i_pData + 32));
+		o_pullNewLine[l_lBlock] = (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_Low, l_NewLine))
+								| (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_High, l_NewLine)) << 32;
+		o_pullNul[l_lBlock]     = (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_Low, l_Nul))
+								| (unsigned long long) (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_High, l_Nul)) << 32;
+	}
+}
+
+__attribute__((target("avx512bw")))
+void ScanInputBlocksAVX512 (const char *i_pData, long i_lBlocks, unsigned long long *o_pullNewLine, unsigned long long *o_pullNul)
+{
+	__m512i				l_NewLine		= _mm512_set1_epi8('\n');
+	__m512i				l_Nul			= _mm512_setzero_si512();
+	__m512i				l_Data;
+	long				l_lBlock		= 0;
+
+	for (l_lBlock = 0; l_lBlock < i_lBlocks; l_lBlock++, i_pData += INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_Data = _mm512_loadu_si512((const void *) i_pData);
+		o_pullNewLine[l_lBlock] = _mm512_cmpeq_epi8_mask(l_Data, l_NewLine);
+		o_pullNul[l_lBlock]     = _mm512_cmpeq_epi8_mask(l_Data, l_Nul);
+	}
+}
+#endif
+
+/*
+ * =============================================================================
+ *   Choose the widest Scanner supported by the Processor, or the one named by
+ *   INPUT_SCAN_VARIABLE if it is narrower
+ * =============================================================================
+*/
+void SelectInputScanner (InputMap *io_pMap)
+{
+	const char	*l_strScanner	= getenv(INPUT_SCAN_VARIABLE);
+
+	io_pMap->pScanBlocks = ScanInputBlocksScalar;
+	if ((l_strScanner != NULL) && (strcmp(l_strScanner, "scalar") == 0))
+	{
+		return;
+	}
+#ifdef __SSE2__
+	io_pMap->pScanBlocks = ScanInputBlocksSSE2;
+	if ((l_strScanner != NULL) && (strcmp(l_strScanner, "sse2") == 0))
+	{
+		return;
+	}
+#endif
+#ifdef INPUT_SCAN_DISPATCHED
+	__builtin_cpu_init();
+	if (! __builtin_cpu_supports("avx2"))
+	{
+		return;
+	}
+	io_pMap->pScanBlocks = ScanInputBlocksAVX2;
+	if (((l_strScanner != NULL) && (strcmp(l_strScanner, "avx2") == 0)) || (! __builtin_cpu_supports("avx512bw")))
+	{
+		return;
+	}
+	io_pMap->pScanBlocks = ScanInputBlocksAVX512;
+#endif
+}
+
+/*
+ * =============================================================================
+ *   Position of the first Bit set in i_pullMasks from i_lFrom, i_lTo if none
+ *   is set before i_lTo
+ * =============================================================================
+*/
+long FindInputScanBit (const unsigned long long *i_pullMasks, long i_lFrom, long i_lTo)
+{
+	long				l_lBlock	= i_lFrom / INPUT_SCAN_BLOCK_SIZE;
+	unsigned long long	l_ullMask	= i_pullMasks[l_lBlock] & (~0ULL << (i_lFrom % INPUT_SCAN_BLOCK_SIZE));
+	long				l_lPosit	= 0;
+
+	while ((l_ullMask == 0) && ((l_lBlock + 1) * INPUT_SCAN_BLOCK_SIZE < i_lTo))
+	{
+		l_lBlock++;
+		l_ullMask = i_pullMasks[l_lBlock];
+	}
+	if (l_ullMask == 0)
+	{
+		return i_lTo;
+	}
+	l_lPosit = l_lBlock * INPUT_SCAN_BLOCK_SIZE + __builtin_ctzll(l_ullMask);
+	return (l_lPosit < i_lTo) ? l_lPosit : i_lTo;
+}
+
+/*
+ * =============================================================================
+ *   Find in one pass the next Records of the Window, from llRecordOffset : the
+ *   Bytes read and the Length given by strlen of each one are those fgets
+ *   would give. The Records found are those read before the Window moves, up
+ *   to INPUT_SCAN_RECORDS and as far as INPUT_SCAN_BLOCKS Blocks are scanned.
+ * =============================================================================
+*/
+void ScanInputRecords (InputMap *io_pMap)
+{
+	const char	*l_pData		= io_pMap->pWindow + (io_pMap->llRecordOffset - io_pMap->llWindowOffset);
+	long long	l_llWindowEnd	= io_pMap->llWindowOffset + io_pMap->lWindowSize;
+	long		l_lScanned		= l_llWindowEnd - io_pMap->llRecordOffset;
+	long		l_lBlocks		= 0;
+	long		l_lStart		= 0;
+	long		l_lChunk		= 0;
+	long		l_lEnd			= 0;
+	char		l_strTail[INPUT_SCAN_BLOCK_SIZE];
+
+	if (l_lScanned > INPUT_SCAN_BLOCKS * INPUT_SCAN_BLOCK_SIZE)
+	{
+		l_lScanned = INPUT_SCAN_BLOCKS * INPUT_SCAN_BLOCK_SIZE;
+	}
+	l_lBlocks = l_lScanned / INPUT_SCAN_BLOCK_SIZE;
+	io_pMap->pScanBlocks (l_pData, l_lBlocks, io_pMap->pullNewLineMasks, io_pMap->pullNulMasks);
+	if (l_lScanned % INPUT_SCAN_BLOCK_SIZE > 0)
+	{
+		// The last Bytes are scanned apart, not to read beyond the Window
+		memset(l_strTail, '\0', INPUT_SCAN_BLOCK_SIZE);
+		memcpy(l_strTail, l_pData + l_lBlocks * INPUT_SCAN_BLOCK_SIZE, l_lScanned % INPUT_SCAN_BLOCK_SIZE);
+		io_pMap->pScanBlocks (l_strTail, 1, io_pMap->pullNewLineMasks + l_lBlocks, io_pMap->pullNulMasks + l_lBlocks);
+	}
+
+	io_pMap->lScanRecords = 0;
+	io_pMap->lScanNext    = 0;
+	while ((io_pMap->lScanRecords < INPUT_SCAN_RECORDS) && (io_pMap->llRecordOffset + l_lStart < io_pMap->llFileSize))
+	{
+		l_lChunk = MAX_INPUT_REC_LENGTH - 1;
+		if (io_pMap->llRecordOffset + l_lStart + l_lChunk > io_pMap->llFileSize)
+		{
+			l_lChunk = io_pMap->llFileSize - io_pMap->llRecordOffset - l_lStart;
+		}
+		// The Window moves before a Record going beyond it
+		if (io_pMap->llRecordOffset + l_lStart + l_lChunk > l_llWindowEnd)
+		{
+			break;
+		}
+		l_lEnd = FindInputScanBit (io_pMap->pullNewLineMasks, l_lStart, (l_lStart + l_lChunk < l_lScanned) ? l_lStart + l_lChunk : l_lScanned);
+		if (l_lEnd < l_lStart + l_lChunk)
+		{
+			if (l_lEnd == l_lScanned)
+			{
+				// The End of the Record is beyond the scanned Bytes : it is found by the next Scan
+				break;
+			}
+			l_lChunk = l_lEnd - l_lStart + 1;
+		}
+		io_pMap->plScanOffset[io_pMap->lScanRecords] = l_pData + l_lStart - io_pMap->pWindow;
+		io_pMap->plScanChunk[io_pMap->lScanRecords]  = l_lChunk;
+		io_pMap->plScanLength[io_pMap->lScanRecords] = FindInputScanBit (io_pMap->pullNulMasks, l_lStart, l_lStart + l_lChunk) - l_lStart;
+		io_pMap->lScanRecords++;
+		l_lStart += l_lChunk;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Map the Input File, or read it ahead through an I/O Ring unless
+ *   IO_RING_DEPTH_VARIABLE is 0. Returns EXIT_ERR if it cannot be mapped (empty
+ *   File, pipe, INPUT_STDIO_VARIABLE set) : the Records are then read with fgets.
+ * =============================================================================
+*/
+int OpenInputMap (InputMap *o_pMap, FILE *i_File_Ptr)
+{
+	struct stat	l_InputFile_Stat;
+	int			l_iIdx			= 0;
+	int			l_iDepth		= EvaluateIORingDepth ();
+
+	memset(o_pMap, '\0', sizeof(InputMap));
+	o_pMap->iFile = fileno(i_File_Ptr);
+
+	// Create_Output_Record reads the Input Record up to lInputRecordExtent, even if it is read with fgets
+	lInputRecordExtent = 0;
+	while (l_iIdx < iFieldPlanNumber)
+	{
+		if ((tabFieldPlan[l_iIdx].iFieldStartPosInput >= 0) && (tabFieldPlan[l_iIdx].iFieldLengthInput >= 0)
+		&&  (tabFieldPlan[l_iIdx].iFieldStartPosInput + tabFieldPlan[l_iIdx].iFieldLengthInput > lInputRecordExtent))
+		{
+			lInputRecordExtent = tabFieldPlan[l_iIdx].iFieldStartPosInput + tabFieldPlan[l_iIdx].iFieldLengthInput;
+		}
+		l_iIdx++;
+	}
+
+	if ((getenv(INPUT_STDIO_VARIABLE) != NULL)
+	||  (fstat(o_pMap->iFile, &l_InputFile_Stat) != 0)
+	||  (! S_ISREG(l_InputFile_Stat.st_mode))
+	||  (l_InputFile_Stat.st_size == 0))
+	{
+		return EXIT_ERR;
+	}
+	o_pMap->llFileSize = l_InputFile_Stat.st_size;
+
+	// One Mask of each Kind more for the last Bytes of the Window
+	o_pMap->pullNewLineMasks = (unsigned long long *) malloc(2 * (INPUT_SCAN_BLOCKS + 1) * sizeof(unsigned long long));
+	o_pMap->plScanOffset     = (long *) malloc(3 * INPUT_SCAN_RECORDS * sizeof(long));
+	if ((o_pMap->pullNewLineMasks == NULL) || (o_pMap->plScanOffset == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating the Scanner of the Input File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+	o_pMap->pullNulMasks = o_pMap->pullNewLineMasks + INPUT_SCAN_BLOCKS + 1;
+	o_pMap->plScanChunk  = o_pMap->plScanOffset + INPUT_SCAN_RECORDS;
+	o_pMap->plScanLength = o_pMap->plScanChunk + INPUT_SCAN_RECORDS;
+	SelectInputScanner (o_pMap);
+
+	if (l_iDepth > 0)
+	{
+		o_pMap->lBufferSize = EvaluateIOBufferSize ();
+		o_pMap->pBuffers = (char *) malloc(l_iDepth * (MAX_INPUT_REC_LENGTH + o_pMap->lBufferSize));
+		if (o_pMap->pBuffers == NULL)
+		{
+			printf("Error %d : '%s' occurs when allocating Input Buffers, Input File mapped\n", errno, strerror(errno));
+		}
+		else if (StartIORing (&o_pMap->stRing, l_iDepth, FALSE) == EXIT_ERR)
+		{
+			free(o_pMap->pBuffers);
+			o_pMap->pBuffers = NULL;
+		}
+		else
+		{
+			// Each Buffer is read ahead : the first Window is the Buffer 0
+			for (l_iIdx = 0; l_iIdx < l_iDepth; l_iIdx++)
+			{
+				SubmitInputRead (o_pMap, l_iIdx);
+			}
+			o_pMap->iBuffer = l_iDepth - 1;
+		}
+	}
+	return MapInputWindow (o_pMap, 0);
+}
+
+/*
+ * =============================================================================
+ *   Read the next Record of the Input File, as fgets into Input_Record_Struct
+ *   would : up to MAX_INPUT_REC_LENGTH - 1 characters, ended by its '\n'.
+ *   o_lLength is the Length given by strlen. Returns FALSE at the End of File.
+ *   A mapped Record long enough for Create_Output_Record is read in place,
+ *   as found by the last Scan of the Window.
+ * =============================================================================
+*/
+int ReadInputRecord (FILE *i_File_Ptr, InputMap *io_pMap, const char **o_pRecord, long *o_lLength)
+{
+	const char	*l_pRecord		= NULL;
+	long		l_lChunk		= 0;
+
+	if (io_pMap->pWindow == NULL)
+	{
+		if (fgets((char*) &Input_Record_Struct, MAX_INPUT_REC_LENGTH, i_File_Ptr) == NULL)
+		{
+			return FALSE;
+		}
+		*o_pRecord = Input_Record_Struct.Input_Record;
+		*o_lLength = strlen(Input_Record_Struct.Input_Record);
+		return TRUE;
+	}
+
+	if (io_pMap->llRecordOffset >= io_pMap->llFileSize)
+	{
+		return FALSE;
+	}
+	if (io_pMap->lScanNext == io_pMap->lScanRecords)
+	{
+		l_lChunk = MAX_INPUT_REC_LENGTH - 1;
+		if (io_pMap->llRecordOffset + l_lChunk > io_pMap->llFileSize)
+		{
+			l_lChunk = io_pMap->llFileSize - io_pMap->llRecordOffset;
+		}
+		// The next Window starts with the Record going beyond the current one
+		if (io_pMap->llRecordOffset + l_lChunk > io_pMap->llWindowOffset + io_pMap->lWindowSize)
+		{
+			if (MapInputWindow (io_pMap, io_pMap->llRecordOffset) == EXIT_ERR)
+			{
+				return FALSE;
+			}
+		}
+		ScanInputRecords (io_pMap);
+	}
+	l_pRecord  = io_pMap->pWindow + io_pMap->plScanOffset[io_pMap->lScanNext];
+	l_lChunk   = io_pMap->plScanChunk[io_pMap->lScanNext];
+	*o_lLength = io_pMap->plScanLength[io_pMap->lScanNext];
+	io_pMap->lScanNext++;
+	io_pMap->llRecordOffset += l_lChunk;
+
+	if (l_lChunk >= lInputRecordExtent)
+	{
+		io_pMap->pPendingRecord = l_pRecord;
+		io_pMap->lPendingLength = l_lChunk;
+		*o_pRecord = l_pRecord;
+	}
+	else
+	{
+		KeepPendingInputRecord (io_pMap);
+		memcpy(Input_Record_Struct.Input_Record, l_pRecord, l_lChunk);
+		Input_Record_Struct.Input_Record[l_lChunk] = '\0';
+		*o_pRecord = Input_Record_Struct.Input_Record;
+	}
+	return TRUE;
+}
+
+/*
+ * =============================================================================
+ *                 Unmap the Input File, or stop its I/O Ring
+ * =============================================================================
+*/
+void CloseInputMap (InputMap *io_pMap)
+{
+	int		l_iIdx		= 0;
+
+	if (io_pMap->stRing.iDepth > 0)
+	{
+		// Reads still in flight are waited for before their Buffers are freed
+		for (l_iIdx = 0; l_iIdx < io_pMap->stRing.iDepth; l_iIdx++)
+		{
+			WaitIORequest (&io_pMap->stRing, l_iIdx);
+		}
+		StopIORing (&io_pMap->stRing);
+		free(io_pMap->pBuffers);
+		io_pMap->pBuffers = NULL;
+		io_pMap->pWindow  = NULL;
+	}
+	else if (io_pMap->pWindow != NULL)
+	{
+		munmap(io_pMap->pWindow, io_pMap->lWindowSize);
+		io_pMap->pWindow = NULL;
+	}
+	free(io_pMap->pullNewLineMasks);
+	free(io_pMap->plScanOffset);
+	io_pMap->pullNewLineMasks = NULL;
+	io_pMap->plScanOffset     = NULL;
+}
+
+/*
+ * =============================================================================
+ *   Length of the Output Record given by the Fields of tabFieldOfRecord
+ * =============================================================================
+*/
+long EvaluateOutputRecordLength ()
+{
+	long	l_lLength	= HEADER_LENGTH;
+	int		l_iIdx		= 0;
+
+	while (l_iIdx < iFieldPlanNumber)
+	{
+		if (tabFieldPlan[l_iIdx].iFieldStartPosOutput + tabFieldPlan[l_iIdx].iFieldLengthOutput > l_lLength)
+		{
+			l_lLength = tabFieldPlan[l_iIdx].iFieldStartPosOutput + tabFieldPlan[l_iIdx].iFieldLengthOutput;
+		}
+		l_iIdx++;
+	}
+	return l_lLength;
+}
+
+/*
+ * =============================================================================
+ *   Build the Output Record Template, once the Plan of the Output Record is
+ *   known : the Header with HEADER_MVT_LABEL and the Accounting Date, the
+ *   Detail filled by spaces, and AMOUNT_DECIMAL_NR in QTE_DECIMALES.
+ *   Each Output Record starts from a copy of this Template.
+ * =============================================================================
+*/
+void BuildOutputRecordTemplate (const char *i_strAccountingDate)
+{
+	int		l_iIdx		= 0;
+
+	memset(&Output_Record_Template, '\0', sizeof(OutputRecord));
+	memset(Output_Record_Template.Output_Header, ' ', HEADER_LENGTH);
+	memcpy(Output_Record_Template.Output_Header,  HEADER_MVT_LABEL, strlen(HEADER_MVT_LABEL));
+	memcpy(Output_Record_Template.Output_Header + HEADER_MVT_LABEL_LENGTH, i_strAccountingDate, DATE_LENGTH);
+	memset(Output_Record_Template.Output_Record, ' ', MAX_INPUT_REC_LENGTH + TIERS_RICOS_FIELD_NUMBER * TIERS_RICOS_FIELD_LENGTH);
+	for (l_iIdx = 0; l_iIdx < iFieldPlanNumber; l_iIdx++)
+	{
+		if (tabFieldPlan[l_iIdx].iFieldRole == roleQTE_DECIMALES)
+		{
+			memcpy((char *) &Output_Record_Template + tabFieldPlan[l_iIdx].iFieldStartPosOutput, AMOUNT_DECIMAL_NR, tabFieldPlan[l_iIdx].iFieldLengthOutput);
+		}
+	}
+	// The Bytes beyond the last Field are never written in the Output File
+	lOutputRecordTemplateLength = EvaluateOutputRecordLength ();
+	if (lOutputRecordTemplateLength > (long) sizeof(OutputRecord))
+	{
+		lOutputRecordTemplateLength = sizeof(OutputRecord);
+	}
+}
+
+/*
+ * =============================================================================
+ *   Start writing the Output File by large Blocks. The File is allocated at
+ *   once to i_llExpectedSize Bytes (0 if unknown), unless it is a Pipe
+ *   (i_iStream) or compressed (i_iCompression). The Blocks are written behind
+ *   through an I/O Ring unless IO_RING_DEPTH_VARIABLE is 0.
+ * =============================================================================
+*/
+int OpenOutputWriter (OutputWriter *o_pWriter, FILE *i_File_Ptr, long long i_llExpectedSize, int i_iStream, int i_iCompression, int i_iCompressionLevel)
+{
+	int		l_iDepth		= EvaluateIORingDepth ();
+
+	memset(o_pWriter, '\0', sizeof(OutputWriter));
+	o_pWriter->iFile = fileno(i_File_Ptr);
+	o_pWriter->iStream = (i_iStream) || (i_iCompression != COMPRESSION_NONE);
+	o_pWriter->lBufferSize = EvaluateIOBufferSize ();
+	if (posix_memalign((void **) &o_pWriter->pBuffers, OUTPUT_BUFFER_ALIGNMENT, ((l_iDepth > 0) ? l_iDepth : 1) * o_pWriter->lBufferSize) != 0)
+	{
+		printf("Error : '%s' occurs when allocating Output Buffers (%d x %ld Bytes)\n", strerror(ENOMEM), l_iDepth, o_pWriter->lBufferSize);
+		o_pWriter->pBuffers = NULL;
+		return EXIT_ERR;
+	}
+	o_pWriter->pBuffer = o_pWriter->pBuffers;
+	if ((i_iCompression != COMPRESSION_NONE) && (StartCompressor (&o_pWriter->stCompressor, i_iCompression, i_iCompressionLevel, o_pWriter->lBufferSize) == EXIT_ERR))
+	{
+		return EXIT_ERR;
+	}
+	if (l_iDepth > 0)
+	{
+		// If the Ring cannot be started, the Output File is written synchronously
+		StartIORing (&o_pWriter->stRing, l_iDepth, o_pWriter->iStream);
+		if (i_iCompression != COMPRESSION_NONE)
+		{
+			o_pWriter->stRing.pCompressor = &o_pWriter->stCompressor;
+		}
+	}
+	if ((i_llExpectedSize > 0) && (! o_pWriter->iStream))
+	{
+		// Records are fixed width : the File is truncated to the Bytes written when closed
+		posix_fallocate(o_pWriter->iFile, 0, i_llExpectedSize);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &o_pWriter->stStartTime);
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                 Write the Output Buffer in the Output File
+ * =============================================================================
+*/
+int FlushOutputWriter (OutputWriter *io_pWriter)
+{
+	long	l_lWrites	= 0;
+
+	if ((io_pWriter->stRing.iDepth > 0) && (io_pWriter->lBufferUsed > 0))
+	{
+		// The Buffer is written behind : the next one is filled once its former Write is over
+		SubmitIORequest (&io_pWriter->stRing, io_pWriter->iBuffer, io_pWriter->iFile, IO_REQUEST_WRITE, io_pWriter->pBuffer, io_pWriter->lBufferUsed,
+						 (io_pWriter->iStream) ? -1 : io_pWriter->llBytesWritten);
+		io_pWriter->llBytesWritten += io_pWriter->lBufferUsed;
+		io_pWriter->lBufferUsed = 0;
+		io_pWriter->lWrites++;
+		io_pWriter->iBuffer = (io_pWriter->iBuffer + 1) % io_pWriter->stRing.iDepth;
+		io_pWriter->pBuffer = io_pWriter->pBuffers + io_pWriter->iBuffer * io_pWriter->lBufferSize;
+		if (WaitIORequest (&io_pWriter->stRing, io_pWriter->iBuffer) < 0)
+		{
+			printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+			return EXIT_ERR;
+		}
+		return EXIT_OK;
+	}
+
+	if (io_pWriter->stCompressor.iFormat != COMPRESSION_NONE)
+	{
+		l_lWrites = (CompressAndWrite (&io_pWriter->stCompressor, io_pWriter->iFile, io_pWriter->pBuffer, io_pWriter->lBufferUsed, FALSE) == EXIT_ERR) ? -1 : 1;
+	}
+	else
+	{
+		l_lWrites = WriteFully (io_pWriter->iFile, io_pWriter->pBuffer, io_pWriter->lBufferUsed);
+	}
+	if (l_lWrites < 0)
+	{
+		printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+		return EXIT_ERR;
+	}
+	io_pWriter->lWrites += l_lWrites;
+	io_pWriter->llBytesWritten += io_pWriter->lBufferUsed;
+	io_pWriter->lBufferUsed = 0;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Add an Output Record and its '\n' in the Output Buffer. As with "%s", the
+ *   Record ends at its first '\0' : at most i_lMaxLength characters are read.
+ * =============================================================================
+*/
+int WriteOutputRecord (OutputWriter *io_pWriter, const char *i_pRecord, long i_lMaxLength)
+{
+	const char	*l_pEnd		= NULL;
+	long		l_lLength	= 0;
+
+	l_pEnd = (const char *) memchr(i_pRecord, '\0', i_lMaxLength);
+	l_lLength = (l_pEnd != NULL) ? l_pEnd - i_pRecord : i_lMaxLength;
+	if (io_pWriter->lBufferUsed + l_lLength + 1 > io_pWriter->lBufferSize)
+	{
+		if (FlushOutputWriter (io_pWriter) == EXIT_ERR)
+		{
+			return EXIT_ERR;
+		}
+	}
+	memcpy(io_pWriter->pBuffer + io_pWriter->lBufferUsed, i_pRecord, l_lLength);
+	io_pWriter->pBuffer[io_pWriter->lBufferUsed + l_lLength] = '\n';
+	io_pWriter->lBufferUsed += l_lLength + 1;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Map the Output File up to i_llRecords Slots at least. The File grows by
+ *   doubling its Size : no Record may be written in the former Mapping.
+ * =============================================================================
+*/
+int ReserveOutputMapping (OutputWriter *io_pWriter, long long i_llRecords)
+{
+	char		*l_pMapping		= NULL;
+	long long	l_llSize		= i_llRecords * io_pWriter->lSlotSize;
+
+	if (l_llSize <= io_pWriter->llMappingSize)
+	{
+		return EXIT_OK;
+	}
+	if (l_llSize < 2 * io_pWriter->llMappingSize)
+	{
+		l_llSize = 2 * io_pWriter->llMappingSize;
+	}
+	if (ftruncate(io_pWriter->iFile, l_llSize) != 0)
+	{
+		printf("Error %d : '%s' occurs when mapping Output File (%lld Bytes)\n", errno, strerror(errno), l_llSize);
+		return EXIT_ERR;
+	}
+	l_pMapping = (char *) mmap(NULL, l_llSize, PROT_READ | PROT_WRITE, MAP_SHARED, io_pWriter->iFile, 0);
+	if (l_pMapping == MAP_FAILED)
+	{
+		printf("Error %d : '%s' occurs when mapping Output File (%lld Bytes)\n", errno, strerror(errno), l_llSize);
+		return EXIT_ERR;
+	}
+	if (io_pWriter->pMapping != NULL)
+	{
+		munmap(io_pWriter->pMapping, io_pWriter->llMappingSize);
+	}
+	io_pWriter->pMapping      = l_pMapping;
+	io_pWriter->llMappingSize = l_llSize;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Map the Output File for the Enrichment Threads : each Record is written
+ *   in its Slot of i_lSlotSize Bytes, given by its Number. Not done for a
+ *   Pipe or a compressed File, or if OUTPUT_MAPPED_OFF_VARIABLE is set : the
+ *   Records are then written through the Output Buffers.
+ * =============================================================================
+*/
+int MapOutputWriter (OutputWriter *io_pWriter, long i_lSlotSize, long long i_llExpectedRecords)
+{
+	if ((io_pWriter->iStream) || (getenv(OUTPUT_MAPPED_OFF_VARIABLE) != NULL) || (io_pWriter->llBytesWritten + io_pWriter->lBufferUsed > 0))
+	{
+		return EXIT_ERR;
+	}
+	io_pWriter->lSlotSize = i_lSlotSize;
+	return ReserveOutputMapping (io_pWriter, (i_llExpectedRecords > 0) ? i_llExpectedRecords : 1);
+}
+
+/*
+ * =============================================================================
+ *   Keep an Output Record written with its '\n' in its Slot of the mapped
+ *   Output File. Once a former Record was shorter than its Slot, the Records
+ *   are moved back, so that they follow each other as if they were written.
+ * =============================================================================
+*/
+void WriteMappedOutputRecord (OutputWriter *io_pWriter, const char *i_pSlot, long i_lLength)
+{
+	if (i_pSlot != io_pWriter->pMapping + io_pWriter->llBytesWritten)
+	{
+		memmove(io_pWriter->pMapping + io_pWriter->llBytesWritten, i_pSlot, i_lLength + 1);
+	}
+	io_pWriter->llBytesWritten += i_lLength + 1;
+}
+
+/*
+ * =============================================================================
+ *   End writing the Output File : what was allocated beyond the written Bytes
+ *   is released, and the Throughput is reported.
+ * =============================================================================
+*/
+int CloseOutputWriter (OutputWriter *io_pWriter)
+{
+	struct timespec	l_stEndTime;
+	double			l_dSeconds		= 0;
+	int				l_iResult		= EXIT_OK;
+	int				l_iIdx			= 0;
+	const char		*l_strMode		= (io_pWriter->pMapping != NULL) ? "mapped" : DescribeIORing (&io_pWriter->stRing);
+
+	if (io_pWriter->pBuffers == NULL)
+	{
+		return EXIT_OK;
+	}
+	l_iResult = FlushOutputWriter (io_pWriter);
+	// Writes still in flight are waited for before the Buffers are freed
+	for (l_iIdx = 0; l_iIdx < io_pWriter->stRing.iDepth; l_iIdx++)
+	{
+		if (WaitIORequest (&io_pWriter->stRing, l_iIdx) < 0)
+		{
+			printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+			l_iResult = EXIT_ERR;
+		}
+	}
+	StopIORing (&io_pWriter->stRing);
+	if (io_pWriter->stCompressor.iFormat != COMPRESSION_NONE)
+	{
+		// End of the compressed Stream, once every Block was compressed
+		if (CompressAndWrite (&io_pWriter->stCompressor, io_pWriter->iFile, NULL, 0, TRUE) == EXIT_ERR)
+		{
+			printf("Error %d : '%s' occurs when writing Output File\n", errno, strerror(errno));
+			l_iResult = EXIT_ERR;
+		}
+		StopCompressor (&io_pWriter->stCompressor);
+	}
+	if (io_pWriter->pMapping != NULL)
+	{
+		munmap(io_pWriter->pMapping, io_pWriter->llMappingSize);
+		io_pWriter->pMapping = NULL;
+	}
+	if (! io_pWriter->iStream)
+	{
+		ftruncate(io_pWriter->iFile, io_pWriter->llBytesWritten);
+	}
+	free(io_pWriter->pBuffers);
+	io_pWriter->pBuffers = NULL;
+	io_pWriter->pBuffer  = NULL;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_stEndTime);
+	l_dSeconds = (l_stEndTime.tv_sec - io_pWriter->stStartTime.tv_sec) + (l_stEndTime.tv_nsec - io_pWriter->stStartTime.tv_nsec) / 1e9;
+	printf("Output Bytes Written .......... : %lld in %ld write(s) - %.1f MB/s (%s)\n", io_pWriter->llBytesWritten, io_pWriter->lWrites,
+				(l_dSeconds > 0) ? io_pWriter->llBytesWritten / l_dSeconds / 1e6 : 0.0, l_strMode);
+	if (io_pWriter->stCompressor.iFormat != COMPRESSION_NONE)
+	{
+		printf("Output Compressed (%s) ...... : %lld Bytes\n", tabCompressionName[io_pWriter->stCompressor.iFormat], io_pWriter->stCompressor.llBytesOut);
+	}
+	return l_iResult;
+}
+
+/*
+ * =============================================================================
+ *   Number of Enrichment Threads, given by ENRICH_THREADS_VARIABLE
+ *   1 : the Output Records are created by main
+ * =============================================================================
+*/
+int EvaluateEnrichThreads ()
+{
+	char	*l_strThreads	= getenv(ENRICH_THREADS_VARIABLE);
+	long	l_lThreads		= 1;
+
+	if (l_strThreads == NULL)
+	{
+		return 1;
+	}
+	l_lThreads = atol(l_strThreads);
+	if (l_lThreads <= 0)
+	{
+		l_lThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	if (l_lThreads < 1)
+	{
+		return 1;
+	}
+	return (l_lThreads > ENRICH_MAX_THREADS) ? ENRICH_MAX_THREADS : (int) l_lThreads;
+}
+
+/*
+ * =============================================================================
+ *   Create the Output Records of a Batch in the Context of an Enrichment
+ *   Thread. The Messages and the Key Counters are kept with the Batch, to be
+ *   given by main in the Order of the Input File.
+ * =============================================================================
+*/
+void EnrichRecordBatch (EnrichThread *io_pThread, RecordBatch *io_pBatch)
+{
+	EnrichPool	*l_pPool		= io_pThread->pPool;
+	const char	*l_pEnd			= NULL;
+	char		*l_pSlot		= NULL;
+	long		l_lOutputUsed	= 0;
+	long		l_lIdx			= 0;
+
+	io_pBatch->pLog     = NULL;
+	io_pBatch->lLogSize = 0;
+	RecordLog_Ptr = open_memstream(&io_pBatch->pLog, &io_pBatch->lLogSize);
+	lSIAMKeyFound    = 0;
+	lSIAMKeyNotFound = 0;
+	lSIAMKeyFiltered = 0;
+	lRTSKeyFound     = 0;
+	lRTSKeyNotFound  = 0;
+	lRTSKeyFiltered  = 0;
+
+	io_pBatch->lRejected = -1;
+	for (l_lIdx = 0; l_lIdx < io_pBatch->lRecords; l_lIdx++)
+	{
+		if (BuildOutputRecord(&io_pThread->stOutputRecord, io_pBatch->pInput + io_pBatch->plInputOffset[l_lIdx]) == EXIT_ERR)
+		{
+			// The following Records are not created, as main would have stopped
+			io_pBatch->lRejected = l_lIdx;
+			break;
+		}
+		// Create_Output_Record ends the Record after its last Field
+		l_pEnd = (const char *) memchr(&io_pThread->stOutputRecord, '\0', l_pPool->lOutputRecordLength);
+		io_pBatch->plOutputLength[l_lIdx] = (l_pEnd != NULL) ? l_pEnd - (const char *) &io_pThread->stOutputRecord : l_pPool->lOutputRecordLength;
+		if (l_pPool->pWriter->pMapping != NULL)
+		{
+			// The Record and its '\n' are written in its Slot of the mapped Output File
+			l_pSlot = l_pPool->pWriter->pMapping + (io_pBatch->lFirstRecord - 1 + l_lIdx) * l_pPool->pWriter->lSlotSize;
+			memcpy(l_pSlot, &io_pThread->stOutputRecord, io_pBatch->plOutputLength[l_lIdx]);
+			l_pSlot[io_pBatch->plOutputLength[l_lIdx]] = '\n';
+		}
+		else
+		{
+			memcpy(io_pBatch->pOutput + l_lOutputUsed, &io_pThread->stOutputRecord, io_pBatch->plOutputLength[l_lIdx]);
+			l_lOutputUsed += io_pBatch->plOutputLength[l_lIdx];
+		}
+	}
+
+	io_pBatch->lSIAMKeyFound    = lSIAMKeyFound;
+	io_pBatch->lSIAMKeyNotFound = lSIAMKeyNotFound;
+	io_pBatch->lSIAMKeyFiltered = lSIAMKeyFiltered;
+	io_pBatch->lRTSKeyFound     = lRTSKeyFound;
+	io_pBatch->lRTSKeyNotFound  = lRTSKeyNotFound;
+	io_pBatch->lRTSKeyFiltered  = lRTSKeyFiltered;
+	if (RecordLog_Ptr != NULL)
+	{
+		fclose(RecordLog_Ptr);
+		RecordLog_Ptr = NULL;
+	}
+}
+
+/*
+ * =============================================================================
+ *   Enrichment Thread : the Batches are taken in the Order they were submitted
+ * =============================================================================
+*/
+void *RunEnrichThread (void *io_pThread)
+{
+	EnrichThread	*l_pThread		= (EnrichThread *) io_pThread;
+	EnrichPool		*l_pPool		= l_pThread->pPool;
+	RecordBatch		*l_pBatch		= NULL;
+
+	pthread_mutex_lock(&l_pPool->stMutex);
+	while (TRUE)
+	{
+		while ((l_pPool->lTaken == l_pPool->lSubmitted) && (! l_pPool->iStop))
+		{
+			pthread_cond_wait(&l_pPool->stQueued, &l_pPool->stMutex);
+		}
+		if (l_pPool->iStop)
+		{
+			break;
+		}
+		l_pBatch = &l_pPool->pBatches[l_pPool->lTaken % l_pPool->iBatches];
+		l_pPool->lTaken++;
+		pthread_mutex_unlock(&l_pPool->stMutex);
+
+		EnrichRecordBatch (l_pThread, l_pBatch);
+
+		pthread_mutex_lock(&l_pPool->stMutex);
+		l_pBatch->iState = ENRICH_BATCH_DONE;
+		pthread_cond_broadcast(&l_pPool->stDone);
+	}
+	pthread_mutex_unlock(&l_pPool->stMutex);
+	return NULL;
+}
+
+/*
+ * =============================================================================
+ *                 Stop the Enrichment Threads and free their Batches
+ * =============================================================================
+*/
+void StopEnrichPool (EnrichPool *io_pPool)
+{
+	int		l_iIdx		= 0;
+
+	if (io_pPool->iThreads > 0)
+	{
+		pthread_mutex_lock(&io_pPool->stMutex);
+		io_pPool->iStop = TRUE;
+		pthread_cond_broadcast(&io_pPool->stQueued);
+		pthread_mutex_unlock(&io_pPool->stMutex);
+		for (l_iIdx = 0; l_iIdx < io_pPool->iThreads; l_iIdx++)
+		{
+			pthread_join(io_pPool->pThreads[l_iIdx].stThread, NULL);
+		}
+		io_pPool->iThreads = 0;
+	}
+	if (io_pPool->pBatches != NULL)
+	{
+		for (l_iIdx = 0; l_iIdx < io_pPool->iBatches; l_iIdx++)
+		{
+			free(io_pPool->pBatches[l_iIdx].pInput);
+			free(io_pPool->pBatches[l_iIdx].plInputOffset);
+			free(io_pPool->pBatches[l_iIdx].plInputLength);
+			free(io_pPool->pBatches[l_iIdx].pOutput);
+			free(io_pPool->pBatches[l_iIdx].plOutputLength);
+			free(io_pPool->pBatches[l_iIdx].pLog);
+		}
+		free(io_pPool->pBatches);
+		io_pPool->pBatches = NULL;
+	}
+	free(io_pPool->pThreads);
+	io_pPool->pThreads = NULL;
+}
+
+/*
+ * =============================================================================
+ *   Start i_iThreads Enrichment Threads, if there are more than one.
+ *   Returns EXIT_ERR if they cannot be started : the Output Records are then
+ *   created by main.
+ * =============================================================================
+*/
+int StartEnrichPool (EnrichPool *o_pPool, int i_iThreads)
+{
+	RecordBatch	*l_pBatch		= NULL;
+	int			l_iIdx			= 0;
+	int			l_iError		= 0;
+
+	memset(o_pPool, '\0', sizeof(EnrichPool));
+	if (i_iThreads <= 1)
+	{
+		return EXIT_ERR;
+	}
+	o_pPool->lOutputRecordLength = EvaluateOutputRecordLength ();
+	o_pPool->iBatches            = i_iThreads * ENRICH_BATCHES_BY_THREAD;
+	o_pPool->pBatches            = (RecordBatch *) calloc(o_pPool->iBatches, sizeof(RecordBatch));
+	o_pPool->pThreads            = (EnrichThread *) calloc(i_iThreads, sizeof(EnrichThread));
+	if ((o_pPool->pBatches == NULL) || (o_pPool->pThreads == NULL))
+	{
+		printf("Error %d : '%s' occurs when allocating Enrichment Threads, Records handled by main\n", errno, strerror(errno));
+		StopEnrichPool (o_pPool);
+		return EXIT_ERR;
+	}
+	for (l_iIdx = 0; l_iIdx < o_pPool->iBatches; l_iIdx++)
+	{
+		// A Batch is submitted once ENRICH_BATCH_SIZE is reached : its last Input Record may go beyond
+		l_pBatch = &o_pPool->pBatches[l_iIdx];
+		l_pBatch->pInput         = (char *) malloc(ENRICH_BATCH_SIZE + ((lInputRecordExtent > MAX_INPUT_REC_LENGTH) ? lInputRecordExtent : MAX_INPUT_REC_LENGTH));
+		l_pBatch->plInputOffset  = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		l_pBatch->plInputLength  = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		l_pBatch->pOutput        = (char *) malloc(ENRICH_BATCH_RECORDS * o_pPool->lOutputRecordLength);
+		l_pBatch->plOutputLength = (long *) malloc(ENRICH_BATCH_RECORDS * sizeof(long));
+		if ((l_pBatch->pInput == NULL) || (l_pBatch->plInputOffset == NULL) || (l_pBatch->plInputLength == NULL) || (l_pBatch->pOutput == NULL) || (l_pBatch->plOutputLength == NULL))
+		{
+			printf("Error %d : '%s' occurs when allocating Enrichment Batches, Records handled by main\n", errno, strerror(errno));
+			StopEnrichPool (o_pPool);
+			return EXIT_ERR;
+		}
+	}
+
+	pthread_mutex_init(&o_pPool->stMutex, NULL);
+	pthread_cond_init(&o_pPool->stQueued, NULL);
+	pthread_cond_init(&o_pPool->stDone, NULL);
+	for (l_iIdx = 0; l_iIdx < i_iThreads; l_iIdx++)
+	{
+		o_pPool->pThreads[l_iIdx].pPool = o_pPool;
+		l_iError = pthread_create(&o_pPool->pThreads[l_iIdx].stThread, NULL, RunEnrichThread, &o_pPool->pThreads[l_iIdx]);
+		if (l_iError != 0)
+		{
+			printf("Error %d : '%s' occurs when starting the Enrichment Thread %d\n", l_iError, strerror(l_iError), l_iIdx + 1);
+			break;
+		}
+		o_pPool->iThreads++;
+	}
+	if (o_pPool->iThreads == 0)
+	{
+		StopEnrichPool (o_pPool);
+		return EXIT_ERR;
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *                 Submit a Batch to the Enrichment Threads
+ * =============================================================================
+*/
+void SubmitRecordBatch (EnrichPool *io_pPool, RecordBatch *io_pBatch)
+{
+	pthread_mutex_lock(&io_pPool->stMutex);
+	io_pBatch->iState = ENRICH_BATCH_QUEUED;
+	io_pPool->lSubmitted++;
+	pthread_cond_signal(&io_pPool->stQueued);
+	pthread_mutex_unlock(&io_pPool->stMutex);
+}
+
+/*
+ * =============================================================================
+ *   Wait for the oldest Batch not written, then write its Output Records, as
+ *   main would have done : its Messages first, then the Records created up
+ *   to the rejected one.
+ * =============================================================================
+*/
+int WriteRecordBatch (EnrichPool *io_pPool, OutputWriter *io_pWriter)
+{
+	RecordBatch	*l_pBatch		= &io_pPool->pBatches[io_pPool->lWritten % io_pPool->iBatches];
+	long		l_lOutputUsed	= 0;
+	long		l_lRecords		= 0;
+	long		l_lIdx			= 0;
+
+	pthread_mutex_lock(&io_pPool->stMutex);
+	while (l_pBatch->iState != ENRICH_BATCH_DONE)
+	{
+		pthread_cond_wait(&io_pPool->stDone, &io_pPool->stMutex);
+	}
+	pthread_mutex_unlock(&io_pPool->stMutex);
+
+	if (l_pBatch->pLog != NULL)
+	{
+		fwrite(l_pBatch->pLog, 1, l_pBatch->lLogSize, stdout);
+		free(l_pBatch->pLog);
+		l_pBatch->pLog = NULL;
+	}
+	lSIAMKeyFound    += l_pBatch->lSIAMKeyFound;
+	lSIAMKeyNotFound += l_pBatch->lSIAMKeyNotFound;
+	lSIAMKeyFiltered += l_pBatch->lSIAMKeyFiltered;
+	lRTSKeyFound     += l_pBatch->lRTSKeyFound;
+	lRTSKeyNotFound  += l_pBatch->lRTSKeyNotFound;
+	lRTSKeyFiltered  += l_pBatch->lRTSKeyFiltered;
+
+	l_lRecords = (l_pBatch->lRejected >= 0) ? l_pBatch->lRejected : l_pBatch->lRecords;
+	for (l_lIdx = 0; l_lIdx < l_lRecords; l_lIdx++)
+	{
+		if (io_pWriter->pMapping != NULL)
+		{
+			WriteMappedOutputRecord (io_pWriter, io_pWriter->pMapping + (l_pBatch->lFirstRecord - 1 + l_lIdx) * io_pWriter->lSlotSize, l_pBatch->plOutputLength[l_lIdx]);
+		}
+		else if (WriteOutputRecord (io_pWriter, l_pBatch->pOutput + l_lOutputUsed, l_pBatch->plOutputLength[l_lIdx]) == EXIT_ERR)
+		{
+			printf("Process aborting. Record Nr %ld not written\n", l_pBatch->lFirstRecord + l_lIdx);
+			return EXIT_ERR;
+		}
+		l_lOutputUsed += l_pBatch->plOutputLength[l_lIdx];
+	}
+	if (l_pBatch->lRejected >= 0)
+	{
+		printf("Process aborting. Record Nr %ld rejected : %.*s\n", l_pBatch->lFirstRecord + l_pBatch->lRejected,
+					(int) l_pBatch->plInputLength[l_pBatch->lRejected], l_pBatch->pInput + l_pBatch->plInputOffset[l_pBatch->lRejected]);
+		// The Threads may still write the following Batches in the mapped Output File
+		StopEnrichPool (io_pPool);
+		CloseOutputWriter (io_pWriter);
+		return EXIT_ERR;
+	}
+	l_pBatch->iState = ENRICH_BATCH_FREE;
+	io_pPool->lWritten++;
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Write every Batch submitted and not written yet
+ * =============================================================================
+*/
+int WriteRecordBatches (EnrichPool *io_pPool, OutputWriter *io_pWriter)
+{
+	while (io_pPool->lWritten < io_pPool->lSubmitted)
+	{
+		if (WriteRecordBatch (io_pPool, io_pWriter) == EXIT_ERR)
+		{
+			return EXIT_ERR;
+		}
+	}
+	return EXIT_OK;
+}
+
+/*
+ * =============================================================================
+ *   Handle the Input Records through the Enrichment Threads : the Records are
+ *   copied by Batches, as Create_Output_Record would read them, and the Output
+ *   Records are written in the Order of the Input File.
+ * =============================================================================
+*/
+int EnrichRecordsInParallel (EnrichPool *io_pPool, FILE *i_File_Ptr, InputMap *io_pMap, OutputWriter *io_pWriter, long *io_lRecordNumber, long *io_lEmptyRecordNumber)
+{
+	RecordBatch	*l_pBatch				= NULL;
+	const char	*l_pInputRecord			= NULL;
+	long		l_lInputRecordLength	= 0;
+	long		l_lCopied				= 0;
+
+	io_pPool->pWriter = io_pWriter;
+	while (ReadInputRecord (i_File_Ptr, io_pMap, &l_pInputRecord, &l_lInputRecordLength))
+	{
+		if (l_lInputRecordLength > 1)
+		{
+			// Handle only not empty records
+			(*io_lRecordNumber)++;
+			if (l_pBatch == NULL)
+			{
+				// Every Batch is in use : the oldest one is written first
+				if ((io_pPool->lSubmitted - io_pPool->lWritten == io_pPool->iBatches) && (WriteRecordBatch (io_pPool, io_pWriter) == EXIT_ERR))
 				{
-					tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_CPY_USING_RTS;
-					// Add TIERS_EXT_RICOS and TIERS_EXT_RICOS_CY in Output File
-					l_iPreviousInputFieldNumber = l_iFieldNumber;
-					l_iFieldNumber++;
-					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EXT_RICOS");
-					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-					tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-					tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_CPY_RTS_INPUT_POSIT;
-					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber - 1].iFieldLengthOutput;
-					l_iFieldNumber++;
-					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EXT_RICOS_CY");
-					strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "entierZG");
-					tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-					tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_CPY_RTS_INPUT_POSIT;
-					tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-					l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+					return EXIT_ERR;
 				}
-				else
+				if ((io_pWriter->pMapping != NULL) && ((*io_lRecordNumber - 1 + ENRICH_BATCH_RECORDS) * io_pWriter->lSlotSize > io_pWriter->llMappingSize))
 				{
-					if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_EMPPRET") == 0)
+					// The mapped Output File grows once every Batch is written
+					if (WriteRecordBatches (io_pPool, io_pWriter) == EXIT_ERR)
 					{
-						tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-						// Add TIERS_EMPPRET_RICOS in Output File
-						l_iPreviousInputFieldNumber = l_iFieldNumber;
-						l_iFieldNumber++;
-						strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EMPPRET_RICOS");
-						strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-						tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-						tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-						tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-						tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-						l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
+						return EXIT_ERR;
 					}
-					else
+					if (ReserveOutputMapping (io_pWriter, *io_lRecordNumber - 1 + ENRICH_BATCH_RECORDS) == EXIT_ERR)
 					{
-						if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_GARANT")  == 0)
-						{
-							tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-							// Add TIERS_GARANT_RICOS in Output File
-							l_iPreviousInputFieldNumber = l_iFieldNumber;
-							l_iFieldNumber++;
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_GARANT_RICOS");
-							strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-							tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-							tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-							tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-							l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-						}
-						else
-						{
-							if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_EMETTIT") == 0)
-							{
-								tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-								// Add TIERS_EMETTIT_RICOS in Output File
-								l_iPreviousInputFieldNumber = l_iFieldNumber;
-								l_iFieldNumber++;
-								strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EMETTIT_RICOS");
-								strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-								tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-								tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-								tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-								tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-								l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-							}
-							else
-							{
-								if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_DEPOSIT") == 0)
-								{
-									tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-									// Add TIERS_DEPOSIT_RICOS in Output File
-									l_iPreviousInputFieldNumber = l_iFieldNumber;
-									l_iFieldNumber++;
-									strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_DEPOSIT_RICOS");
-									strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-									tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-									tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-									tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-									tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-									l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-								}
-								else
-								{
-									if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_EMETSSJ") == 0)
-									{
-										tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-										// Add TIERS_EMETSSJ_RICOS in Output File
-										l_iPreviousInputFieldNumber = l_iFieldNumber;
-										l_iFieldNumber++;
-										strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_EMETSSJ_RICOS");
-										strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-										tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-										tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-										tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-										tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-										l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-									}
-									else
-									{
-										if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_ACTR") == 0)
-										{
-											tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-											// Add TIERS_ACTR_RICOS in Output File
-											l_iPreviousInputFieldNumber = l_iFieldNumber;
-											l_iFieldNumber++;
-											strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_ACTR_RICOS");
-											strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-											tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-											tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-											tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-											tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-											l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-										}
-										else
-										{
-											if (strcmp(tabFieldOfRecord[l_iFieldNumber].strFieldName, "Z_ALIAS_ID_TIERORI") == 0)
-											{
-												tabFieldOfRecord[l_iFieldNumber].iFieldType           = ADD_RICOS_SC_USING_RTS;
-												// Add TIERS_ORI_RICOS in Output File
-												l_iPreviousInputFieldNumber = l_iFieldNumber;
-												l_iFieldNumber++;
-												strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldName, "TIERS_ORI_RICOS");
-												strcpy(tabFieldOfRecord[l_iFieldNumber].strFieldFormat, "charED");
-												tabFieldOfRecord[l_iFieldNumber].iFieldFormat         = whichOutputFormat(tabFieldOfRecord[l_iFieldNumber].strFieldFormat);
-												tabFieldOfRecord[l_iFieldNumber].iFieldLengthOutput   = TIERS_RICOS_FIELD_LENGTH;
-												tabFieldOfRecord[l_iFieldNumber].iFieldStartPosInput  = RICOS_SC_RTS_INPUT_POSIT;
-												tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput = tabFieldOfRecord[l_iFieldNumber - 1].iFieldStartPosOutput + tabFieldOfRecord[l_iFieldNumber -1].iFieldLengthOutput;
-												l_iStartFieldPositionForOutput                        = tabFieldOfRecord[l_iFieldNumber].iFieldStartPosOutput;
-											}
-											else
-											{
-												l_iPreviousInputFieldNumber = l_iFieldNumber;
-											}
-										}
-									}
-								}
-							}
-						}
+						printf("Process aborting. Record Nr %ld not written\n", *io_lRecordNumber);
+						return EXIT_ERR;
 					}
 				}
+				l_pBatch = &io_pPool->pBatches[io_pPool->lSubmitted % io_pPool->iBatches];
+				l_pBatch->lFirstRecord = *io_lRecordNumber;
+				l_pBatch->lRecords     = 0;
+				l_pBatch->lInputUsed   = 0;
+			}
+			// Create_Output_Record may read beyond the End of a short Record
+			l_lCopied = (l_lInputRecordLength > lInputRecordExtent) ? l_lInputRecordLength : lInputRecordExtent;
+			memcpy(l_pBatch->pInput + l_pBatch->lInputUsed, l_pInputRecord, l_lCopied);
+			l_pBatch->plInputOffset[l_pBatch->lRecords] = l_pBatch->lInputUsed;
+			l_pBatch->plInputLength[l_pBatch->lRecords] = l_lInputRecordLength;
+			l_pBatch->lInputUsed += l_lCopied;
+			l_pBatch->lRecords++;
+			if ((l_pBatch->lRecords == ENRICH_BATCH_RECORDS) || (l_pBatch->lInputUsed >= ENRICH_BATCH_SIZE))
+			{
+				SubmitRecordBatch (io_pPool, l_pBatch);
+				l_pBatch = NULL;
 			}
 		}
+		else
+		{
+			(*io_lEmptyRecordNumber)++;
+		}
 	}
-	/* Closing struct_pestd.conf File */
-	printf("Closing %s File ...\n", l_strFullInputFileFormatName);
-	fclose(l_InputFile_RecordFormat_Ptr);
-	return EXIT_OK;
+	if (l_pBatch != NULL)
+	{
+		SubmitRecordBatch (io_pPool, l_pBatch);
+	}
+	return WriteRecordBatches (io_pPool, io_pWriter);
 }
 
 /* 
@@ -2165,6 +5849,24 @@ main(int argc, char *argv[])
 	long l_lIdx					= 0;
 	long Record_Number       	= 0;
 	long Empty_Record_Number 	= 0;
+	long l_lInputRecordLength	= 0;
+	const char *l_pInputRecord	= NULL;
+	int l_iStreamOutputFile		= -1;
+	int l_iOutputCompression	= COMPRESSION_NONE;
+	int l_iOutputCompressionLevel	= 0;
+	char *l_pStreamInputBuffer	= NULL;
+	int l_iResult				= EXIT_OK;
+
+	/* Streaming : stdout is kept for the Output Records, the Logs go to stderr */
+	if ((argc > 1) && (strcmp(argv[1], STREAM_FILE_NAME) == 0))
+	{
+		l_iStreamOutputFile = dup(STDOUT_FILENO);
+		if ((l_iStreamOutputFile < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+		{
+			fprintf(stderr, "Error %d : '%s' occurs when redirecting stdout to stderr\n", errno, strerror(errno));
+			return EXIT_ERR;
+		}
+	}
 
 	/* Start of Program */
 	printf("Start Har_Transco_PESTD Program ...\n");
@@ -2188,6 +5890,7 @@ main(int argc, char *argv[])
 		printf("Bad Number of Parameters. This Number must be %d instead of %d\n", NB_PARAM - 1, argc - 1);
 		printf("---                                   U S A G E                                   ---\n");
 		printf("   - Parameter 1 : Input File                                          [Mandatory]\n");
+		printf("                   \"-\" : stdin to stdout, Logs to stderr\n");
 		printf("   - Parameter 2 : Accounting Date in YYYYMMDD Format                  [Mandatory]\n");
 		return EXIT_ERR;
 	}
@@ -2200,7 +5903,7 @@ main(int argc, char *argv[])
 	printf("Checking Parameters ...\n");
 	
 	// Input File
-	InputFile_Name = (char*) malloc(strlen(argv[1]) * sizeof(char));        
+	InputFile_Name = (char*) malloc((1 + strlen(argv[1])) * sizeof(char));        
     strncpy(InputFile_Name, argv[1], strlen(argv[1]));
 	InputFile_Name[strlen(argv[1])] = '\0';
 
@@ -2237,6 +5940,9 @@ main(int argc, char *argv[])
 		}
 	}*/
 
+	/* Building the Template of the Output Records */
+	BuildOutputRecordTemplate (Accounting_Date);
+
 	/* Getting the REF_TIERS.dat File Format using REF_TIERS.conf File */
 	// TIERS Fields with ACRO_SIAM and RTS Format converted to RICOS Format
 	if (BuildRefTiersRecordFormat() == EXIT_ERR)
@@ -2251,35 +5957,29 @@ main(int argc, char *argv[])
 	}
 	/*else
 	{
-		for (l_lIdx = 0; l_lIdx < HASH_ARRAY_SIZE; l_lIdx++)
+		for (l_lIdx = 0; l_lIdx < lSIAMHashArraySize; l_lIdx++)
 		{
-			for (l_lIdY = 0; l_lIdY < HASH_ARRAY_SIZE; l_lIdY++)
+			if (SIAMHashCtrl[l_lIdx] != HASH_CTRL_EMPTY)
 			{
-				if (SIAMHashArray[l_lIdx].stElt[l_lIdY].SIAMHashKey >= 0)
-				{
-					printf (" - [main] - SIAMHashArray - Record %03ld , %03ld : %lld | \t\t%s | \t\t%s | \t\t%s\n",	
-								l_lIdx, l_lIdY,
-								SIAMHashArray[l_lIdx].stElt[l_lIdY].SIAMHashKey,
-								SIAMHashArray[l_lIdx].stElt[l_lIdY].strSIAM,
-								SIAMHashArray[l_lIdx].stElt[l_lIdY].strRICOS_SC_ID,
-								SIAMHashArray[l_lIdx].stElt[l_lIdY].strRICOS_CPY_ID);
-				}
+				printf (" - [main] - SIAMHashArray - Record %06ld : %lld | \t\t%s | \t\t%s | \t\t%s\n",	
+							l_lIdx,
+							SIAMHashArray[l_lIdx].SIAMHashKey,
+							TIERS_STRING(SIAMHashArray[l_lIdx].uiSIAM),
+							TIERS_STRING(SIAMHashArray[l_lIdx].uiRICOS_SC_ID),
+							TIERS_STRING(SIAMHashArray[l_lIdx].uiRICOS_CPY_ID));
 			}
 		}
 		printf("\n");
-		for (l_lIdx = 0; l_lIdx < HASH_ARRAY_SIZE; l_lIdx++)
+		for (l_lIdx = 0; l_lIdx < lRTSHashArraySize; l_lIdx++)
 		{
-			for (l_lIdY = 0; l_lIdY < HASH_ARRAY_SIZE; l_lIdY++)
+			if (RTSHashCtrl[l_lIdx] != HASH_CTRL_EMPTY)
 			{
-				if (RTSHashArray[l_lIdx].stElt[l_lIdY].RTSHashKey >= 0)
-				{
-					printf (" - [main] - RTSHashArray - Record %03ld , %03ld : %lld | \t\t%s | \t\t%s | \t\t%s\n",
-								l_lIdx, l_lIdY,
-								RTSHashArray[l_lIdx].stElt[l_lIdY].RTSHashKey,
-								RTSHashArray[l_lIdx].stElt[l_lIdY].strRTS_SC_ID,
-								RTSHashArray[l_lIdx].stElt[l_lIdY].strRICOS_SC_ID,
-								RTSHashArray[l_lIdx].stElt[l_lIdY].strRICOS_CPY_ID);
-				}
+				printf (" - [main] - RTSHashArray - Record %06ld : %lld | \t\t%s | \t\t%s | \t\t%s\n",
+							l_lIdx,
+							RTSHashArray[l_lIdx].RTSHashKey,
+							TIERS_STRING(RTSHashArray[l_lIdx].uiRTS_SC_ID),
+							TIERS_STRING(RTSHashArray[l_lIdx].uiRICOS_SC_ID),
+							TIERS_STRING(RTSHashArray[l_lIdx].uiRICOS_CPY_ID));
 			}
 		}
 	}
@@ -2308,20 +6008,25 @@ main(int argc, char *argv[])
 	}
 	/*else
 	{	
-		for (l_lIdX = 0; l_lIdX < HASH_CURRENCY_ARRAY_SIZE; l_lIdX++)
+		for (l_lIdX = 0; l_lIdX < CURRENCY_EMPTY_INDEX; l_lIdX++)
 		{
-			for (l_lIdY = 0; l_lIdY < HASH_CURRENCY_ARRAY_SIZE; l_lIdY++)
+			if (CURRENCYDecimalArray[l_lIdX] != CURRENCY_DECIMAL_NOT_FOUND)
 			{
-				if (CURRENCYHashArray[l_lIdX].stElt[l_lIdY].CURRENCYHashKey >= 0)
-				{
-					printf (" - [main] - CURRENCYHashArray - Record %03ld , %03ld : %lld | \t\t%s | \t\t%s\n",	
-								l_lIdX, l_lIdY,
-								CURRENCYHashArray[l_lIdX].stElt[l_lIdY].CURRENCYHashKey,
-								CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strCURRENCY_CD,
-								CURRENCYHashArray[l_lIdX].stElt[l_lIdY].strDECIMAL_POS);
-				}
+				printf (" - [main] - CURRENCYDecimalArray - Record %05ld : %c%c%c | \t\t%c\n",	
+							l_lIdX,
+							(char) ('A' + l_lIdX / (CURRENCY_LETTER_NUMBER * CURRENCY_LETTER_NUMBER)),
+							(char) ('A' + (l_lIdX / CURRENCY_LETTER_NUMBER) % CURRENCY_LETTER_NUMBER),
+							(char) ('A' + l_lIdX % CURRENCY_LETTER_NUMBER),
+							CURRENCYDecimalArray[l_lIdX]);
 			}
 		}
+		for (l_lIdX = 0; l_lIdX < lCURRENCYOverflowNumber; l_lIdX++)
+		{
+			printf (" - [main] - CURRENCYOverflowArray - Record %03ld : %s | \t\t%s\n",	
+						l_lIdX,
+						CURRENCYOverflowArray[l_lIdX].strCURRENCY_CD,
+						CURRENCYOverflowArray[l_lIdX].strDECIMAL_POS);
+		}
 	}
 	printf("\n");*/
 	
@@ -2330,20 +6035,56 @@ main(int argc, char *argv[])
 
 	/* Opening Input File */
 	printf("Opening Input  File ........... : %s\n", InputFile_Name);
-	InputFile_Ptr = fopen(InputFile_Name, "r");
+	if (l_iStreamOutputFile >= 0)
+	{
+		// stdin is read by large Blocks too, unless it can be mapped
+		InputFile_Ptr = stdin;
+		l_pStreamInputBuffer = (char *) malloc(EvaluateIOBufferSize ());
+		if (l_pStreamInputBuffer != NULL)
+		{
+			setvbuf(InputFile_Ptr, l_pStreamInputBuffer, _IOFBF, EvaluateIOBufferSize ());
+		}
+	}
+	else
+	{
+		InputFile_Ptr = fopen(InputFile_Name, "r");
+	}
 	if (InputFile_Ptr == NULL)
 	{
 		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), InputFile_Name);
 		free(InputFile_Name);
 		return EXIT_ERR;
 	}	
+
+	/* Decompressing Input File : if it is compressed, its Records are read from a Pipe */
+	if (OpenInputDecompressor (&InputFile_Decompressor, &InputFile_Ptr) == EXIT_ERR)
+	{
+		free(InputFile_Name);
+		return EXIT_ERR;
+	}
 	
 	/* Opening Ouput File */
-	OutputFile_Name = (char*) malloc((1 + strlen(argv[1]) + strlen(OUTPUT_FILE_EXTENSION)) * sizeof(char));
-	strcpy(OutputFile_Name, InputFile_Name);
-	strcat(OutputFile_Name, OUTPUT_FILE_EXTENSION);
-	printf("Opening Output File ........... : %s\n", OutputFile_Name);
-	OutputFile_Ptr = fopen(OutputFile_Name, "w");
+	l_iOutputCompression = EvaluateOutputCompression (&l_iOutputCompressionLevel);
+	if (l_iOutputCompression < 0)
+	{
+		free(InputFile_Name);
+		return EXIT_ERR;
+	}
+	OutputFile_Name = (char*) malloc((1 + strlen(argv[1]) + strlen(OUTPUT_FILE_EXTENSION) + strlen(STREAM_OUTPUT_FILE_NAME) + strlen(tabCompressionExtension[l_iOutputCompression])) * sizeof(char));
+	if (l_iStreamOutputFile >= 0)
+	{
+		strcpy(OutputFile_Name, STREAM_OUTPUT_FILE_NAME);
+		printf("Opening Output File ........... : %s\n", OutputFile_Name);
+		OutputFile_Ptr = fdopen(l_iStreamOutputFile, "w");
+	}
+	else
+	{
+		strcpy(OutputFile_Name, InputFile_Name);
+		strcat(OutputFile_Name, OUTPUT_FILE_EXTENSION);
+		strcat(OutputFile_Name, tabCompressionExtension[l_iOutputCompression]);
+		printf("Opening Output File ........... : %s\n", OutputFile_Name);
+		OutputFile_Ptr = fopen(OutputFile_Name, "w+");
+	}
 	if (OutputFile_Ptr == NULL)
 	{
 		printf("Error %d : '%s' occurs when opening %s File \n", errno, strerror(errno), OutputFile_Name);
@@ -2351,51 +6092,111 @@ main(int argc, char *argv[])
 		return EXIT_ERR;
 	}   
 	
-	/* Handling Input Data and Creating Output File */
-	while (fgets((char*) &Input_Record_Struct, MAX_INPUT_REC_LENGTH, InputFile_Ptr) != NULL)
+	/* Mapping Input File : if it cannot be mapped, it is read with fgets */
+	OpenInputMap (&InputFile_Map, InputFile_Ptr);
+
+	/* Output File allocated for one Output Record by Input Record, if the Input File is mapped */
+	if (OpenOutputWriter (&OutputFile_Writer, OutputFile_Ptr, (InputFile_Map.pWindow != NULL) ? (InputFile_Map.llFileSize / (lInputRecordExtent + 1) + 1) * (EvaluateOutputRecordLength () + 1) : 0, (l_iStreamOutputFile >= 0), l_iOutputCompression, l_iOutputCompressionLevel) == EXIT_ERR)
+	{
+		free(InputFile_Name);
+		free(OutputFile_Name);
+		return EXIT_ERR;
+	}
+
+	/* Handling Input Data and Creating Output File : by the Enrichment Threads if they are started */
+	if (StartEnrichPool (&Enrich_Pool, EvaluateEnrichThreads ()) == EXIT_OK)
 	{
-		if (strlen(Input_Record_Struct.Input_Record) > 1)
+		printf("Enrichment Threads ............ : %d\n", Enrich_Pool.iThreads);
+		// The Enrichment Threads write the Records in place : the mapped Output File grows beyond the Records expected
+		MapOutputWriter (&OutputFile_Writer, Enrich_Pool.lOutputRecordLength + 1, InputFile_Map.llFileSize / (lInputRecordExtent + 1) + 1);
+		l_iResult = EnrichRecordsInParallel (&Enrich_Pool, InputFile_Ptr, &InputFile_Map, &OutputFile_Writer, &Record_Number, &Empty_Record_Number);
+		StopEnrichPool (&Enrich_Pool);
+		if (l_iResult == EXIT_ERR)
 		{
-			// Handle only not empty records
-			Record_Number++;
-			// Create Output Record Header
-			memset(Output_Record_Struct.Output_Header, ' ', HEADER_LENGTH);
-			memcpy(Output_Record_Struct.Output_Header,  HEADER_MVT_LABEL, strlen(HEADER_MVT_LABEL));
-			memcpy(Output_Record_Struct.Output_Header + HEADER_MVT_LABEL_LENGTH, Accounting_Date, DATE_LENGTH);
-			// Create Output Record Detail
-			memset(Output_Record_Struct.Output_Record, ' ', MAX_INPUT_REC_LENGTH + TIERS_RICOS_FIELD_NUMBER * TIERS_RICOS_FIELD_LENGTH);
-			if (Create_Output_Record(Input_Record_Struct.Input_Record, (char *) &Output_Record_Struct) == EXIT_ERR)
+			free(InputFile_Name);
+			free(OutputFile_Name);
+			return EXIT_ERR;
+		}
+	}
+	else
+	{
+		while (ReadInputRecord (InputFile_Ptr, &InputFile_Map, &l_pInputRecord, &l_lInputRecordLength))
+		{
+			if (l_lInputRecordLength > 1)
 			{
-				printf("Process aborting. Record Nr %ld rejected : %s\n", Record_Number, Input_Record_Struct.Input_Record);
-				free(InputFile_Name);
-				free(OutputFile_Name);
-				return EXIT_ERR;
+				// Handle only not empty records
+				Record_Number++;
+				if (BuildOutputRecord(&Output_Record_Struct, l_pInputRecord) == EXIT_ERR)
+				{
+					printf("Process aborting. Record Nr %ld rejected : %.*s\n", Record_Number, (int) l_lInputRecordLength, l_pInputRecord);
+					CloseOutputWriter (&OutputFile_Writer);
+					free(InputFile_Name);
+					free(OutputFile_Name);
+					return EXIT_ERR;
+				}
+				else
+				{
+					if (WriteOutputRecord (&OutputFile_Writer, (char *) &Output_Record_Struct, sizeof(Output_Record_Struct)) == EXIT_ERR)
+					{
+						printf("Process aborting. Record Nr %ld not written\n", Record_Number);
+						free(InputFile_Name);
+						free(OutputFile_Name);
+						return EXIT_ERR;
+					}
+				}
 			}
 			else
 			{
-				fprintf(OutputFile_Ptr, "%s\n", (char *) &Output_Record_Struct);
+				Empty_Record_Number++;
 			}
 		}
-		else
-		{
-			Empty_Record_Number++;
-		}
 	}
 	
 	printf("Total Number of Records Read .. : %d\n", Record_Number + Empty_Record_Number);
 	printf("Total Number of Handled Records : %d\n", Record_Number);
+	printf("SIAM Keys Found / NOT FOUND ... : %ld / %ld (%ld NOT FOUND by the Bloom Filter)\n", lSIAMKeyFound, lSIAMKeyNotFound, lSIAMKeyFiltered);
+	printf("RTS Keys Found / NOT FOUND .... : %ld / %ld (%ld NOT FOUND by the Bloom Filter)\n", lRTSKeyFound, lRTSKeyNotFound, lRTSKeyFiltered);
 
 	/* End Input File Handling */
 	printf("End   Handling of %s File\n", InputFile_Name);
 	
 	/* Closing Files */
 	printf("Closing %s and %s Files ...\n", OutputFile_Name, InputFile_Name);
+	if (CloseOutputWriter (&OutputFile_Writer) == EXIT_ERR)
+	{
+		printf("Error : Output File %s is incomplete\n", OutputFile_Name);
+	}
 	fclose(OutputFile_Ptr);
+	CloseInputMap (&InputFile_Map);
 	fclose(InputFile_Ptr);
+	free(l_pStreamInputBuffer);
+	if (CloseInputDecompressor (&InputFile_Decompressor) == EXIT_ERR)
+	{
+		printf("Process aborting. Input File %s was not read to its End\n", InputFile_Name);
+		free(InputFile_Name);
+		free(OutputFile_Name);
+		return EXIT_ERR;
+	}
 
 	/* Free memory allocation */
 	free(InputFile_Name);
 	free(OutputFile_Name);
+	if (TiersSnapshot.pMapping != NULL)
+	{
+		// SIAM, RTS and TiersArena Tables are mapped from the Snapshot of REF_TIERS.dat File
+		CloseSnapshot (&TiersSnapshot);
+	}
+	else
+	{
+		free(SIAMHashArray);
+		free(SIAMHashCtrl);
+		free(SIAMBloomFilter);
+		free(RTSHashArray);
+		free(RTSHashCtrl);
+		free(RTSBloomFilter);
+		free(TiersArena);
+	}
+	free(TiersInternArray);
 	
 	/* End of Program */
 	printf("End   Har_Transco_PESTD Program ...\n");